@@ -0,0 +1,158 @@
+// AlertDeduplicator::should_suppress with 1M tracked keys, compared with
+// the string-keyed unordered_map it replaced (inlined below). Hit repeats
+// alerts inside their window, so every call is a lookup that suppresses.
+// Churn is the steady state: keys come round again every ~62 s against a
+// 60 s window, so most calls find an expired key, and the cleanup that runs
+// every 100 alerts has entries to remove.
+
+#include "sentinel/events/utils/hex_codec.hpp"
+#include "sentinel/risk/alert_deduplicator.hpp"
+#include "sentinel/risk/alert_dispatcher.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using namespace sentinel::risk;
+
+constexpr uint64_t kWindowMs = 60'000;
+constexpr uint64_t kStartMs = 1'700'000'000'000ULL;
+constexpr uint64_t kTokensPerCustomer = 16;
+
+// Same (customer, rule, chain, token) key, as the pre-change deduplicator
+// built it: one std::string per call and a full scan every n alerts.
+class StringKeyDeduplicator {
+public:
+  explicit StringKeyDeduplicator(DeduplicatorConfig cfg) : cfg_(std::move(cfg)) {}
+
+  bool should_suppress(const Alert &a, uint64_t now_ms) {
+    std::string key;
+    key.reserve(64);
+    key += std::to_string(a.customer_id);
+    key += '|';
+    key += a.rule_type;
+    key += '|';
+    key += a.chain_id.has_value() ? std::to_string(*a.chain_id) : "-";
+    key += '|';
+    key += a.token_address.value_or("");
+
+    auto window_it = cfg_.per_rule_window_ms.find(a.rule_type);
+    const uint64_t window = window_it != cfg_.per_rule_window_ms.end()
+                                ? window_it->second
+                                : cfg_.default_window_ms;
+    bool suppress = false;
+    auto it = last_fired_ms_.find(key);
+    if (it == last_fired_ms_.end()) {
+      last_fired_ms_.emplace(key, now_ms);
+    } else if (now_ms < it->second || now_ms - it->second < window) {
+      suppress = true;
+    } else {
+      it->second = now_ms;
+    }
+    if (++since_cleanup_ >= cfg_.cleanup_every_n_alerts) {
+      std::erase_if(last_fired_ms_, [&](const auto &kv) {
+        return now_ms >= kv.second && now_ms - kv.second > cfg_.default_window_ms;
+      });
+      since_cleanup_ = 0;
+    }
+    return suppress;
+  }
+
+  void set_cleanup_every(size_t n) { cfg_.cleanup_every_n_alerts = n; }
+  size_t tracked_keys_count() const { return last_fired_ms_.size(); }
+
+private:
+  DeduplicatorConfig cfg_;
+  std::unordered_map<std::string, uint64_t> last_fired_ms_;
+  size_t since_cleanup_ = 0;
+};
+
+std::vector<Alert> make_alerts(std::size_t n) {
+  std::vector<Alert> alerts;
+  alerts.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    std::array<uint8_t, 20> addr{};
+    addr[0] = 0xaa;
+    addr[19] = static_cast<uint8_t>(i % kTokensPerCustomer);
+    Alert a{};
+    a.customer_id = i / kTokensPerCustomer;
+    a.rule_type = "large_transfer";
+    a.message = "Large transfer detected";
+    a.chain_id = 42161;
+    a.token_address = sentinel::events::utils::bytes_to_hex(addr);
+    alerts.push_back(std::move(a));
+  }
+  return alerts;
+}
+
+DeduplicatorConfig make_config(size_t cleanup_every) {
+  DeduplicatorConfig cfg;
+  cfg.default_window_ms = kWindowMs;
+  cfg.cleanup_every_n_alerts = cleanup_every;
+  return cfg;
+}
+
+// The string map is not cleaned while it is filled, which would take
+// minutes at this size
+template <typename Dedup> void set_cleanup_every(Dedup &, size_t) {}
+void set_cleanup_every(StringKeyDeduplicator &d, size_t n) { d.set_cleanup_every(n); }
+
+template <typename Dedup> void run_hit(benchmark::State &state) {
+  const auto alerts = make_alerts(static_cast<std::size_t>(state.range(0)));
+  Dedup dedup(make_config(100));
+  set_cleanup_every(dedup, SIZE_MAX);
+  for (const auto &a : alerts) {
+    dedup.should_suppress(a, kStartMs);
+  }
+  set_cleanup_every(dedup, 100);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dedup.should_suppress(alerts[i++ % alerts.size()], kStartMs + 1));
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["tracked_keys"] = static_cast<double>(dedup.tracked_keys_count());
+}
+
+template <typename Dedup> void run_churn(benchmark::State &state) {
+  const auto alerts = make_alerts(static_cast<std::size_t>(state.range(0)));
+  // Every key comes round once per ~62 s
+  const uint64_t per_ms = std::max<uint64_t>(1, alerts.size() / 62'000);
+
+  // One round to fill the table
+  Dedup dedup(make_config(100));
+  set_cleanup_every(dedup, SIZE_MAX);
+  uint64_t i = 0;
+  for (; i < alerts.size(); ++i) {
+    dedup.should_suppress(alerts[i], kStartMs + i / per_ms);
+  }
+  set_cleanup_every(dedup, 100);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        dedup.should_suppress(alerts[i % alerts.size()], kStartMs + i / per_ms));
+    ++i;
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["tracked_keys"] = static_cast<double>(dedup.tracked_keys_count());
+}
+
+void BM_Dedup_StringKey_Hit(benchmark::State &state) { run_hit<StringKeyDeduplicator>(state); }
+void BM_Dedup_Hit(benchmark::State &state) { run_hit<AlertDeduplicator>(state); }
+void BM_Dedup_StringKey_Churn(benchmark::State &state) {
+  run_churn<StringKeyDeduplicator>(state);
+}
+void BM_Dedup_Churn(benchmark::State &state) { run_churn<AlertDeduplicator>(state); }
+
+} // namespace
+
+BENCHMARK(BM_Dedup_StringKey_Hit)->Arg(1'000'000);
+BENCHMARK(BM_Dedup_Hit)->Arg(1'000'000);
+BENCHMARK(BM_Dedup_StringKey_Churn)->Arg(1'000'000);
+BENCHMARK(BM_Dedup_Churn)->Arg(1'000'000);
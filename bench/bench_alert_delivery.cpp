@@ -0,0 +1,97 @@
+// Per-alert delivery work outside the network: the Telegram text with 10k
+// customer names and token symbols to look up, and the webhook JSON body
+// with and without the HMAC-SHA256 signature every signed endpoint gets.
+
+#include "sentinel/events/utils/hex_codec.hpp"
+#include "sentinel/risk/alert_dispatcher.hpp"
+#include "sentinel/risk/alert_formatter.hpp"
+#include "sentinel/risk/webhook_alert_channel.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using namespace sentinel::risk;
+
+constexpr uint64_t kChain = 42161;
+constexpr uint32_t kCustomers = 10'000;
+constexpr uint32_t kTokens = 200;
+
+std::string token(uint32_t n) {
+  std::array<uint8_t, 20> addr{};
+  addr[0] = 0xaa;
+  addr[18] = static_cast<uint8_t>(n >> 8);
+  addr[19] = static_cast<uint8_t>(n);
+  return sentinel::events::utils::bytes_to_hex(addr);
+}
+
+// Large transfers and approvals, the alerts that carry every field
+std::vector<Alert> make_alerts() {
+  std::vector<Alert> alerts;
+  for (uint32_t i = 0; i < 64; ++i) {
+    const bool approval = i % 4 == 0;
+    alerts.push_back(Alert{.customer_id = (i * 7919) % kCustomers,
+                           .rule_type = approval ? "approval" : "large_transfer",
+                           .message = approval ? "Large approval detected"
+                                               : "Large transfer detected",
+                           .timestamp_ms = 1'716'580'000'000ULL + i,
+                           .internal_ingress_time_ms = 1'716'580'000'250ULL + i,
+                           .amount_decimal = "1250000000000000000000",
+                           .token_address = token(i % kTokens),
+                           .chain_id = kChain});
+  }
+  return alerts;
+}
+
+void BM_FormatTelegram(benchmark::State &state) {
+  std::unordered_map<std::uint64_t, std::string> customers;
+  for (uint32_t c = 0; c < kCustomers; ++c) {
+    customers[c] = "customer-" + std::to_string(c);
+  }
+  std::unordered_map<TokenKey, std::string> tokens;
+  for (uint32_t t = 0; t < kTokens; ++t) {
+    tokens[{kChain, token(t)}] = "TKN" + std::to_string(t);
+  }
+  const auto alerts = make_alerts();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    auto text = AlertFormatter::format_telegram(alerts[i++ % alerts.size()], &customers, &tokens);
+    benchmark::DoNotOptimize(text.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_WebhookPayload(benchmark::State &state) {
+  const auto alerts = make_alerts();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    auto body = webhook_payload(alerts[i++ % alerts.size()]);
+    benchmark::DoNotOptimize(body.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_WebhookPayloadSigned(benchmark::State &state) {
+  const auto alerts = make_alerts();
+  const std::string secret = "whsec_5f0c2a9e8d4b7163a1e2f3c4d5b6a798";
+  std::size_t i = 0;
+  for (auto _ : state) {
+    const auto &alert = alerts[i++ % alerts.size()];
+    auto body = webhook_payload(alert);
+    auto signature = webhook_signature(secret, std::to_string(alert.timestamp_ms), body);
+    benchmark::DoNotOptimize(signature.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK(BM_FormatTelegram);
+BENCHMARK(BM_WebhookPayload);
+BENCHMARK(BM_WebhookPayloadSigned);
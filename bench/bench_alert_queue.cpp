@@ -0,0 +1,111 @@
+// Alert hand-off from rule threads to the dispatcher. Mutex is the
+// std::queue + condition_variable pair AlertDispatcher used before; Mpsc is
+// the bounded lock-free queue with batched dequeue. Arg(n) producer threads
+// push (as RiskEngine workers do), the benchmark thread drains.
+
+#include "sentinel/risk/alert_dispatcher.hpp"
+#include "sentinel/risk/mpsc_queue.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using sentinel::risk::Alert;
+
+Alert make_alert() {
+  Alert a{};
+  a.customer_id = 1;
+  a.rule_type = "large_transfer";
+  a.message = "Large transfer of 1500000.0 USDC detected";
+  a.chain_id = 42161;
+  return a;
+}
+
+// Per-producer share of `total`, the remainder going to producer 0.
+int64_t share(int64_t total, int producers, int p) {
+  return total / producers + (p == 0 ? total % producers : 0);
+}
+
+void BM_AlertQueue_Mutex(benchmark::State &state) {
+  const int producers = static_cast<int>(state.range(0));
+  const int64_t total = static_cast<int64_t>(state.max_iterations);
+  const Alert proto = make_alert();
+
+  std::mutex mu;
+  std::condition_variable cv;
+  std::queue<Alert> queue;
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&, n = share(total, producers, p)] {
+      for (int64_t i = 0; i < n; ++i) {
+        {
+          std::lock_guard<std::mutex> lk(mu);
+          queue.push(proto);
+        }
+        cv.notify_one();
+      }
+    });
+  }
+
+  for (auto _ : state) {
+    std::unique_lock<std::mutex> lk(mu);
+    cv.wait(lk, [&] { return !queue.empty(); });
+    Alert a = std::move(queue.front());
+    queue.pop();
+    lk.unlock();
+    benchmark::DoNotOptimize(a);
+  }
+
+  for (auto &t : threads) t.join();
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AlertQueue_Mutex)->Arg(1)->Arg(4)->UseRealTime();
+
+void BM_AlertQueue_Mpsc(benchmark::State &state) {
+  const int producers = static_cast<int>(state.range(0));
+  const int64_t total = static_cast<int64_t>(state.max_iterations);
+  const Alert proto = make_alert();
+
+  sentinel::risk::MpscQueue<Alert> queue(16384);
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&, n = share(total, producers, p)] {
+      for (int64_t i = 0; i < n; ++i) {
+        Alert a = proto;
+        while (!queue.try_push(std::move(a))) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  std::vector<Alert> batch;
+  batch.reserve(64);
+  std::size_t next = 0;
+  for (auto _ : state) {
+    if (next == batch.size()) {
+      batch.clear();
+      next = 0;
+      while (queue.pop_batch(batch, 64) == 0) {
+        queue.wait_for(std::chrono::milliseconds(1), [] { return false; });
+      }
+    }
+    benchmark::DoNotOptimize(batch[next++]);
+  }
+
+  for (auto &t : threads) t.join();
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AlertQueue_Mpsc)->Arg(1)->Arg(4)->UseRealTime();
+
+} // namespace
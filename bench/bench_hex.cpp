@@ -0,0 +1,122 @@
+// Hex decode/encode for the sizes on the ingest path: 20-byte addresses,
+// 32-byte topics and hashes, and 256 bytes of log data. Legacy is the
+// per-character hex_nibble() parser and the snprintf("%02x") formatter the
+// codec replaced; the other rows run each kernel this CPU supports.
+
+#include "sentinel/events/utils/hex.hpp"
+#include "sentinel/events/utils/hex_codec.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace sentinel::events::utils;
+
+std::vector<uint8_t> random_bytes(std::size_t n) {
+  std::mt19937 rng(1);
+  std::vector<uint8_t> out(n);
+  for (auto &b : out) b = static_cast<uint8_t>(rng());
+  return out;
+}
+
+std::string hex_of(const std::vector<uint8_t> &bytes) {
+  return bytes_to_hex(bytes.data(), bytes.size());
+}
+
+// ---------------------------------------------------------------------------
+// The replaced implementations
+
+void legacy_validate(std::string_view hex) {
+  for (std::size_t i = 2; i < hex.size(); ++i) {
+    static_cast<void>(hex_nibble(hex[i]));
+  }
+}
+
+void legacy_parse(std::string_view hex, uint8_t *out, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    out[i] = (hex_nibble(hex[2 + i * 2]) << 4) | hex_nibble(hex[2 + i * 2 + 1]);
+  }
+}
+
+std::string legacy_format(const uint8_t *in, std::size_t n) {
+  std::string out = "0x";
+  for (std::size_t i = 0; i < n; ++i) {
+    char buf[3];
+    std::snprintf(buf, sizeof(buf), "%02x", in[i]);
+    out += buf;
+  }
+  return out;
+}
+
+// ---------------------------------------------------------------------------
+
+void BM_HexDecode_Legacy(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const std::string hex = hex_of(random_bytes(n));
+  std::vector<uint8_t> out(n);
+  for (auto _ : state) {
+    // normalize() validated data before parsing it
+    legacy_validate(hex);
+    legacy_parse(hex, out.data(), n);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(hex.size()));
+}
+
+void BM_HexDecode(benchmark::State &state, const HexKernels *k) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const std::string hex = hex_of(random_bytes(n));
+  std::vector<uint8_t> out(n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(k->decode(hex.data() + 2, n, out.data()));
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(hex.size()));
+}
+
+void BM_HexEncode_Legacy(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const auto bytes = random_bytes(n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(legacy_format(bytes.data(), n));
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+
+void BM_HexEncode(benchmark::State &state, const HexKernels *k) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const auto bytes = random_bytes(n);
+  for (auto _ : state) {
+    // Same allocation as bytes_to_hex, so the rows compare like for like
+    std::string out(2 + 2 * n, '0');
+    out[1] = 'x';
+    k->encode(bytes.data(), n, out.data() + 2);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+
+const int kRegistered = [] {
+  benchmark::RegisterBenchmark("BM_HexDecode_Legacy", BM_HexDecode_Legacy)
+      ->Arg(20)->Arg(32)->Arg(256);
+  benchmark::RegisterBenchmark("BM_HexEncode_Legacy", BM_HexEncode_Legacy)
+      ->Arg(20)->Arg(32)->Arg(256);
+  for (const auto &k : available_hex_kernels()) {
+    benchmark::RegisterBenchmark(("BM_HexDecode/" + std::string(k.name)).c_str(),
+                                 BM_HexDecode, &k)
+        ->Arg(20)->Arg(32)->Arg(256);
+    benchmark::RegisterBenchmark(("BM_HexEncode/" + std::string(k.name)).c_str(),
+                                 BM_HexEncode, &k)
+        ->Arg(20)->Arg(32)->Arg(256);
+  }
+  return 0;
+}();
+
+} // namespace
@@ -0,0 +1,135 @@
+// eth_getLogs decode: nlohmann DOM -> RawLog -> normalize() vs the streaming
+// decoder. Set SENTINEL_BENCH_GETLOGS_PAYLOAD to a recorded eth_getLogs
+// response body to run against real data instead of the synthetic payload.
+
+#include "sentinel/events/RawLog.hpp"
+#include "sentinel/events/log_stream_decoder.hpp"
+#include "sentinel/events/normalize.hpp"
+#include "sentinel/events/utils/hex.hpp"
+
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr uint64_t kChainId = 42161;
+
+// Deterministic 0x-prefixed hex of `bytes` bytes.
+std::string synth_hex(uint64_t &state, std::size_t bytes) {
+  static constexpr char kDigits[] = "0123456789abcdef";
+  std::string s = "0x";
+  s.reserve(2 + bytes * 2);
+  for (std::size_t i = 0; i < bytes * 2; ++i) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    s.push_back(kDigits[(state >> 59) & 0xF]);
+  }
+  return s;
+}
+
+// Mix of ERC20 Transfer / Approval and Uniswap V3 Swap logs, laid out the way
+// providers return them (including fields the pipeline ignores).
+std::string synth_payload(std::size_t n_logs) {
+  static const char *kTopic0[] = {
+      "0xddf252ad1be2c89b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef",
+      "0x8c5be1e5ebec7d5bd14f71427d1e84f3dd0314c0f7b2291e5b200ac8c7c3b925",
+      "0xc42079f94a6350d7e6235f29174924f928cc2ac818eb64fed8004e115fbcca67",
+  };
+  static const std::size_t kDataBytes[] = {32, 32, 160};
+
+  uint64_t state = 1;
+  nlohmann::json logs = nlohmann::json::array();
+  for (std::size_t i = 0; i < n_logs; ++i) {
+    const std::size_t kind = i % 3;
+    const std::string pad = "0x000000000000000000000000";
+    logs.push_back({
+        {"address", synth_hex(state, 20)},
+        {"topics",
+         {kTopic0[kind], pad + synth_hex(state, 20).substr(2),
+          pad + synth_hex(state, 20).substr(2)}},
+        {"data", synth_hex(state, kDataBytes[kind])},
+        {"blockNumber", sentinel::events::utils::to_hex_quantity(200000000 + i / 20)},
+        {"blockHash", synth_hex(state, 32)},
+        {"blockTimestamp", "0x6650f0a0"},
+        {"transactionHash", synth_hex(state, 32)},
+        {"transactionIndex", sentinel::events::utils::to_hex_quantity(i % 50)},
+        {"logIndex", sentinel::events::utils::to_hex_quantity(i % 200)},
+        {"removed", false},
+    });
+  }
+  return nlohmann::json{{"jsonrpc", "2.0"}, {"id", 1}, {"result", logs}}.dump();
+}
+
+const std::string &payload(std::size_t n_logs) {
+  static std::map<std::size_t, std::string> cache;
+  auto it = cache.find(n_logs);
+  if (it != cache.end()) {
+    return it->second;
+  }
+
+  std::string body;
+  if (const char *path = std::getenv("SENTINEL_BENCH_GETLOGS_PAYLOAD")) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+      throw std::runtime_error(std::string("cannot open ") + path);
+    }
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    body = ss.str();
+  } else {
+    body = synth_payload(n_logs);
+  }
+  return cache.emplace(n_logs, std::move(body)).first->second;
+}
+
+void BM_GetLogs_DomRawLogNormalize(benchmark::State &state) {
+  const std::string &body = payload(static_cast<std::size_t>(state.range(0)));
+  std::size_t logs = 0;
+
+  for (auto _ : state) {
+    auto res = nlohmann::json::parse(body);
+    const auto &arr = res.at("result");
+    std::vector<sentinel::events::RawLog> raws;
+    raws.reserve(arr.size());
+    for (const auto &jlog : arr) {
+      raws.push_back(jlog.get<sentinel::events::RawLog>());
+    }
+    for (const auto &raw : raws) {
+      sentinel::risk::Signal sig{};
+      sentinel::events::normalize(raw, sig, kChainId, 0);
+      benchmark::DoNotOptimize(sig);
+    }
+    logs = raws.size();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * body.size()));
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * logs));
+}
+
+void BM_GetLogs_StreamDecode(benchmark::State &state) {
+  const std::string &body = payload(static_cast<std::size_t>(state.range(0)));
+  std::vector<sentinel::risk::Signal> out;
+  std::size_t logs = 0;
+
+  for (auto _ : state) {
+    out.clear();
+    logs = sentinel::events::decode_get_logs_response(body, kChainId, out);
+    benchmark::DoNotOptimize(out.data());
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * body.size()));
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * logs));
+}
+
+} // namespace
+
+BENCHMARK(BM_GetLogs_DomRawLogNormalize)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GetLogs_StreamDecode)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
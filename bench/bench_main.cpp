@@ -0,0 +1,151 @@
+// sentinel_bench entry point: google benchmark's own flags, plus
+//
+//   --baseline=<file>              compare against a previous run saved with
+//                                  --benchmark_out=<file>
+//                                  --benchmark_out_format=json
+//   --regression-threshold=<pct>   slowdown that counts as a regression (10)
+//
+// With a baseline, every benchmark present in both runs is listed with its
+// change in real time, and the exit status is 1 if any regressed.
+
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+constexpr std::string_view kBaselineFlag = "--baseline=";
+constexpr std::string_view kThresholdFlag = "--regression-threshold=";
+
+// Real time per iteration in ns, by benchmark name (aggregates included
+// under their suffixed names; stddev and cv are not times and are skipped)
+using Timings = std::map<std::string, double>;
+
+bool is_time(std::string_view aggregate_name) {
+  return aggregate_name != "stddev" && aggregate_name != "cv";
+}
+
+double unit_to_ns(std::string_view unit) {
+  if (unit == "us") return 1e3;
+  if (unit == "ms") return 1e6;
+  if (unit == "s") return 1e9;
+  return 1.0;
+}
+
+class CollectingReporter : public benchmark::ConsoleReporter {
+public:
+  explicit CollectingReporter(Timings &out) : ConsoleReporter(OO_Tabular), out_(out) {}
+
+  void ReportRuns(const std::vector<Run> &runs) override {
+    for (const auto &run : runs) {
+      if (run.run_type == Run::RT_Aggregate && !is_time(run.aggregate_name)) {
+        continue;
+      }
+      out_[run.benchmark_name()] = run.GetAdjustedRealTime() * 1e9 /
+                                   benchmark::GetTimeUnitMultiplier(run.time_unit);
+    }
+    ConsoleReporter::ReportRuns(runs);
+  }
+
+private:
+  Timings &out_;
+};
+
+Timings load_baseline(const std::string &path) {
+  std::ifstream in(path);
+  if (!in) {
+    throw std::runtime_error("cannot open baseline " + path);
+  }
+  const auto doc = nlohmann::json::parse(in);
+  Timings timings;
+  for (const auto &entry : doc.at("benchmarks")) {
+    if (entry.value("run_type", "iteration") == "aggregate" &&
+        !is_time(entry.value("aggregate_name", ""))) {
+      continue;
+    }
+    // Errored runs carry no time
+    if (!entry.contains("real_time")) {
+      continue;
+    }
+    timings[entry.at("name").get<std::string>()] =
+        entry.at("real_time").get<double>() * unit_to_ns(entry.value("time_unit", "ns"));
+  }
+  return timings;
+}
+
+// Prints the comparison and returns the number of regressions.
+int compare(const Timings &baseline, const Timings &current, double threshold_pct) {
+  std::printf("\nAgainst baseline (real time, regression above +%.1f%%):\n", threshold_pct);
+  std::printf("%-56s %14s %14s %9s\n", "Benchmark", "Baseline ns", "Current ns", "Change");
+  int regressions = 0;
+  for (const auto &[name, now] : current) {
+    auto it = baseline.find(name);
+    if (it == baseline.end() || it->second <= 0 || now <= 0) {
+      continue;
+    }
+    const double change_pct = (now - it->second) / it->second * 100.0;
+    const bool regressed = change_pct > threshold_pct;
+    regressions += regressed;
+    std::printf("%-56s %14.1f %14.1f %+8.1f%%%s\n", name.c_str(), it->second, now, change_pct,
+                regressed ? "  REGRESSION" : "");
+  }
+  std::printf("%d regression(s)\n", regressions);
+  return regressions;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::string baseline_path;
+  double threshold_pct = 10.0;
+
+  // Take our flags out before google benchmark sees the rest
+  std::vector<char *> args;
+  for (int i = 0; i < argc; ++i) {
+    const std::string_view arg(argv[i]);
+    try {
+      if (arg.starts_with(kBaselineFlag)) {
+        baseline_path = arg.substr(kBaselineFlag.size());
+      } else if (arg.starts_with(kThresholdFlag)) {
+        threshold_pct = std::stod(std::string(arg.substr(kThresholdFlag.size())));
+      } else {
+        args.push_back(argv[i]);
+      }
+    } catch (const std::exception &) {
+      std::cerr << "Error: invalid value for " << arg << "\n";
+      return 1;
+    }
+  }
+  int bench_argc = static_cast<int>(args.size());
+  benchmark::Initialize(&bench_argc, args.data());
+  if (benchmark::ReportUnrecognizedArguments(bench_argc, args.data())) {
+    return 1;
+  }
+
+  if (baseline_path.empty()) {
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+  }
+
+  Timings baseline;
+  try {
+    baseline = load_baseline(baseline_path);
+  } catch (const std::exception &e) {
+    std::cerr << "Error: " << e.what() << "\n";
+    return 1;
+  }
+  Timings current;
+  CollectingReporter reporter(current);
+  benchmark::RunSpecifiedBenchmarks(&reporter);
+  benchmark::Shutdown();
+  return compare(baseline, current, threshold_pct) > 0 ? 1 : 0;
+}
@@ -0,0 +1,104 @@
+// normalize() of one RawLog per event kind the pipeline sees: the typed
+// decoders (Transfer, Approval, AnswerUpdated, OwnershipTransferred), a V3
+// Swap that keeps its topics and data out of line, and an unregistered
+// topic0. BM_GetLogs_DomRawLogNormalize covers the same path for whole
+// responses.
+
+#include "sentinel/events/RawLog.hpp"
+#include "sentinel/events/normalize.hpp"
+#include "sentinel/events/topic_registry.hpp"
+#include "sentinel/events/utils/hex.hpp"
+#include "sentinel/events/utils/hex_codec.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace {
+
+using sentinel::events::RawLog;
+using sentinel::events::utils::bytes_to_hex;
+using sentinel::events::utils::to_be_256;
+
+constexpr uint64_t kChainId = 42161;
+
+std::string topic0(std::string_view signature) {
+  for (const auto &entry : sentinel::events::kTopicRegistry) {
+    if (entry.signature == signature) {
+      return bytes_to_hex(entry.topic0);
+    }
+  }
+  throw std::logic_error("unregistered event");
+}
+
+// An address or small integer as an indexed topic
+std::string word(uint64_t v) { return bytes_to_hex(to_be_256(v)); }
+
+std::string address(uint8_t tag) {
+  std::array<uint8_t, 20> addr{};
+  addr.fill(tag);
+  return bytes_to_hex(addr);
+}
+
+RawLog make_log(int kind) {
+  RawLog log;
+  log.address = address(0xaa);
+  log.blockNumber = "0xbebc200";
+  log.transactionHash = word(0x1234);
+  log.logIndex = "0x2a";
+  log.transactionIndex = "0x7";
+  switch (kind) {
+  case 0:
+    log.topics = {topic0("Transfer(address,address,uint256)"), word(0x11), word(0x22)};
+    log.data = word(1'000'000'000);
+    break;
+  case 1:
+    log.topics = {topic0("Approval(address,address,uint256)"), word(0x11), word(0x22)};
+    log.data = word(1'000'000'000);
+    break;
+  case 2:
+    log.topics = {topic0("AnswerUpdated(int256,uint256,uint256)"), word(6'543'210'000),
+                  word(18'446'744'073'709'551'615ULL)};
+    log.data = word(1'716'580'000);
+    break;
+  case 3:
+    log.topics = {topic0("OwnershipTransferred(address,address)"), word(0x11), word(0x22)};
+    log.data = "0x";
+    break;
+  case 4:
+    log.topics = {topic0("Swap(address,address,int256,int256,uint160,uint128,int24)"),
+                  word(0x11), word(0x22)};
+    log.data = "0x";
+    for (uint64_t slot = 1; slot <= 5; ++slot) {
+      log.data += word(slot * 1'000'003).substr(2);
+    }
+    break;
+  default:
+    log.topics = {word(0xdeadbeef), word(0x11)};
+    log.data = word(7);
+    break;
+  }
+  return log;
+}
+
+void BM_Normalize(benchmark::State &state) {
+  static constexpr const char *kLabels[] = {"transfer", "approval", "oracle",
+                                            "governance", "swap", "unknown"};
+  const auto kind = static_cast<int>(state.range(0));
+  const RawLog log = make_log(kind);
+  sentinel::risk::Signal signal{};
+  for (auto _ : state) {
+    sentinel::events::normalize(log, signal, kChainId, 1'716'580'000);
+    benchmark::DoNotOptimize(signal);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetLabel(kLabels[kind]);
+}
+
+} // namespace
+
+BENCHMARK(BM_Normalize)->DenseRange(0, 5);
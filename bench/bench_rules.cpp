@@ -0,0 +1,235 @@
+// evaluate() of the rules other than LargeTransferRule, each with 10k and
+// 100k customer configs spread over 200 watched contracts (feeds for the
+// oracle rule). Every signal hits a watched contract and alerts for ~1% of
+// its configs, except governance, where customers subscribe to actions
+// rather than amounts and about two thirds of them match.
+
+#include "sentinel/risk/rules/approval_rule.hpp"
+#include "sentinel/risk/rules/bridge_transfer_rule.hpp"
+#include "sentinel/risk/rules/governance_rule.hpp"
+#include "sentinel/risk/rules/mint_burn_rule.hpp"
+#include "sentinel/risk/rules/oracle_update_rule.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+using namespace sentinel::risk;
+using sentinel::events::utils::uint256;
+
+constexpr uint64_t kChain = 42161;
+constexpr uint32_t kContracts = 200;
+constexpr uint32_t kBridges = 10;
+constexpr uint64_t kMaxThreshold = 1'000'000'000;
+constexpr uint32_t kMaxSpikeBps = 5'000;
+
+std::array<uint8_t, 20> contract(uint32_t n, uint8_t tag = 0xaa) {
+  std::array<uint8_t, 20> addr{};
+  addr[0] = tag;
+  addr[16] = static_cast<uint8_t>(n >> 24);
+  addr[17] = static_cast<uint8_t>(n >> 16);
+  addr[18] = static_cast<uint8_t>(n >> 8);
+  addr[19] = static_cast<uint8_t>(n);
+  return addr;
+}
+
+std::array<uint8_t, 32> be256(uint64_t v) {
+  std::array<uint8_t, 32> out{};
+  for (int i = 0; i < 8; ++i) {
+    out[31 - i] = static_cast<uint8_t>(v >> (i * 8));
+  }
+  return out;
+}
+
+std::size_t config_count(const benchmark::State &state) {
+  return static_cast<std::size_t>(state.range(0));
+}
+
+// One signal per watched contract, built by `make`, cycled 64 at a time
+template <typename Make> std::vector<Signal> make_signals(Make make) {
+  std::vector<Signal> signals;
+  for (uint32_t i = 0; i < 64; ++i) {
+    signals.push_back(make(i % kContracts));
+  }
+  return signals;
+}
+
+template <typename Rule>
+void run(benchmark::State &state, Rule &rule, const std::vector<Signal> &signals) {
+  StateStore store;
+  std::vector<Alert> alerts;
+  std::size_t i = 0;
+  for (auto _ : state) {
+    alerts.clear();
+    rule.evaluate(signals[i++ % signals.size()], store, alerts);
+    benchmark::DoNotOptimize(alerts.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_Rule_Governance(benchmark::State &state) {
+  static constexpr std::optional<GovernanceAction> kFilters[] = {
+      std::nullopt, GovernanceAction::OwnershipTransferred, GovernanceAction::Upgraded};
+  GovernanceRule::ConfigMap configs;
+  for (std::size_t i = 0; i < config_count(state); ++i) {
+    const auto addr = contract(static_cast<uint32_t>(i % kContracts));
+    configs[{kChain, addr}].push_back({.customer_id = i,
+                                       .chain_id = kChain,
+                                       .contract_address = addr,
+                                       .enabled = true,
+                                       .action_filter = kFilters[i % 3]});
+  }
+  GovernanceRule rule(std::move(configs));
+  const auto signals = make_signals([](uint32_t n) {
+    Signal s{};
+    s.type = SignalType::Governance;
+    s.payload = GovernanceEvent{GovernanceAction::OwnershipTransferred, kChain, contract(n)};
+    return s;
+  });
+  run(state, rule, signals);
+}
+
+void BM_Rule_MintBurn(benchmark::State &state) {
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<uint64_t> threshold(1, kMaxThreshold);
+  MintBurnRule::ConfigMap configs;
+  for (std::size_t i = 0; i < config_count(state); ++i) {
+    const auto addr = contract(static_cast<uint32_t>(i % kContracts));
+    configs[{kChain, addr}].push_back({.customer_id = i,
+                                       .chain_id = kChain,
+                                       .contract_address = addr,
+                                       .mint_threshold = threshold(rng),
+                                       .burn_threshold = threshold(rng),
+                                       .enabled = true});
+  }
+  MintBurnRule rule(std::move(configs));
+  const auto signals = make_signals([](uint32_t n) {
+    Signal s{};
+    s.type = SignalType::MintBurn;
+    MintBurnEvent mb{};
+    mb.chain_id = kChain;
+    mb.token_address = contract(n);
+    mb.amount = be256(kMaxThreshold / 100);
+    mb.to = contract(n, 0x11);
+    mb.direction = n % 2 ? MintBurnDirection::Burn : MintBurnDirection::Mint;
+    s.payload = mb;
+    return s;
+  });
+  run(state, rule, signals);
+}
+
+void BM_Rule_Approval(benchmark::State &state) {
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<uint64_t> threshold(1, kMaxThreshold);
+  ApprovalRule::ConfigMap configs;
+  for (std::size_t i = 0; i < config_count(state); ++i) {
+    const auto addr = contract(static_cast<uint32_t>(i % kContracts));
+    configs[{kChain, addr}].push_back({.customer_id = i,
+                                       .chain_id = kChain,
+                                       .token_address = addr,
+                                       .threshold = threshold(rng),
+                                       .alert_on_infinite = true,
+                                       .enabled = true});
+  }
+  ApprovalRule rule(std::move(configs));
+  const auto signals = make_signals([](uint32_t n) {
+    Signal s{};
+    s.type = SignalType::Approval;
+    ApprovalEvent ap{};
+    ap.chain_id = kChain;
+    ap.token_address = contract(n);
+    ap.owner = contract(n, 0x11);
+    ap.spender = contract(n, 0x22);
+    ap.amount = be256(kMaxThreshold / 100);
+    s.payload = ap;
+    return s;
+  });
+  run(state, rule, signals);
+}
+
+void BM_Rule_Bridge(benchmark::State &state) {
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<uint64_t> threshold(1, kMaxThreshold);
+  std::unordered_map<BridgeRuleKey, std::vector<BridgeRuleConfig>> configs;
+  for (std::size_t i = 0; i < config_count(state); ++i) {
+    const auto addr = contract(static_cast<uint32_t>(i % kContracts));
+    configs[{kChain, addr}].push_back({.customer_id = i,
+                                       .chain_id = kChain,
+                                       .token_address = addr,
+                                       .threshold = threshold(rng),
+                                       .enabled = true});
+  }
+  std::unordered_set<BridgeAddressKey> bridges;
+  std::unordered_map<BridgeAddressKey, std::string> names;
+  for (uint32_t b = 0; b < kBridges; ++b) {
+    const BridgeAddressKey key{kChain, contract(b, 0xbb)};
+    bridges.insert(key);
+    names[key] = "bridge-" + std::to_string(b);
+  }
+  BridgeTransferRule rule(std::move(configs), std::move(bridges), std::move(names));
+  const auto signals = make_signals([](uint32_t n) {
+    Signal s{};
+    s.type = SignalType::Transfer;
+    TransferEvent tr{};
+    tr.chain_id = kChain;
+    tr.token_address = contract(n);
+    tr.from = contract(n, 0x11);
+    tr.to = contract(n % kBridges, 0xbb);
+    tr.amount = be256(kMaxThreshold / 100);
+    s.payload = tr;
+    return s;
+  });
+  run(state, rule, signals);
+}
+
+// Each feed's answer alternates between two prices 50 bps apart, so every
+// update after a feed's first is compared against thresholds of 1..5000 bps.
+void BM_Rule_Oracle(benchmark::State &state) {
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<uint32_t> threshold(1, kMaxSpikeBps);
+  OracleUpdateRule::ConfigMap configs;
+  for (std::size_t i = 0; i < config_count(state); ++i) {
+    const auto addr = contract(static_cast<uint32_t>(i % kContracts), 0xcc);
+    configs[{kChain, addr}].push_back({.customer_id = i,
+                                       .chain_id = kChain,
+                                       .aggregator_address = addr,
+                                       .feed_label = "ETH / USD",
+                                       .spike_threshold_bps = threshold(rng),
+                                       .decimals = 8,
+                                       .enabled = true});
+  }
+  OracleUpdateRule rule(std::move(configs));
+  std::vector<Signal> signals;
+  for (uint64_t price : {200'000'000'000ULL, 201'000'000'000ULL}) {
+    for (uint32_t n = 0; n < 64; ++n) {
+      Signal s{};
+      s.type = SignalType::OracleUpdate;
+      OracleUpdateEvent oracle{};
+      oracle.chain_id = kChain;
+      oracle.aggregator_address = contract(n % kContracts, 0xcc);
+      oracle.current_answer = be256(price);
+      oracle.round_id = be256(n);
+      oracle.updated_at = 1'716'580'000;
+      s.payload = oracle;
+      signals.push_back(s);
+    }
+  }
+  run(state, rule, signals);
+}
+
+} // namespace
+
+BENCHMARK(BM_Rule_Governance)->Arg(10'000)->Arg(100'000);
+BENCHMARK(BM_Rule_MintBurn)->Arg(10'000)->Arg(100'000);
+BENCHMARK(BM_Rule_Approval)->Arg(10'000)->Arg(100'000);
+BENCHMARK(BM_Rule_Bridge)->Arg(10'000)->Arg(100'000);
+BENCHMARK(BM_Rule_Oracle)->Arg(10'000)->Arg(100'000);
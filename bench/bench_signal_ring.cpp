@@ -0,0 +1,147 @@
+// Throughput of the SPSC ring between EventSource and RiskEngine for the
+// current Signal layout and for the one it replaced, a 528-byte variant that
+// carried every log's topics and data inline. One producer thread pushes
+// (as EventSource does), the benchmark thread pops (as RiskEngine does).
+
+#include "sentinel/risk/signal.hpp"
+
+#include <benchmark/benchmark.h>
+#include <rigtorp/SPSCQueue.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <variant>
+
+namespace {
+
+// Same capacity as App::init_modules_.
+constexpr std::size_t kRingSize = 65536;
+
+namespace legacy {
+
+struct SignalMeta {
+  uint64_t timestamp_ms;
+  uint64_t internal_ingress_time_ms = 0;
+  std::optional<uint64_t> block_number;
+  std::optional<std::array<uint8_t, 32>> tx_hash;
+  bool is_final;
+  uint32_t source_id;
+};
+
+struct EvmLogEvent {
+  uint64_t chain_id;
+  uint32_t tx_index;
+  uint32_t log_index;
+  bool removed;
+  std::array<uint8_t, 20> address;
+  uint8_t topic_count;
+  std::array<std::array<uint8_t, 32>, 4> topics;
+  uint32_t data_size;
+  std::array<uint8_t, 256> data;
+  bool truncated;
+};
+
+struct Signal {
+  sentinel::risk::SignalType type;
+  SignalMeta meta;
+  std::variant<std::monostate, EvmLogEvent, sentinel::risk::PriceTick,
+               sentinel::risk::PoolSnapshot, sentinel::risk::GovernanceEvent,
+               sentinel::risk::ControlSignal, sentinel::risk::MintBurnEvent,
+               sentinel::risk::OracleUpdateEvent>
+      payload;
+};
+
+Signal transfer() {
+  Signal s{};
+  s.type = sentinel::risk::SignalType::Transfer;
+  s.meta.block_number = 250'000'000;
+  s.meta.tx_hash = std::array<uint8_t, 32>{0xab};
+  EvmLogEvent evm{};
+  evm.chain_id = 42161;
+  evm.topic_count = 3;
+  evm.data_size = 32;
+  evm.data[31] = 0x10;
+  s.payload = evm;
+  return s;
+}
+
+} // namespace legacy
+
+sentinel::risk::Signal transfer() {
+  sentinel::risk::Signal s{};
+  s.type = sentinel::risk::SignalType::Transfer;
+  s.meta.block_number = 250'000'000;
+  s.meta.tx_hash[0] = 0xab;
+  sentinel::risk::TransferEvent tr{};
+  tr.chain_id = 42161;
+  tr.amount[31] = 0x10;
+  s.payload = tr;
+  return s;
+}
+
+// A log with no typed payload: its topics and data sit in a shared body.
+sentinel::risk::Signal generic_log() {
+  sentinel::risk::Signal s{};
+  s.type = sentinel::risk::SignalType::Swap;
+  s.meta.block_number = 250'000'000;
+  sentinel::risk::EvmLogEvent evm{};
+  evm.chain_id = 42161;
+  evm.topic_count = 3;
+  evm.data_size = 160;
+  evm.body = std::make_shared<sentinel::risk::EvmLogBody>();
+  s.payload = std::move(evm);
+  return s;
+}
+
+template <typename S>
+void ring_throughput(benchmark::State &state, const S &proto) {
+  rigtorp::SPSCQueue<S> ring(kRingSize);
+  const int64_t total = static_cast<int64_t>(state.max_iterations);
+
+  std::thread producer([&] {
+    for (int64_t i = 0; i < total; ++i) {
+      S s = proto;
+      s.meta.timestamp_ms = static_cast<uint64_t>(i);
+      while (!ring.try_push(std::move(s))) {
+      }
+    }
+  });
+
+  for (auto _ : state) {
+    S *slot = nullptr;
+    while ((slot = ring.front()) == nullptr) {
+    }
+    S s = std::move(*slot);
+    ring.pop();
+    benchmark::DoNotOptimize(s);
+  }
+
+  producer.join();
+
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(
+      static_cast<int64_t>(state.iterations() * sizeof(S)));
+  state.counters["slot_bytes"] = static_cast<double>(sizeof(S));
+}
+
+void BM_Ring_LegacySignal_Transfer(benchmark::State &state) {
+  ring_throughput(state, legacy::transfer());
+}
+
+void BM_Ring_Signal_Transfer(benchmark::State &state) {
+  ring_throughput(state, transfer());
+}
+
+void BM_Ring_Signal_GenericLog(benchmark::State &state) {
+  ring_throughput(state, generic_log());
+}
+
+} // namespace
+
+BENCHMARK(BM_Ring_LegacySignal_Transfer)->UseRealTime();
+BENCHMARK(BM_Ring_Signal_Transfer)->UseRealTime();
+BENCHMARK(BM_Ring_Signal_GenericLog)->UseRealTime();
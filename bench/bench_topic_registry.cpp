@@ -0,0 +1,65 @@
+// topic0 classification over a mix of logs: every registered event plus as
+// many unregistered topics, since a node without a topic filter returns
+// plenty of those. IfChain is the comparison chain find_topic() replaced.
+
+#include "sentinel/events/topic_registry.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+using namespace sentinel::events;
+using sentinel::risk::SignalType;
+
+std::vector<std::array<uint8_t, 32>> make_topics() {
+  std::vector<std::array<uint8_t, 32>> topics;
+  std::mt19937_64 rng(5);
+  for (const auto &entry : kTopicRegistry) {
+    topics.push_back(entry.topic0);
+    std::array<uint8_t, 32> other{};
+    for (auto &b : other) b = static_cast<uint8_t>(rng());
+    topics.push_back(other);
+  }
+  std::shuffle(topics.begin(), topics.end(), rng);
+  return topics;
+}
+
+SignalType classify_if_chain(const std::array<uint8_t, 32> &topic0) {
+  for (const auto &entry : kTopicRegistry) {
+    if (topic0 == entry.topic0) {
+      return entry.type;
+    }
+  }
+  return SignalType::Unknown;
+}
+
+void BM_ClassifyTopic0_IfChain(benchmark::State &state) {
+  const auto topics = make_topics();
+  for (auto _ : state) {
+    for (const auto &t : topics) {
+      benchmark::DoNotOptimize(classify_if_chain(t));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(topics.size()));
+}
+BENCHMARK(BM_ClassifyTopic0_IfChain);
+
+void BM_ClassifyTopic0_Registry(benchmark::State &state) {
+  const auto topics = make_topics();
+  for (auto _ : state) {
+    for (const auto &t : topics) {
+      const TopicEntry *e = find_topic(t);
+      benchmark::DoNotOptimize(e ? e->type : SignalType::Unknown);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(topics.size()));
+}
+BENCHMARK(BM_ClassifyTopic0_Registry);
+
+} // namespace
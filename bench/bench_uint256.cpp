@@ -0,0 +1,131 @@
+// uint256 <-> decimal for the values alerts carry: a 6-decimal stablecoin
+// amount that fits in 64 bits, an 18-decimal token amount around 10^24, and
+// an infinite approval (2^256 - 1). Legacy is the byte-at-a-time long
+// division uint256_be_to_decimal and decimal_to_be_256 used to do.
+
+#include "sentinel/events/utils/uint256.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+using sentinel::events::utils::uint256;
+
+uint256 sample(int64_t which) {
+  switch (which) {
+  case 0:
+    return uint256(25'000'000'000ULL); // 25k USDC
+  case 1:
+    return uint256::from_decimal("1234567890123456789012345"); // ~1.2M tokens
+  default:
+    return uint256::max();
+  }
+}
+
+// ---------------------------------------------------------------------------
+// The replaced implementations
+
+std::string legacy_to_decimal(const uint8_t *data) {
+  std::array<uint8_t, 32> buffer;
+  std::memcpy(buffer.data(), data, 32);
+
+  bool is_zero = true;
+  for (int i = 0; i < 32; ++i) {
+    if (buffer[i] != 0) {
+      is_zero = false;
+      break;
+    }
+  }
+  if (is_zero) {
+    return "0";
+  }
+
+  std::string result;
+  is_zero = false;
+  while (!is_zero) {
+    uint32_t remainder = 0;
+    is_zero = true;
+    for (int i = 0; i < 32; ++i) {
+      uint32_t num = (remainder << 8) | buffer[i];
+      buffer[i] = static_cast<uint8_t>(num / 10);
+      remainder = num % 10;
+      if (buffer[i] != 0) {
+        is_zero = false;
+      }
+    }
+    result.push_back(static_cast<char>('0' + remainder));
+  }
+  std::reverse(result.begin(), result.end());
+  return result;
+}
+
+std::array<uint8_t, 32> legacy_from_decimal(std::string_view decimal) {
+  std::array<uint8_t, 32> result{};
+  for (char c : decimal) {
+    if (c < '0' || c > '9') {
+      throw std::runtime_error("invalid decimal digit");
+    }
+    uint32_t carry = static_cast<uint32_t>(c - '0');
+    for (int i = 31; i >= 0; --i) {
+      uint32_t val = (static_cast<uint32_t>(result[i]) * 10) + carry;
+      result[i] = static_cast<uint8_t>(val & 0xFF);
+      carry = val >> 8;
+    }
+    if (carry > 0) {
+      throw std::runtime_error("decimal string too large for 256-bit int");
+    }
+  }
+  return result;
+}
+
+// ---------------------------------------------------------------------------
+
+void BM_U256ToDecimal_Legacy(benchmark::State &state) {
+  const auto be = sample(state.range(0)).to_be_bytes();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(legacy_to_decimal(be.data()));
+  }
+}
+BENCHMARK(BM_U256ToDecimal_Legacy)->DenseRange(0, 2);
+
+void BM_U256ToDecimal(benchmark::State &state) {
+  const auto be = sample(state.range(0)).to_be_bytes();
+  for (auto _ : state) {
+    // From bytes, as the rules do it
+    benchmark::DoNotOptimize(uint256::from_be_bytes(be).to_decimal());
+  }
+}
+BENCHMARK(BM_U256ToDecimal)->DenseRange(0, 2);
+
+void BM_U256ToDecimalScaled(benchmark::State &state) {
+  const uint256 v = sample(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(v.to_decimal(18));
+  }
+}
+BENCHMARK(BM_U256ToDecimalScaled)->DenseRange(0, 2);
+
+void BM_U256FromDecimal_Legacy(benchmark::State &state) {
+  const std::string dec = sample(state.range(0)).to_decimal();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(legacy_from_decimal(dec));
+  }
+}
+BENCHMARK(BM_U256FromDecimal_Legacy)->DenseRange(0, 2);
+
+void BM_U256FromDecimal(benchmark::State &state) {
+  const std::string dec = sample(state.range(0)).to_decimal();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(uint256::from_decimal(dec));
+  }
+}
+BENCHMARK(BM_U256FromDecimal)->DenseRange(0, 2);
+
+} // namespace
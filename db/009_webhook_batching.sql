@@ -0,0 +1,20 @@
+-- Opt-in batching for customer webhooks.
+--
+-- With batch_max_items > 1, alerts for an endpoint are held until that many
+-- have accumulated or batch_max_delay_ms has passed since the first one,
+-- then POSTed as a single JSON array signed once. The defaults keep the
+-- existing one-request-per-alert behaviour.
+
+ALTER TABLE customer_webhook_channels
+    ADD COLUMN IF NOT EXISTS batch_max_items INT NOT NULL DEFAULT 1,
+    ADD COLUMN IF NOT EXISTS batch_max_delay_ms INT NOT NULL DEFAULT 0;
+
+ALTER TABLE customer_webhook_channels
+    DROP CONSTRAINT IF EXISTS customer_webhook_channels_batching_check;
+
+ALTER TABLE customer_webhook_channels
+    ADD CONSTRAINT customer_webhook_channels_batching_check CHECK (
+        batch_max_items BETWEEN 1 AND 1000 AND
+        batch_max_delay_ms BETWEEN 0 AND 60000 AND
+        (batch_max_items = 1 OR batch_max_delay_ms > 0)
+    );
@@ -0,0 +1,29 @@
+-- Durable record of every alert the dispatcher hands to its channels.
+--
+-- Rows are written in batches by the alert outbox writer and completed once
+-- every channel has finished with the alert; delivered is false when at
+-- least one channel failed after its retries. On startup the rows of the
+-- chain that were never completed (queued or mid-retry when the process
+-- died) are delivered again.
+--
+-- id is assigned by the process: (start time in ms << 20) + sequence.
+
+CREATE TABLE IF NOT EXISTS alert_outbox (
+    chain TEXT NOT NULL,
+    id BIGINT NOT NULL,
+    customer_id BIGINT NOT NULL,
+    rule_type TEXT NOT NULL,
+    message TEXT NOT NULL,
+    alert_timestamp_ms BIGINT NOT NULL,
+    chain_id BIGINT,
+    token_address TEXT,
+    amount_decimal TEXT,
+    created_at TIMESTAMPTZ NOT NULL DEFAULT NOW(),
+    completed_at TIMESTAMPTZ,
+    delivered BOOLEAN,                       -- NULL until completed
+    PRIMARY KEY (chain, id),
+    CHECK ((completed_at IS NULL) = (delivered IS NULL))
+);
+
+CREATE INDEX IF NOT EXISTS idx_alert_outbox_open
+    ON alert_outbox(chain, id) WHERE completed_at IS NULL;
@@ -0,0 +1,36 @@
+-- Live rule configuration changes.
+--
+-- Every statement that changes one of the tables below raises
+-- NOTIFY sentinel_config with the table name as payload. A running sentinel
+-- listens on that channel and reloads the rules built from the table, so
+-- adding a customer rule or changing a threshold needs no restart.
+-- Postgres folds identical notifications from one transaction into one.
+
+CREATE OR REPLACE FUNCTION sentinel_notify_config_change() RETURNS trigger AS $$
+BEGIN
+    PERFORM pg_notify('sentinel_config', TG_TABLE_NAME);
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+DO $$
+DECLARE
+    t TEXT;
+BEGIN
+    FOREACH t IN ARRAY ARRAY[
+        'customer_risk_rules',
+        'customer_governance_rules',
+        'customer_mint_burn_rules',
+        'customer_approval_rules',
+        'customer_bridge_rules',
+        'bridge_contracts',
+        'customer_oracle_rules'
+    ] LOOP
+        EXECUTE format('DROP TRIGGER IF EXISTS sentinel_config_notify ON %I', t);
+        EXECUTE format(
+            'CREATE TRIGGER sentinel_config_notify '
+            'AFTER INSERT OR UPDATE OR DELETE OR TRUNCATE ON %I '
+            'FOR EACH STATEMENT EXECUTE FUNCTION sentinel_notify_config_change()', t);
+    END LOOP;
+END;
+$$;
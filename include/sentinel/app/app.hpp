@@ -1,28 +1,36 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
 #include <unordered_map>
-#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "sentinel/chains/arbitrum/ArbitrumAdapter.hpp"
+#include "sentinel/db_config_listener.hpp"
 #include "sentinel/events/EventSource.hpp"
 #include "sentinel/health/heartbeat.hpp"
 #include "sentinel/health/health_server.hpp"
 #include "sentinel/metrics/metrics.hpp"
 #include "sentinel/risk/alert_dispatcher.hpp"
-#include "sentinel/risk/approval_config.hpp"
-#include "sentinel/risk/bridge_config.hpp"
-#include "sentinel/risk/governance_config.hpp"
-#include "sentinel/risk/mint_burn_config.hpp"
-#include "sentinel/risk/oracle_config.hpp"
+#include "sentinel/risk/alert_outbox.hpp"
+#include "sentinel/risk/checkpoint_writer.hpp"
+#include "sentinel/risk/http_delivery.hpp"
+#include "sentinel/risk/rcu.hpp"
 #include "sentinel/risk/risk_engine.hpp"
+#include "sentinel/risk/rules/approval_rule.hpp"
+#include "sentinel/risk/rules/bridge_transfer_rule.hpp"
+#include "sentinel/risk/rules/governance_rule.hpp"
 #include "sentinel/risk/rules/large_transfer_rule.hpp"
+#include "sentinel/risk/rules/mint_burn_rule.hpp"
+#include "sentinel/risk/rules/oracle_update_rule.hpp"
 #include "sentinel/risk/signal.hpp"
 #include "sentinel/risk/webhook_alert_channel.hpp"
 #include "sentinel/rpc/JsonRpcClient.hpp"
@@ -43,6 +51,36 @@ struct AppConfig {
   std::chrono::milliseconds shutdown_drain_timeout{5000};
   std::string metrics_listen_address = "0.0.0.0:8080";
   std::string health_listen_address  = "0.0.0.0:8081";
+
+  // Server-side eth_getLogs filter: topic0s the registered rules can use
+  // and, optionally, only the contracts named in the rule configs.
+  bool log_filter_topics = true;
+  bool log_filter_addresses = false;
+  std::size_t log_filter_max_addresses = 500;
+
+  // Rule evaluation threads; see RiskEngineConfig.
+  unsigned risk_engine_workers = 1;
+
+  sentinel::risk::AlertQueueConfig alert_queue_cfg;
+  // Shared by the Telegram and webhook channels
+  sentinel::risk::HttpDeliveryConfig alert_http_cfg;
+
+  // Durable alert log in Postgres; undelivered alerts are replayed on start
+  bool alert_outbox = true;
+  sentinel::risk::OutboxConfig alert_outbox_cfg;
+
+  // How often the processed-block checkpoint may be written
+  sentinel::risk::CheckpointWriterConfig checkpoint_cfg;
+
+  // Reload rule configs when their tables change (LISTEN sentinel_config)
+  bool rule_reload = true;
+
+  // Connections the startup config load runs its queries over in parallel
+  std::size_t startup_db_connections = 4;
+
+  // When set, the node's responses are also captured here for
+  // `sentinel replay`
+  std::string rpc_capture_path;
 };
 
 class App {
@@ -63,47 +101,75 @@ public:
 private:
   bool init_logging_();
   bool init_db_();
+  // Reads the customers, webhook channels and rule configs from the DB,
+  // over cfg_.startup_db_connections connections at once.
+  void load_configs_();
   void init_modules_();
-  std::vector<sentinel::risk::LargeTransferRuleConfig>
-  load_large_transfer_configs_();
-  void load_governance_configs_();
-  void load_mint_burn_configs_();
-  void load_approval_configs_();
-  void load_bridge_configs_();
-  void load_oracle_configs_();
-  void load_webhook_channels_();
-  void load_customer_map_();
+  // Rule config loaders; they throw if the query fails, and skip malformed
+  // rows with a warning.
+  static std::vector<sentinel::risk::LargeTransferRuleConfig>
+  load_large_transfer_configs_(pqxx::connection &conn);
+  static sentinel::risk::GovernanceRule::ConfigMap
+  load_governance_configs_(pqxx::connection &conn);
+  static sentinel::risk::MintBurnRule::ConfigMap
+  load_mint_burn_configs_(pqxx::connection &conn);
+  static sentinel::risk::ApprovalRule::ConfigMap
+  load_approval_configs_(pqxx::connection &conn);
+  static sentinel::risk::BridgeTransferRule::Config
+  load_bridge_configs_(pqxx::connection &conn);
+  static sentinel::risk::OracleUpdateRule::ConfigMap
+  load_oracle_configs_(pqxx::connection &conn);
+  // Throw if the query fails; run on the startup loader threads.
+  void load_webhook_channels_(pqxx::connection &conn);
+  void load_customer_map_(pqxx::connection &conn);
   void load_token_map_();
   void register_rules_();
+  // `watched` holds the contracts named by the configs the rule starts with
+  template <typename Rule, typename Load>
+  void add_rule_reloader_(Rule &rule, std::vector<std::string> tables, Load load,
+                          std::vector<std::array<uint8_t, 20>> watched);
+  // Contracts on this chain named in `configs`; empty unless
+  // LOG_FILTER_ADDRESSES is set.
+  template <typename Configs>
+  std::vector<std::array<uint8_t, 20>> watched_addresses_(const Configs &configs) const;
+  // Runs on the config listener thread. An empty `tables` reloads every rule.
+  void reload_rule_configs_(pqxx::connection &conn, const std::vector<std::string> &tables,
+                            std::chrono::steady_clock::time_point notified_at);
+  // Sends the node the topic0 whitelist and, with LOG_FILTER_ADDRESSES, the
+  // contracts every rule's current configs name. Called again after reloads.
+  void apply_log_filter_();
   void start_threads_();
   void stop_orderly_();
   void join_threads_();
   void write_readiness_file_();
   void remove_readiness_file_();
+  // Logs how long a startup phase took and exports it as
+  // startup_phase_duration_seconds; callable from any thread.
+  void record_startup_phase_(const std::string &phase, std::chrono::duration<double> elapsed);
 
   AppConfig cfg_;
 
+  const std::chrono::steady_clock::time_point started_at_ = std::chrono::steady_clock::now();
+  std::mutex startup_phases_mutex_;
+  // Phases finished before metrics_ existed, exported once it does
+  std::vector<std::pair<std::string, double>> startup_phases_;
+
+  // Rule configs read by load_configs_, moved into the rules by
+  // register_rules_
+  struct StartupConfigs {
+    std::vector<sentinel::risk::LargeTransferRuleConfig> large_transfer;
+    sentinel::risk::GovernanceRule::ConfigMap governance;
+    sentinel::risk::MintBurnRule::ConfigMap mint_burn;
+    sentinel::risk::ApprovalRule::ConfigMap approval;
+    sentinel::risk::BridgeTransferRule::Config bridge;
+    sentinel::risk::OracleUpdateRule::ConfigMap oracle;
+  };
+  StartupConfigs startup_configs_;
+
   std::unordered_map<sentinel::risk::CustomerId, std::string>
       customer_id_to_key_;
   std::unordered_map<sentinel::risk::TokenKey, std::string>
       token_addresses_to_symbols_;
-  std::unordered_map<sentinel::risk::GovernanceContractKey,
-                     std::vector<sentinel::risk::GovernanceRuleConfig>>
-      governance_rules_by_contract_;
-  std::unordered_map<sentinel::risk::MintBurnContractKey,
-                     std::vector<sentinel::risk::MintBurnRuleConfig>>
-      mint_burn_rules_by_contract_;
-  std::unordered_map<sentinel::risk::ApprovalContractKey,
-                     std::vector<sentinel::risk::ApprovalRuleConfig>>
-      approval_rules_by_contract_;
-  std::unordered_map<sentinel::risk::BridgeRuleKey,
-                     std::vector<sentinel::risk::BridgeRuleConfig>>
-      bridge_configs_by_key_;
-  std::unordered_set<sentinel::risk::BridgeAddressKey> bridge_addresses_;
-  std::unordered_map<sentinel::risk::BridgeAddressKey, std::string> bridge_names_;
-  std::unordered_map<sentinel::risk::OracleFeedKey,
-                     std::vector<sentinel::risk::OracleRuleConfig>>
-      oracle_configs_by_feed_;
   std::unordered_map<std::uint64_t,
                      std::vector<sentinel::risk::WebhookEndpoint>>
       customer_webhooks_;
@@ -120,17 +186,27 @@ private:
 
   // Database
   std::shared_ptr<pqxx::connection> conn_;
+  std::uint64_t checkpoint_block_ = 0; // as loaded at startup
 
   // Health server (separate from metrics, default port 8081)
   std::unique_ptr<sentinel::health::HealthServer> health_server_;
 
+  // Retired rule config snapshots; outlives the rules and the engine
+  sentinel::risk::RcuDomain rcu_;
+
   // Modules
   std::unique_ptr<sentinel::metrics::Metrics> metrics_;
   std::unique_ptr<sentinel::risk::RingBuffer<sentinel::risk::Signal>>
       ring_buffer_;
   std::unique_ptr<JsonRpcClient> rpc_;
+  std::unique_ptr<sentinel::replay::CorpusWriter> rpc_capture_; // outlives the adapter
   std::unique_ptr<ArbitrumAdapter> arbitrum_adapter_;
   std::unique_ptr<sentinel::events::EventSource> event_source_;
+  // Declared before dispatcher_ so they outlive the channels and the
+  // delivery callbacks using them
+  std::unique_ptr<sentinel::risk::CheckpointWriter> checkpoint_writer_;
+  std::unique_ptr<sentinel::risk::AlertOutbox> alert_outbox_;
+  std::unique_ptr<sentinel::risk::HttpDeliveryLoop> alert_http_;
   std::unique_ptr<sentinel::risk::AlertDispatcher> dispatcher_;
   std::unique_ptr<sentinel::risk::RiskEngine> risk_engine_;
 
@@ -141,6 +217,24 @@ private:
 
   // Rules ownership
   std::vector<std::unique_ptr<sentinel::risk::IRiskRule>> rules_;
+
+  // How one rule's configs are reloaded after a change to its tables
+  struct RuleReloader {
+    std::string rule_type;
+    std::vector<std::string> tables;
+    // Publishes the new configs, updates `watched` and returns the rule's
+    // config generation
+    std::function<uint64_t(pqxx::connection &, RuleReloader &)> reload;
+    // Contracts named by the configs the rule currently runs with, for the
+    // LOG_FILTER_ADDRESSES address list
+    std::vector<std::array<uint8_t, 20>> watched;
+    prometheus::Histogram *duration_hist = nullptr;
+    prometheus::Gauge *generation_gauge = nullptr;
+    prometheus::Counter *failures_counter = nullptr;
+  };
+  std::vector<RuleReloader> rule_reloaders_;
+  // Declared last: its thread reloads the rules above until it is destroyed
+  std::unique_ptr<sentinel::DbConfigListener> config_listener_;
 };
 
 } // namespace sentinel::app
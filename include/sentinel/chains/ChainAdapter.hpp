@@ -1,8 +1,15 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
+#include <exception>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "sentinel/events/RawLog.hpp"
+#include "sentinel/events/log_filter.hpp"
+#include "sentinel/events/normalize.hpp"
+#include "sentinel/risk/signal.hpp"
 
 class ChainAdapter {
 public:
@@ -13,6 +20,57 @@ public:
   virtual uint64_t latestBlock() = 0;
   virtual uint64_t blockTimestamp(uint64_t block_number) = 0;
 
+  // Narrows what getLogs(), getSignals() and fetchRange() return from now
+  // on. Adapters that cannot filter on the node ignore it; the rules only
+  // act on the logs they are interested in anyway.
+  virtual void setLogFilter(const sentinel::events::LogFilter &filter) {
+    (void)filter;
+  }
+
   virtual std::vector<sentinel::events::RawLog> getLogs(uint64_t from_block,
                                                         uint64_t to_block) = 0;
+
+  // Fetches logs for [from_block, to_block] and appends them to `out` as
+  // normalized Signals with meta.timestamp_ms left at 0. The default goes
+  // through getLogs() + normalize(); adapters that can decode the response
+  // body directly override it to skip the RawLog/JSON DOM round trip.
+  virtual void getSignals(uint64_t from_block, uint64_t to_block,
+                          uint64_t chain_id,
+                          std::vector<sentinel::risk::Signal> &out) {
+    for (const auto &raw : getLogs(from_block, to_block)) {
+      sentinel::events::normalize(raw, out.emplace_back(), chain_id, 0);
+    }
+  }
+
+  struct RangeFetch {
+    // Chain head observed in the same round trip; 0 if not fetched.
+    uint64_t chain_head = 0;
+    // Timestamp (seconds) of to_block; empty if it could not be fetched,
+    // with the reason in timestamp_error.
+    std::optional<uint64_t> to_block_timestamp;
+    std::string timestamp_error;
+    // Size of the HTTP response body(ies) carrying the logs; 0 if unknown.
+    std::size_t response_bytes = 0;
+  };
+
+  // Everything one poll cycle needs for [from_block, to_block]: the logs
+  // (appended to `out` as by getSignals()), the to_block timestamp and, where
+  // it comes for free, the current chain head. Log failures throw; timestamp
+  // and head failures only leave their fields empty. The default issues the
+  // calls one after another; adapters whose endpoint accepts JSON-RPC
+  // batches override it to use a single round trip. May be called from
+  // several threads at once (parallel backfill).
+  virtual RangeFetch fetchRange(uint64_t from_block, uint64_t to_block,
+                                uint64_t chain_id,
+                                std::vector<sentinel::risk::Signal> &out) {
+    getSignals(from_block, to_block, chain_id, out);
+
+    RangeFetch res;
+    try {
+      res.to_block_timestamp = blockTimestamp(to_block);
+    } catch (const std::exception &e) {
+      res.timestamp_error = e.what();
+    }
+    return res;
+  }
 };
@@ -1,22 +1,73 @@
 #pragma once
 #include "sentinel/chains/ChainAdapter.hpp"
 #include "sentinel/log.hpp"
+#include "sentinel/replay/corpus.hpp"
 #include "sentinel/rpc/JsonRpcClient.hpp"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+
 class ArbitrumAdapter : public ChainAdapter {
 public:
   explicit ArbitrumAdapter(JsonRpcClient &rpc);
 
+  // Capture mode: every chain id, head, block timestamp and eth_getLogs
+  // response received from now on is also written to `recorder`, which
+  // must outlive the adapter's use. Call before the adapter is shared.
+  void setRecorder(sentinel::replay::CorpusWriter *recorder);
+
   std::string name() const override;
 
   uint64_t chainId() override;
   uint64_t latestBlock() override;
   uint64_t blockTimestamp(uint64_t block_number) override;
 
+  // Address lists longer than filter.max_addresses_per_request become several
+  // eth_getLogs calls whose results are merged back into chain order.
+  void setLogFilter(const sentinel::events::LogFilter &filter) override;
+
   std::vector<sentinel::events::RawLog> getLogs(uint64_t from_block,
                                                 uint64_t to_block) override;
 
+  void getSignals(uint64_t from_block, uint64_t to_block, uint64_t chain_id,
+                  std::vector<sentinel::risk::Signal> &out) override;
+
+  // eth_getLogs + eth_getBlockByNumber(to_block) + eth_blockNumber as one
+  // JSON-RPC batch. Falls back to the serial default for good if the
+  // endpoint rejects batches: a non-array answer, an HTTP status from
+  // refusesBatch(), or an error element without an id. Other HTTP errors
+  // are thrown and leave batching on.
+  RangeFetch fetchRange(uint64_t from_block, uint64_t to_block,
+                        uint64_t chain_id,
+                        std::vector<sentinel::risk::Signal> &out) override;
+
 private:
+  // LogFilter rendered once into eth_getLogs filter fragments.
+  struct PreparedFilter {
+    nlohmann::json topics;                      // null = any topic
+    std::vector<nlohmann::json> address_chunks; // empty = any address
+  };
+
+  // One eth_getLogs filter object per address chunk (at least one).
+  std::vector<nlohmann::json> logsFilters(uint64_t from_block,
+                                          uint64_t to_block) const;
+  uint64_t headFromResponse(const nlohmann::json &res);
+  uint64_t timestampFromResponse(const nlohmann::json &res,
+                                 uint64_t block_number);
+  // HTTP statuses with which a server refuses a JSON-RPC batch as such
+  static bool refusesBatch(long http_status);
+  // Turns batching off and serves the range with one request per method.
+  RangeFetch fetchUnbatched(uint64_t from_block, uint64_t to_block,
+                            uint64_t chain_id,
+                            std::vector<sentinel::risk::Signal> &out,
+                            const std::string &reason);
+
   JsonRpcClient &rpc_;
   spdlog::logger &log_;
+  sentinel::replay::CorpusWriter *recorder_ = nullptr;
+  std::atomic<bool> batch_supported_{true};
+
+  mutable std::mutex filter_mutex_;
+  std::shared_ptr<const PreparedFilter> filter_;
 };
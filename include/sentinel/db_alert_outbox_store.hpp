@@ -0,0 +1,33 @@
+#pragma once
+#include <memory>
+#include <string>
+
+#include "sentinel/risk/alert_outbox.hpp"
+
+namespace pqxx {
+class connection;
+}
+
+namespace sentinel {
+
+// alert_outbox rows for one chain (db/010_alert_outbox.sql). Owns its
+// connection, since the outbox writes from its own thread, and reconnects
+// on the next call after the connection breaks.
+class DbAlertOutboxStore : public risk::IAlertOutboxStore {
+public:
+  DbAlertOutboxStore(std::string database_url, std::string chain);
+  ~DbAlertOutboxStore() override;
+
+  void write(const std::vector<risk::OutboxRecord>& records,
+             const std::vector<risk::OutboxCompletion>& completions) override;
+  std::vector<risk::Alert> load_pending(std::chrono::hours max_age) override;
+
+private:
+  pqxx::connection& conn_();
+
+  std::string database_url_;
+  std::string chain_;
+  std::unique_ptr<pqxx::connection> conn_ptr_;
+};
+
+} // namespace sentinel
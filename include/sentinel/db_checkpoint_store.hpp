@@ -5,6 +5,8 @@
 
 #include <pqxx/pqxx>   // IMPORTANT: pqxx::connection is an alias in libpqxx 6.x
 
+#include "sentinel/risk/checkpoint_writer.hpp"
+
 namespace sentinel {
 
 class DbCheckpointStore {
@@ -19,4 +21,18 @@ private:
   std::shared_ptr<pqxx::connection> conn_;
 };
 
+// upsert_checkpoint() for the CheckpointWriter thread, on a connection of
+// its own that is reopened on the next save after it breaks.
+class DbCheckpointSink : public risk::ICheckpointSink {
+public:
+  DbCheckpointSink(std::string database_url, std::string chain);
+
+  void save(std::uint64_t last_block) override;
+
+private:
+  std::string database_url_;
+  std::string chain_;
+  std::shared_ptr<pqxx::connection> conn_;
+};
+
 } // namespace sentinel
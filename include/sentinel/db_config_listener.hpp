@@ -0,0 +1,70 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace pqxx {
+class connection;
+}
+
+namespace sentinel {
+
+// Listens for NOTIFY sentinel_config (db/011_rule_config_notify.sql) on a
+// connection and thread of its own, and calls on_change with the names of
+// the tables that changed. The callback runs on the listener thread and
+// may query through the connection it is given.
+//
+// LISTEN is issued by the constructor, so changes made after construction
+// are not missed even if the thread is started later. When the connection
+// has to be reopened, notifications may have been lost in between, and
+// on_change is called with an empty list, meaning every table.
+class DbConfigListener {
+public:
+  using Callback = std::function<void(pqxx::connection& conn,
+                                      const std::vector<std::string>& tables,
+                                      std::chrono::steady_clock::time_point notified_at)>;
+
+  static constexpr const char* kChannel = "sentinel_config";
+
+  DbConfigListener(std::string database_url, Callback on_change,
+                   std::chrono::milliseconds reconnect_backoff = std::chrono::seconds(5));
+  // Stops the thread; a callback in progress is finished first.
+  ~DbConfigListener();
+
+  DbConfigListener(const DbConfigListener&) = delete;
+  DbConfigListener& operator=(const DbConfigListener&) = delete;
+
+  void start();
+
+private:
+  class Receiver;
+
+  // Opens the connection and subscribes; false (logged) on failure.
+  bool connect_();
+  void run_();
+
+  std::string database_url_;
+  Callback on_change_;
+  std::chrono::milliseconds reconnect_backoff_;
+
+  std::unique_ptr<pqxx::connection> conn_;
+  std::unique_ptr<Receiver> receiver_;
+  bool reload_all_ = false; // set after a reconnect
+
+  // Filled by the receiver while the thread waits for notifications
+  std::vector<std::string> pending_;
+  std::chrono::steady_clock::time_point first_pending_at_{};
+
+  std::atomic<bool> stopping_{false};
+  std::mutex stop_mutex_; // only for the reconnect back-off
+  std::condition_variable stop_cv_;
+  std::thread thread_;
+};
+
+} // namespace sentinel
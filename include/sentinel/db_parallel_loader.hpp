@@ -0,0 +1,116 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace sentinel {
+
+// Runs independent load tasks over a few database connections at once, one
+// worker thread per connection. A task queries and parses on the worker that
+// runs it, so both the round trips and the row parsing of different tables
+// overlap. Used for the startup config load.
+//
+// Conn is pqxx::connection in the app; tests use a stand-in.
+template <typename Conn> class ParallelLoader {
+public:
+  // Opens the connection of worker `index` (0-based). A worker whose
+  // connection cannot be opened (exception or null) runs nothing and the
+  // other workers take its share.
+  using Open = std::function<std::shared_ptr<Conn>(std::size_t index)>;
+  // Throws on failure; what it loads is stored by the task itself.
+  using Task = std::function<void(Conn &)>;
+
+  struct Result {
+    std::string name;
+    std::chrono::duration<double> elapsed{}; // zero if it never ran
+    std::string error;                       // empty on success
+  };
+
+  ParallelLoader(std::size_t connections, Open open)
+    : connections_(std::max<std::size_t>(1, connections)), open_(std::move(open)) {}
+
+  void add(std::string name, Task task) {
+    tasks_.push_back({std::move(name), std::move(task)});
+  }
+
+  // Runs every task once and returns one result per task, in the order they
+  // were added. Task failures are reported in the results, not thrown.
+  std::vector<Result> run() {
+    std::vector<Result> results(tasks_.size());
+    std::vector<char> ran(tasks_.size(), 0);
+    for (std::size_t i = 0; i < tasks_.size(); ++i) {
+      results[i].name = tasks_[i].name;
+    }
+
+    const std::size_t workers = std::min(connections_, tasks_.size());
+    std::vector<std::string> open_errors(workers);
+    std::atomic<std::size_t> next{0};
+
+    auto work = [&](std::size_t index) {
+      std::shared_ptr<Conn> conn;
+      try {
+        conn = open_(index);
+      } catch (const std::exception &e) {
+        open_errors[index] = e.what();
+      }
+      if (!conn) {
+        if (open_errors[index].empty()) {
+          open_errors[index] = "connection unavailable";
+        }
+        return;
+      }
+      for (std::size_t i = next.fetch_add(1); i < tasks_.size(); i = next.fetch_add(1)) {
+        const auto start = std::chrono::steady_clock::now();
+        try {
+          tasks_[i].run(*conn);
+        } catch (const std::exception &e) {
+          results[i].error = e.what();
+          if (results[i].error.empty()) {
+            results[i].error = "unknown error";
+          }
+        }
+        results[i].elapsed = std::chrono::steady_clock::now() - start;
+        ran[i] = 1;
+      }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers > 0 ? workers - 1 : 0);
+    for (std::size_t w = 1; w < workers; ++w) {
+      threads.emplace_back(work, w);
+    }
+    if (workers > 0) {
+      work(0);
+    }
+    for (auto &t : threads) {
+      t.join();
+    }
+
+    for (std::size_t i = 0; i < tasks_.size(); ++i) {
+      if (!ran[i]) {
+        results[i].error = "no database connection: " + open_errors.front();
+      }
+    }
+    return results;
+  }
+
+private:
+  struct Named {
+    std::string name;
+    Task run;
+  };
+
+  std::size_t connections_;
+  Open open_;
+  std::vector<Named> tasks_;
+};
+
+} // namespace sentinel
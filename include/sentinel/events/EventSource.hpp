@@ -2,11 +2,15 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <stop_token>
+#include <vector>
 
 #include <rigtorp/SPSCQueue.h>
 
 #include "sentinel/events/RawLog.hpp"
+#include "sentinel/events/block_range_controller.hpp"
 #include "sentinel/events/normalize.hpp"
 #include "sentinel/health/heartbeat.hpp"
 #include "sentinel/log.hpp"
@@ -20,12 +24,27 @@ namespace sentinel::events {
 
 struct EventSourceConfig {
   uint64_t start_block = 0;
+
+  // eth_getLogs range bounds; the actual range adapts between them (see
+  // BlockRangeController) starting from initial_block_range.
   uint64_t max_block_range = 1000;
+  uint64_t initial_block_range = 1000;
+  std::size_t target_response_bytes = std::size_t{4} << 20;
+  uint64_t target_logs_per_request = 5000;
+  std::chrono::milliseconds target_rpc_latency{2000};
 
   std::chrono::milliseconds idle_sleep{200};     // live mode
   std::chrono::milliseconds error_backoff{1000}; // after an error
   std::chrono::microseconds push_backoff{10};    // queue is full
   uint64_t min_block_range = 1;                  // retry halfening
+
+  // Catch-up: when the cursor is at least backfill_parallelism ranges behind
+  // the head, fetch range-sized shards on this many threads and push them in
+  // block order. 1 disables it.
+  unsigned backfill_parallelism = 1;
+  // Cap on decoded signal bytes waiting to be pushed during a backfill;
+  // workers stop taking new shards while it is exceeded.
+  std::size_t backfill_max_inflight_bytes = std::size_t{256} << 20;
 };
 
 class EventSource {
@@ -43,9 +62,19 @@ public:
   // Clean shutdown
   void stop();
 
+  // Resolved from the adapter at construction.
+  uint64_t chain_id() const { return chain_id_; }
+
 private:
-  void push_blocking(const sentinel::risk::Signal &ev);
+  void push_blocking(sentinel::risk::Signal &&ev);
+  // Stamps ingress time on every signal of a fetched range and moves them
+  // into the ring.
+  void push_batch_(std::vector<sentinel::risk::Signal> &batch);
+  // Checkpoint barrier after the signals of every block up to `block`.
+  void push_sync_(uint64_t block);
   bool poll_once();
+  // Parallel catch-up from next_block_ to `to_block` (see RangeBackfiller).
+  void backfill_(uint64_t to_block);
 
 private:
   ChainAdapter &adapter_;
@@ -56,9 +85,15 @@ private:
   EventSourceConfig cfg_;
 
   std::atomic<bool> running_{true};
+  std::stop_token stop_token_;
   uint64_t next_block_;
   bool cold_start_;
   uint64_t cached_chain_head_ = 0;
+  BlockRangeController range_ctl_;
+
+  // Decoded signals for the current range; reused across polls so the
+  // steady state does not allocate.
+  std::vector<sentinel::risk::Signal> batch_;
 
   spdlog::logger &log_;
   sentinel::metrics::Metrics *metrics_;
@@ -70,6 +105,8 @@ private:
   prometheus::Gauge* metrics_ring_buffer_depth_{nullptr};
   prometheus::Gauge* metrics_last_seen_block_{nullptr};
   prometheus::Gauge* metrics_last_processed_block_{nullptr};
+  prometheus::Gauge* metrics_backfill_blocks_per_second_{nullptr};
+  prometheus::Gauge* metrics_getlogs_block_range_{nullptr};
 };
 
 } // namespace sentinel::events
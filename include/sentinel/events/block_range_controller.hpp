@@ -0,0 +1,59 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace sentinel::events {
+
+struct BlockRangeControllerConfig {
+  uint64_t min_range = 1;
+  uint64_t max_range = 10000;
+  uint64_t initial_range = 1000;
+
+  // Aim each eth_getLogs response at these; the tightest one wins.
+  std::size_t target_response_bytes = std::size_t{4} << 20;
+  uint64_t target_logs = 5000;
+  std::chrono::milliseconds target_latency{2000};
+
+  // Largest multiplicative step up per successful request.
+  double max_growth = 2.0;
+};
+
+// Picks the eth_getLogs block range for the next request from what the
+// previous ones returned. It tracks logs and bytes per block, sizes the next
+// range to land near the targets and grows at most max_growth x per step,
+// and only after a request that covered the full range.
+// Provider result-limit errors shrink it sharply; other errors halve it.
+class BlockRangeController {
+public:
+  explicit BlockRangeController(BlockRangeControllerConfig cfg);
+
+  uint64_t range() const { return range_; }
+
+  // `blocks` is the size of the range that was actually requested (it may
+  // be smaller than range() near the chain head). `response_bytes` may be 0
+  // when the adapter cannot report it.
+  void on_success(uint64_t blocks, uint64_t logs, std::size_t response_bytes,
+                  std::chrono::steady_clock::duration latency);
+  void on_error(uint64_t blocks, std::string_view error);
+
+  // "query returned more than 10000 results" and friends.
+  static bool is_result_limit_error(std::string_view error);
+  // Some providers name a range that would have worked, e.g.
+  // "... this block range should work: [0x1a2b, 0x1c3d]".
+  static std::optional<uint64_t> suggested_range(std::string_view error);
+
+private:
+  uint64_t clamp_(double range) const;
+
+  BlockRangeControllerConfig cfg_;
+  uint64_t range_;
+  // Smoothed densities; negative until the first sample.
+  double logs_per_block_ = -1.0;
+  double bytes_per_block_ = -1.0;
+};
+
+} // namespace sentinel::events
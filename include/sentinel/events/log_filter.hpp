@@ -0,0 +1,22 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sentinel::events {
+
+// Server-side eth_getLogs filter. A log is returned if its topic0 is one of
+// `topic0s` and it was emitted by one of `addresses`; an empty list leaves
+// that side unfiltered.
+struct LogFilter {
+  std::vector<std::array<uint8_t, 32>> topic0s;
+  std::vector<std::array<uint8_t, 20>> addresses;
+
+  // Providers cap the address list of a single eth_getLogs call; longer
+  // lists are spread over several calls.
+  std::size_t max_addresses_per_request = 500;
+};
+
+} // namespace sentinel::events
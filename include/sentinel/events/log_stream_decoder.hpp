@@ -0,0 +1,42 @@
+#pragma once
+
+#include "sentinel/risk/signal.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace sentinel::events {
+
+// Decodes a raw eth_getLogs JSON-RPC response body straight into Signals,
+// without building a JSON DOM or intermediate RawLog strings. Produces the
+// same Signals as RawLog + normalize() (meta.timestamp_ms is left at 0 for
+// the caller to stamp once the block timestamp is known).
+//
+// Appends to `out` and returns the number of logs decoded. Throws
+// std::runtime_error on malformed input, a missing field, or a JSON-RPC
+// "error" object; `out` is left at its original size in that case.
+std::size_t decode_get_logs_response(std::string_view body,
+                                     uint64_t chain_id,
+                                     std::vector<sentinel::risk::Signal>& out);
+
+// Thrown when a server answers a batch request with something other than a
+// batch response, i.e. it does not support JSON-RPC batching.
+struct BatchRejectedError : std::runtime_error {
+  using std::runtime_error::runtime_error;
+};
+
+// Splits a JSON-RPC batch response (an array of response objects, possibly
+// out of order) into the raw text of each element, indexed by its numeric
+// "id". `by_id` must be pre-sized to the number of requests; ids that are
+// absent from the response leave an empty view. Throws BatchRejectedError if
+// the body is not an array (e.g. a single error object rejecting the whole
+// batch) or an element has a null or missing id, and std::runtime_error on
+// malformed input or an out-of-range id.
+// The views point into `body`.
+void split_batch_response(std::string_view body,
+                          std::vector<std::string_view>& by_id);
+
+} // namespace sentinel::events
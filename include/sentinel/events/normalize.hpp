@@ -3,7 +3,9 @@
 #include "sentinel/events/RawLog.hpp"
 #include "sentinel/risk/signal.hpp"
 
+#include <array>
 #include <cstdint>
+#include <vector>
 
 namespace sentinel::events {
 
@@ -13,4 +15,32 @@ void normalize(const RawLog& raw,
                uint64_t chain_id,
                uint64_t block_timestamp /*=0*/);
 
+// One log decoded in full: scratch space for the decoders, never stored in
+// a Signal.
+struct DecodedLog {
+  uint64_t chain_id;
+  uint32_t tx_index;
+  uint32_t log_index;
+  bool removed;
+  std::array<uint8_t, 20> address;
+  uint8_t topic_count;
+  std::array<std::array<uint8_t, 32>, 4> topics;
+  uint32_t data_size;
+  std::array<uint8_t, 256> data;
+  bool truncated;
+};
+
+// Sets out.type and out.payload for a decoded log: a typed event where one
+// applies, otherwise an EvmLogEvent with the topics and data out of line.
+// Shared by normalize() and the streaming eth_getLogs decoder so both paths
+// classify identically.
+void classify_log(const DecodedLog& log, sentinel::risk::Signal& out);
+
+// topic0 values of every log that classify_log() turns into one of the
+// signal types in `interests`, for use as an eth_getLogs topic filter.
+// Empty if no server-side filter can serve `interests` (it includes Unknown,
+// or no type is asked for).
+std::vector<std::array<uint8_t, 32>>
+topic0_whitelist(sentinel::risk::SignalMask interests);
+
 } // namespace sentinel::events
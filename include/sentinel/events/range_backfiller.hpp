@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "sentinel/log.hpp"
+#include "sentinel/risk/signal.hpp"
+
+class ChainAdapter;
+
+namespace sentinel::events {
+
+// Catch-up helper for EventSource: splits a long block range into shards,
+// fetches them concurrently on worker threads and hands them back strictly in
+// block order on the calling thread. Only the caller ever touches the SPSC
+// ring, so the single-producer contract and per-block ordering still hold.
+//
+// The adapter's fetchRange() is called from several threads at once.
+class RangeBackfiller {
+public:
+  struct Shard {
+    uint64_t from_block = 0;
+    uint64_t to_block = 0;
+    // Decoded signals with meta.timestamp_ms already stamped.
+    std::vector<sentinel::risk::Signal> signals;
+  };
+
+  // Called on the run() thread for each shard, in ascending block order.
+  using EmitFn = std::function<void(Shard &)>;
+  // Polled on the run() thread while it waits; return false to abort.
+  using ContinueFn = std::function<bool()>;
+
+  RangeBackfiller(ChainAdapter &adapter, uint64_t chain_id,
+                  unsigned parallelism, std::size_t max_inflight_bytes,
+                  uint64_t shard_blocks, uint64_t min_shard_blocks);
+
+  // Backfills [from_block, to_block]. Returns the number of blocks emitted,
+  // which is less than the full range only if `should_continue` aborted the
+  // run. If a shard cannot be fetched even at min_shard_blocks, the error is
+  // rethrown once the workers are joined; shards before it have already been
+  // emitted.
+  uint64_t run(uint64_t from_block, uint64_t to_block, const EmitFn &emit,
+               const ContinueFn &should_continue);
+
+private:
+  // Fetches [from_block, to_block] into `out`, halving the range on errors
+  // down to min_shard_blocks_, and stamps each sub-range's timestamp.
+  void fetch_into_(uint64_t from_block, uint64_t to_block,
+                   std::vector<sentinel::risk::Signal> &out);
+
+  ChainAdapter &adapter_;
+  uint64_t chain_id_;
+  unsigned parallelism_;
+  std::size_t max_inflight_bytes_;
+  uint64_t shard_blocks_;
+  uint64_t min_shard_blocks_;
+  spdlog::logger &log_;
+};
+
+} // namespace sentinel::events
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "sentinel/events/utils/keccak.hpp"
+#include "sentinel/risk/signal.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace sentinel::events {
+
+// Which typed payload classify_log() builds for a log. Generic keeps the
+// whole log as an EvmLogEvent.
+enum class TopicDecoder : uint8_t {
+  Generic,
+  Transfer, // TransferEvent, or MintBurnEvent when from or to is zero
+  Approval,
+  Governance,
+  OracleAnswer,
+};
+
+struct TopicEntry {
+  std::string_view signature;
+  std::array<uint8_t, 32> topic0;
+  sentinel::risk::SignalType type;
+  TopicDecoder decoder;
+  sentinel::risk::GovernanceAction action; // Governance entries only
+  // Every signal type a log with this topic0 can become
+  sentinel::risk::SignalMask produces;
+};
+
+constexpr TopicEntry event_topic(std::string_view signature,
+                                 sentinel::risk::SignalType type,
+                                 TopicDecoder decoder = TopicDecoder::Generic) {
+  sentinel::risk::SignalMask produces = sentinel::risk::make_mask(type);
+  if (decoder == TopicDecoder::Transfer) {
+    produces |= sentinel::risk::make_mask(sentinel::risk::SignalType::MintBurn);
+  }
+  return TopicEntry{.signature = signature,
+                    .topic0 = utils::keccak256(signature),
+                    .type = type,
+                    .decoder = decoder,
+                    .action = sentinel::risk::GovernanceAction::Unknown,
+                    .produces = produces};
+}
+
+constexpr TopicEntry governance_topic(std::string_view signature,
+                                      sentinel::risk::GovernanceAction action) {
+  TopicEntry e = event_topic(signature, sentinel::risk::SignalType::Governance,
+                             TopicDecoder::Governance);
+  e.action = action;
+  return e;
+}
+
+// Every event normalize() recognises. Adding one is a line here; its topic0
+// is derived from the signature at compile time.
+inline constexpr std::array kTopicRegistry{
+    // ERC-20
+    event_topic("Transfer(address,address,uint256)", sentinel::risk::SignalType::Transfer,
+                TopicDecoder::Transfer),
+    event_topic("Approval(address,address,uint256)", sentinel::risk::SignalType::Approval,
+                TopicDecoder::Approval),
+
+    // Uniswap V2 and V3 pools
+    event_topic("Swap(address,uint256,uint256,uint256,uint256,address)",
+                sentinel::risk::SignalType::Swap),
+    event_topic("Swap(address,address,int256,int256,uint160,uint128,int24)",
+                sentinel::risk::SignalType::Swap),
+    event_topic("Mint(address,uint256,uint256)", sentinel::risk::SignalType::LiquidityChange),
+    event_topic("Burn(address,uint256,uint256,address)",
+                sentinel::risk::SignalType::LiquidityChange),
+
+    // Ownable, Pausable, AccessControl, ERC-1967 proxies
+    governance_topic("OwnershipTransferred(address,address)",
+                     sentinel::risk::GovernanceAction::OwnershipTransferred),
+    governance_topic("Paused(address)", sentinel::risk::GovernanceAction::Paused),
+    governance_topic("Unpaused(address)", sentinel::risk::GovernanceAction::Unpaused),
+    governance_topic("RoleGranted(bytes32,address,address)",
+                     sentinel::risk::GovernanceAction::RoleGranted),
+    governance_topic("RoleRevoked(bytes32,address,address)",
+                     sentinel::risk::GovernanceAction::RoleRevoked),
+    governance_topic("Upgraded(address)", sentinel::risk::GovernanceAction::Upgraded),
+
+    // Chainlink AggregatorV3Interface
+    event_topic("AnswerUpdated(int256,uint256,uint256)", sentinel::risk::SignalType::OracleUpdate,
+                TopicDecoder::OracleAnswer),
+};
+
+namespace detail {
+
+// Multiplicative hash of topic0's first 8 bytes into 64 slots. Keccak
+// output is uniform, so a multiplier that separates the registry is found
+// in a few tries.
+inline constexpr unsigned kTopicSlotBits = 6;
+
+struct TopicTable {
+  uint64_t multiplier;
+  std::array<uint8_t, std::size_t{1} << kTopicSlotBits> slots; // registry index + 1, 0 = empty
+};
+
+constexpr uint64_t topic_prefix(const std::array<uint8_t, 32> &topic) {
+  uint64_t v = 0;
+  for (std::size_t i = 0; i < 8; ++i) {
+    v |= static_cast<uint64_t>(topic[i]) << (8 * i);
+  }
+  return v;
+}
+
+constexpr std::size_t topic_slot(uint64_t prefix, uint64_t multiplier) {
+  return static_cast<std::size_t>((prefix * multiplier) >> (64 - kTopicSlotBits));
+}
+
+constexpr TopicTable build_topic_table() {
+  static_assert(kTopicRegistry.size() < (std::size_t{1} << kTopicSlotBits) / 2,
+                "grow kTopicSlotBits with the registry");
+  uint64_t state = 0;
+  uint64_t multiplier = 0x9e3779b97f4a7c15ULL;
+  for (int attempt = 0; attempt < 100000; ++attempt) {
+    TopicTable table{multiplier, {}};
+    bool ok = true;
+    for (std::size_t i = 0; i < kTopicRegistry.size() && ok; ++i) {
+      auto &slot = table.slots[topic_slot(topic_prefix(kTopicRegistry[i].topic0), multiplier)];
+      ok = slot == 0;
+      slot = static_cast<uint8_t>(i + 1);
+    }
+    if (ok) {
+      return table;
+    }
+    // Next candidate from splitmix64, kept odd
+    state += 0x9e3779b97f4a7c15ULL;
+    uint64_t z = state;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    multiplier = (z ^ (z >> 31)) | 1;
+  }
+  // Only reachable with two entries sharing a topic0 prefix, i.e. a
+  // duplicate signature: fails the build.
+  throw "no perfect hash for kTopicRegistry";
+}
+
+inline constexpr TopicTable kTopicTable = build_topic_table();
+
+} // namespace detail
+
+// Registry entry for a topic0, or nullptr: one multiply, one slot load and
+// one 32-byte compare.
+constexpr const TopicEntry *find_topic(const std::array<uint8_t, 32> &topic0) {
+  const uint8_t slot = detail::kTopicTable.slots[detail::topic_slot(
+      detail::topic_prefix(topic0), detail::kTopicTable.multiplier)];
+  if (slot == 0) {
+    return nullptr;
+  }
+  const TopicEntry &entry = kTopicRegistry[slot - 1];
+  return entry.topic0 == topic0 ? &entry : nullptr;
+}
+
+} // namespace sentinel::events
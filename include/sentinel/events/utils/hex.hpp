@@ -8,6 +8,9 @@
 #include <stdexcept>
 #include <string_view>
 
+#include "sentinel/events/utils/hex_codec.hpp"
+#include "sentinel/events/utils/uint256.hpp"
+
 namespace sentinel::events::utils {
 
 inline uint8_t hex_nibble(char c) {
@@ -69,9 +72,32 @@ inline void parse_hex_bytes(std::string_view hex, std::array<uint8_t, N> &out) {
   const size_t hex_len = hex.size() - 2;
   const size_t byte_len = std::min(hex_len / 2, N);
 
-  for (size_t i = 0; i < byte_len; ++i) {
-    out[i] = (hex_nibble(hex[2 + i * 2]) << 4) | hex_nibble(hex[2 + i * 2 + 1]);
+  if (!decode_hex(hex.data() + 2, byte_len, out.data())) {
+    throw std::runtime_error("invalid hex character");
+  }
+}
+
+// Like validate_hex() followed by parse_hex_bytes(), in one pass: decodes
+// the first N bytes into `out`, only checks the digits after them. Returns
+// the full byte length of `hex`.
+template <size_t N>
+inline size_t parse_hex_data(std::string_view hex, std::array<uint8_t, N> &out) {
+  if (hex.size() < 2 || hex.substr(0, 2) != "0x") {
+    throw std::runtime_error("Expected 0x-prefixed hex string");
+  }
+  if (((hex.size() - 2) % 2) != 0) {
+    throw std::runtime_error("Hex string has odd length");
+  }
+
+  const size_t byte_len = (hex.size() - 2) / 2;
+  const size_t decoded = std::min(byte_len, N);
+  const char *digits = hex.data() + 2;
+
+  if (!decode_hex(digits, decoded, out.data()) ||
+      !validate_hex_digits(digits + 2 * decoded, 2 * (byte_len - decoded))) {
+    throw std::runtime_error("invalid hex character");
   }
+  return byte_len;
 }
 
 inline void validate_hex(std::string_view hex) {
@@ -81,8 +107,8 @@ inline void validate_hex(std::string_view hex) {
   if (((hex.size() - 2) % 2) != 0) {
     throw std::runtime_error("Hex string has odd length");
   }
-  for (size_t i = 2; i < hex.size(); ++i) {
-    static_cast<void>(hex_nibble(hex[i]));
+  if (!validate_hex_digits(hex.data() + 2, hex.size() - 2)) {
+    throw std::runtime_error("invalid hex character");
   }
 }
 
@@ -105,62 +131,12 @@ inline bool greater_be_256(const uint8_t *lhs, const uint8_t *rhs) {
 
 // Converts a 32-byte big-endian value to a base-10 string
 inline std::string uint256_be_to_decimal(const uint8_t *data) {
-  std::array<uint8_t, 32> buffer;
-  std::memcpy(buffer.data(), data, 32);
-
-  bool is_zero = true;
-  for (int i = 0; i < 32; ++i) {
-    if (buffer[i] != 0) {
-      is_zero = false;
-      break;
-    }
-  }
-
-  if (is_zero) {
-    return "0";
-  }
-
-  std::string result;
-  is_zero = false;
-  while (!is_zero) {
-    uint32_t remainder = 0;
-    is_zero = true;
-    for (int i = 0; i < 32; ++i) {
-      uint32_t num = (remainder << 8) | buffer[i];
-      buffer[i] = static_cast<uint8_t>(num / 10);
-      remainder = num % 10;
-      if (buffer[i] != 0) {
-        is_zero = false;
-      }
-    }
-    result.push_back(static_cast<char>('0' + remainder));
-  }
-
-  std::reverse(result.begin(), result.end());
-  return result;
+  return uint256::from_be_bytes(data).to_decimal();
 }
 
 // Converts a base-10 string (decimal) to a 32-byte big-endian value.
 inline std::array<uint8_t, 32> decimal_to_be_256(std::string_view decimal) {
-  std::array<uint8_t, 32> result{};
-  for (char c : decimal) {
-    if (c < '0' || c > '9') {
-      throw std::runtime_error("invalid decimal digit");
-    }
-    uint32_t digit = c - '0';
-
-    // result = result * 10 + digit
-    uint32_t carry = digit;
-    for (int i = 31; i >= 0; --i) {
-      uint32_t val = (static_cast<uint32_t>(result[i]) * 10) + carry;
-      result[i] = static_cast<uint8_t>(val & 0xFF);
-      carry = val >> 8;
-    }
-    if (carry > 0) {
-      throw std::runtime_error("decimal string too large for 256-bit int");
-    }
-  }
-  return result;
+  return uint256::from_decimal(decimal).to_be_bytes();
 }
 
 } // namespace sentinel::events::utils
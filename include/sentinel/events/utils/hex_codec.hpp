@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace sentinel::events::utils {
+
+// Hex <-> bytes kernels without the "0x" prefix. Decoding accepts upper and
+// lower case and validates every digit in the same pass; encoding emits
+// lower case.
+struct HexKernels {
+  const char *name; // "avx2", "sse4.1" or "scalar"
+  // Decodes 2 * n_bytes digits. False if any digit is not hex; `out` is
+  // then partially written.
+  bool (*decode)(const char *in, std::size_t n_bytes, uint8_t *out);
+  // True if all n_chars characters are hex digits.
+  bool (*validate)(const char *in, std::size_t n_chars);
+  // Writes 2 * n_bytes digits.
+  void (*encode)(const uint8_t *in, std::size_t n_bytes, char *out);
+};
+
+// Best kernels for this CPU, picked once on first use.
+const HexKernels &hex_kernels();
+
+// Every kernel set this CPU can run, scalar last. For tests and benchmarks.
+std::span<const HexKernels> available_hex_kernels();
+
+inline bool decode_hex(const char *in, std::size_t n_bytes, uint8_t *out) {
+  return hex_kernels().decode(in, n_bytes, out);
+}
+
+inline bool validate_hex_digits(const char *in, std::size_t n_chars) {
+  return hex_kernels().validate(in, n_chars);
+}
+
+inline void encode_hex(const uint8_t *in, std::size_t n_bytes, char *out) {
+  hex_kernels().encode(in, n_bytes, out);
+}
+
+// "0x" followed by lower-case hex.
+std::string bytes_to_hex(const uint8_t *data, std::size_t n);
+
+template <std::size_t N>
+std::string bytes_to_hex(const std::array<uint8_t, N> &bytes) {
+  return bytes_to_hex(bytes.data(), N);
+}
+
+} // namespace sentinel::events::utils
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace sentinel::events::utils {
+
+namespace detail {
+
+inline constexpr std::array<uint64_t, 24> kKeccakRoundConstants = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL,
+    0x8000000080008000ULL, 0x000000000000808bULL, 0x0000000080000001ULL,
+    0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008aULL,
+    0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL,
+    0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x000000000000800aULL, 0x800000008000000aULL, 0x8000000080008081ULL,
+    0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL,
+};
+
+// Rho rotation and pi destination for each step of the lane walk from (1, 0).
+inline constexpr std::array<unsigned, 24> kKeccakRotation = {
+    1, 3, 6, 10, 15, 21, 28, 36, 45, 55, 2, 14, 27, 41, 56, 8, 25, 43, 62, 18, 39, 61, 20, 44};
+inline constexpr std::array<std::size_t, 24> kKeccakPiLane = {
+    10, 7, 11, 17, 18, 3, 5, 16, 8, 21, 24, 4, 15, 23, 19, 13, 12, 2, 20, 14, 22, 9, 6, 1};
+
+constexpr uint64_t rotl64(uint64_t x, unsigned n) { return (x << n) | (x >> (64 - n)); }
+
+constexpr void keccak_f1600(std::array<uint64_t, 25> &st) {
+  for (uint64_t rc : kKeccakRoundConstants) {
+    // theta
+    std::array<uint64_t, 5> bc{};
+    for (std::size_t i = 0; i < 5; ++i) {
+      bc[i] = st[i] ^ st[i + 5] ^ st[i + 10] ^ st[i + 15] ^ st[i + 20];
+    }
+    for (std::size_t i = 0; i < 5; ++i) {
+      const uint64_t t = bc[(i + 4) % 5] ^ rotl64(bc[(i + 1) % 5], 1);
+      for (std::size_t j = 0; j < 25; j += 5) {
+        st[j + i] ^= t;
+      }
+    }
+    // rho and pi
+    uint64_t t = st[1];
+    for (std::size_t i = 0; i < 24; ++i) {
+      const std::size_t j = kKeccakPiLane[i];
+      const uint64_t next = st[j];
+      st[j] = rotl64(t, kKeccakRotation[i]);
+      t = next;
+    }
+    // chi
+    for (std::size_t j = 0; j < 25; j += 5) {
+      for (std::size_t i = 0; i < 5; ++i) {
+        bc[i] = st[j + i];
+      }
+      for (std::size_t i = 0; i < 5; ++i) {
+        st[j + i] ^= ~bc[(i + 1) % 5] & bc[(i + 2) % 5];
+      }
+    }
+    // iota
+    st[0] ^= rc;
+  }
+}
+
+// 256-bit output sponge; `domain` is the padding suffix (0x01 for the
+// original Keccak Ethereum uses, 0x06 for FIPS-202 SHA3-256).
+constexpr std::array<uint8_t, 32> keccak_256_sponge(std::string_view in, uint8_t domain) {
+  constexpr std::size_t kRate = 136;
+  std::array<uint64_t, 25> st{};
+
+  auto absorb = [&st](std::size_t pos, uint8_t b) {
+    st[pos / 8] ^= static_cast<uint64_t>(b) << (8 * (pos % 8));
+  };
+
+  std::size_t pos = 0;
+  for (char c : in) {
+    absorb(pos, static_cast<uint8_t>(c));
+    if (++pos == kRate) {
+      keccak_f1600(st);
+      pos = 0;
+    }
+  }
+  absorb(pos, domain);
+  absorb(kRate - 1, 0x80);
+  keccak_f1600(st);
+
+  std::array<uint8_t, 32> out{};
+  for (std::size_t i = 0; i < 32; ++i) {
+    out[i] = static_cast<uint8_t>(st[i / 8] >> (8 * (i % 8)));
+  }
+  return out;
+}
+
+} // namespace detail
+
+// Ethereum's keccak256, usable in constant expressions, e.g. to derive an
+// event's topic0 from its signature. Not meant for hashing bulk data at
+// runtime.
+constexpr std::array<uint8_t, 32> keccak256(std::string_view in) {
+  return detail::keccak_256_sponge(in, 0x01);
+}
+
+} // namespace sentinel::events::utils
@@ -0,0 +1,268 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace sentinel::events::utils {
+
+// Unsigned 256-bit integer on four 64-bit limbs, least significant first.
+// Arithmetic wraps modulo 2^256; the *_small helpers report what did not
+// fit. EVM words arrive big-endian, so from_be_bytes/to_be_bytes are the
+// conversions at the ABI boundary.
+class uint256 {
+public:
+  constexpr uint256() noexcept = default;
+  constexpr uint256(uint64_t v) noexcept : limbs_{v, 0, 0, 0} {}
+  constexpr uint256(uint64_t l3, uint64_t l2, uint64_t l1, uint64_t l0) noexcept
+      : limbs_{l0, l1, l2, l3} {}
+
+  static constexpr uint256 max() noexcept {
+    return {~uint64_t{0}, ~uint64_t{0}, ~uint64_t{0}, ~uint64_t{0}};
+  }
+
+  static constexpr uint256 from_be_bytes(const uint8_t *p) noexcept {
+    uint256 r;
+    for (std::size_t limb = 0; limb < 4; ++limb) {
+      uint64_t v = 0;
+      for (std::size_t i = 0; i < 8; ++i) {
+        v = (v << 8) | p[(3 - limb) * 8 + i];
+      }
+      r.limbs_[limb] = v;
+    }
+    return r;
+  }
+
+  static constexpr uint256 from_be_bytes(const std::array<uint8_t, 32> &b) noexcept {
+    return from_be_bytes(b.data());
+  }
+
+  constexpr std::array<uint8_t, 32> to_be_bytes() const noexcept {
+    std::array<uint8_t, 32> out{};
+    for (std::size_t limb = 0; limb < 4; ++limb) {
+      for (std::size_t i = 0; i < 8; ++i) {
+        out[(3 - limb) * 8 + i] =
+            static_cast<uint8_t>(limbs_[limb] >> (56 - 8 * i));
+      }
+    }
+    return out;
+  }
+
+  // Base-10 digits with no sign or padding; throws std::runtime_error on an
+  // empty string, a non-digit, or a value of 2^256 or more.
+  static uint256 from_decimal(std::string_view decimal);
+
+  constexpr uint64_t limb(std::size_t i) const noexcept { return limbs_[i]; }
+  constexpr uint64_t low64() const noexcept { return limbs_[0]; }
+
+  constexpr bool is_zero() const noexcept {
+    return (limbs_[0] | limbs_[1] | limbs_[2] | limbs_[3]) == 0;
+  }
+
+  constexpr bool fits_u64() const noexcept {
+    return (limbs_[1] | limbs_[2] | limbs_[3]) == 0;
+  }
+
+  // Number of significant bits; 0 for zero.
+  constexpr unsigned bit_width() const noexcept {
+    for (std::size_t i = 4; i-- > 0;) {
+      if (limbs_[i] != 0) {
+        return static_cast<unsigned>(64 * i + std::bit_width(limbs_[i]));
+      }
+    }
+    return 0;
+  }
+
+  constexpr bool operator==(const uint256 &) const noexcept = default;
+
+  constexpr std::strong_ordering operator<=>(const uint256 &o) const noexcept {
+    for (std::size_t i = 4; i-- > 0;) {
+      if (limbs_[i] != o.limbs_[i]) {
+        return limbs_[i] <=> o.limbs_[i];
+      }
+    }
+    return std::strong_ordering::equal;
+  }
+
+  constexpr uint256 &operator+=(const uint256 &o) noexcept {
+    uint64_t carry = 0;
+    for (std::size_t i = 0; i < 4; ++i) {
+      const uint64_t s = limbs_[i] + carry;
+      carry = s < carry;
+      limbs_[i] = s + o.limbs_[i];
+      carry += limbs_[i] < s;
+    }
+    return *this;
+  }
+
+  constexpr uint256 &operator-=(const uint256 &o) noexcept {
+    uint64_t borrow = 0;
+    for (std::size_t i = 0; i < 4; ++i) {
+      const uint64_t d = limbs_[i] - o.limbs_[i];
+      const uint64_t b1 = limbs_[i] < o.limbs_[i];
+      limbs_[i] = d - borrow;
+      borrow = b1 | (d < borrow);
+    }
+    return *this;
+  }
+
+  // *this *= m. Returns the high limb shifted out, 0 if the product fit.
+  constexpr uint64_t mul_small(uint64_t m) noexcept {
+    uint64_t carry = 0;
+    for (std::size_t i = 0; i < 4; ++i) {
+      const u128 p = static_cast<u128>(limbs_[i]) * m + carry;
+      limbs_[i] = static_cast<uint64_t>(p);
+      carry = static_cast<uint64_t>(p >> 64);
+    }
+    return carry;
+  }
+
+  // *this /= d, returning the remainder. d must not be zero.
+  constexpr uint64_t div_small(uint64_t d) noexcept {
+    uint64_t rem = 0;
+    for (std::size_t i = 4; i-- > 0;) {
+      const u128 n = (static_cast<u128>(rem) << 64) | limbs_[i];
+      limbs_[i] = static_cast<uint64_t>(n / d);
+      rem = static_cast<uint64_t>(n % d);
+    }
+    return rem;
+  }
+
+  constexpr uint256 &operator*=(uint64_t m) noexcept {
+    mul_small(m);
+    return *this;
+  }
+
+  constexpr uint256 &operator/=(uint64_t d) noexcept {
+    div_small(d);
+    return *this;
+  }
+
+  constexpr uint256 &operator>>=(unsigned n) noexcept {
+    if (n >= 256) {
+      return *this = uint256{};
+    }
+    const std::size_t words = n / 64;
+    const unsigned bits = n % 64;
+    for (std::size_t i = 0; i < 4; ++i) {
+      const std::size_t src = i + words;
+      uint64_t v = src < 4 ? limbs_[src] >> bits : 0;
+      if (bits != 0 && src + 1 < 4) {
+        v |= limbs_[src + 1] << (64 - bits);
+      }
+      limbs_[i] = v;
+    }
+    return *this;
+  }
+
+  constexpr uint256 &operator<<=(unsigned n) noexcept {
+    if (n >= 256) {
+      return *this = uint256{};
+    }
+    const std::size_t words = n / 64;
+    const unsigned bits = n % 64;
+    for (std::size_t i = 4; i-- > 0;) {
+      uint64_t v = i >= words ? limbs_[i - words] << bits : 0;
+      if (bits != 0 && i >= words + 1) {
+        v |= limbs_[i - words - 1] >> (64 - bits);
+      }
+      limbs_[i] = v;
+    }
+    return *this;
+  }
+
+  friend constexpr uint256 operator+(uint256 a, const uint256 &b) noexcept { return a += b; }
+  friend constexpr uint256 operator-(uint256 a, const uint256 &b) noexcept { return a -= b; }
+  friend constexpr uint256 operator*(uint256 a, uint64_t m) noexcept { return a *= m; }
+  friend constexpr uint256 operator/(uint256 a, uint64_t d) noexcept { return a /= d; }
+  friend constexpr uint64_t operator%(uint256 a, uint64_t d) noexcept { return a.div_small(d); }
+  friend constexpr uint256 operator>>(uint256 a, unsigned n) noexcept { return a >>= n; }
+  friend constexpr uint256 operator<<(uint256 a, unsigned n) noexcept { return a <<= n; }
+
+  constexpr uint256 operator~() const noexcept {
+    return {~limbs_[3], ~limbs_[2], ~limbs_[1], ~limbs_[0]};
+  }
+
+  // Base-10, peeled off 19 digits (one uint64 division step) at a time.
+  std::string to_decimal() const;
+
+  // The value scaled down by 10^decimals, e.g. 1500000 with 6 decimals is
+  // "1.5". Trailing fractional zeros are dropped, as is a bare point.
+  std::string to_decimal(unsigned decimals) const;
+
+private:
+  __extension__ typedef unsigned __int128 u128;
+
+  std::array<uint64_t, 4> limbs_{};
+};
+
+// Two's-complement signed 256-bit integer sharing uint256's storage, for
+// int256 ABI values such as Chainlink answers.
+class int256 {
+public:
+  constexpr int256() noexcept = default;
+  constexpr int256(int64_t v) noexcept
+      : bits_(v < 0 ? ~uint256(~static_cast<uint64_t>(v)) : uint256(static_cast<uint64_t>(v))) {}
+
+  static constexpr int256 from_bits(const uint256 &bits) noexcept {
+    int256 r;
+    r.bits_ = bits;
+    return r;
+  }
+
+  static constexpr int256 from_be_bytes(const uint8_t *p) noexcept {
+    return from_bits(uint256::from_be_bytes(p));
+  }
+
+  static constexpr int256 from_be_bytes(const std::array<uint8_t, 32> &b) noexcept {
+    return from_be_bytes(b.data());
+  }
+
+  constexpr std::array<uint8_t, 32> to_be_bytes() const noexcept { return bits_.to_be_bytes(); }
+  constexpr const uint256 &bits() const noexcept { return bits_; }
+
+  constexpr bool is_negative() const noexcept { return (bits_.limb(3) >> 63) != 0; }
+  constexpr bool is_zero() const noexcept { return bits_.is_zero(); }
+
+  // |value|; well-defined for the minimum too, since it is returned unsigned.
+  constexpr uint256 magnitude() const noexcept {
+    return is_negative() ? uint256{} - bits_ : bits_;
+  }
+
+  constexpr bool operator==(const int256 &) const noexcept = default;
+
+  constexpr std::strong_ordering operator<=>(const int256 &o) const noexcept {
+    if (is_negative() != o.is_negative()) {
+      return is_negative() ? std::strong_ordering::less : std::strong_ordering::greater;
+    }
+    // Same sign: two's-complement bits order like the values
+    return bits_ <=> o.bits_;
+  }
+
+  constexpr int256 &operator+=(const int256 &o) noexcept {
+    bits_ += o.bits_;
+    return *this;
+  }
+
+  constexpr int256 &operator-=(const int256 &o) noexcept {
+    bits_ -= o.bits_;
+    return *this;
+  }
+
+  friend constexpr int256 operator+(int256 a, const int256 &b) noexcept { return a += b; }
+  friend constexpr int256 operator-(int256 a, const int256 &b) noexcept { return a -= b; }
+
+  constexpr int256 operator-() const noexcept { return from_bits(uint256{} - bits_); }
+
+  std::string to_decimal() const;
+  std::string to_decimal(unsigned decimals) const;
+
+private:
+  uint256 bits_;
+};
+
+} // namespace sentinel::events::utils
@@ -24,20 +24,42 @@ struct Metrics {
     prometheus::Family<prometheus::Counter>& alerts_sent_total;
     prometheus::Family<prometheus::Counter>& alerts_send_failures_total;
     prometheus::Family<prometheus::Counter>& alerts_deduplicated_total;
+    prometheus::Family<prometheus::Counter>& alerts_dropped_total;
+    prometheus::Family<prometheus::Counter>& alert_retry_attempts_total;
+    prometheus::Family<prometheus::Counter>& alert_circuit_rejections_total;
+    prometheus::Family<prometheus::Counter>& alert_outbox_dropped_total;
+    prometheus::Family<prometheus::Counter>& checkpoint_write_failures_total;
+    prometheus::Family<prometheus::Counter>& rule_config_reload_failures_total;
     prometheus::Family<prometheus::Counter>& rpc_calls_total;
+    prometheus::Family<prometheus::Counter>& risk_engine_shard_signals_total;
+    prometheus::Family<prometheus::Counter>& risk_engine_shard_busy_seconds_total;
 
     // Gauges
     prometheus::Family<prometheus::Gauge>& ring_buffer_depth;
     prometheus::Family<prometheus::Gauge>& alert_queue_depth;
+    prometheus::Family<prometheus::Gauge>& alert_deliveries_in_flight;
+    prometheus::Family<prometheus::Gauge>& alert_circuit_breakers;
+    prometheus::Family<prometheus::Gauge>& alert_retry_queue_depth;
+    prometheus::Family<prometheus::Gauge>& alert_outbox_backlog;
+    prometheus::Family<prometheus::Gauge>& checkpoint_block;
+    prometheus::Family<prometheus::Gauge>& rule_config_generation;
+    prometheus::Family<prometheus::Gauge>& startup_phase_duration_seconds;
     prometheus::Family<prometheus::Gauge>& last_rpc_success_timestamp_seconds;
     prometheus::Family<prometheus::Gauge>& last_alert_success_timestamp_seconds;
     prometheus::Family<prometheus::Gauge>& last_seen_block;
     prometheus::Family<prometheus::Gauge>& last_processed_block;
+    prometheus::Family<prometheus::Gauge>& backfill_blocks_per_second;
+    prometheus::Family<prometheus::Gauge>& getlogs_block_range;
+    prometheus::Family<prometheus::Gauge>& risk_engine_shard_queue_depth;
 
     // Histograms
     prometheus::Family<prometheus::Histogram>& alert_send_duration_seconds;
     prometheus::Family<prometheus::Histogram>& signal_to_alert_seconds;
+    prometheus::Family<prometheus::Histogram>& alert_enqueue_duration_seconds;
+    prometheus::Family<prometheus::Histogram>& alert_outbox_flush_duration_seconds;
+    prometheus::Family<prometheus::Histogram>& rule_config_reload_duration_seconds;
     prometheus::Family<prometheus::Histogram>& rpc_call_duration_seconds;
+    prometheus::Family<prometheus::Histogram>& rpc_call_phase_seconds;
 
     // Canonical Chain Label
     std::string chain_name;
@@ -51,6 +73,8 @@ struct Metrics {
     prometheus::Gauge* last_alert_success_timestamp_seconds_chain = nullptr;
     prometheus::Gauge* last_seen_block_chain = nullptr;
     prometheus::Gauge* last_processed_block_chain = nullptr;
+    prometheus::Gauge* backfill_blocks_per_second_chain = nullptr;
+    prometheus::Gauge* getlogs_block_range_chain = nullptr;
 
     explicit Metrics(const std::string& listen_address, const std::string& chain);
     ~Metrics() = default;
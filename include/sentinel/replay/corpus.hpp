@@ -0,0 +1,102 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct gzFile_s;
+
+namespace sentinel::replay {
+
+// A capture of what the chain adapter received from the node, replayed by
+// ReplayChainAdapter. The file is a gzip stream of records:
+//
+//   "SNTLRPC1"
+//   kind u8, offset_us u64, a u64, b u64, part u32, body_len u32, body
+//
+// integers little-endian. offset_us is the time since the capture started.
+enum class RecordKind : uint8_t {
+  ChainId = 1,        // a = chain id
+  Head = 2,           // a = chain head
+  BlockTimestamp = 3, // a = block, b = timestamp (s)
+  Logs = 4,           // a = from_block, b = to_block, part = address chunk,
+                      // body = raw eth_getLogs response
+};
+
+struct CorpusRecord {
+  RecordKind kind{};
+  uint64_t offset_us = 0;
+  uint64_t a = 0;
+  uint64_t b = 0;
+  uint32_t part = 0;
+  std::string body;
+};
+
+// Appends records from any number of threads (the parallel backfill fetches
+// ranges concurrently). Compression runs on the calling thread under a lock,
+// so capturing costs some throughput.
+class CorpusWriter {
+public:
+  // Creates or truncates `path`; throws std::runtime_error if it cannot.
+  explicit CorpusWriter(const std::string &path);
+  // Flushes and closes the file.
+  ~CorpusWriter();
+
+  CorpusWriter(const CorpusWriter &) = delete;
+  CorpusWriter &operator=(const CorpusWriter &) = delete;
+
+  void chain_id(uint64_t chain_id);
+  void head(uint64_t block);
+  void block_timestamp(uint64_t block, uint64_t timestamp);
+  // The response bodies of one range, one per eth_getLogs address chunk;
+  // written together so a reader sees them as one range.
+  void logs(uint64_t from_block, uint64_t to_block,
+            const std::vector<std::string_view> &bodies);
+
+  std::size_t records() const;
+
+private:
+  // Caller holds mutex_. Write errors are logged once and then ignored: a
+  // broken capture must not stop the pipeline.
+  void write_(RecordKind kind, uint64_t offset_us, uint64_t a, uint64_t b,
+              uint32_t part, std::string_view body);
+  uint64_t offset_us_() const;
+
+  mutable std::mutex mutex_;
+  gzFile_s *file_ = nullptr;
+  const std::chrono::steady_clock::time_point started_at_;
+  std::size_t records_ = 0;
+  bool failed_ = false;
+};
+
+class CorpusReader {
+public:
+  // Throws std::runtime_error if `path` cannot be opened or is not a corpus.
+  explicit CorpusReader(const std::string &path);
+  ~CorpusReader();
+
+  CorpusReader(const CorpusReader &) = delete;
+  CorpusReader &operator=(const CorpusReader &) = delete;
+
+  // False at the end of the corpus. A record cut short at the end (a capture
+  // that was killed) also ends it and sets truncated(); anything else
+  // malformed throws std::runtime_error.
+  bool next(CorpusRecord &record);
+  bool truncated() const { return truncated_; }
+
+private:
+  // Reads exactly n bytes; false if the stream ended first.
+  bool read_(void *buf, std::size_t n);
+
+  gzFile_s *file_ = nullptr;
+  bool truncated_ = false;
+};
+
+// Every record of the corpus at `path`, in file order.
+std::vector<CorpusRecord> read_corpus(const std::string &path);
+
+} // namespace sentinel::replay
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace sentinel::replay {
+
+// Log-linear histogram of durations in nanoseconds: exact below 32 ns,
+// then 8 buckets per power of two, so a percentile is within 12.5% of the
+// true value. record() is one relaxed atomic increment and may be called
+// from any number of threads.
+class LatencyHistogram {
+public:
+  static constexpr std::size_t kBuckets = 32 + 59 * 8;
+
+  void record(uint64_t ns) noexcept {
+    buckets_[bucket_of(ns)].fetch_add(1, std::memory_order_relaxed);
+    uint64_t seen = max_.load(std::memory_order_relaxed);
+    while (ns > seen && !max_.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {
+    }
+  }
+
+  uint64_t count() const noexcept;
+  uint64_t max() const noexcept { return max_.load(std::memory_order_relaxed); }
+  // Upper bound of the bucket holding the p-th percentile (0 < p <= 100),
+  // capped at max(); 0 when nothing was recorded.
+  uint64_t percentile(double p) const noexcept;
+
+  static std::size_t bucket_of(uint64_t ns) noexcept;
+  static uint64_t bucket_upper(std::size_t bucket) noexcept;
+
+private:
+  std::array<std::atomic<uint64_t>, kBuckets> buckets_{};
+  std::atomic<uint64_t> max_{0};
+};
+
+} // namespace sentinel::replay
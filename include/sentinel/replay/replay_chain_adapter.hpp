@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "sentinel/chains/ChainAdapter.hpp"
+#include "sentinel/replay/corpus.hpp"
+#include "sentinel/replay/latency_histogram.hpp"
+
+namespace sentinel::replay {
+
+enum class ReplayPace {
+  Fast,     // every recorded block is available at once
+  Recorded, // the head advances as it did during the capture
+};
+
+// Serves a captured corpus (see CorpusWriter) in place of a node. Log
+// responses go through the same decoder as live ones, so a replay measures
+// decoding too. Requests need not match the recorded ranges: every recorded
+// range overlapping the request is decoded and the logs outside it dropped.
+// Blocks the capture did not cover have no logs.
+class ReplayChainAdapter : public ChainAdapter {
+public:
+  // Throws std::runtime_error if the corpus has no chain id or no logs.
+  explicit ReplayChainAdapter(std::vector<CorpusRecord> records,
+                              ReplayPace pace = ReplayPace::Fast);
+
+  std::string name() const override;
+  uint64_t chainId() override;
+  // With ReplayPace::Recorded the recorded ranges become available at the
+  // offset they were captured at, counted from the first call.
+  uint64_t latestBlock() override;
+  // The recorded timestamp of the block, or of the closest earlier block.
+  uint64_t blockTimestamp(uint64_t block_number) override;
+
+  std::vector<sentinel::events::RawLog> getLogs(uint64_t from_block,
+                                                uint64_t to_block) override;
+  void getSignals(uint64_t from_block, uint64_t to_block, uint64_t chain_id,
+                  std::vector<sentinel::risk::Signal> &out) override;
+  RangeFetch fetchRange(uint64_t from_block, uint64_t to_block, uint64_t chain_id,
+                        std::vector<sentinel::risk::Signal> &out) override;
+
+  uint64_t first_block() const { return first_block_; }
+  uint64_t last_block() const { return last_block_; }
+  std::size_t ranges() const { return ranges_.size(); }
+  // Recorded ranges dropped because they overlapped an earlier one
+  std::size_t overlapping_ranges() const { return overlapping_ranges_; }
+  std::size_t corpus_bytes() const { return corpus_bytes_; }
+
+  // Signals handed out and time spent producing them, per fetch
+  uint64_t signals_served() const { return signals_served_.load(std::memory_order_relaxed); }
+  const LatencyHistogram &fetch_latency() const { return fetch_latency_; }
+
+private:
+  struct Range {
+    uint64_t to_block;
+    uint64_t offset_us;
+    std::vector<std::string> bodies; // one per address chunk
+  };
+
+  // Decodes the recorded ranges overlapping [from_block, to_block]; returns
+  // the response bytes decoded.
+  std::size_t decode_(uint64_t from_block, uint64_t to_block, uint64_t chain_id,
+                      std::vector<sentinel::risk::Signal> &out);
+
+  ReplayPace pace_;
+  uint64_t chain_id_ = 0;
+  std::map<uint64_t, Range> ranges_; // by from_block, disjoint
+  std::map<uint64_t, uint64_t> timestamps_;
+  uint64_t first_block_ = 0;
+  uint64_t last_block_ = 0;
+  std::size_t overlapping_ranges_ = 0;
+  std::size_t corpus_bytes_ = 0;
+
+  // Recorded pace: (offset_us, highest block available from then on)
+  std::vector<std::pair<uint64_t, uint64_t>> availability_;
+  std::atomic<int64_t> replay_start_ns_{0}; // steady clock; 0 until first use
+
+  std::atomic<uint64_t> signals_served_{0};
+  LatencyHistogram fetch_latency_;
+};
+
+} // namespace sentinel::replay
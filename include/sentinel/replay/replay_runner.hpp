@@ -0,0 +1,65 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "sentinel/replay/replay_chain_adapter.hpp"
+#include "sentinel/risk/rule_interface.hpp"
+
+namespace sentinel::replay {
+
+struct ReplayOptions {
+  unsigned risk_engine_workers = 1;
+  unsigned backfill_parallelism = 4;
+  uint64_t max_block_range = 10'000;
+  // Gives up after this long; zero waits until the corpus is processed
+  std::chrono::milliseconds timeout{0};
+};
+
+struct StageLatency {
+  std::string stage;
+  uint64_t count = 0;
+  uint64_t p50_ns = 0;
+  uint64_t p90_ns = 0;
+  uint64_t p99_ns = 0;
+  uint64_t p999_ns = 0;
+  uint64_t max_ns = 0;
+};
+
+struct ReplayReport {
+  uint64_t first_block = 0;
+  uint64_t last_block = 0;
+  std::size_t ranges = 0;
+  std::size_t corpus_bytes = 0;
+  bool completed = false; // false if the timeout hit first
+  double wall_seconds = 0;
+  uint64_t signals = 0;
+  uint64_t alerts_generated = 0; // by the rules
+  uint64_t alerts_delivered = 0; // after deduplication
+  // fetch (corpus decode), rule:<type> (one evaluate() call) and
+  // signal_to_alert (ingress to delivery; millisecond resolution)
+  std::vector<StageLatency> stages;
+
+  double signals_per_second() const;
+  double alerts_per_second() const; // delivered
+};
+
+// Runs the corpus through EventSource -> RiskEngine -> AlertDispatcher with
+// `rules`, delivering to a channel that only counts, until every block of
+// the corpus has been processed (checkpointed). Single use per adapter.
+ReplayReport run_replay(ReplayChainAdapter &adapter,
+                        std::vector<std::unique_ptr<sentinel::risk::IRiskRule>> rules,
+                        const ReplayOptions &options);
+
+void print_report(const ReplayReport &report, std::ostream &out);
+
+// `sentinel replay <corpus> [options]`; see the usage text. Exit code 0 on
+// success, 1 on bad arguments, 2 if the corpus or rules cannot be loaded,
+// 3 if the replay timed out.
+int replay_command(int argc, char **argv);
+
+} // namespace sentinel::replay
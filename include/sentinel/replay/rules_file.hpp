@@ -0,0 +1,35 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "sentinel/risk/rule_interface.hpp"
+
+namespace sentinel::replay {
+
+// Rule configs for a replay, which runs without the database. One optional
+// key per rule type, mirroring the DB tables (amounts are decimal strings,
+// addresses 0x-prefixed hex):
+//
+//   {
+//     "large_transfer": [{"customer_id", "chain_id", "token_address", "threshold"}],
+//     "governance":     [{"customer_id", "chain_id", "contract_address"}],
+//     "mint_burn":      [{"customer_id", "chain_id", "contract_address",
+//                         "mint_threshold", "burn_threshold"}],
+//     "approval":       [{"customer_id", "chain_id", "token_address", "threshold",
+//                         "alert_on_infinite"}],
+//     "bridge": {"contracts": [{"chain_id", "address", "name"}],
+//                "rules":     [{"customer_id", "chain_id", "token_address", "threshold"}]},
+//     "oracle":         [{"customer_id", "chain_id", "aggregator_address", "feed_label",
+//                         "spike_threshold_bps", "decimals"}]
+//   }
+//
+// A rule is built for every key present. Throws std::runtime_error (or a
+// nlohmann::json exception) on a missing field or malformed value.
+std::vector<std::unique_ptr<sentinel::risk::IRiskRule>> rules_from_json(const nlohmann::json &doc);
+std::vector<std::unique_ptr<sentinel::risk::IRiskRule>> load_rules_file(const std::string &path);
+
+} // namespace sentinel::replay
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace sentinel::risk {
+
+// Hash of a (chain_id, 20-byte address) pair. The address is read as three
+// words (8 + 8 + 4 bytes) and folded with the chain id, followed by the
+// splitmix64 finalizer: a handful of multiplies instead of a per-byte loop.
+inline uint64_t hash_address_key(uint64_t chain_id,
+                                 const std::array<uint8_t, 20> &address) noexcept {
+  uint64_t lo = 0;
+  uint64_t mid = 0;
+  uint32_t hi = 0;
+  std::memcpy(&lo, address.data(), sizeof(lo));
+  std::memcpy(&mid, address.data() + 8, sizeof(mid));
+  std::memcpy(&hi, address.data() + 16, sizeof(hi));
+
+  uint64_t h = chain_id ^ (lo * 0x9e3779b97f4a7c15ULL) ^
+               (mid * 0xc2b2ae3d27d4eb4fULL) ^ (uint64_t{hi} << 17);
+  h ^= h >> 30;
+  h *= 0xbf58476d1ce4e5b9ULL;
+  h ^= h >> 27;
+  h *= 0x94d049bb133111ebULL;
+  h ^= h >> 31;
+  return h;
+}
+
+} // namespace sentinel::risk
@@ -1,15 +1,34 @@
 #pragma once
 
+#include <functional>
 #include <string>
 #include "sentinel/risk/alert_dispatcher.hpp"
 
 namespace sentinel::risk {
 
+struct DeliveryResult {
+  bool ok = true;
+  std::string error; // first failure when !ok
+};
+
+using DeliveryCallback = std::function<void(const DeliveryResult &)>;
+
 class IAlertChannel {
 public:
   virtual ~IAlertChannel() = default;
   virtual std::string name() const = 0;
+
+  // Delivers `alert` before returning.
   virtual void send(const Alert &alert) = 0;
+
+  // Starts delivering `alert` and calls `done` exactly once when it has
+  // finished, possibly on another thread. Channels doing network I/O
+  // override this so the dispatcher never waits on a slow endpoint; the
+  // default delivers inline and lets send()'s exceptions propagate.
+  virtual void send_async(const Alert &alert, DeliveryCallback done) {
+    send(alert);
+    done(DeliveryResult{});
+  }
 };
 
 } // namespace sentinel::risk
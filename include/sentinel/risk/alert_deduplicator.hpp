@@ -1,9 +1,11 @@
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace sentinel::risk {
 
@@ -16,6 +18,12 @@ struct DeduplicatorConfig {
     size_t cleanup_every_n_alerts = 100;
 };
 
+// Keys are fixed-size binary structs held in an open-addressing table, and
+// every tracked key sits in a hierarchical timing wheel at the time it goes
+// stale, so expiry only touches the keys that expire. Neither path
+// allocates once the table has grown to the number of keys tracked; a rule
+// type not named in the config is interned (one allocation) the first time
+// it is seen.
 class AlertDeduplicator {
 public:
     explicit AlertDeduplicator(DeduplicatorConfig cfg);
@@ -31,13 +39,77 @@ public:
     size_t cleanup_stale_entries(uint64_t now_ms);
 
     // Inspection (for tests/metrics): number of tracked keys.
-    size_t tracked_keys_count() const { return last_fired_ms_.size(); }
+    size_t tracked_keys_count() const { return size_; }
 
 private:
+    static constexpr uint32_t kNone = UINT32_MAX;
+    static constexpr int kLevels = 4;       // 1 ms ticks; reaches ~49 days
+    static constexpr int kSlotBits = 8;
+    static constexpr int kSlots = 1 << kSlotBits;
+
+    // (customer, rule, chain, token). Token addresses are stored as their
+    // 20 bytes; anything else in token_address is stored as a 128-bit hash.
+    struct Key {
+        uint64_t customer_id = 0;
+        uint64_t chain_id = 0;
+        uint32_t rule = 0;   // index into rules_
+        uint8_t has_chain = 0;
+        uint8_t token_kind = 0;
+        uint8_t pad[2] = {};
+        std::array<uint8_t, 20> token{};
+
+        bool operator==(const Key&) const = default;
+    };
+
+    struct Entry {
+        Key key;
+        uint64_t last_fired_ms = 0;
+        uint32_t hash = 0;
+        uint32_t next = kNone;  // wheel slot list, or the free list
+    };
+
+    struct Bucket {
+        uint32_t hash = 0;
+        uint32_t entry = kNone;
+    };
+
+    struct Rule {
+        std::string name;
+        uint64_t window_ms;
+    };
+
+    uint32_t rule_id_(const std::string& rule_type);
+    Key make_key_(const Alert& alert);
+    static uint32_t hash_(const Key& key);
+
+    uint32_t find_(const Key& key, uint32_t hash) const;
+    void insert_(const Key& key, uint32_t hash, uint64_t now_ms);
+    void erase_(uint32_t entry);
+    void grow_();
+
+    // Timing wheel over entry indices; ticks are milliseconds.
+    uint64_t due_tick_(uint32_t entry) const;
+    void schedule_(uint32_t entry);
+    // Erases the entries of a detached slot list that are due, and moves
+    // the rest to the slot of their current due tick.
+    size_t fire_(uint32_t head);
+    size_t advance_(uint64_t now_ms);
+
     DeduplicatorConfig cfg_;
-    std::unordered_map<std::string, uint64_t> last_fired_ms_;
-    size_t alerts_processed_since_cleanup_ = 0;
+    std::vector<Rule> rules_;
     uint64_t max_configured_window_ms_;  // computed once in constructor
+
+    std::vector<Entry> entries_;
+    uint32_t free_ = kNone;
+    std::vector<Bucket> buckets_;  // power-of-two size, linear probing
+    size_t size_ = 0;
+
+    std::array<std::array<uint32_t, kSlots>, kLevels> wheel_;
+    std::array<std::array<uint64_t, kSlots / 64>, kLevels> occupied_{};
+    uint32_t overflow_ = kNone;    // beyond the top level
+    uint64_t current_tick_ = 0;    // last tick expired
+
+    size_t alerts_processed_since_cleanup_ = 0;
 };
 
 } // namespace sentinel::risk
@@ -1,17 +1,20 @@
 #pragma once
 
 #include <atomic>
-#include <condition_variable>
+#include <chrono>
+#include <cstddef>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <optional>
-#include <queue>
+#include <stop_token>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "sentinel/health/heartbeat.hpp"
 #include "sentinel/risk/alert_deduplicator.hpp"
+#include "sentinel/risk/mpsc_queue.hpp"
 
 namespace sentinel::metrics {
 struct Metrics;
@@ -26,6 +29,9 @@ class Histogram;
 namespace sentinel::risk {
 
 class IAlertChannel;
+class AlertOutbox;
+class CheckpointWriter;
+struct DeliveryResult;
 
 using CustomerId = std::uint64_t;
 
@@ -47,6 +53,19 @@ struct Alert {
   std::optional<std::string> amount_decimal;
   std::optional<std::string> token_address;
   std::optional<uint64_t> chain_id;
+  uint64_t outbox_id = 0; // alert_outbox row; 0 until recorded
+};
+
+// What dispatch() does when the alert queue is full.
+enum class AlertOverflowPolicy {
+  Block,      // back off until the dispatcher frees a slot (or stop())
+  DropNewest, // drop the incoming alert and count it
+};
+
+struct AlertQueueConfig {
+  std::size_t capacity = 16384;
+  AlertOverflowPolicy overflow = AlertOverflowPolicy::Block;
+  std::size_t batch_size = 64; // alerts taken per dequeue
 };
 
 class AlertDispatcher {
@@ -55,7 +74,8 @@ public:
                   sentinel::metrics::Metrics* metrics,
                   DeduplicatorConfig dedup_cfg,
                   std::vector<std::string> rule_types,
-                  sentinel::health::Heartbeat* heartbeat = nullptr);
+                  sentinel::health::Heartbeat* heartbeat = nullptr,
+                  AlertQueueConfig queue_cfg = {});
   ~AlertDispatcher();
 
   // Prevent copy/move
@@ -64,32 +84,96 @@ public:
 
   void add_channel(std::unique_ptr<IAlertChannel> channel);
 
+  // Records every alert that passes deduplication in `outbox` and marks
+  // it completed once all channels are done. Call before run(); `outbox`
+  // must outlive the dispatcher.
+  void set_outbox(AlertOutbox *outbox);
+
+  // Passes each checkpoint barrier to `writer` once every alert queued
+  // before it has been delivered (or failed, or was suppressed). Call
+  // before run(); `writer` must outlive the dispatcher.
+  void set_checkpoint_writer(CheckpointWriter *writer);
+
+  // Alerts recovered from the outbox. run() delivers them first, without
+  // deduplication, since they already passed it before the restart; they
+  // do start dedup windows, which suppress the copies rebuilt when their
+  // blocks are processed again. Call before run().
+  void replay(std::vector<Alert> alerts);
+
   void run(std::stop_token st = {});
   void stop();
 
+  // Thread-safe and lock-free: any number of producers (e.g. RiskEngine
+  // workers) may call it concurrently. Delivery is asynchronous: run()
+  // hands each alert to every channel's send_async() without waiting, so a
+  // slow endpoint holds up only its own deliveries.
   void dispatch(Alert alert);
 
+  // Checkpoint barrier: every alert for blocks up to `block` has been
+  // dispatch()ed by the caller. Queued behind those alerts, with the same
+  // overflow policy; a dropped barrier is covered by the next one.
+  void checkpoint(uint64_t block);
+
 private:
+  struct PendingAlert;
+
+  struct QueueItem {
+    Alert alert;
+    std::optional<uint64_t> checkpoint; // a barrier rather than an alert
+  };
+
+  // Alerts fanned out between two barriers. An epoch settles once it is
+  // closed by its barrier and none of its deliveries are outstanding.
+  struct Epoch {
+    std::size_t outstanding = 0;
+    std::optional<uint64_t> block; // set when its barrier arrives
+  };
+  static constexpr uint64_t kNoEpoch = UINT64_MAX;
+
+  void deliver_(Alert &alert);
+  void fan_out_(const Alert &alert, bool track = true);
+  void close_epoch_(uint64_t block);
+  void settle_(uint64_t epoch);
+  // Pops settled epochs from the front; returns the last block among them.
+  // Caller holds epochs_mutex_.
+  std::optional<uint64_t> pop_settled_locked_();
+  // Called once per channel per delivered alert, from whichever thread the
+  // channel completes on.
+  void on_delivered_(PendingAlert &pending, const std::string &channel,
+                     std::chrono::steady_clock::time_point start,
+                     const DeliveryResult &result);
+
   std::vector<std::unique_ptr<IAlertChannel>> channels_;
-  std::queue<Alert> queue_;
-  std::mutex mutex_;
-  std::condition_variable cv_;
+  AlertOutbox* outbox_ = nullptr;
+  std::vector<Alert> replay_;
+  AlertQueueConfig queue_cfg_;
+  MpscQueue<QueueItem> queue_;
   std::atomic<bool> running_{false};
+  std::atomic<bool> stop_requested_{false};
+  std::atomic<std::size_t> deliveries_in_flight_{0};
   std::string chain_name_;
   sentinel::metrics::Metrics* metrics_;
   sentinel::health::Heartbeat* heartbeat_ = nullptr;
 
   AlertDeduplicator deduplicator_;
 
+  CheckpointWriter* checkpoint_writer_ = nullptr;
+  std::mutex epochs_mutex_;    // fan-out vs. delivery threads
+  std::deque<Epoch> epochs_;   // oldest unsettled first; the last is open
+  uint64_t first_epoch_ = 0;   // id of epochs_.front()
+
   std::unordered_map<std::string, prometheus::Counter*> alerts_sent_counters_;
   std::unordered_map<std::string, prometheus::Counter*> alerts_send_failures_counters_;
   std::unordered_map<std::string, prometheus::Counter*> alerts_deduplicated_counters_;
+  std::unordered_map<std::string, prometheus::Histogram*> alert_send_duration_hists_;
 
   prometheus::Gauge* last_alert_success_gauge_ = nullptr;
   prometheus::Gauge* alert_queue_depth_gauge_ = nullptr;
-  prometheus::Histogram* alert_send_duration_hist_ = nullptr;
+  prometheus::Gauge* deliveries_in_flight_gauge_ = nullptr;
   prometheus::Histogram* signal_to_alert_hist_ = nullptr;
-
+  prometheus::Histogram* enqueue_duration_hist_ = nullptr;
+  prometheus::Counter* dropped_queue_full_counter_ = nullptr;
+  prometheus::Counter* dropped_shutdown_counter_ = nullptr;
 };
 
 } // namespace sentinel::risk
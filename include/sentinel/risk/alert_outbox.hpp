@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sentinel/risk/alert_dispatcher.hpp"
+#include "sentinel/risk/mpsc_queue.hpp"
+
+namespace sentinel::metrics {
+struct Metrics;
+}
+
+namespace prometheus {
+class Counter;
+class Gauge;
+class Histogram;
+}
+
+namespace sentinel::risk {
+
+struct OutboxConfig {
+  std::size_t buffer_capacity = 65536; // operations held before dropping
+  std::size_t max_batch = 500;         // rows per write
+  std::chrono::milliseconds flush_interval{200};
+  std::chrono::milliseconds retry_backoff{1000};
+  std::chrono::hours replay_max_age{24}; // older open rows are not replayed
+};
+
+struct OutboxRecord {
+  Alert alert; // alert.outbox_id is the row id
+  // Set when the delivery finished before the row was written
+  std::optional<bool> delivered;
+};
+
+struct OutboxCompletion {
+  uint64_t id;
+  bool delivered; // every channel succeeded
+};
+
+// Where the outbox rows live; a Postgres table in production.
+class IAlertOutboxStore {
+public:
+  virtual ~IAlertOutboxStore() = default;
+
+  // One transaction: inserts `records` (ids already present are left
+  // alone), then marks `completions` finished. Throws on failure.
+  virtual void write(const std::vector<OutboxRecord> &records,
+                     const std::vector<OutboxCompletion> &completions) = 0;
+
+  // Rows never marked finished, oldest first. Rows older than `max_age`
+  // are marked undelivered instead of being returned.
+  virtual std::vector<Alert> load_pending(std::chrono::hours max_age) = 0;
+};
+
+// Durable log of alerts between the dispatcher and their delivery. The
+// dispatcher records each alert it is about to deliver and completes it
+// once every channel has finished; after a crash the alerts never
+// completed are loaded again and redelivered.
+//
+// record() and complete() only push onto a bounded lock-free buffer, which
+// a writer thread drains into the store in batches. When the buffer is
+// full the operation is dropped and counted rather than waited for.
+class AlertOutbox {
+public:
+  AlertOutbox(std::unique_ptr<IAlertOutboxStore> store, OutboxConfig cfg = {},
+              std::string chain_name = "", sentinel::metrics::Metrics *metrics = nullptr);
+  // Writes what is still buffered (one attempt per batch), then stops.
+  ~AlertOutbox();
+
+  AlertOutbox(const AlertOutbox &) = delete;
+  AlertOutbox &operator=(const AlertOutbox &) = delete;
+
+  // Alerts to redeliver, with outbox_id set. Call before the first record().
+  std::vector<Alert> load_pending();
+
+  // Thread-safe. Assigns alert.outbox_id and queues the row.
+  void record(Alert &alert);
+  // Thread-safe.
+  void complete(uint64_t id, bool delivered);
+
+  // Operations not yet written to the store.
+  std::size_t backlog() const noexcept;
+
+private:
+  struct Op {
+    std::optional<Alert> alert; // a record; otherwise a completion
+    uint64_t id = 0;
+    bool delivered = false;
+  };
+
+  void push_(Op op);
+  void run_();
+  bool flush_(const std::vector<Op> &ops);
+
+  std::unique_ptr<IAlertOutboxStore> store_;
+  OutboxConfig cfg_;
+  MpscQueue<Op> queue_;
+  std::atomic<std::size_t> carried_{0}; // ops of a failed batch, retried
+  std::atomic<uint64_t> next_id_;
+  std::atomic<bool> stopping_{false};
+  std::mutex stop_mutex_; // only for the writer's timed sleeps
+  std::condition_variable stop_cv_;
+
+  prometheus::Histogram *flush_duration_hist_ = nullptr;
+  prometheus::Gauge *backlog_gauge_ = nullptr;
+  prometheus::Counter *dropped_buffer_full_counter_ = nullptr;
+  prometheus::Counter *dropped_write_failed_counter_ = nullptr;
+
+  std::thread thread_;
+};
+
+} // namespace sentinel::risk
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "sentinel/events/utils/uint256.hpp"
+
 #include <array>
 #include <cstdint>
 #include <functional>
@@ -10,7 +12,7 @@ struct BridgeRuleConfig {
     uint64_t customer_id;
     uint64_t chain_id;
     std::array<uint8_t, 20> token_address;
-    std::array<uint8_t, 32> threshold_be;
+    sentinel::events::utils::uint256 threshold;
     bool enabled;
 };
 
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace sentinel::metrics {
+struct Metrics;
+}
+
+namespace prometheus {
+class Counter;
+class Gauge;
+}
+
+namespace sentinel::risk {
+
+struct CheckpointWriterConfig {
+  std::chrono::milliseconds min_interval{1000}; // between two writes
+  std::chrono::milliseconds retry_backoff{5000};
+};
+
+// Where checkpoints are persisted; the checkpoints table in production.
+class ICheckpointSink {
+public:
+  virtual ~ICheckpointSink() = default;
+  // Records that every block up to and including `last_block` has been
+  // processed. Throws on failure.
+  virtual void save(uint64_t last_block) = 0;
+};
+
+// Persists the highest fully processed block from a thread of its own.
+// advance() only raises an atomic, so the dispatcher and delivery threads
+// that settle checkpoint barriers never wait on the database. The writer
+// saves the latest value at most once per min_interval, skipping values
+// overtaken in between.
+class CheckpointWriter {
+public:
+  CheckpointWriter(std::unique_ptr<ICheckpointSink> sink, uint64_t initial_block,
+                   CheckpointWriterConfig cfg = {}, std::string chain_name = "",
+                   sentinel::metrics::Metrics *metrics = nullptr);
+  // Saves the latest block if it is newer than the last one saved (one
+  // attempt), then stops.
+  ~CheckpointWriter();
+
+  CheckpointWriter(const CheckpointWriter &) = delete;
+  CheckpointWriter &operator=(const CheckpointWriter &) = delete;
+
+  // Thread-safe and lock-free. Lower values than the current one are
+  // ignored.
+  void advance(uint64_t block) noexcept;
+
+  uint64_t latest() const noexcept { return latest_.load(std::memory_order_relaxed); }
+  uint64_t persisted() const noexcept { return persisted_.load(std::memory_order_relaxed); }
+
+private:
+  void run_();
+  bool save_(uint64_t block);
+
+  std::unique_ptr<ICheckpointSink> sink_;
+  CheckpointWriterConfig cfg_;
+  std::atomic<uint64_t> latest_;
+  std::atomic<uint64_t> persisted_;
+  std::atomic<bool> stopping_{false};
+  std::mutex stop_mutex_; // only for the writer's timed sleeps
+  std::condition_variable stop_cv_;
+
+  prometheus::Gauge *block_gauge_ = nullptr;
+  prometheus::Counter *failures_counter_ = nullptr;
+
+  std::thread thread_;
+};
+
+} // namespace sentinel::risk
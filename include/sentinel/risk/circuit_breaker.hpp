@@ -0,0 +1,48 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace sentinel::risk {
+
+struct CircuitBreakerConfig {
+  std::size_t failure_threshold = 5; // consecutive failures that open it
+  std::chrono::milliseconds open_duration{30000};
+  std::size_t half_open_probes = 1;  // requests let through to test recovery
+};
+
+// Health of one endpoint. Closed lets everything through; Open rejects
+// until open_duration has passed, then HalfOpen admits a few probes whose
+// outcome closes or re-opens it. Times are passed in so tests control the
+// clock. Not thread-safe.
+class CircuitBreaker {
+public:
+  using Clock = std::chrono::steady_clock;
+  enum class State { Closed, Open, HalfOpen };
+
+  explicit CircuitBreaker(CircuitBreakerConfig cfg = {});
+
+  // Whether a request may go out now. In HalfOpen each `true` uses up a
+  // probe until its result is recorded.
+  bool allow(Clock::time_point now);
+
+  void record_success();
+  void record_failure(Clock::time_point now);
+
+  State state() const noexcept { return state_; }
+  // When an open breaker starts admitting probes.
+  Clock::time_point reopens_at() const noexcept { return opened_at_ + cfg_.open_duration; }
+
+private:
+  void open_(Clock::time_point now);
+
+  CircuitBreakerConfig cfg_;
+  State state_ = State::Closed;
+  std::size_t failures_ = 0;
+  std::size_t probes_ = 0; // in flight while HalfOpen
+  Clock::time_point opened_at_{};
+};
+
+const char *to_string(CircuitBreaker::State state) noexcept;
+
+} // namespace sentinel::risk
@@ -1,29 +1,27 @@
 #pragma once
 
+#include "address_hash.hpp"
 #include "signal.hpp"
+#include <array>
 #include <cstdint>
 #include <functional>
 #include <optional>
-#include <string>
 
 namespace sentinel::risk {
 
 struct GovernanceRuleConfig {
   uint64_t customer_id;
   uint64_t chain_id;
-  std::string contract_address;
+  std::array<uint8_t, 20> contract_address;
   bool enabled;
   std::optional<GovernanceAction> action_filter;
 };
 
 struct GovernanceContractKey {
   uint64_t chain_id;
-  std::string contract_address;
+  std::array<uint8_t, 20> contract_address;
 
-  bool operator==(const GovernanceContractKey &other) const {
-    return chain_id == other.chain_id &&
-           contract_address == other.contract_address;
-  }
+  bool operator==(const GovernanceContractKey &) const = default;
 };
 
 } // namespace sentinel::risk
@@ -31,7 +29,6 @@ struct GovernanceContractKey {
 template <> struct std::hash<sentinel::risk::GovernanceContractKey> {
   std::size_t
   operator()(const sentinel::risk::GovernanceContractKey &key) const {
-    return std::hash<uint64_t>()(key.chain_id) ^
-           (std::hash<std::string>()(key.contract_address) << 1);
+    return sentinel::risk::hash_address_key(key.chain_id, key.contract_address);
   }
 };
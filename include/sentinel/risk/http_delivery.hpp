@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sentinel/risk/circuit_breaker.hpp"
+
+namespace sentinel::metrics {
+struct Metrics;
+}
+
+namespace sentinel::risk {
+
+// Failed requests (transport errors, 408, 429, 5xx) are tried again after
+// an exponential backoff, half of it randomized so retries to one endpoint
+// spread out.
+struct RetryPolicy {
+  std::size_t max_attempts = 4; // including the first; 1 disables retries
+  std::chrono::milliseconds initial_backoff{500};
+  std::chrono::milliseconds max_backoff{30000};
+};
+
+struct HttpDeliveryConfig {
+  std::size_t max_per_endpoint = 4;  // requests in flight to one endpoint
+  long max_host_connections = 8;     // CURLMOPT_MAX_HOST_CONNECTIONS
+  long max_total_connections = 64;   // CURLMOPT_MAX_TOTAL_CONNECTIONS
+  std::chrono::milliseconds connect_timeout{5000};
+  std::chrono::milliseconds timeout{10000};
+  RetryPolicy retry{};
+  CircuitBreakerConfig breaker{}; // one breaker per endpoint
+};
+
+struct HttpRequest {
+  std::string endpoint; // concurrency-limit key; the URL when empty
+  std::string url;
+  std::string body;     // POSTed as is
+  std::vector<std::string> headers; // "Name: value"
+  std::string channel;  // metrics label, e.g. "webhook"
+};
+
+struct HttpResponse {
+  bool ok = false;   // transfer completed with a 2xx status
+  long status = 0;   // 0 when no HTTP response arrived
+  std::string error; // curl error text when status == 0
+  std::string body;
+};
+
+// Runs HTTP POSTs concurrently on one thread with a curl multi handle.
+// Connections live in the multi handle's cache and are reused per host;
+// easy handles are pooled. Requests beyond max_per_endpoint wait in that
+// endpoint's FIFO, so a slow endpoint only delays its own traffic.
+//
+// Each endpoint also has a circuit breaker: once it opens, requests fail
+// without touching the network until a half-open probe succeeds. Failures
+// are retried per cfg.retry from a timer wheel on the loop thread, so the
+// callback only sees the outcome of the last attempt.
+class HttpDeliveryLoop {
+public:
+  using Callback = std::function<void(HttpResponse)>;
+
+  // `metrics` (optional) receives per-channel breaker and retry metrics.
+  explicit HttpDeliveryLoop(HttpDeliveryConfig cfg = {},
+                            sentinel::metrics::Metrics *metrics = nullptr);
+  // Requests still waiting for an endpoint slot complete with an error;
+  // those already in flight finish (bounded by the timeouts).
+  ~HttpDeliveryLoop();
+
+  HttpDeliveryLoop(const HttpDeliveryLoop &) = delete;
+  HttpDeliveryLoop &operator=(const HttpDeliveryLoop &) = delete;
+
+  // Thread-safe. `done` runs exactly once, on the loop thread, and must not
+  // block; it may submit() again.
+  void submit(HttpRequest request, Callback done);
+
+  // Thread-safe. Runs `fn` on the loop thread once `delay` has passed.
+  // Timers still pending when the loop is destroyed are dropped.
+  void schedule(std::chrono::milliseconds delay, std::function<void()> fn);
+
+  // Thread-safe. Completes every request waiting for a retry with its last
+  // failure and stops scheduling new retries. Used at shutdown so draining
+  // the alert queue is not held up by backoff delays.
+  void abandon_retries();
+
+  // Submitted requests whose callback has not run yet, including those
+  // waiting for a retry.
+  std::size_t pending() const noexcept {
+    return pending_.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct Submission {
+    HttpRequest request;
+    Callback done;
+    std::size_t attempts = 0;
+  };
+  struct Timer {
+    std::chrono::steady_clock::time_point due;
+    std::function<void()> fn;
+  };
+  struct State; // curl handles, endpoint queues, timers; loop thread only
+
+  void run_();
+
+  HttpDeliveryConfig cfg_;
+  sentinel::metrics::Metrics *metrics_;
+  std::unique_ptr<State> state_;
+
+  std::mutex incoming_mutex_;
+  std::vector<Submission> incoming_;
+  std::vector<Timer> incoming_timers_;
+  std::atomic<bool> stopping_{false};
+  std::atomic<bool> retries_abandoned_{false};
+  std::atomic<std::size_t> pending_{0};
+
+  std::thread thread_;
+};
+
+} // namespace sentinel::risk
@@ -1,30 +1,28 @@
 #pragma once
 
+#include "address_hash.hpp"
 #include "signal.hpp"
+#include "sentinel/events/utils/uint256.hpp"
 #include <array>
 #include <cstdint>
 #include <functional>
-#include <string>
 
 namespace sentinel::risk {
 
 struct MintBurnRuleConfig {
   uint64_t customer_id;
   uint64_t chain_id;
-  std::string contract_address;
-  std::array<uint8_t, 32> mint_threshold_be;
-  std::array<uint8_t, 32> burn_threshold_be;
+  std::array<uint8_t, 20> contract_address;
+  sentinel::events::utils::uint256 mint_threshold;
+  sentinel::events::utils::uint256 burn_threshold;
   bool enabled;
 };
 
 struct MintBurnContractKey {
   uint64_t chain_id;
-  std::string contract_address;
+  std::array<uint8_t, 20> contract_address;
 
-  bool operator==(const MintBurnContractKey &other) const {
-    return chain_id == other.chain_id &&
-           contract_address == other.contract_address;
-  }
+  bool operator==(const MintBurnContractKey &) const = default;
 };
 
 } // namespace sentinel::risk
@@ -32,7 +30,6 @@ struct MintBurnContractKey {
 template <> struct std::hash<sentinel::risk::MintBurnContractKey> {
   std::size_t
   operator()(const sentinel::risk::MintBurnContractKey &key) const {
-    return std::hash<uint64_t>()(key.chain_id) ^
-           (std::hash<std::string>()(key.contract_address) << 1);
+    return sentinel::risk::hash_address_key(key.chain_id, key.contract_address);
   }
 };
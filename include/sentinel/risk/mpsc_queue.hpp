@@ -0,0 +1,164 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace sentinel::risk {
+
+// Lets one consumer sleep until a producer signals, without a mutex on the
+// producer side. notify() is a fence and a load unless the consumer is
+// actually parked; parking is a futex wait on Linux.
+class EventCount {
+public:
+  // Blocks until notify(), the timeout, or `ready()` holding. `ready` is
+  // re-checked after the wait is announced, so a notify() racing with the
+  // caller's last emptiness check is never lost.
+  template <typename Ready>
+  void wait_for(std::chrono::milliseconds timeout, Ready &&ready) {
+    const uint32_t key = epoch_.load(std::memory_order_acquire);
+    waiting_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!ready()) {
+      park_(key, timeout);
+    }
+    waiting_.store(false, std::memory_order_relaxed);
+  }
+
+  void notify() noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting_.load(std::memory_order_relaxed)) {
+      epoch_.fetch_add(1, std::memory_order_release);
+      wake_();
+    }
+  }
+
+private:
+  void park_(uint32_t key, std::chrono::milliseconds timeout);
+  void wake_() noexcept;
+
+  std::atomic<uint32_t> epoch_{0};
+  std::atomic<bool> waiting_{false};
+};
+
+// Bounded lock-free multi-producer / single-consumer queue. Each cell
+// carries a sequence number (Vyukov's bounded queue): producers claim a
+// slot with one CAS on the tail and publish it with a release store; the
+// consumer never writes shared state other than the cell it frees.
+template <typename T> class MpscQueue {
+public:
+  // Capacity is rounded up to a power of two.
+  explicit MpscQueue(std::size_t capacity)
+      : mask_(round_up_(capacity) - 1), cells_(new Cell[mask_ + 1]) {
+    for (std::size_t i = 0; i <= mask_; ++i) {
+      cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpscQueue(const MpscQueue &) = delete;
+  MpscQueue &operator=(const MpscQueue &) = delete;
+
+  std::size_t capacity() const noexcept { return mask_ + 1; }
+
+  // Any thread. Returns false, leaving `value` untouched, when full.
+  bool try_push(T &&value) {
+    std::size_t pos = tail_.load(std::memory_order_relaxed);
+    Cell *cell;
+    for (;;) {
+      cell = &cells_[pos & mask_];
+      const std::size_t seq = cell->seq.load(std::memory_order_acquire);
+      const auto dif = static_cast<std::ptrdiff_t>(seq - pos);
+      if (dif == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (dif < 0) {
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value.emplace(std::move(value));
+    cell->seq.store(pos + 1, std::memory_order_release);
+    ready_.notify();
+    return true;
+  }
+
+  // Consumer only. Moves up to `max` items onto the end of `out`.
+  std::size_t pop_batch(std::vector<T> &out, std::size_t max) {
+    std::size_t head = head_.load(std::memory_order_relaxed);
+    std::size_t n = 0;
+    for (; n < max; ++n, ++head) {
+      Cell &cell = cells_[head & mask_];
+      if (cell.seq.load(std::memory_order_acquire) != head + 1) {
+        break;
+      }
+      out.push_back(std::move(*cell.value));
+      cell.value.reset();
+      cell.seq.store(head + mask_ + 1, std::memory_order_release);
+    }
+    head_.store(head, std::memory_order_relaxed);
+    return n;
+  }
+
+  // Consumer only.
+  bool empty() const noexcept {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    return cells_[head & mask_].seq.load(std::memory_order_acquire) != head + 1;
+  }
+
+  // Approximate from any thread; exact from the consumer when producers
+  // are idle.
+  std::size_t size() const noexcept {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    return tail > head ? tail - head : 0;
+  }
+
+  // Consumer only: sleeps until an item is pushed, `wake_early()` holds or
+  // the timeout passes. Pair a change to what `wake_early` reads with
+  // notify(). Yields a few times before parking, so producers pushing
+  // back-to-back don't each pay for a futex wake.
+  template <typename Pred>
+  void wait_for(std::chrono::milliseconds timeout, Pred &&wake_early) {
+    auto ready = [&] { return !empty() || wake_early(); };
+    for (int i = 0; i < kSpinYields; ++i) {
+      if (ready()) {
+        return;
+      }
+      std::this_thread::yield();
+    }
+    ready_.wait_for(timeout, ready);
+  }
+
+  void notify() noexcept { ready_.notify(); }
+
+private:
+  static constexpr int kSpinYields = 16;
+
+  struct Cell {
+    std::atomic<std::size_t> seq;
+    std::optional<T> value;
+  };
+
+  static std::size_t round_up_(std::size_t n) {
+    std::size_t p = 2;
+    while (p < n) {
+      p <<= 1;
+    }
+    return p;
+  }
+
+  const std::size_t mask_;
+  std::unique_ptr<Cell[]> cells_;
+  alignas(64) std::atomic<std::size_t> tail_{0};
+  alignas(64) std::atomic<std::size_t> head_{0};
+  EventCount ready_;
+};
+
+} // namespace sentinel::risk
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace sentinel::risk {
+
+// Quiescent-state based reclamation for data read on the rule evaluation
+// threads and replaced from elsewhere (rule config snapshots).
+//
+// Each reader thread registers a slot and calls quiescent() at points where
+// it holds no pointer obtained from an RcuCell, i.e. between signals. That
+// is one load and, only after a publish, one store: readers never lock,
+// wait or write shared cache lines. A writer that replaces a value retires
+// the old one; it is destroyed once every registered reader has passed a
+// quiescent point after the replacement. Threads that are not registered
+// must not read cells while they are being published.
+class RcuDomain {
+public:
+  static constexpr std::size_t kMaxReaders = 64;
+
+  RcuDomain();
+  // Destroys everything still retired; no reader may be registered.
+  ~RcuDomain();
+
+  RcuDomain(const RcuDomain &) = delete;
+  RcuDomain &operator=(const RcuDomain &) = delete;
+
+  // Returns the reader's slot. Throws std::runtime_error if all slots are
+  // taken.
+  std::size_t register_reader();
+  void unregister_reader(std::size_t slot) noexcept;
+
+  // The calling reader holds no pointer read from a cell.
+  void quiescent(std::size_t slot) noexcept {
+    const uint64_t epoch = epoch_.load(std::memory_order_acquire);
+    auto &seen = slots_[slot].seen;
+    if (seen.load(std::memory_order_relaxed) != epoch) {
+      seen.store(epoch, std::memory_order_release);
+    }
+  }
+
+  // Hands over a replaced value; `destroy` runs once no reader can still
+  // see it, on whichever thread calls retire() or collect() then.
+  void retire(std::function<void()> destroy);
+  // Destroys what has become unreachable; returns how many values that was.
+  std::size_t collect();
+  // Values retired and not yet destroyed.
+  std::size_t pending() const;
+
+private:
+  static constexpr uint64_t kIdle = UINT64_MAX; // no reader in the slot
+
+  struct alignas(64) Slot {
+    std::atomic<uint64_t> seen{kIdle};
+    std::atomic<bool> taken{false};
+  };
+  struct Retired {
+    uint64_t epoch;
+    std::function<void()> destroy;
+  };
+
+  std::atomic<uint64_t> epoch_{1};
+  std::array<Slot, kMaxReaders> slots_;
+
+  mutable std::mutex retired_mutex_; // writers only
+  std::vector<Retired> retired_;
+};
+
+// An immutable T that readers load without synchronisation and a single
+// writer replaces as a whole. read() is valid until the reader's next
+// RcuDomain::quiescent() call.
+template <typename T> class RcuCell {
+public:
+  explicit RcuCell(std::unique_ptr<const T> initial) : value_(initial.release()) {}
+  ~RcuCell() { delete value_.load(std::memory_order_relaxed); }
+
+  RcuCell(const RcuCell &) = delete;
+  RcuCell &operator=(const RcuCell &) = delete;
+
+  const T &read() const noexcept { return *value_.load(std::memory_order_acquire); }
+
+  // Writers must not call publish() concurrently with each other.
+  void publish(std::unique_ptr<const T> next, RcuDomain &domain) {
+    const T *old = value_.exchange(next.release(), std::memory_order_seq_cst);
+    generation_.fetch_add(1, std::memory_order_relaxed);
+    domain.retire([old] { delete old; });
+  }
+
+  // Number of publish() calls so far.
+  uint64_t generation() const noexcept { return generation_.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<const T *> value_;
+  std::atomic<uint64_t> generation_{0};
+};
+
+} // namespace sentinel::risk
@@ -1,12 +1,16 @@
 #pragma once
 
 #include "alert_dispatcher.hpp"
+#include "rcu.hpp"
 #include "rule_interface.hpp"
 #include "signal.hpp"
 
 #include <array>
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <unordered_map>
@@ -25,26 +29,84 @@ class Gauge;
 
 namespace sentinel::risk {
 
+struct RiskEngineConfig {
+  // Rule evaluation threads. With 1 the rules run on the run() thread. With
+  // more, run() only partitions: each signal is handed to the worker that
+  // owns its (chain_id, contract) key.
+  unsigned workers = 1;
+  // Slots in each worker's SPSC ring.
+  std::size_t shard_queue_capacity = 8192;
+  // Domain of the rule config snapshots that may be replaced while the
+  // engine runs. Every evaluating thread registers as a reader and reports
+  // a quiescent state between signals. Null when configs never change.
+  RcuDomain *rcu = nullptr;
+};
+
+// Hash of the (chain_id, contract) pair a signal is about: the token for
+// transfers, approvals and mints/burns, the governed contract, the oracle
+// aggregator or the emitting address of a generic log. 0 for signals that
+// carry no contract.
+uint64_t partition_key(const Signal &signal);
+
+// Evaluates the registered rules on every signal from the input ring and
+// forwards their alerts to the dispatcher.
+//
+// Sharded mode (workers > 1): signals with the same partition_key() always go
+// to the same worker, in input order. Rules may therefore keep per-contract
+// state without locks, as long as each entry is created before run() starts
+// or published with the rule's config (see OracleUpdateRule). Alerts from
+// different contracts can reach the dispatcher out of input order.
+//
+// Checkpoint barriers (ControlSignal::Command::Sync) are passed on to
+// AlertDispatcher::checkpoint() once every signal before them has been
+// evaluated; in sharded mode, once every worker has reached the barrier.
 class RiskEngine {
 public:
   explicit RiskEngine(RingBuffer<Signal> &input_queue,
                       AlertDispatcher &dispatcher,
                       std::string chain_name,
                       sentinel::metrics::Metrics* metrics = nullptr,
-                      sentinel::health::Heartbeat* heartbeat = nullptr);
+                      sentinel::health::Heartbeat* heartbeat = nullptr,
+                      RiskEngineConfig cfg = {});
   ~RiskEngine();
 
   // Prevent copy/move
   RiskEngine(const RiskEngine &) = delete;
   RiskEngine &operator=(const RiskEngine &) = delete;
 
+  // Must be called before run().
   void register_rule(IRiskRule *rule);
 
   void run(std::stop_token st = {});
   void stop();
   bool is_finished() const { return finished_.load(std::memory_order_acquire); }
 
+  std::size_t worker_count() const { return shards_.empty() ? 1 : shards_.size(); }
+
 private:
+  struct Shard {
+    explicit Shard(std::size_t capacity) : queue(capacity) {}
+
+    RingBuffer<Signal> queue;
+    StateStore state_store;
+    prometheus::Gauge *depth_gauge = nullptr;
+    prometheus::Counter *signals_counter = nullptr;
+    prometheus::Counter *busy_seconds_counter = nullptr;
+    uint64_t synced_block = 0; // last barrier passed; guarded by sync_mutex_
+  };
+
+  void run_single_(std::stop_token st);
+  void run_sharded_(std::stop_token st);
+  void run_shard_(Shard &shard);
+  // Blocks while the worker's ring is full; false if the engine was stopped.
+  bool push_to_shard_(Shard &shard, Signal &&signal);
+  // A worker has passed the barrier for `block`; forwards the lowest block
+  // all workers have passed.
+  void shard_synced_(Shard &shard, uint64_t block);
+  // Runs the rules subscribed to signal.type and dispatches their alerts.
+  void evaluate_(const Signal &signal, StateStore &state_store,
+                 std::vector<Alert> &alerts);
+
   RingBuffer<Signal> &input_queue_;
   AlertDispatcher &dispatcher_;
   StateStore state_store_;
@@ -58,7 +120,14 @@ private:
   sentinel::metrics::Metrics* metrics_;
   sentinel::health::Heartbeat* heartbeat_ = nullptr;
   prometheus::Gauge* ring_buffer_depth_gauge_ = nullptr;
-  
+  RcuDomain* rcu_ = nullptr;
+
+  // Empty in single-threaded mode.
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::mutex sync_mutex_;
+  uint64_t forwarded_block_ = 0; // guarded by sync_mutex_
+
+  // Read concurrently by the workers; only written by register_rule().
   std::unordered_map<std::string, prometheus::Counter*> alerts_generated_counters_;
 };
 
@@ -2,6 +2,7 @@
 
 #include "sentinel/risk/alert_dispatcher.hpp"
 #include "sentinel/risk/bridge_config.hpp"
+#include "sentinel/risk/rcu.hpp"
 #include "sentinel/risk/rule_interface.hpp"
 
 #include <string>
@@ -13,10 +14,21 @@ namespace sentinel::risk {
 
 class BridgeTransferRule : public IRiskRule {
 public:
+    // The bridge contract registry and the customer rules, replaced together.
+    struct Config {
+        std::unordered_map<BridgeRuleKey, std::vector<BridgeRuleConfig>> configs_by_key;
+        std::unordered_set<BridgeAddressKey> bridge_addresses;
+        std::unordered_map<BridgeAddressKey, std::string> bridge_names;
+    };
+
     BridgeTransferRule(
         std::unordered_map<BridgeRuleKey, std::vector<BridgeRuleConfig>> configs_by_key,
-        const std::unordered_set<BridgeAddressKey>& bridge_addresses,
-        const std::unordered_map<BridgeAddressKey, std::string>& bridge_names);
+        std::unordered_set<BridgeAddressKey> bridge_addresses,
+        std::unordered_map<BridgeAddressKey, std::string> bridge_names);
+
+    // Swaps in a new registry and rule set while the engine runs; see RcuCell.
+    void reload(Config config, RcuDomain& rcu);
+    uint64_t config_generation() const { return config_.generation(); }
 
     SignalMask interests() const override;
     std::string_view rule_type_name() const override;
@@ -26,9 +38,7 @@ public:
                   std::vector<Alert>& out) override;
 
 private:
-    std::unordered_map<BridgeRuleKey, std::vector<BridgeRuleConfig>> configs_by_key_;
-    const std::unordered_set<BridgeAddressKey>& bridge_addresses_;
-    const std::unordered_map<BridgeAddressKey, std::string>& bridge_names_;
+    RcuCell<Config> config_;
 };
 
 } // namespace sentinel::risk
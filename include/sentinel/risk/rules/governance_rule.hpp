@@ -3,6 +3,7 @@
 #include "sentinel/risk/rule_interface.hpp"
 #include "sentinel/risk/governance_config.hpp"
 #include "sentinel/risk/alert_dispatcher.hpp"
+#include "sentinel/risk/rcu.hpp"
 
 #include <unordered_map>
 #include <vector>
@@ -11,9 +12,14 @@ namespace sentinel::risk {
 
 class GovernanceRule : public IRiskRule {
 public:
-  explicit GovernanceRule(
-      const std::unordered_map<GovernanceContractKey,
-                               std::vector<GovernanceRuleConfig>> &config_map);
+  using ConfigMap =
+      std::unordered_map<GovernanceContractKey, std::vector<GovernanceRuleConfig>>;
+
+  explicit GovernanceRule(ConfigMap config_map);
+
+  // Swaps in a new config map while the engine runs; see RcuCell.
+  void reload(ConfigMap config_map, RcuDomain &rcu);
+  uint64_t config_generation() const { return config_map_.generation(); }
 
   SignalMask interests() const override;
   std::string_view rule_type_name() const override;
@@ -22,9 +28,7 @@ public:
                 std::vector<Alert> &out) override;
 
 private:
-  // Store a const reference to the app's loaded config map.
-  const std::unordered_map<GovernanceContractKey,
-                           std::vector<GovernanceRuleConfig>> &config_map_;
+  RcuCell<ConfigMap> config_map_;
 };
 
 } // namespace sentinel::risk
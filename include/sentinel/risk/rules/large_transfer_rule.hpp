@@ -1,13 +1,19 @@
 #pragma once
 
-#include "sentinel/events/utils/hex.hpp"
+#include "sentinel/events/utils/uint256.hpp"
 #include "sentinel/log.hpp"
+#include "sentinel/risk/address_hash.hpp"
 #include "sentinel/risk/alert_dispatcher.hpp"
+#include "sentinel/risk/rcu.hpp"
 #include "sentinel/risk/rule_interface.hpp"
 
 #include <array>
-#include <cstring>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace sentinel::risk {
 
@@ -15,14 +21,38 @@ struct LargeTransferRuleConfig {
   uint64_t customer_id;
   uint64_t chain_id;
   std::array<uint8_t, 20> token_address;
-  std::array<uint8_t, 32> threshold_be;
+  sentinel::events::utils::uint256 threshold;
 };
 
+struct LargeTransferTokenKey {
+  uint64_t chain_id;
+  std::array<uint8_t, 20> token_address;
+
+  bool operator==(const LargeTransferTokenKey &) const = default;
+};
+
+} // namespace sentinel::risk
+
+template <> struct std::hash<sentinel::risk::LargeTransferTokenKey> {
+  std::size_t operator()(const sentinel::risk::LargeTransferTokenKey &k) const {
+    return sentinel::risk::hash_address_key(k.chain_id, k.token_address);
+  }
+};
+
+namespace sentinel::risk {
+
+// Alerts when a Transfer's amount is strictly above a customer's threshold
+// for that token. Configs are bucketed by (chain_id, token) with thresholds
+// sorted ascending, so a transfer costs one hash lookup plus a binary search;
+// every config before the search point has been exceeded.
 class LargeTransferRule : public IRiskRule {
 public:
-  LargeTransferRule(std::vector<LargeTransferRuleConfig> configs)
-      : configs_(std::move(configs)),
-        log_(sentinel::logger(sentinel::LogComponent::Risk)) {}
+  explicit LargeTransferRule(std::vector<LargeTransferRuleConfig> configs);
+
+  // Rebuilds the buckets on the calling thread and swaps them in while the
+  // engine runs; see RcuCell.
+  void reload(std::vector<LargeTransferRuleConfig> configs, RcuDomain &rcu);
+  uint64_t config_generation() const { return buckets_.generation(); }
 
   SignalMask interests() const override {
     return make_mask(SignalType::Transfer);
@@ -31,61 +61,25 @@ public:
   std::string_view rule_type_name() const override { return "large_transfer"; }
 
   void evaluate(const Signal &signal, StateStore & /* state_store */,
-                std::vector<Alert> &out) override {
-    const auto *evm = std::get_if<EvmLogEvent>(&signal.payload);
-    if (!evm) {
-      return;
-    }
-
-    if (evm->removed || evm->topic_count < 3 || evm->data_size < 32 ||
-        evm->truncated) {
-      return;
-    }
-
-    // Match based on configs
-    for (const auto &config : configs_) {
-      if (evm->chain_id != config.chain_id) {
-        continue;
-      }
-
-      if (evm->address != config.token_address) {
-        continue;
-      }
-
-      if (sentinel::events::utils::greater_be_256(evm->data.data(),
-                                                  config.threshold_be.data())) {
-        if (log_.should_log(spdlog::level::debug)) {
-          std::string amount_dec =
-              sentinel::events::utils::uint256_be_to_decimal(evm->data.data());
-          log_.debug("[{}] Large transfer detected: amount={}, timestamp_ms={}",
-                     config.customer_id, amount_dec, signal.meta.timestamp_ms);
-        }
-
-        std::string amount_dec =
-            sentinel::events::utils::uint256_be_to_decimal(evm->data.data());
-
-        // Format token address back to 0x string
-        std::string token_addr_str = "0x";
-        for (uint8_t b : config.token_address) {
-          char buf[3];
-          std::snprintf(buf, sizeof(buf), "%02x", b);
-          token_addr_str += buf;
-        }
-
-        out.push_back(Alert{.customer_id = config.customer_id,
-                            .rule_type = "large_transfer",
-                            .message = "Large transfer detected",
-                            .timestamp_ms = signal.meta.timestamp_ms,
-                            .amount_decimal = amount_dec,
-                            .token_address = token_addr_str,
-                            .chain_id = config.chain_id});
-      }
-    }
-  }
+                std::vector<Alert> &out) override;
+
+  std::size_t bucket_count() const { return buckets_.read().size(); }
 
 private:
-  std::vector<LargeTransferRuleConfig> configs_;
+  struct Bucket {
+    std::string token_address_hex; // formatted once for alerts
+    // Parallel arrays, ascending by threshold
+    std::vector<sentinel::events::utils::uint256> thresholds;
+    std::vector<uint64_t> customer_ids;
+  };
+
+  using Buckets = std::unordered_map<LargeTransferTokenKey, Bucket>;
+
+  static std::unique_ptr<const Buckets>
+  build_buckets_(const std::vector<LargeTransferRuleConfig> &configs);
+
+  RcuCell<Buckets> buckets_;
   spdlog::logger &log_;
 };
 
-} // namespace sentinel::risk
\ No newline at end of file
+} // namespace sentinel::risk
@@ -3,6 +3,7 @@
 #include "sentinel/risk/rule_interface.hpp"
 #include "sentinel/risk/mint_burn_config.hpp"
 #include "sentinel/risk/alert_dispatcher.hpp"
+#include "sentinel/risk/rcu.hpp"
 
 #include <unordered_map>
 #include <vector>
@@ -11,9 +12,14 @@ namespace sentinel::risk {
 
 class MintBurnRule : public IRiskRule {
 public:
-  MintBurnRule(
-      const std::unordered_map<MintBurnContractKey,
-                               std::vector<MintBurnRuleConfig>> &config_map);
+  using ConfigMap =
+      std::unordered_map<MintBurnContractKey, std::vector<MintBurnRuleConfig>>;
+
+  explicit MintBurnRule(ConfigMap config_map);
+
+  // Swaps in a new config map while the engine runs; see RcuCell.
+  void reload(ConfigMap config_map, RcuDomain &rcu);
+  uint64_t config_generation() const { return config_map_.generation(); }
 
   SignalMask interests() const override;
   std::string_view rule_type_name() const override;
@@ -22,8 +28,7 @@ public:
                 std::vector<Alert> &out) override;
 
 private:
-  const std::unordered_map<MintBurnContractKey,
-                           std::vector<MintBurnRuleConfig>> &config_map_;
+  RcuCell<ConfigMap> config_map_;
 };
 
 } // namespace sentinel::risk
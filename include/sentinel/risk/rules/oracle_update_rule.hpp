@@ -1,9 +1,12 @@
 #pragma once
 
+#include "sentinel/events/utils/uint256.hpp"
 #include "sentinel/risk/alert_dispatcher.hpp"
 #include "sentinel/risk/oracle_config.hpp"
+#include "sentinel/risk/rcu.hpp"
 #include "sentinel/risk/rule_interface.hpp"
 
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -11,8 +14,15 @@ namespace sentinel::risk {
 
 class OracleUpdateRule : public IRiskRule {
 public:
-    explicit OracleUpdateRule(
-        std::unordered_map<OracleFeedKey, std::vector<OracleRuleConfig>> configs_by_feed);
+    using ConfigMap = std::unordered_map<OracleFeedKey, std::vector<OracleRuleConfig>>;
+
+    explicit OracleUpdateRule(ConfigMap configs_by_feed);
+
+    // Swaps in a new config map while the engine runs; see RcuCell. Feeds
+    // present before and after keep their last observation, so a reload
+    // does not cold-start their baselines.
+    void reload(ConfigMap configs_by_feed, RcuDomain& rcu);
+    uint64_t config_generation() const { return feeds_.generation(); }
 
     SignalMask interests() const override;
     std::string_view rule_type_name() const override;
@@ -23,15 +33,26 @@ public:
 
 private:
     struct LastObservation {
-        std::array<uint8_t, 32> answer;   // raw int256 big-endian
+        sentinel::events::utils::int256 answer;
         uint64_t updated_at;
+        bool seen = false;
+    };
+
+    // The last observation is created with the feed's config and shared by
+    // the snapshots that include the feed. evaluate() never inserts, and the
+    // RiskEngine routes every feed to a single worker, so no locking is
+    // required.
+    struct Feed {
+        std::vector<OracleRuleConfig> configs;
+        std::shared_ptr<LastObservation> last;
     };
+    using Feeds = std::unordered_map<OracleFeedKey, Feed>;
 
-    std::unordered_map<OracleFeedKey, std::vector<OracleRuleConfig>> configs_by_feed_;
+    // `previous` supplies the observations of feeds that stay configured.
+    static std::unique_ptr<const Feeds> build_feeds_(ConfigMap configs_by_feed,
+                                                     const Feeds* previous);
 
-    // Per-feed last observation. Only accessed from the RiskEngine thread,
-    // so no locking is required.
-    std::unordered_map<OracleFeedKey, LastObservation> last_by_feed_;
+    RcuCell<Feeds> feeds_;
 };
 
 } // namespace sentinel::risk
@@ -2,7 +2,7 @@
 
 #include <array>
 #include <cstdint>
-#include <optional>
+#include <memory>
 #include <variant>
 #include <vector>
 
@@ -36,24 +36,54 @@ constexpr std::size_t SignalTypeCount = 11;
 struct SignalMeta {
   uint64_t timestamp_ms;
   uint64_t internal_ingress_time_ms = 0;
-  std::optional<uint64_t> block_number;
-  std::optional<std::array<uint8_t, 32>> tx_hash;
-  bool is_final;
+  uint64_t block_number = 0;         // 0 if not from a block
+  std::array<uint8_t, 32> tx_hash{}; // all zero if not from a transaction
+  uint32_t log_index = 0; // position in the block; orders merged responses
   uint32_t source_id; // debug only, not used for routing
+  bool is_final;
 };
 
 // Payload Types (No virtual methods, POD-like)
+
+// Topics and data of a log that has no typed payload. Kept out of line so
+// Signal stays small; immutable and shared once the signal is built.
+struct EvmLogBody {
+  std::array<std::array<uint8_t, 32>, 4> topics;
+  std::array<uint8_t, 256> data;
+};
+
+// A log without a typed payload (Swap, LiquidityChange, Unknown, or a known
+// topic0 whose layout did not match). Fixed-size fields are inline.
 struct EvmLogEvent {
   uint64_t chain_id;
   uint32_t tx_index;
   uint32_t log_index;
-  bool removed;
   std::array<uint8_t, 20> address;
+  bool removed;
+  bool truncated;
   uint8_t topic_count;
-  std::array<std::array<uint8_t, 32>, 4> topics;
   uint32_t data_size;
-  std::array<uint8_t, 256> data;
-  bool truncated;
+  std::shared_ptr<const EvmLogBody> body;
+};
+
+// ERC-20 Transfer(from, to, value) with neither side zero.
+struct TransferEvent {
+  uint64_t chain_id;
+  std::array<uint8_t, 20> token_address;
+  std::array<uint8_t, 20> from;
+  std::array<uint8_t, 20> to;
+  std::array<uint8_t, 32> amount; // uint256 big-endian
+  bool removed;
+};
+
+// ERC-20 Approval(owner, spender, value).
+struct ApprovalEvent {
+  uint64_t chain_id;
+  std::array<uint8_t, 20> token_address;
+  std::array<uint8_t, 20> owner;
+  std::array<uint8_t, 20> spender;
+  std::array<uint8_t, 32> amount; // uint256 big-endian
+  bool removed;
 };
 
 struct PriceTick {
@@ -64,8 +94,11 @@ struct PoolSnapshot {
   uint64_t reserves[2]; // Example
 };
 
+// Stop drains the engine and ends it. Sync is a checkpoint barrier: every
+// signal of blocks up to and including `block` was pushed before it.
 struct ControlSignal {
   enum class Command { Stop, Sync } command;
+  uint64_t block = 0; // Sync only
 };
 
 enum class GovernanceAction : uint8_t {
@@ -91,12 +124,12 @@ enum class MintBurnDirection : uint8_t {
 };
 
 struct MintBurnEvent {
-  MintBurnDirection direction;
   uint64_t chain_id;
   std::array<uint8_t, 20> token_address;
   std::array<uint8_t, 32> amount;
   std::array<uint8_t, 20> from;
   std::array<uint8_t, 20> to;
+  MintBurnDirection direction;
 };
 
 struct OracleUpdateEvent {
@@ -110,14 +143,19 @@ struct OracleUpdateEvent {
 // Use std::variant, no inheritance
 using SignalPayload = std::variant<std::monostate, EvmLogEvent, PriceTick,
                                    PoolSnapshot, GovernanceEvent, ControlSignal,
-                                   MintBurnEvent, OracleUpdateEvent>;
+                                   MintBurnEvent, OracleUpdateEvent,
+                                   TransferEvent, ApprovalEvent>;
 
-struct Signal {
+// Every ring slot is three whole cache lines: type + meta in the first, the
+// typed payload in the other two. Variable-size log data lives in EvmLogBody.
+struct alignas(64) Signal {
   SignalType type;
   SignalMeta meta;
   SignalPayload payload;
 };
 
+static_assert(sizeof(Signal) <= 192, "Signal must stay within 3 cache lines");
+
 // Bitmask for checking rule interests
 using SignalMask = uint32_t;
 
@@ -1,7 +1,9 @@
 #pragma once
+#include <memory>
 #include <string>
 
 #include "sentinel/risk/alert_channel.hpp"
+#include "sentinel/risk/http_delivery.hpp"
 #include <unordered_map>
 
 namespace sentinel::risk {
@@ -11,10 +13,12 @@ public:
   TelegramAlertChannel(
       std::string bot_token, std::string chat_id,
       const std::unordered_map<std::uint64_t, std::string> *customer_map,
-      const std::unordered_map<TokenKey, std::string> *token_map);
+      const std::unordered_map<TokenKey, std::string> *token_map,
+      HttpDeliveryLoop *http = nullptr);
   ~TelegramAlertChannel() override;
 
   void send(const Alert &alert) override;
+  void send_async(const Alert &alert, DeliveryCallback done) override;
   std::string name() const override { return "telegram"; }
 
 private:
@@ -22,6 +26,8 @@ private:
   std::string chat_id_;
   const std::unordered_map<std::uint64_t, std::string> *customer_map_;
   const std::unordered_map<TokenKey, std::string> *token_map_;
+  std::unique_ptr<HttpDeliveryLoop> owned_http_;
+  HttpDeliveryLoop *http_;
 };
 
 } // namespace sentinel::risk
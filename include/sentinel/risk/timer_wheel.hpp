@@ -0,0 +1,52 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace sentinel::risk {
+
+// Hashed timing wheel: O(1) schedule, and expiry walks only the slots the
+// clock has passed. Timers fire at most one tick late and never early.
+// Timers further out than one rotation stay in their slot until their
+// round comes up. Not thread-safe.
+class TimerWheel {
+public:
+  using Clock = std::chrono::steady_clock;
+  using Callback = std::function<void()>;
+
+  explicit TimerWheel(std::chrono::milliseconds tick = std::chrono::milliseconds(10),
+                      std::size_t slots = 512, Clock::time_point start = Clock::now());
+
+  void schedule(Clock::time_point due, Callback fn);
+
+  // Removes and returns every timer due at or before `now`. The caller
+  // runs them, so callbacks may schedule() again.
+  std::vector<Callback> expire(Clock::time_point now);
+
+  // Start of the earliest tick holding a timer, looking one rotation
+  // ahead; a timer in a later round makes this an early estimate.
+  std::optional<Clock::time_point> next_due() const;
+
+  std::size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+private:
+  struct Entry {
+    uint64_t tick;
+    Callback fn;
+  };
+
+  uint64_t tick_of_(Clock::time_point t) const;
+
+  std::chrono::milliseconds tick_;
+  Clock::time_point start_;
+  std::vector<std::vector<Entry>> slots_;
+  uint64_t current_ = 0; // last tick expired
+  std::size_t size_ = 0;
+};
+
+} // namespace sentinel::risk
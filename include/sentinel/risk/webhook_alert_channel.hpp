@@ -1,32 +1,62 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "sentinel/risk/alert_channel.hpp"
+#include "sentinel/risk/http_delivery.hpp"
 
 namespace sentinel::risk {
 
 struct WebhookEndpoint {
     std::string url;
     std::string hmac_secret; // empty = skip signing (not recommended)
+
+    // Batching is opt-in: above 1, alerts for this endpoint are held until
+    // batch_max_items have accumulated or batch_max_delay has passed since
+    // the first, then POSTed together as one JSON array.
+    std::size_t batch_max_items = 1;
+    std::chrono::milliseconds batch_max_delay{0};
 };
 
+// JSON body POSTed for `alert`; it is signed byte for byte as returned.
+std::string webhook_payload(const Alert &alert);
+
+// X-Risk-Sentinel-Signature value ("sha256=<hex>") for `body` sent with
+// X-Risk-Sentinel-Timestamp `timestamp_ms_str`.
+std::string webhook_signature(const std::string &secret,
+                              const std::string &timestamp_ms_str,
+                              const std::string &body);
+
 class WebhookAlertChannel : public IAlertChannel {
 public:
+    // Requests go through `http`, which must outlive the channel; without
+    // one the channel runs its own.
     explicit WebhookAlertChannel(
         std::unordered_map<std::uint64_t, std::vector<WebhookEndpoint>>
-            customer_webhooks);
+            customer_webhooks,
+        HttpDeliveryLoop *http = nullptr);
+    // Sends any batches still being accumulated.
     ~WebhookAlertChannel() override;
 
     void send(const Alert &alert) override;
+    // Posts to every endpoint of the customer concurrently; `done` reports
+    // failure if any endpoint failed.
+    void send_async(const Alert &alert, DeliveryCallback done) override;
     std::string name() const override { return "webhook"; }
 
 private:
+    struct Batches; // per-endpoint accumulators; shared with flush timers
+
     std::unordered_map<std::uint64_t, std::vector<WebhookEndpoint>>
         customer_webhooks_;
+    std::unique_ptr<HttpDeliveryLoop> owned_http_;
+    HttpDeliveryLoop *http_;
+    std::shared_ptr<Batches> batches_;
 };
 
 } // namespace sentinel::risk
@@ -1,7 +1,16 @@
 #pragma once
 
 #include <nlohmann/json.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <unordered_map>
 
@@ -15,21 +24,98 @@ class Gauge;
 class Histogram;
 }
 
+// A response with an HTTP status other than 200. Callers that can act on the
+// status (a batch refused with a 4xx, say) catch this rather than parsing
+// the message.
+struct JsonRpcHttpError : std::runtime_error {
+    JsonRpcHttpError(long status, const std::string& what)
+        : std::runtime_error(what), status(status) {}
+    long status;
+};
+
+// Thread-safe JSON-RPC over HTTP(S). Curl easy handles are pooled and reused
+// so consecutive calls keep their TCP/TLS connection alive (HTTP/2 where the
+// server offers it, compressed responses negotiated); concurrent callers each
+// lease their own handle.
 class JsonRpcClient {
 public:
     explicit JsonRpcClient(std::string endpoint, std::string chain_name, sentinel::metrics::Metrics* metrics = nullptr);
+    ~JsonRpcClient();
+
+    JsonRpcClient(const JsonRpcClient&) = delete;
+    JsonRpcClient& operator=(const JsonRpcClient&) = delete;
+
+    struct BatchCall {
+        std::string method;
+        nlohmann::json params = nlohmann::json::array();
+    };
 
     nlohmann::json call(
         const std::string& method,
         const nlohmann::json& params = nlohmann::json::array()
     );
 
+    // Performs the request and hands the raw HTTP response body to `consume`
+    // without building a JSON DOM. The body buffer belongs to the pooled
+    // handle and is reused, so the view is only valid inside `consume`.
+    // JSON-RPC level errors must be detected by `consume`; anything it throws
+    // is counted as an RPC error and rethrown.
+    void call_raw(
+        const std::string& method,
+        const nlohmann::json& params,
+        const std::function<void(std::string_view)>& consume
+    );
+
+    // Sends `calls` as one JSON-RPC batch (request ids are the indices into
+    // `calls`) and hands the raw response array to `consume`, as call_raw()
+    // does. Servers may answer batch elements in any order; see
+    // sentinel::events::split_batch_response(). Metrics are recorded under
+    // method="batch".
+    void call_batch_raw(
+        const std::vector<BatchCall>& calls,
+        const std::function<void(std::string_view)>& consume
+    );
+
+    // Runs once, on the calling thread, after the first call that succeeds.
+    // Must be set before the client is shared with other threads.
+    void set_first_success_callback(std::function<void()> callback);
+
 private:
+    struct PooledHandle;
+    struct CurlShared;
+    class HandleLease;
+
+    // Idle handles kept for reuse; extra concurrent callers get a fresh
+    // handle that is discarded on release.
+    static constexpr std::size_t kMaxIdleHandles = 4;
+
+    std::unique_ptr<PooledHandle> acquire_handle_(const std::string& method);
+    void release_handle_(std::unique_ptr<PooledHandle> handle);
+
+    // One HTTP round trip on `handle` posting `body`; the response lands in
+    // handle.response. Throws on transport errors, and JsonRpcHttpError on
+    // non-200 responses.
+    void perform_(const std::string& method, const std::string& body, PooledHandle& handle);
+    void consume_raw_(const std::string& method, const std::string& body,
+                      const std::function<void(std::string_view)>& consume);
+    void count_(const std::string& method, const char* status);
+    void record_success_(const std::string& method, std::chrono::steady_clock::time_point start_time);
+    void record_phases_(const std::string& method, PooledHandle& handle);
+
     std::string endpoint_;
     std::string chain_name_;
     sentinel::metrics::Metrics* metrics_;
 
+    std::function<void()> on_first_success_;
+    std::atomic<bool> succeeded_once_{false};
+
+    std::unique_ptr<CurlShared> shared_;
+    std::mutex pool_mutex_;
+    std::vector<std::unique_ptr<PooledHandle>> idle_handles_;
+
     prometheus::Gauge* last_rpc_success_gauge_ = nullptr;
     std::unordered_map<std::string, prometheus::Counter*> rpc_counters_;
     std::unordered_map<std::string, prometheus::Histogram*> rpc_histograms_;
+    // [0] = connect, [1] = transfer
+    std::unordered_map<std::string, std::array<prometheus::Histogram*, 2>> rpc_phase_histograms_;
 };
@@ -0,0 +1,186 @@
+#include <csignal>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include <pthread.h>
+#include <spdlog/spdlog.h>
+
+#include "mock_node.hpp"
+
+namespace {
+
+void print_usage(const char *prog) {
+  std::cerr
+      << "Usage: " << prog << " [options]\n"
+      << "\n"
+      << "  Mock EVM JSON-RPC node on http://<listen>/ and webhook sink on\n"
+      << "  http://<listen>/webhook/...; GET /stats for counters. Stops on SIGINT.\n"
+      << "\n"
+      << "  --listen <host:port>        default 127.0.0.1:8545\n"
+      << "  --threads <n>               HTTP worker threads (16)\n"
+      << "  --chain-id <id>             (42161)\n"
+      << "  --start-block <n>           head at startup (1000000)\n"
+      << "  --block-time-ms <ms>        0 = only POST /control/mine (250)\n"
+      << "  --logs-per-block <n>        (20)\n"
+      << "  --mix <kind=weight,...>     transfer, approval, oracle, governance (70,10,10,10)\n"
+      << "  --tokens <n>                token contracts (8)\n"
+      << "  --reorg-every <blocks>      automatic reorgs (off)\n"
+      << "  --reorg-depth <blocks>      (3)\n"
+      << "  --latency-ms <ms>           added to every RPC request (0)\n"
+      << "  --jitter-ms <ms>            uniform extra latency (0)\n"
+      << "  --slow-rate <p> --slow-ms <ms>  occasional slow requests (0, 1000)\n"
+      << "  --http-error-rate <p>       HTTP 503 (0)\n"
+      << "  --rpc-error-rate <p>        JSON-RPC internal error per call (0)\n"
+      << "  --too-many-rate <p>         eth_getLogs refused as too large (0)\n"
+      << "  --max-results <n>           real eth_getLogs result limit (10000)\n"
+      << "  --max-block-range <n>       eth_getLogs range limit (0 = none)\n"
+      << "  --no-batch                  reject JSON-RPC batches\n"
+      << "  --batch-reject-status <code>  HTTP status of that rejection (200)\n"
+      << "  --webhook-latency-ms <ms>   webhook sink response delay (0)\n"
+      << "  --webhook-error-rate <p>    webhook sink HTTP 500 (0)\n"
+      << "  --webhook-log <file>        CSV line per webhook delivery\n"
+      << "  --seed <n>                  chain and fault randomness (1)\n";
+}
+
+void parse_mix(const std::string &spec, sentinel::mock::EventMix &mix) {
+  std::istringstream in(spec);
+  std::string item;
+  while (std::getline(in, item, ',')) {
+    const auto eq = item.find('=');
+    if (eq == std::string::npos) {
+      throw std::invalid_argument(item);
+    }
+    const std::string kind = item.substr(0, eq);
+    const auto weight = static_cast<unsigned>(std::stoul(item.substr(eq + 1)));
+    if (kind == "transfer") {
+      mix.transfer = weight;
+    } else if (kind == "approval") {
+      mix.approval = weight;
+    } else if (kind == "oracle") {
+      mix.oracle = weight;
+    } else if (kind == "governance") {
+      mix.governance = weight;
+    } else {
+      throw std::invalid_argument(kind);
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  using std::chrono::milliseconds;
+
+  sentinel::mock::MockNodeConfig cfg;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg(argv[i]);
+    const bool has_value = i + 1 < argc;
+    try {
+      if (arg == "--listen" && has_value) {
+        const std::string listen = argv[++i];
+        const auto colon = listen.rfind(':');
+        if (colon == std::string::npos) {
+          throw std::invalid_argument(listen);
+        }
+        cfg.host = listen.substr(0, colon);
+        cfg.port = std::stoi(listen.substr(colon + 1));
+      } else if (arg == "--threads" && has_value) {
+        cfg.threads = static_cast<unsigned>(std::stoul(argv[++i]));
+      } else if (arg == "--chain-id" && has_value) {
+        cfg.chain.chain_id = std::stoull(argv[++i]);
+      } else if (arg == "--start-block" && has_value) {
+        cfg.chain.start_block = std::stoull(argv[++i]);
+      } else if (arg == "--block-time-ms" && has_value) {
+        cfg.chain.block_time = milliseconds(std::stoll(argv[++i]));
+      } else if (arg == "--logs-per-block" && has_value) {
+        cfg.chain.logs_per_block = static_cast<unsigned>(std::stoul(argv[++i]));
+      } else if (arg == "--mix" && has_value) {
+        parse_mix(argv[++i], cfg.chain.mix);
+      } else if (arg == "--tokens" && has_value) {
+        cfg.chain.tokens = static_cast<unsigned>(std::stoul(argv[++i]));
+      } else if (arg == "--reorg-every" && has_value) {
+        cfg.chain.reorg_every = std::stoull(argv[++i]);
+      } else if (arg == "--reorg-depth" && has_value) {
+        cfg.chain.reorg_depth = std::stoull(argv[++i]);
+      } else if (arg == "--latency-ms" && has_value) {
+        cfg.faults.latency = milliseconds(std::stoll(argv[++i]));
+      } else if (arg == "--jitter-ms" && has_value) {
+        cfg.faults.jitter = milliseconds(std::stoll(argv[++i]));
+      } else if (arg == "--slow-rate" && has_value) {
+        cfg.faults.slow_rate = std::stod(argv[++i]);
+      } else if (arg == "--slow-ms" && has_value) {
+        cfg.faults.slow_latency = milliseconds(std::stoll(argv[++i]));
+      } else if (arg == "--http-error-rate" && has_value) {
+        cfg.faults.http_error_rate = std::stod(argv[++i]);
+      } else if (arg == "--rpc-error-rate" && has_value) {
+        cfg.faults.rpc_error_rate = std::stod(argv[++i]);
+      } else if (arg == "--too-many-rate" && has_value) {
+        cfg.faults.too_many_results_rate = std::stod(argv[++i]);
+      } else if (arg == "--max-results" && has_value) {
+        cfg.faults.max_results = std::stoull(argv[++i]);
+      } else if (arg == "--max-block-range" && has_value) {
+        cfg.faults.max_block_range = std::stoull(argv[++i]);
+      } else if (arg == "--no-batch") {
+        cfg.faults.batch = false;
+      } else if (arg == "--batch-reject-status" && has_value) {
+        cfg.faults.batch_rejection_status = std::stoi(argv[++i]);
+      } else if (arg == "--webhook-latency-ms" && has_value) {
+        cfg.webhook.latency = milliseconds(std::stoll(argv[++i]));
+      } else if (arg == "--webhook-error-rate" && has_value) {
+        cfg.webhook.error_rate = std::stod(argv[++i]);
+      } else if (arg == "--webhook-log" && has_value) {
+        cfg.webhook.log_path = argv[++i];
+      } else if (arg == "--seed" && has_value) {
+        cfg.seed = cfg.chain.seed = std::stoull(argv[++i]);
+      } else if (arg == "--help" || arg == "-h") {
+        print_usage(argv[0]);
+        return 0;
+      } else {
+        std::cerr << "Error: unknown argument '" << arg << "'\n";
+        print_usage(argv[0]);
+        return 1;
+      }
+    } catch (const std::exception &) {
+      std::cerr << "Error: invalid value for " << arg << "\n";
+      return 1;
+    }
+  }
+
+  sigset_t set;
+  sigemptyset(&set);
+  sigaddset(&set, SIGINT);
+  sigaddset(&set, SIGTERM);
+  if (pthread_sigmask(SIG_BLOCK, &set, nullptr) != 0) {
+    return 1;
+  }
+
+  try {
+    sentinel::mock::MockNode node(cfg);
+    node.start();
+
+    auto &chain = node.chain();
+    spdlog::info("Mock node for chain {} on {} (head {})", cfg.chain.chain_id, node.url(),
+                 chain.head());
+    for (unsigned t = 0; t < chain.config().tokens; ++t) {
+      spdlog::info("  token     {}", chain.token_address(t));
+    }
+    for (unsigned o = 0; o < chain.config().oracles; ++o) {
+      spdlog::info("  oracle    {}", chain.oracle_address(o));
+    }
+    for (unsigned g = 0; g < chain.config().governed_contracts; ++g) {
+      spdlog::info("  governed  {}", chain.governed_address(g));
+    }
+    spdlog::info("Webhook sink: {}", node.url("/webhook/<any>"));
+
+    int sig = 0;
+    sigwait(&set, &sig);
+    node.stop();
+    std::cout << node.stats().dump(2) << std::endl;
+  } catch (const std::exception &e) {
+    std::cerr << "Error: " << e.what() << "\n";
+    return 2;
+  }
+  return 0;
+}
@@ -0,0 +1,298 @@
+#include "mock_chain.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "sentinel/events/utils/hex.hpp"
+#include "sentinel/events/utils/hex_codec.hpp"
+#include "sentinel/events/utils/keccak.hpp"
+
+namespace sentinel::mock {
+
+namespace {
+
+using sentinel::events::utils::bytes_to_hex;
+using sentinel::events::utils::keccak256;
+using sentinel::events::utils::to_hex_quantity;
+
+const std::string kTransfer = bytes_to_hex(keccak256("Transfer(address,address,uint256)"));
+const std::string kApproval = bytes_to_hex(keccak256("Approval(address,address,uint256)"));
+const std::string kAnswerUpdated =
+    bytes_to_hex(keccak256("AnswerUpdated(int256,uint256,uint256)"));
+const std::string kOwnershipTransferred =
+    bytes_to_hex(keccak256("OwnershipTransferred(address,address)"));
+const std::string kUpgraded = bytes_to_hex(keccak256("Upgraded(address)"));
+
+uint64_t splitmix(uint64_t &state) {
+  uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+uint64_t seed_for(uint64_t seed, uint64_t block, uint64_t fork, uint64_t item) {
+  uint64_t state = seed;
+  state ^= splitmix(state) + block;
+  state ^= splitmix(state) + (fork << 32) + item;
+  return state;
+}
+
+void append_hex(std::string &out, uint64_t value, int digits) {
+  static constexpr char kDigits[] = "0123456789abcdef";
+  for (int shift = (digits - 1) * 4; shift >= 0; shift -= 4) {
+    out.push_back(kDigits[(value >> shift) & 0xf]);
+  }
+}
+
+// A 32-byte word holding a random 20-byte address
+std::string random_address_word(uint64_t &rng) {
+  std::string word = "0x000000000000000000000000";
+  append_hex(word, splitmix(rng), 16);
+  append_hex(word, splitmix(rng), 16);
+  append_hex(word, splitmix(rng), 8);
+  return word;
+}
+
+std::string uint_word(uint64_t value) {
+  std::string word = "0x";
+  word.append(48, '0');
+  append_hex(word, value, 16);
+  return word;
+}
+
+// Log-uniform between ~10^11 and ~10^25 base units, so a spread of
+// thresholds each see a share of the transfers
+std::string amount_word(uint64_t &rng) {
+  const int digits = 10 + static_cast<int>(splitmix(rng) % 12);
+  std::string word = "0x";
+  word.append(64 - digits, '0');
+  uint64_t bits = splitmix(rng) | 1;
+  word.push_back("123456789abcdef"[bits % 15]);
+  for (int i = 1; i < digits; ++i) {
+    if (i % 16 == 0) {
+      bits = splitmix(rng);
+    }
+    word.push_back("0123456789abcdef"[(bits >> ((i % 16) * 4)) & 0xf]);
+  }
+  return word;
+}
+
+std::string hash_of(uint64_t seed, uint64_t block, uint64_t fork) {
+  uint64_t rng = seed_for(seed, block, fork, UINT64_MAX);
+  std::string hash = "0x";
+  for (int i = 0; i < 4; ++i) {
+    append_hex(hash, splitmix(rng), 16);
+  }
+  return hash;
+}
+
+std::string contract_address(unsigned kind, unsigned index) {
+  std::string address = "0x";
+  append_hex(address, kind, 2);
+  address.append(30, '0');
+  append_hex(address, index + 1, 8);
+  return address;
+}
+
+// Forks are numbered from 1 in the order they happened; the latest one
+// starting at or below `block` is the one it is on
+uint64_t fork_at(const std::vector<uint64_t> &forks, uint64_t block) {
+  for (std::size_t i = forks.size(); i > 0; --i) {
+    if (forks[i - 1] <= block) {
+      return i;
+    }
+  }
+  return 0;
+}
+
+template <typename T> bool matches(const std::vector<T> &allowed, const T &value) {
+  return allowed.empty() || std::find(allowed.begin(), allowed.end(), value) != allowed.end();
+}
+
+} // namespace
+
+MockChain::MockChain(ChainConfig config)
+  : config_(config),
+    started_(std::chrono::steady_clock::now()),
+    started_unix_ms_(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                               std::chrono::system_clock::now().time_since_epoch())
+                                               .count())),
+    head_(config.start_block) {
+  if (config_.start_block == 0) {
+    throw std::runtime_error("MockChain: start_block must be at least 1");
+  }
+  config_.tokens = std::max(config_.tokens, 1u);
+  config_.oracles = std::max(config_.oracles, 1u);
+  config_.governed_contracts = std::max(config_.governed_contracts, 1u);
+  config_.reorg_depth = std::max<uint64_t>(config_.reorg_depth, 1);
+  next_auto_reorg_ = config_.start_block + config_.reorg_every;
+}
+
+void MockChain::advance_() {
+  uint64_t head = config_.start_block + mined_;
+  if (config_.block_time.count() > 0) {
+    const auto elapsed = std::chrono::steady_clock::now() - started_;
+    head += static_cast<uint64_t>(elapsed / config_.block_time);
+  }
+  head_ = std::max(head_, head);
+
+  while (config_.reorg_every > 0 && head_ >= next_auto_reorg_) {
+    forks_.push_back(next_auto_reorg_ > config_.reorg_depth
+                         ? next_auto_reorg_ - config_.reorg_depth + 1
+                         : 1);
+    next_auto_reorg_ += config_.reorg_every;
+  }
+}
+
+uint64_t MockChain::head() {
+  std::lock_guard<std::mutex> lk(mu_);
+  advance_();
+  return head_;
+}
+
+void MockChain::mine(uint64_t blocks) {
+  std::lock_guard<std::mutex> lk(mu_);
+  mined_ += blocks;
+  advance_();
+}
+
+uint64_t MockChain::reorg(uint64_t depth) {
+  std::lock_guard<std::mutex> lk(mu_);
+  advance_();
+  depth = std::max<uint64_t>(depth, 1);
+  const uint64_t from = head_ > depth ? head_ - depth + 1 : 1;
+  forks_.push_back(from);
+  return from;
+}
+
+uint64_t MockChain::reorgs() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return forks_.size();
+}
+
+uint64_t MockChain::block_timestamp(uint64_t block) {
+  const int64_t interval_ms =
+      config_.block_time.count() > 0 ? static_cast<int64_t>(config_.block_time.count()) : 1000;
+  const int64_t offset_ms =
+      (static_cast<int64_t>(block) - static_cast<int64_t>(config_.start_block)) * interval_ms;
+  const int64_t ms = static_cast<int64_t>(started_unix_ms_) + offset_ms;
+  return ms > 0 ? static_cast<uint64_t>(ms) / 1000 : 0;
+}
+
+std::string MockChain::block_hash(uint64_t block) {
+  uint64_t fork;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    fork = fork_at(forks_, block);
+  }
+  return hash_of(config_.seed, block, fork);
+}
+
+std::string MockChain::token_address(unsigned index) const { return contract_address(0x10, index); }
+std::string MockChain::oracle_address(unsigned index) const { return contract_address(0x20, index); }
+std::string MockChain::governed_address(unsigned index) const {
+  return contract_address(0x30, index);
+}
+
+std::optional<std::size_t> MockChain::logs_json(const LogQuery &query, std::size_t max_results,
+                                                std::string &out) {
+  std::vector<uint64_t> forks;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    forks = forks_;
+  }
+
+  const EventMix &mix = config_.mix;
+  const uint64_t total = uint64_t{mix.transfer} + mix.approval + mix.oracle + mix.governance;
+  const std::size_t base = out.size();
+  std::size_t count = 0;
+  out.push_back('[');
+
+  for (uint64_t block = query.from_block; total > 0 && block <= query.to_block; ++block) {
+    const uint64_t fork = fork_at(forks, block);
+    const std::string block_number = to_hex_quantity(block);
+    std::string block_hash;
+
+    for (unsigned i = 0; i < config_.logs_per_block; ++i) {
+      uint64_t rng = seed_for(config_.seed, block, fork, i);
+      const uint64_t roll = splitmix(rng) % total;
+
+      std::string address;
+      std::vector<std::string> topics;
+      std::string data = "0x";
+      if (roll < mix.transfer) {
+        address = token_address(static_cast<unsigned>(splitmix(rng) % config_.tokens));
+        const bool mint = splitmix(rng) % 20 == 0;
+        topics = {kTransfer, mint ? uint_word(0) : random_address_word(rng),
+                  random_address_word(rng)};
+        data = amount_word(rng);
+      } else if (roll < uint64_t{mix.transfer} + mix.approval) {
+        address = token_address(static_cast<unsigned>(splitmix(rng) % config_.tokens));
+        topics = {kApproval, random_address_word(rng), random_address_word(rng)};
+        data = splitmix(rng) % 10 == 0 ? "0x" + std::string(64, 'f') : amount_word(rng);
+      } else if (roll < total - mix.governance) {
+        address = oracle_address(static_cast<unsigned>(splitmix(rng) % config_.oracles));
+        // ~2000.00000000 with 8 decimals, moving up to 0.5%, spiking 20% now and then
+        int64_t answer = 200'000'000'000 + static_cast<int64_t>(splitmix(rng) % 2'000'000'000) -
+                         1'000'000'000;
+        if (splitmix(rng) % 50 == 0) {
+          answer = answer * 6 / 5;
+        }
+        topics = {kAnswerUpdated, uint_word(static_cast<uint64_t>(answer)),
+                  uint_word(block * config_.logs_per_block + i)};
+        data = uint_word(block_timestamp(block));
+      } else {
+        address = governed_address(static_cast<unsigned>(splitmix(rng) % config_.governed_contracts));
+        if (splitmix(rng) % 2 == 0) {
+          topics = {kOwnershipTransferred, random_address_word(rng), random_address_word(rng)};
+        } else {
+          topics = {kUpgraded, random_address_word(rng)};
+        }
+      }
+
+      if (!matches(query.addresses, address) || !matches(query.topic0s, topics[0])) {
+        continue;
+      }
+      if (++count > max_results) {
+        out.resize(base);
+        return std::nullopt;
+      }
+
+      if (block_hash.empty()) {
+        block_hash = hash_of(config_.seed, block, fork);
+      }
+      if (count > 1) {
+        out.push_back(',');
+      }
+      out += R"({"address":")";
+      out += address;
+      out += R"(","topics":[)";
+      for (std::size_t t = 0; t < topics.size(); ++t) {
+        out += t == 0 ? "\"" : ",\"";
+        out += topics[t];
+        out.push_back('"');
+      }
+      out += R"(],"data":")";
+      out += data;
+      out += R"(","blockNumber":")";
+      out += block_number;
+      out += R"(","blockHash":")";
+      out += block_hash;
+      out += R"(","transactionHash":"0x)";
+      uint64_t tx = seed_for(config_.seed ^ 0x7478, block, fork, i);
+      for (int w = 0; w < 4; ++w) {
+        append_hex(out, splitmix(tx), 16);
+      }
+      out += R"(","transactionIndex":")";
+      out += to_hex_quantity(i);
+      out += R"(","logIndex":")";
+      out += to_hex_quantity(i);
+      out += R"(","removed":false})";
+    }
+  }
+
+  out.push_back(']');
+  return count;
+}
+
+} // namespace sentinel::mock
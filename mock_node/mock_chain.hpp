@@ -0,0 +1,96 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace sentinel::mock {
+
+struct EventMix {
+  unsigned transfer = 70;
+  unsigned approval = 10;
+  unsigned oracle = 10;
+  unsigned governance = 10;
+};
+
+struct ChainConfig {
+  uint64_t chain_id = 42161;
+  // Head when the node starts; every earlier block exists too
+  uint64_t start_block = 1'000'000;
+  // One block per interval; zero means blocks only appear through mine()
+  std::chrono::milliseconds block_time{250};
+  unsigned logs_per_block = 20;
+  EventMix mix{};
+  // Contracts the logs are spread over, per event kind
+  unsigned tokens = 8;
+  unsigned oracles = 2;
+  unsigned governed_contracts = 2;
+  // Every `reorg_every` new blocks, replace the last `reorg_depth`
+  // (0 = no automatic reorgs)
+  uint64_t reorg_every = 0;
+  uint64_t reorg_depth = 3;
+  uint64_t seed = 1;
+};
+
+// eth_getLogs filter, already lower-cased. Empty lists match anything.
+struct LogQuery {
+  uint64_t from_block = 0;
+  uint64_t to_block = 0;
+  std::vector<std::string> addresses;
+  std::vector<std::string> topic0s;
+};
+
+// A deterministic synthetic chain. A block's logs, hash and timestamp are a
+// function of the seed, the block number and the fork it is on, so nothing
+// is stored per block and any range can be served at any time. A reorg
+// starts a new fork at some block: from then on that block and every later
+// one get new hashes and different logs.
+class MockChain {
+public:
+  explicit MockChain(ChainConfig config);
+
+  const ChainConfig &config() const { return config_; }
+
+  // Advances with the wall clock (see ChainConfig::block_time) and applies
+  // the automatic reorgs that became due.
+  uint64_t head();
+  // Adds `blocks` to the head at once.
+  void mine(uint64_t blocks);
+  // Replaces the last `depth` blocks; returns the first replaced block.
+  uint64_t reorg(uint64_t depth);
+  uint64_t reorgs() const;
+
+  // Unix seconds; blocks before the start are back-dated one interval each.
+  uint64_t block_timestamp(uint64_t block);
+  std::string block_hash(uint64_t block);
+
+  // Appends the JSON array of logs matching `query` to `out`. Returns the
+  // number of logs, or std::nullopt (leaving `out` as it was) once more than
+  // `max_results` match, the way providers refuse oversized queries.
+  std::optional<std::size_t> logs_json(const LogQuery &query, std::size_t max_results,
+                                       std::string &out);
+
+  // Addresses the logs come from, "0x" + 40 lower-case hex digits
+  std::string token_address(unsigned index) const;
+  std::string oracle_address(unsigned index) const;
+  std::string governed_address(unsigned index) const;
+
+private:
+  void advance_(); // caller holds mu_
+
+  ChainConfig config_;
+  std::chrono::steady_clock::time_point started_;
+  uint64_t started_unix_ms_;
+
+  mutable std::mutex mu_;
+  uint64_t head_;
+  uint64_t mined_ = 0;           // blocks added through mine()
+  uint64_t next_auto_reorg_ = 0; // head that triggers the next one
+  std::vector<uint64_t> forks_;  // first block of each fork, in order
+};
+
+} // namespace sentinel::mock
@@ -0,0 +1,395 @@
+#include "mock_node.hpp"
+
+#include <httplib.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+#include <utility>
+
+#include "sentinel/events/utils/hex.hpp"
+
+namespace sentinel::mock {
+
+namespace {
+
+using nlohmann::json;
+using sentinel::events::utils::parse_hex_uint64;
+using sentinel::events::utils::to_hex_quantity;
+
+uint64_t now_unix_us() {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                   std::chrono::system_clock::now().time_since_epoch())
+                                   .count());
+}
+
+std::string result(const std::string &id, const std::string &raw) {
+  return R"({"jsonrpc":"2.0","id":)" + id + R"(,"result":)" + raw + "}";
+}
+
+std::string error(const std::string &id, int code, const std::string &message) {
+  return R"({"jsonrpc":"2.0","id":)" + id + R"(,"error":{"code":)" + std::to_string(code) +
+         R"(,"message":)" + json(message).dump() + "}}";
+}
+
+std::string quoted(const std::string &s) { return "\"" + s + "\""; }
+
+std::string lowercase(std::string s) {
+  std::transform(s.begin(), s.end(), s.begin(),
+                 [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  return s;
+}
+
+// A string or an array of strings, lower-cased; null and absent match anything
+std::vector<std::string> any_of(const json &value) {
+  std::vector<std::string> out;
+  if (value.is_string()) {
+    out.push_back(lowercase(value.get<std::string>()));
+  } else if (value.is_array()) {
+    for (const auto &v : value) {
+      out.push_back(lowercase(v.get<std::string>()));
+    }
+  }
+  return out;
+}
+
+json percentiles_ms(const sentinel::replay::LatencyHistogram &h) {
+  auto ms = [](uint64_t ns) { return static_cast<double>(ns) / 1e6; };
+  return {{"count", h.count()},
+          {"p50", ms(h.percentile(50))},
+          {"p90", ms(h.percentile(90))},
+          {"p99", ms(h.percentile(99))},
+          {"p999", ms(h.percentile(99.9))},
+          {"max", ms(h.max())}};
+}
+
+} // namespace
+
+MockNode::MockNode(MockNodeConfig config)
+  : config_(std::move(config)), chain_(config_.chain), rng_(config_.seed) {
+  if (!config_.webhook.log_path.empty()) {
+    webhook_log_.open(config_.webhook.log_path, std::ios::app);
+    if (!webhook_log_) {
+      throw std::runtime_error("MockNode: cannot open " + config_.webhook.log_path);
+    }
+    if (webhook_log_.tellp() == 0) {
+      webhook_log_ << "received_unix_us,path,status,bytes,alerts\n";
+    }
+  }
+}
+
+MockNode::~MockNode() { stop(); }
+
+std::string MockNode::url(const std::string &path) const {
+  return "http://" + config_.host + ":" + std::to_string(port_) + path;
+}
+
+bool MockNode::roll_(double rate) {
+  if (rate <= 0) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lk(rng_mu_);
+  return std::uniform_real_distribution<double>(0, 1)(rng_) < rate;
+}
+
+std::chrono::milliseconds MockNode::delay_() {
+  const FaultConfig &f = config_.faults;
+  auto delay = f.latency;
+  if (f.jitter.count() > 0) {
+    std::lock_guard<std::mutex> lk(rng_mu_);
+    delay += std::chrono::milliseconds(
+        std::uniform_int_distribution<int64_t>(0, f.jitter.count())(rng_));
+  }
+  if (roll_(f.slow_rate)) {
+    delay += f.slow_latency;
+    std::lock_guard<std::mutex> lk(stats_mu_);
+    ++slow_requests_;
+  }
+  return delay;
+}
+
+void MockNode::start() {
+  server_ = std::make_unique<httplib::Server>();
+  server_->new_task_queue = [n = std::max(config_.threads, 1u)] {
+    return new httplib::ThreadPool(n);
+  };
+
+  server_->Post("/", [this](const httplib::Request &req, httplib::Response &res) {
+    {
+      std::lock_guard<std::mutex> lk(stats_mu_);
+      ++requests_;
+    }
+    std::this_thread::sleep_for(delay_());
+    if (roll_(config_.faults.http_error_rate)) {
+      {
+        std::lock_guard<std::mutex> lk(stats_mu_);
+        ++injected_http_errors_;
+      }
+      res.status = 503;
+      res.set_content("mock: injected failure", "text/plain");
+      return;
+    }
+    int status = 200;
+    res.set_content(handle_rpc(req.body, &status), "application/json");
+    res.status = status;
+  });
+
+  server_->Post(R"(/webhook(/.*)?)", [this](const httplib::Request &req, httplib::Response &res) {
+    std::this_thread::sleep_for(config_.webhook.latency);
+    res.status = roll_(config_.webhook.error_rate) ? 500 : 200;
+    record_webhook_(req.path, req.body, req.get_header_value("X-Risk-Sentinel-Timestamp"),
+                    req.has_header("X-Risk-Sentinel-Signature"), res.status);
+  });
+
+  server_->Get("/stats", [this](const httplib::Request &, httplib::Response &res) {
+    res.set_content(stats().dump(2), "application/json");
+  });
+
+  server_->Post("/control/mine", [this](const httplib::Request &req, httplib::Response &res) {
+    const uint64_t blocks =
+        req.has_param("blocks") ? std::stoull(req.get_param_value("blocks")) : 1;
+    chain_.mine(blocks);
+    res.set_content(json{{"head", chain_.head()}}.dump(), "application/json");
+  });
+
+  server_->Post("/control/reorg", [this](const httplib::Request &req, httplib::Response &res) {
+    const uint64_t depth =
+        req.has_param("depth") ? std::stoull(req.get_param_value("depth")) : 1;
+    const uint64_t from = chain_.reorg(depth);
+    spdlog::info("MockNode: reorg from block {}", from);
+    res.set_content(json{{"from", from}, {"head", chain_.head()}}.dump(), "application/json");
+  });
+
+  if (config_.port == 0) {
+    port_ = server_->bind_to_any_port(config_.host);
+    if (port_ < 0) {
+      throw std::runtime_error("MockNode: cannot bind " + config_.host);
+    }
+  } else {
+    if (!server_->bind_to_port(config_.host, config_.port)) {
+      throw std::runtime_error("MockNode: cannot bind " + config_.host + ":" +
+                               std::to_string(config_.port));
+    }
+    port_ = config_.port;
+  }
+  server_thread_ = std::thread([this] { server_->listen_after_bind(); });
+}
+
+void MockNode::stop() {
+  if (server_) {
+    server_->stop();
+  }
+  if (server_thread_.joinable()) {
+    server_thread_.join();
+  }
+}
+
+std::string MockNode::handle_rpc(std::string_view body, int *http_status) {
+  if (http_status) {
+    *http_status = 200;
+  }
+  json request;
+  try {
+    request = json::parse(body);
+  } catch (const json::exception &) {
+    return error("null", -32700, "parse error");
+  }
+
+  if (!request.is_array()) {
+    return call_(request);
+  }
+  if (!config_.faults.batch) {
+    if (http_status) {
+      *http_status = config_.faults.batch_rejection_status;
+    }
+    return error("null", -32600, "batch requests are not supported");
+  }
+  std::string out = "[";
+  for (const auto &element : request) {
+    if (out.size() > 1) {
+      out.push_back(',');
+    }
+    out += call_(element);
+  }
+  out.push_back(']');
+  return out;
+}
+
+std::string MockNode::call_(const json &request) {
+  const std::string id = request.contains("id") ? request["id"].dump() : "null";
+  if (!request.is_object() || !request.contains("method") || !request["method"].is_string()) {
+    return error(id, -32600, "invalid request");
+  }
+  const std::string method = request["method"].get<std::string>();
+  const json params = request.value("params", json::array());
+  {
+    std::lock_guard<std::mutex> lk(stats_mu_);
+    ++calls_[method];
+  }
+
+  if (roll_(config_.faults.rpc_error_rate)) {
+    std::lock_guard<std::mutex> lk(stats_mu_);
+    ++injected_rpc_errors_;
+    return error(id, -32603, "mock: injected internal error");
+  }
+
+  try {
+    if (method == "eth_chainId") {
+      return result(id, quoted(to_hex_quantity(chain_.config().chain_id)));
+    }
+    if (method == "eth_blockNumber") {
+      return result(id, quoted(to_hex_quantity(chain_.head())));
+    }
+    if (method == "eth_getBlockByNumber") {
+      const std::string tag = params.at(0).get<std::string>();
+      const uint64_t head = chain_.head();
+      const uint64_t block = tag == "latest" ? head : parse_hex_uint64(tag);
+      if (block > head) {
+        return result(id, "null");
+      }
+      const json header{{"number", to_hex_quantity(block)},
+                        {"hash", chain_.block_hash(block)},
+                        {"parentHash", chain_.block_hash(block > 0 ? block - 1 : 0)},
+                        {"timestamp", to_hex_quantity(chain_.block_timestamp(block))},
+                        {"transactions", json::array()}};
+      return result(id, header.dump());
+    }
+    if (method == "eth_getLogs") {
+      return get_logs_(params, id);
+    }
+  } catch (const std::exception &e) {
+    return error(id, -32602, std::string("invalid params: ") + e.what());
+  }
+  return error(id, -32601, "the method " + method + " does not exist/is not available");
+}
+
+std::string MockNode::get_logs_(const json &params, const std::string &id) {
+  const FaultConfig &f = config_.faults;
+  const json &filter = params.at(0);
+  const uint64_t head = chain_.head();
+  auto block_of = [&](const char *field) {
+    if (!filter.contains(field) || filter[field] == "latest") {
+      return head;
+    }
+    if (filter[field] == "earliest") {
+      return uint64_t{0};
+    }
+    return parse_hex_uint64(filter[field].get<std::string>());
+  };
+
+  LogQuery query;
+  query.from_block = block_of("fromBlock");
+  query.to_block = std::min(block_of("toBlock"), head);
+  if (filter.contains("address")) {
+    query.addresses = any_of(filter["address"]);
+  }
+  if (filter.contains("topics") && filter["topics"].is_array() && !filter["topics"].empty()) {
+    query.topic0s = any_of(filter["topics"][0]);
+  }
+  if (query.from_block > query.to_block) {
+    return result(id, "[]");
+  }
+
+  if (f.max_block_range > 0 && query.to_block - query.from_block + 1 > f.max_block_range) {
+    std::lock_guard<std::mutex> lk(stats_mu_);
+    ++range_too_large_;
+    return error(id, -32600,
+                 "block range is too wide, maximum is " + std::to_string(f.max_block_range));
+  }
+  const std::string too_many =
+      "query returned more than " + std::to_string(f.max_results) + " results";
+  if (roll_(f.too_many_results_rate)) {
+    std::lock_guard<std::mutex> lk(stats_mu_);
+    ++injected_too_many_;
+    return error(id, -32005, too_many);
+  }
+
+  std::string logs;
+  const auto count = chain_.logs_json(query, f.max_results, logs);
+  std::lock_guard<std::mutex> lk(stats_mu_);
+  if (!count) {
+    ++too_many_results_;
+    return error(id, -32005, too_many);
+  }
+  logs_served_ += *count;
+  return result(id, logs);
+}
+
+void MockNode::record_webhook_(const std::string &path, const std::string &body,
+                               const std::string &sent_ms, bool signed_request, int status) {
+  WebhookReceipt receipt;
+  receipt.path = path;
+  receipt.received_unix_us = now_unix_us();
+  receipt.bytes = body.size();
+  receipt.signed_request = signed_request;
+  receipt.status = status;
+
+  // Alert timestamp_ms is the block timestamp
+  std::vector<uint64_t> block_ms;
+  try {
+    const json payload = json::parse(body);
+    const json alerts = payload.is_array() ? payload : json::array({payload});
+    for (const auto &alert : alerts) {
+      if (alert.contains("timestamp_ms") && alert["timestamp_ms"].is_number_unsigned()) {
+        block_ms.push_back(alert["timestamp_ms"].get<uint64_t>());
+      }
+    }
+    receipt.alerts = alerts.size();
+  } catch (const json::exception &) {
+    receipt.alerts = 0;
+  }
+
+  auto since = [&](uint64_t ms) {
+    const uint64_t at_us = ms * 1000;
+    return receipt.received_unix_us > at_us ? (receipt.received_unix_us - at_us) * 1000 : 0;
+  };
+  if (status == 200) {
+    for (const uint64_t ms : block_ms) {
+      block_to_webhook_.record(since(ms));
+    }
+    if (!sent_ms.empty()) {
+      send_to_webhook_.record(since(std::stoull(sent_ms)));
+    }
+  }
+
+  std::lock_guard<std::mutex> lk(stats_mu_);
+  if (status == 200) {
+    webhook_alerts_ += receipt.alerts;
+  }
+  if (webhook_log_.is_open()) {
+    webhook_log_ << receipt.received_unix_us << ',' << receipt.path << ',' << receipt.status
+                 << ',' << receipt.bytes << ',' << receipt.alerts << '\n';
+    webhook_log_.flush();
+  }
+  receipts_.push_back(std::move(receipt));
+}
+
+std::vector<WebhookReceipt> MockNode::webhook_receipts() const {
+  std::lock_guard<std::mutex> lk(stats_mu_);
+  return receipts_;
+}
+
+json MockNode::stats() {
+  const uint64_t head = chain_.head();
+  std::lock_guard<std::mutex> lk(stats_mu_);
+  return {{"head", head},
+          {"reorgs", chain_.reorgs()},
+          {"requests", requests_},
+          {"calls", calls_},
+          {"logs_served", logs_served_},
+          {"faults",
+           {{"slow_requests", slow_requests_},
+            {"http_errors", injected_http_errors_},
+            {"rpc_errors", injected_rpc_errors_},
+            {"too_many_results_injected", injected_too_many_},
+            {"too_many_results", too_many_results_},
+            {"range_too_large", range_too_large_}}},
+          {"webhook",
+           {{"deliveries", receipts_.size()},
+            {"alerts", webhook_alerts_},
+            {"block_to_webhook_ms", percentiles_ms(block_to_webhook_)},
+            {"send_to_webhook_ms", percentiles_ms(send_to_webhook_)}}}};
+}
+
+} // namespace sentinel::mock
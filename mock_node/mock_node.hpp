@@ -0,0 +1,146 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "mock_chain.hpp"
+#include "sentinel/replay/latency_histogram.hpp"
+
+namespace httplib {
+class Server;
+}
+
+namespace sentinel::mock {
+
+// Misbehaviour injected into JSON-RPC traffic. Rates are probabilities per
+// HTTP request (latency, HTTP errors) or per call, batch elements included
+// (JSON-RPC errors, refused eth_getLogs).
+struct FaultConfig {
+  std::chrono::milliseconds latency{0};
+  std::chrono::milliseconds jitter{0}; // uniform, added to latency
+  double slow_rate = 0;                // requests that take slow_latency on top
+  std::chrono::milliseconds slow_latency{1000};
+  double http_error_rate = 0;          // HTTP 503, no JSON-RPC body
+  double rpc_error_rate = 0;           // JSON-RPC -32603
+  double too_many_results_rate = 0;    // eth_getLogs refused whatever its size
+  // eth_getLogs limits every provider has in some form
+  std::size_t max_results = 10'000;
+  uint64_t max_block_range = 0; // 0 = unlimited
+  bool batch = true;            // false rejects batch requests outright
+  // HTTP status of that rejection; its body is a JSON-RPC error either way
+  int batch_rejection_status = 200;
+};
+
+// Webhook deliveries POSTed to /webhook/<anything>
+struct WebhookSinkConfig {
+  std::chrono::milliseconds latency{0};
+  double error_rate = 0; // HTTP 500, so the sender retries
+  std::string log_path;  // one CSV line per delivery if set
+};
+
+struct MockNodeConfig {
+  std::string host = "127.0.0.1";
+  int port = 8545; // 0 = any free port
+  unsigned threads = 16;
+  uint64_t seed = 1; // fault decisions; the chain has its own
+  ChainConfig chain;
+  FaultConfig faults;
+  WebhookSinkConfig webhook;
+};
+
+struct WebhookReceipt {
+  std::string path;
+  uint64_t received_unix_us = 0;
+  std::size_t bytes = 0;
+  std::size_t alerts = 0; // a batched delivery holds several
+  bool signed_request = false;
+  int status = 0; // what the sink answered
+};
+
+// A stand-in EVM JSON-RPC node for end-to-end runs. Serves eth_chainId,
+// eth_blockNumber, eth_getBlockByNumber and eth_getLogs (single and batch)
+// from a MockChain, with latency and failures injected per FaultConfig. The
+// same server records webhook deliveries, and exposes:
+//
+//   GET  /stats                   request, fault and webhook counters, and
+//                                 block-to-webhook latency percentiles
+//   POST /control/mine?blocks=N   advance the head
+//   POST /control/reorg?depth=N   replace the last N blocks
+class MockNode {
+public:
+  explicit MockNode(MockNodeConfig config);
+  ~MockNode();
+
+  MockNode(const MockNode &) = delete;
+  MockNode &operator=(const MockNode &) = delete;
+
+  // Binds and serves on a background thread. Throws std::runtime_error if
+  // the address cannot be bound.
+  void start();
+  void stop(); // idempotent
+
+  int port() const { return port_; }
+  std::string url(const std::string &path = "/") const;
+
+  MockChain &chain() { return chain_; }
+  // Advances the chain clock, hence not const
+  nlohmann::json stats();
+  std::vector<WebhookReceipt> webhook_receipts() const;
+
+  // The JSON-RPC response to `body` (one request or a batch), faults
+  // included except HTTP-level ones. `http_status`, if given, is set to the
+  // status to answer with.
+  std::string handle_rpc(std::string_view body, int *http_status = nullptr);
+
+private:
+  // Response objects as text, so log arrays are never parsed back
+  std::string call_(const nlohmann::json &request);
+  std::string get_logs_(const nlohmann::json &params, const std::string &id);
+  void record_webhook_(const std::string &path, const std::string &body,
+                       const std::string &sent_ms, bool signed_request, int status);
+  bool roll_(double rate);
+  std::chrono::milliseconds delay_();
+
+  MockNodeConfig config_;
+  MockChain chain_;
+  std::unique_ptr<httplib::Server> server_;
+  std::thread server_thread_;
+  int port_ = 0;
+
+  std::mutex rng_mu_;
+  std::mt19937_64 rng_;
+
+  mutable std::mutex stats_mu_;
+  std::map<std::string, uint64_t> calls_; // by method
+  uint64_t requests_ = 0;
+  uint64_t injected_http_errors_ = 0;
+  uint64_t injected_rpc_errors_ = 0;
+  uint64_t injected_too_many_ = 0;
+  uint64_t too_many_results_ = 0; // over max_results for real
+  uint64_t range_too_large_ = 0;
+  uint64_t slow_requests_ = 0;
+  uint64_t logs_served_ = 0;
+  std::vector<WebhookReceipt> receipts_;
+  uint64_t webhook_alerts_ = 0;
+  std::ofstream webhook_log_;
+
+  // Block timestamp to receipt (second resolution: block timestamps are
+  // whole seconds) and the sender's X-Risk-Sentinel-Timestamp to receipt
+  sentinel::replay::LatencyHistogram block_to_webhook_;
+  sentinel::replay::LatencyHistogram send_to_webhook_;
+};
+
+} // namespace sentinel::mock
@@ -4,10 +4,15 @@
 #include <cctype>
 #include <fstream>
 #include <stdexcept>
+#include <string_view>
 
 #include <pqxx/pqxx>
 
+#include "sentinel/db_alert_outbox_store.hpp"
 #include "sentinel/db_checkpoint_store.hpp"
+#include "sentinel/db_config_listener.hpp"
+#include "sentinel/db_parallel_loader.hpp"
+#include "sentinel/events/normalize.hpp"
 #include "sentinel/events/utils/hex.hpp"
 #include "sentinel/log.hpp"
 #include "sentinel/risk/console_alert_channel.hpp"
@@ -22,8 +27,6 @@
 #include "sentinel/security/crypto.hpp"
 #include "sentinel/version.hpp"
 
-#include <nlohmann/json.hpp>
-
 #ifdef __linux__
 #include <pthread.h>
 #endif
@@ -40,6 +43,68 @@ void set_thread_name(const char *name) {
   (void)name;
 #endif
 }
+// Parses a rule's 0x-prefixed 20-byte address column into `out`. On a
+// malformed value, logs that the row is skipped and returns false.
+bool parse_address(const std::string &address, std::array<uint8_t, 20> &out,
+                   std::string_view rule, std::string_view column,
+                   uint64_t customer_id) {
+  try {
+    if (address.size() != 42) {
+      throw std::runtime_error("expected 20 bytes");
+    }
+    sentinel::events::utils::parse_hex_bytes(address, out);
+    return true;
+  } catch (const std::exception &e) {
+    sentinel::logger(sentinel::LogComponent::Db)
+        .warn("Skipping {} rule with malformed {}='{}' for customer_id={}: {}",
+              rule, column, address, customer_id, e.what());
+    return false;
+  }
+}
+
+using Address = std::array<uint8_t, 20>;
+
+void add_watched(const std::vector<sentinel::risk::LargeTransferRuleConfig> &configs,
+                 uint64_t chain_id, std::vector<Address> &out) {
+  for (const auto &c : configs) {
+    if (c.chain_id == chain_id) out.push_back(c.token_address);
+  }
+}
+
+void add_watched(const sentinel::risk::GovernanceRule::ConfigMap &configs,
+                 uint64_t chain_id, std::vector<Address> &out) {
+  for (const auto &[key, _] : configs) {
+    if (key.chain_id == chain_id) out.push_back(key.contract_address);
+  }
+}
+
+void add_watched(const sentinel::risk::MintBurnRule::ConfigMap &configs,
+                 uint64_t chain_id, std::vector<Address> &out) {
+  for (const auto &[key, _] : configs) {
+    if (key.chain_id == chain_id) out.push_back(key.contract_address);
+  }
+}
+
+void add_watched(const sentinel::risk::ApprovalRule::ConfigMap &configs,
+                 uint64_t chain_id, std::vector<Address> &out) {
+  for (const auto &[key, _] : configs) {
+    if (key.chain_id == chain_id) out.push_back(key.token_address);
+  }
+}
+
+void add_watched(const sentinel::risk::BridgeTransferRule::Config &config,
+                 uint64_t chain_id, std::vector<Address> &out) {
+  for (const auto &[key, _] : config.configs_by_key) {
+    if (key.chain_id == chain_id) out.push_back(key.token_address);
+  }
+}
+
+void add_watched(const sentinel::risk::OracleUpdateRule::ConfigMap &configs,
+                 uint64_t chain_id, std::vector<Address> &out) {
+  for (const auto &[key, _] : configs) {
+    if (key.chain_id == chain_id) out.push_back(key.aggregator_address);
+  }
+}
 } // namespace
 
 App::App(AppConfig cfg) : cfg_(std::move(cfg)) {}
@@ -62,6 +127,7 @@ int App::run() {
       return 2;
     }
 
+    load_configs_();
     init_modules_();
     register_rules_();
 
@@ -120,6 +186,7 @@ bool App::init_db_() {
     return false;
   }
 
+  const auto connect_start = std::chrono::steady_clock::now();
   int retries = 15;
   while (retries > 0) {
     try {
@@ -143,6 +210,7 @@ bool App::init_db_() {
   }
 
   Ldb.info("database connection OK");
+  record_startup_phase_("db_connect", std::chrono::steady_clock::now() - connect_start);
 
   sentinel::DbCheckpointStore store(conn_);
 
@@ -164,7 +232,10 @@ bool App::init_db_() {
   }
 
   Ldb.info("checkpoint loaded chain={} last_block={}", cfg_.chain, last);
-  cfg_.event_source_cfg.start_block = last;
+  // The checkpoint is the last block fully processed; 0 means none, and
+  // EventSource then starts at the head
+  checkpoint_block_ = last;
+  cfg_.event_source_cfg.start_block = last > 0 ? last + 1 : 0;
 
   return true;
 }
@@ -183,21 +254,30 @@ void App::init_modules_() {
   }
 
   metrics_ = std::make_unique<sentinel::metrics::Metrics>(cfg_.metrics_listen_address, cfg_.chain);
+  {
+    std::lock_guard<std::mutex> lk(startup_phases_mutex_);
+    for (const auto &[phase, seconds] : startup_phases_) {
+      metrics_->startup_phase_duration_seconds.Add({{"chain", cfg_.chain}, {"phase", phase}})
+          .Set(seconds);
+    }
+    startup_phases_.clear();
+  }
 
   rpc_ = std::make_unique<JsonRpcClient>(cfg_.rpc_url, cfg_.chain, metrics_.get());
+  rpc_->set_first_success_callback([this] {
+    record_startup_phase_("first_rpc", std::chrono::steady_clock::now() - started_at_);
+  });
   arbitrum_adapter_ = std::make_unique<ArbitrumAdapter>(*rpc_);
+  if (!cfg_.rpc_capture_path.empty()) {
+    rpc_capture_ = std::make_unique<sentinel::replay::CorpusWriter>(cfg_.rpc_capture_path);
+    arbitrum_adapter_->setRecorder(rpc_capture_.get());
+    Lrpc.info("Capturing RPC responses to {}", cfg_.rpc_capture_path);
+  }
   event_source_ = std::make_unique<sentinel::events::EventSource>(
       *arbitrum_adapter_, *ring_buffer_, cfg_.event_source_cfg, cfg_.chain, metrics_.get(),
       &event_source_hb_);
 
-  load_customer_map_();
   load_token_map_();
-  load_governance_configs_();
-  load_mint_burn_configs_();
-  load_approval_configs_();
-  load_bridge_configs_();
-  load_oracle_configs_();
-  load_webhook_channels_();
 
   sentinel::risk::DeduplicatorConfig dedup_cfg;
   dedup_cfg.default_window_ms = 60'000;
@@ -218,10 +298,27 @@ void App::init_modules_() {
 
   dispatcher_ = std::make_unique<sentinel::risk::AlertDispatcher>(
       cfg_.chain, metrics_.get(),
-      std::move(dedup_cfg), std::move(rule_types), &dispatcher_hb_);
+      std::move(dedup_cfg), std::move(rule_types), &dispatcher_hb_,
+      cfg_.alert_queue_cfg);
   dispatcher_->add_channel(
       std::make_unique<sentinel::risk::ConsoleAlertChannel>());
 
+  checkpoint_writer_ = std::make_unique<sentinel::risk::CheckpointWriter>(
+      std::make_unique<sentinel::DbCheckpointSink>(cfg_.database_url, cfg_.chain),
+      checkpoint_block_, cfg_.checkpoint_cfg, cfg_.chain, metrics_.get());
+  dispatcher_->set_checkpoint_writer(checkpoint_writer_.get());
+
+  if (cfg_.alert_outbox) {
+    alert_outbox_ = std::make_unique<sentinel::risk::AlertOutbox>(
+        std::make_unique<sentinel::DbAlertOutboxStore>(cfg_.database_url, cfg_.chain),
+        cfg_.alert_outbox_cfg, cfg_.chain, metrics_.get());
+    dispatcher_->replay(alert_outbox_->load_pending());
+    dispatcher_->set_outbox(alert_outbox_.get());
+  }
+
+  alert_http_ = std::make_unique<sentinel::risk::HttpDeliveryLoop>(
+      cfg_.alert_http_cfg, metrics_.get());
+
   // Telegram alert channel can be registered here if token/chat_id are provided
   // in config
   if (const char *bot_token = std::getenv("TELEGRAM_BOT_TOKEN"); bot_token) {
@@ -229,19 +326,23 @@ void App::init_modules_() {
       dispatcher_->add_channel(
           std::make_unique<sentinel::risk::TelegramAlertChannel>(
               bot_token, chat_id, &customer_id_to_key_,
-              &token_addresses_to_symbols_));
+              &token_addresses_to_symbols_, alert_http_.get()));
     }
   }
 
   if (!customer_webhooks_.empty()) {
     dispatcher_->add_channel(
         std::make_unique<sentinel::risk::WebhookAlertChannel>(
-            std::move(customer_webhooks_)));
+            std::move(customer_webhooks_), alert_http_.get()));
   }
 
   risk_engine_ =
       std::make_unique<sentinel::risk::RiskEngine>(*ring_buffer_, *dispatcher_, cfg_.chain, metrics_.get(),
-                                                   &risk_engine_hb_);
+                                                   &risk_engine_hb_,
+                                                   sentinel::risk::RiskEngineConfig{
+                                                       .workers = cfg_.risk_engine_workers,
+                                                       .rcu = cfg_.rule_reload ? &rcu_ : nullptr,
+                                                   });
 
   sentinel::health::HealthCheckInputs hc_inputs{
       .event_source = &event_source_hb_,
@@ -273,424 +374,607 @@ void App::init_modules_() {
       std::move(hc_cfg), std::move(hc_inputs));
 }
 
+void App::load_configs_() {
+  auto &Ldb = sentinel::logger(sentinel::LogComponent::Db);
+
+  // Subscribed before the configs are read, so no change made from here on
+  // is missed
+  if (cfg_.rule_reload) {
+    config_listener_ = std::make_unique<sentinel::DbConfigListener>(
+        cfg_.database_url,
+        [this](pqxx::connection &conn, const std::vector<std::string> &tables,
+               std::chrono::steady_clock::time_point notified_at) {
+          reload_rule_configs_(conn, tables, notified_at);
+        });
+  }
+
+  // Worker 0 reuses the connection init_db_ opened; the others are closed
+  // again once everything is loaded.
+  sentinel::ParallelLoader<pqxx::connection> loader(
+      cfg_.startup_db_connections,
+      [this](std::size_t index) -> std::shared_ptr<pqxx::connection> {
+        if (index == 0) {
+          return conn_;
+        }
+        return std::make_shared<pqxx::connection>(cfg_.database_url);
+      });
+
+  auto &out = startup_configs_;
+  loader.add("customers", [this](pqxx::connection &conn) { load_customer_map_(conn); });
+  loader.add("webhook_channels",
+             [this](pqxx::connection &conn) { load_webhook_channels_(conn); });
+  loader.add("large_transfer",
+             [&out](pqxx::connection &conn) { out.large_transfer = load_large_transfer_configs_(conn); });
+  loader.add("governance",
+             [&out](pqxx::connection &conn) { out.governance = load_governance_configs_(conn); });
+  loader.add("mint_burn",
+             [&out](pqxx::connection &conn) { out.mint_burn = load_mint_burn_configs_(conn); });
+  loader.add("approval",
+             [&out](pqxx::connection &conn) { out.approval = load_approval_configs_(conn); });
+  loader.add("bridge",
+             [&out](pqxx::connection &conn) { out.bridge = load_bridge_configs_(conn); });
+  loader.add("oracle",
+             [&out](pqxx::connection &conn) { out.oracle = load_oracle_configs_(conn); });
+
+  // A rule whose configs fail to load starts without any; the next change
+  // to its tables loads them again
+  const auto start = std::chrono::steady_clock::now();
+  for (const auto &result : loader.run()) {
+    if (!result.error.empty()) {
+      Ldb.error("Error loading {}: {}", result.name, result.error);
+      continue;
+    }
+    record_startup_phase_("load_" + result.name, result.elapsed);
+  }
+  record_startup_phase_("config_load", std::chrono::steady_clock::now() - start);
+}
+
 void App::register_rules_() {
-  // Register LargeTransferRule
-  auto configs = load_large_transfer_configs_();
+  auto configs = std::move(startup_configs_.large_transfer);
   if (configs.empty()) {
     auto &Lcore = sentinel::logger(sentinel::LogComponent::Core);
     Lcore.warn("No large_transfer configurations loaded from DB");
   }
-
+  auto governance = std::move(startup_configs_.governance);
+  auto mint_burn = std::move(startup_configs_.mint_burn);
+  auto approval = std::move(startup_configs_.approval);
+  auto bridge = std::move(startup_configs_.bridge);
+  auto oracle = std::move(startup_configs_.oracle);
+
+  // Each rule's contracts are collected before its configs move into it
+  auto watched = watched_addresses_(configs);
   auto large_transfer_rule =
       std::make_unique<sentinel::risk::LargeTransferRule>(std::move(configs));
+  add_rule_reloader_(*large_transfer_rule, {"customer_risk_rules"},
+                     [](pqxx::connection &conn) { return load_large_transfer_configs_(conn); },
+                     std::move(watched));
   risk_engine_->register_rule(large_transfer_rule.get());
   rules_.push_back(std::move(large_transfer_rule));
 
+  watched = watched_addresses_(governance);
   auto governance_rule =
-      std::make_unique<sentinel::risk::GovernanceRule>(governance_rules_by_contract_);
+      std::make_unique<sentinel::risk::GovernanceRule>(std::move(governance));
+  add_rule_reloader_(*governance_rule, {"customer_governance_rules"},
+                     [](pqxx::connection &conn) { return load_governance_configs_(conn); },
+                     std::move(watched));
   risk_engine_->register_rule(governance_rule.get());
   rules_.push_back(std::move(governance_rule));
 
+  watched = watched_addresses_(mint_burn);
   auto mint_burn_rule =
-      std::make_unique<sentinel::risk::MintBurnRule>(
-          mint_burn_rules_by_contract_);
+      std::make_unique<sentinel::risk::MintBurnRule>(std::move(mint_burn));
+  add_rule_reloader_(*mint_burn_rule, {"customer_mint_burn_rules"},
+                     [](pqxx::connection &conn) { return load_mint_burn_configs_(conn); },
+                     std::move(watched));
   risk_engine_->register_rule(mint_burn_rule.get());
   rules_.push_back(std::move(mint_burn_rule));
 
+  watched = watched_addresses_(approval);
   auto approval_rule =
-      std::make_unique<sentinel::risk::ApprovalRule>(approval_rules_by_contract_);
+      std::make_unique<sentinel::risk::ApprovalRule>(std::move(approval));
+  add_rule_reloader_(*approval_rule, {"customer_approval_rules"},
+                     [](pqxx::connection &conn) { return load_approval_configs_(conn); },
+                     std::move(watched));
   risk_engine_->register_rule(approval_rule.get());
   rules_.push_back(std::move(approval_rule));
 
+  watched = watched_addresses_(bridge);
   auto bridge_rule = std::make_unique<sentinel::risk::BridgeTransferRule>(
-      std::move(bridge_configs_by_key_), bridge_addresses_, bridge_names_);
+      std::move(bridge.configs_by_key), std::move(bridge.bridge_addresses),
+      std::move(bridge.bridge_names));
+  add_rule_reloader_(*bridge_rule, {"customer_bridge_rules", "bridge_contracts"},
+                     [](pqxx::connection &conn) { return load_bridge_configs_(conn); },
+                     std::move(watched));
   risk_engine_->register_rule(bridge_rule.get());
   rules_.push_back(std::move(bridge_rule));
 
-  auto oracle_rule = std::make_unique<sentinel::risk::OracleUpdateRule>(
-      std::move(oracle_configs_by_feed_));
+  watched = watched_addresses_(oracle);
+  auto oracle_rule = std::make_unique<sentinel::risk::OracleUpdateRule>(std::move(oracle));
+  add_rule_reloader_(*oracle_rule, {"customer_oracle_rules"},
+                     [](pqxx::connection &conn) { return load_oracle_configs_(conn); },
+                     std::move(watched));
   risk_engine_->register_rule(oracle_rule.get());
   rules_.push_back(std::move(oracle_rule));
-}
 
-std::vector<sentinel::risk::LargeTransferRuleConfig>
-App::load_large_transfer_configs_() {
-  auto &Ldb = sentinel::logger(sentinel::LogComponent::Db);
-  std::vector<sentinel::risk::LargeTransferRuleConfig> configs;
+  apply_log_filter_();
+}
 
-  try {
-    pqxx::work tx(*conn_);
+template <typename Configs>
+std::vector<std::array<uint8_t, 20>> App::watched_addresses_(const Configs &configs) const {
+  std::vector<std::array<uint8_t, 20>> watched;
+  if (cfg_.log_filter_addresses) {
+    add_watched(configs, event_source_->chain_id(), watched);
+  }
+  return watched;
+}
 
-    std::string query = R"(
-      SELECT
-        c.id as customer_id,
-        r.params_jsonb
-      FROM customer_risk_rules r
-      JOIN customers c ON r.customer_id = c.id
-      WHERE r.rule_type = 'large_transfer'
-        AND r.enabled = true
-    )";
+template <typename Rule, typename Load>
+void App::add_rule_reloader_(Rule &rule, std::vector<std::string> tables, Load load,
+                             std::vector<std::array<uint8_t, 20>> watched) {
+  RuleReloader reloader;
+  reloader.rule_type = std::string(rule.rule_type_name());
+  reloader.tables = std::move(tables);
+  reloader.watched = std::move(watched);
+  reloader.reload = [this, &rule, load](pqxx::connection &conn, RuleReloader &self) {
+    auto configs = load(conn);
+    auto watched = watched_addresses_(configs);
+    rule.reload(std::move(configs), rcu_);
+    self.watched = std::move(watched);
+    return rule.config_generation();
+  };
+  if (metrics_) {
+    const prometheus::Labels labels{{"chain", cfg_.chain}, {"rule", reloader.rule_type}};
+    reloader.duration_hist = &metrics_->rule_config_reload_duration_seconds.Add(
+        labels, prometheus::Histogram::BucketBoundaries{0.001, 0.0025, 0.005, 0.01, 0.025,
+                                                        0.05, 0.1, 0.25, 0.5, 1.0, 5.0});
+    reloader.generation_gauge = &metrics_->rule_config_generation.Add(labels);
+    reloader.failures_counter = &metrics_->rule_config_reload_failures_total.Add(labels);
+  }
+  rule_reloaders_.push_back(std::move(reloader));
+}
 
-    pqxx::result res = tx.exec(query);
+void App::reload_rule_configs_(pqxx::connection &conn, const std::vector<std::string> &tables,
+                               std::chrono::steady_clock::time_point notified_at) {
+  auto &Ldb = sentinel::logger(sentinel::LogComponent::Db);
 
-    for (const auto &row : res) {
-      uint64_t customer_id = row["customer_id"].as<uint64_t>();
-      std::string params_str = row["params_jsonb"].as<std::string>();
+  bool reloaded = false;
+  for (auto &r : rule_reloaders_) {
+    const bool affected =
+        tables.empty() || std::any_of(r.tables.begin(), r.tables.end(), [&](const auto &t) {
+          return std::find(tables.begin(), tables.end(), t) != tables.end();
+        });
+    if (!affected) {
+      continue;
+    }
 
-      try {
-        nlohmann::json params = nlohmann::json::parse(params_str);
+    uint64_t generation = 0;
+    try {
+      generation = r.reload(conn, r);
+    } catch (const std::exception &e) {
+      if (r.failures_counter) r.failures_counter->Increment();
+      Ldb.error("Reloading {} configurations failed, keeping the current ones: {}",
+                r.rule_type, e.what());
+      continue;
+    }
 
-        uint64_t chain_id =
-            params.value("chain_id", 42161ULL); // default to Arbitrum
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - notified_at).count();
+    if (r.duration_hist) r.duration_hist->Observe(seconds);
+    if (r.generation_gauge) r.generation_gauge->Set(static_cast<double>(generation));
+    Ldb.info("Reloaded {} configurations (generation {}) {:.1f} ms after the change",
+             r.rule_type, generation, seconds * 1000.0);
+    reloaded = true;
+  }
 
-        std::string token_str = params.value(
-            "token_address", "0xFd086bC7CD5C481DCC9C85ebE478A1C0b69FCbb9");
-        std::array<uint8_t, 20> token_address{};
-        sentinel::events::utils::parse_hex_bytes(token_str, token_address);
+  // A reloaded rule may name contracts the node is not yet asked about
+  if (reloaded && cfg_.log_filter_addresses) {
+    apply_log_filter_();
+  }
 
-        std::string threshold_str =
-            params.value("threshold", "10000000000"); // default 10k USDT
-        std::array<uint8_t, 32> threshold_be =
-            sentinel::events::utils::decimal_to_be_256(threshold_str);
+  // Snapshots the engine was still reading when they were replaced
+  rcu_.collect();
+}
 
-        configs.push_back({.customer_id = customer_id,
-                           .chain_id = chain_id,
-                           .token_address = token_address,
-                           .threshold_be = threshold_be});
+void App::apply_log_filter_() {
+  auto &Lcore = sentinel::logger(sentinel::LogComponent::Core);
 
-        Ldb.info("Loaded large_transfer rule for customer_id: {}", customer_id);
+  sentinel::events::LogFilter filter;
+  filter.max_addresses_per_request = cfg_.log_filter_max_addresses;
 
-      } catch (const std::exception &e) {
-        Ldb.warn("Failed to parse params_jsonb for customer_id '{}': {}",
-                 customer_id, e.what());
-      }
+  if (cfg_.log_filter_topics) {
+    sentinel::risk::SignalMask interests = 0;
+    for (const auto &rule : rules_) {
+      interests |= rule->interests();
     }
+    filter.topic0s = sentinel::events::topic0_whitelist(interests);
+  }
 
-    tx.commit();
-  } catch (const std::exception &e) {
-    Ldb.error("Error loading large_transfer configurations: {}", e.what());
+  if (cfg_.log_filter_addresses) {
+    std::vector<std::array<uint8_t, 20>> addresses;
+    for (const auto &r : rule_reloaders_) {
+      addresses.insert(addresses.end(), r.watched.begin(), r.watched.end());
+    }
+    std::sort(addresses.begin(), addresses.end());
+    addresses.erase(std::unique(addresses.begin(), addresses.end()),
+                    addresses.end());
+    if (addresses.empty()) {
+      Lcore.warn("LOG_FILTER_ADDRESSES is set but no rule config names a "
+                 "contract on this chain; not filtering by address");
+    }
+    filter.addresses = std::move(addresses);
   }
 
-  return configs;
+  arbitrum_adapter_->setLogFilter(filter);
 }
 
-void App::load_governance_configs_() {
+std::vector<sentinel::risk::LargeTransferRuleConfig>
+App::load_large_transfer_configs_(pqxx::connection &conn) {
   auto &Ldb = sentinel::logger(sentinel::LogComponent::Db);
+  std::vector<sentinel::risk::LargeTransferRuleConfig> configs;
 
-  try {
-    pqxx::work tx(*conn_);
-
-    std::string query = R"(
-      SELECT customer_id, chain_id, contract_address, enabled
-      FROM customer_governance_rules
-      WHERE enabled = true
-    )";
-
-    pqxx::result res = tx.exec(query);
-    size_t count = 0;
-
-    for (const auto &row : res) {
-      uint64_t customer_id = row["customer_id"].as<uint64_t>();
-      uint64_t chain_id = row["chain_id"].as<uint64_t>();
-      std::string contract_address = row["contract_address"].as<std::string>();
-      bool enabled = row["enabled"].as<bool>();
-
-      std::transform(contract_address.begin(), contract_address.end(),
-                     contract_address.begin(), ::tolower);
-
-      sentinel::risk::GovernanceRuleConfig config{
-          .customer_id = customer_id,
-          .chain_id = chain_id,
-          .contract_address = contract_address,
-          .enabled = enabled,
-          .action_filter = std::nullopt};
-
-      sentinel::risk::GovernanceContractKey key{chain_id, contract_address};
-      governance_rules_by_contract_[key].push_back(config);
-      count++;
+  pqxx::work tx(conn);
+
+  // The params are picked out of the JSONB by the server, so no JSON
+  // document is built per row here; absent keys come back NULL
+  std::string query = R"(
+    SELECT
+      c.id as customer_id,
+      r.params_jsonb->>'chain_id' AS chain_id,
+      r.params_jsonb->>'token_address' AS token_address,
+      r.params_jsonb->>'threshold' AS threshold
+    FROM customer_risk_rules r
+    JOIN customers c ON r.customer_id = c.id
+    WHERE r.rule_type = 'large_transfer'
+      AND r.enabled = true
+  )";
+
+  pqxx::result res = tx.exec(query);
+  configs.reserve(res.size());
+
+  for (const auto &row : res) {
+    uint64_t customer_id = row["customer_id"].as<uint64_t>();
+
+    try {
+      const uint64_t chain_id =
+          row["chain_id"].is_null() ? 42161ULL // default to Arbitrum
+                                    : row["chain_id"].as<uint64_t>();
+
+      const std::string token_str =
+          row["token_address"].is_null() ? "0xFd086bC7CD5C481DCC9C85ebE478A1C0b69FCbb9"
+                                         : row["token_address"].as<std::string>();
+      std::array<uint8_t, 20> token_address{};
+      sentinel::events::utils::parse_hex_bytes(token_str, token_address);
+
+      const std::string threshold_str =
+          row["threshold"].is_null() ? "10000000000" // default 10k USDT
+                                     : row["threshold"].as<std::string>();
+      configs.push_back(
+          {.customer_id = customer_id,
+           .chain_id = chain_id,
+           .token_address = token_address,
+           .threshold = sentinel::events::utils::uint256::from_decimal(threshold_str)});
+    } catch (const std::exception &e) {
+      Ldb.warn("Failed to parse params_jsonb for customer_id '{}': {}",
+               customer_id, e.what());
     }
-    tx.commit();
-    Ldb.info("Loaded {} governance rules", count);
-  } catch (const std::exception &e) {
-    Ldb.error("Error loading governance configurations: {}", e.what());
   }
+
+  tx.commit();
+  Ldb.info("Loaded {} large_transfer rules", configs.size());
+
+  return configs;
 }
 
-void App::load_mint_burn_configs_() {
+sentinel::risk::GovernanceRule::ConfigMap
+App::load_governance_configs_(pqxx::connection &conn) {
   auto &Ldb = sentinel::logger(sentinel::LogComponent::Db);
+  sentinel::risk::GovernanceRule::ConfigMap governance_rules_by_contract;
 
-  try {
-    pqxx::work tx(*conn_);
-
-    std::string query = R"(
-      SELECT customer_id, chain_id, contract_address, mint_threshold_raw, burn_threshold_raw, enabled
-      FROM customer_mint_burn_rules
-      WHERE enabled = true
-    )";
-
-    pqxx::result res = tx.exec(query);
-    size_t count = 0;
-
-    for (const auto &row : res) {
-      uint64_t customer_id = row["customer_id"].as<uint64_t>();
-      uint64_t chain_id = row["chain_id"].as<uint64_t>();
-      std::string contract_address = row["contract_address"].as<std::string>();
-      std::string mint_threshold_raw = row["mint_threshold_raw"].as<std::string>();
-      std::string burn_threshold_raw = row["burn_threshold_raw"].as<std::string>();
-      bool enabled = row["enabled"].as<bool>();
-
-      std::transform(contract_address.begin(), contract_address.end(),
-                     contract_address.begin(), ::tolower);
-
-      std::array<uint8_t, 32> mint_threshold_be =
-          sentinel::events::utils::decimal_to_be_256(mint_threshold_raw);
-      std::array<uint8_t, 32> burn_threshold_be =
-          sentinel::events::utils::decimal_to_be_256(burn_threshold_raw);
-
-      sentinel::risk::MintBurnRuleConfig config{
-          .customer_id = customer_id,
-          .chain_id = chain_id,
-          .contract_address = contract_address,
-          .mint_threshold_be = mint_threshold_be,
-          .burn_threshold_be = burn_threshold_be,
-          .enabled = enabled};
-
-      sentinel::risk::MintBurnContractKey key{chain_id, contract_address};
-      mint_burn_rules_by_contract_[key].push_back(config);
-      count++;
+  pqxx::work tx(conn);
+
+  std::string query = R"(
+    SELECT customer_id, chain_id, contract_address, enabled
+    FROM customer_governance_rules
+    WHERE enabled = true
+  )";
+
+  pqxx::result res = tx.exec(query);
+  size_t count = 0;
+
+  for (const auto &row : res) {
+    uint64_t customer_id = row["customer_id"].as<uint64_t>();
+    uint64_t chain_id = row["chain_id"].as<uint64_t>();
+    std::string contract_address = row["contract_address"].as<std::string>();
+    bool enabled = row["enabled"].as<bool>();
+
+    std::array<uint8_t, 20> contract_bytes{};
+    if (!parse_address(contract_address, contract_bytes, "governance",
+                       "contract_address", customer_id)) {
+      continue;
     }
-    tx.commit();
-    Ldb.info("Loaded {} mint_burn rules", count);
-  } catch (const std::exception &e) {
-    Ldb.error("Error loading mint_burn configurations: {}", e.what());
+
+    sentinel::risk::GovernanceRuleConfig config{
+        .customer_id = customer_id,
+        .chain_id = chain_id,
+        .contract_address = contract_bytes,
+        .enabled = enabled,
+        .action_filter = std::nullopt};
+
+    sentinel::risk::GovernanceContractKey key{chain_id, contract_bytes};
+    governance_rules_by_contract[key].push_back(config);
+    count++;
   }
+  tx.commit();
+  Ldb.info("Loaded {} governance rules", count);
+
+  return governance_rules_by_contract;
 }
 
-void App::load_approval_configs_() {
+sentinel::risk::MintBurnRule::ConfigMap
+App::load_mint_burn_configs_(pqxx::connection &conn) {
   auto &Ldb = sentinel::logger(sentinel::LogComponent::Db);
+  sentinel::risk::MintBurnRule::ConfigMap mint_burn_rules_by_contract;
+
+  pqxx::work tx(conn);
+
+  std::string query = R"(
+    SELECT customer_id, chain_id, contract_address, mint_threshold_raw, burn_threshold_raw, enabled
+    FROM customer_mint_burn_rules
+    WHERE enabled = true
+  )";
+
+  pqxx::result res = tx.exec(query);
+  size_t count = 0;
+
+  for (const auto &row : res) {
+    uint64_t customer_id = row["customer_id"].as<uint64_t>();
+    uint64_t chain_id = row["chain_id"].as<uint64_t>();
+    std::string contract_address = row["contract_address"].as<std::string>();
+    std::string mint_threshold_raw = row["mint_threshold_raw"].as<std::string>();
+    std::string burn_threshold_raw = row["burn_threshold_raw"].as<std::string>();
+    bool enabled = row["enabled"].as<bool>();
+
+    std::array<uint8_t, 20> contract_bytes{};
+    if (!parse_address(contract_address, contract_bytes, "mint_burn",
+                       "contract_address", customer_id)) {
+      continue;
+    }
 
-  try {
-    pqxx::work tx(*conn_);
-
-    std::string query = R"(
-      SELECT customer_id, chain_id, token_address, threshold_raw, alert_on_infinite, enabled
-      FROM customer_approval_rules
-      WHERE enabled = true
-    )";
-
-    pqxx::result res = tx.exec(query);
-    size_t count = 0;
-
-    for (const auto &row : res) {
-      uint64_t customer_id = row["customer_id"].as<uint64_t>();
-      uint64_t chain_id = row["chain_id"].as<uint64_t>();
-      std::string token_address = row["token_address"].as<std::string>();
-      std::string threshold_raw = row["threshold_raw"].as<std::string>();
-      bool alert_on_infinite = row["alert_on_infinite"].as<bool>();
-      bool enabled = row["enabled"].as<bool>();
-
-      std::transform(token_address.begin(), token_address.end(),
-                     token_address.begin(), ::tolower);
-
-      sentinel::risk::ApprovalRuleConfig config{};
-      config.customer_id = customer_id;
-      config.chain_id = chain_id;
-      config.alert_on_infinite = alert_on_infinite;
-      config.enabled = enabled;
-
-      sentinel::events::utils::parse_hex_bytes(token_address, config.token_address);
-      config.threshold_be =
-          sentinel::events::utils::decimal_to_be_256(threshold_raw);
-
-      sentinel::risk::ApprovalContractKey key{chain_id, token_address};
-      approval_rules_by_contract_[key].push_back(config);
-      count++;
+    sentinel::risk::MintBurnRuleConfig config{
+        .customer_id = customer_id,
+        .chain_id = chain_id,
+        .contract_address = contract_bytes,
+        .mint_threshold =
+            sentinel::events::utils::uint256::from_decimal(mint_threshold_raw),
+        .burn_threshold =
+            sentinel::events::utils::uint256::from_decimal(burn_threshold_raw),
+        .enabled = enabled};
+
+    sentinel::risk::MintBurnContractKey key{chain_id, contract_bytes};
+    mint_burn_rules_by_contract[key].push_back(config);
+    count++;
+  }
+  tx.commit();
+  Ldb.info("Loaded {} mint_burn rules", count);
+
+  return mint_burn_rules_by_contract;
+}
+
+sentinel::risk::ApprovalRule::ConfigMap
+App::load_approval_configs_(pqxx::connection &conn) {
+  auto &Ldb = sentinel::logger(sentinel::LogComponent::Db);
+  sentinel::risk::ApprovalRule::ConfigMap approval_rules_by_contract;
+
+  pqxx::work tx(conn);
+
+  std::string query = R"(
+    SELECT customer_id, chain_id, token_address, threshold_raw, alert_on_infinite, enabled
+    FROM customer_approval_rules
+    WHERE enabled = true
+  )";
+
+  pqxx::result res = tx.exec(query);
+  size_t count = 0;
+
+  for (const auto &row : res) {
+    uint64_t customer_id = row["customer_id"].as<uint64_t>();
+    uint64_t chain_id = row["chain_id"].as<uint64_t>();
+    std::string token_address = row["token_address"].as<std::string>();
+    std::string threshold_raw = row["threshold_raw"].as<std::string>();
+    bool alert_on_infinite = row["alert_on_infinite"].as<bool>();
+    bool enabled = row["enabled"].as<bool>();
+
+    sentinel::risk::ApprovalRuleConfig config{};
+    config.customer_id = customer_id;
+    config.chain_id = chain_id;
+    config.alert_on_infinite = alert_on_infinite;
+    config.enabled = enabled;
+
+    if (!parse_address(token_address, config.token_address, "approval",
+                       "token_address", customer_id)) {
+      continue;
     }
-    tx.commit();
-    Ldb.info("Loaded {} approval rules", count);
-  } catch (const std::exception &e) {
-    Ldb.error("Error loading approval configurations: {}", e.what());
+    config.threshold =
+        sentinel::events::utils::uint256::from_decimal(threshold_raw);
+
+    sentinel::risk::ApprovalContractKey key{chain_id, config.token_address};
+    approval_rules_by_contract[key].push_back(config);
+    count++;
   }
+  tx.commit();
+  Ldb.info("Loaded {} approval rules", count);
+
+  return approval_rules_by_contract;
 }
 
-void App::load_bridge_configs_() {
+sentinel::risk::BridgeTransferRule::Config
+App::load_bridge_configs_(pqxx::connection &conn) {
   auto &Ldb = sentinel::logger(sentinel::LogComponent::Db);
+  sentinel::risk::BridgeTransferRule::Config bridge;
 
-  try {
-    pqxx::work tx(*conn_);
-
-    // Query 1: load the global bridge contract registry.
-    pqxx::result res1 = tx.exec(R"(
-      SELECT chain_id, address, bridge_name
-      FROM bridge_contracts
-      WHERE enabled = true
-    )");
-
-    std::unordered_map<uint64_t, std::size_t> chains_seen;
-    for (const auto &row : res1) {
-      uint64_t chain_id = row["chain_id"].as<uint64_t>();
-      std::string address = row["address"].as<std::string>();
-      std::string bridge_name = row["bridge_name"].as<std::string>();
-
-      std::transform(address.begin(), address.end(), address.begin(), ::tolower);
-
-      std::array<uint8_t, 20> addr_bytes{};
-      sentinel::events::utils::parse_hex_bytes(address, addr_bytes);
-
-      sentinel::risk::BridgeAddressKey key{chain_id, addr_bytes};
-      bridge_addresses_.insert(key);
-      bridge_names_[key] = std::move(bridge_name);
-      chains_seen[chain_id]++;
-    }
+  pqxx::work tx(conn);
 
-    if (bridge_addresses_.empty()) {
-      Ldb.warn("No bridge contracts loaded — bridge_transfer rule will never fire; "
-               "skipping customer_bridge_rules query");
-      tx.commit();
-      return;
-    }
+  // Query 1: load the global bridge contract registry.
+  pqxx::result res1 = tx.exec(R"(
+    SELECT chain_id, address, bridge_name
+    FROM bridge_contracts
+    WHERE enabled = true
+  )");
 
-    Ldb.info("Loaded {} bridge contracts across {} chain(s)",
-             bridge_addresses_.size(), chains_seen.size());
-
-    // Query 2: load per-customer bridge transfer rules.
-    pqxx::result res2 = tx.exec(R"(
-      SELECT customer_id, chain_id, token_address, threshold_raw
-      FROM customer_bridge_rules
-      WHERE enabled = true
-    )");
-
-    std::size_t config_count = 0;
-    for (const auto &row : res2) {
-      uint64_t customer_id = row["customer_id"].as<uint64_t>();
-      uint64_t chain_id = row["chain_id"].as<uint64_t>();
-      std::string token_address = row["token_address"].as<std::string>();
-      std::string threshold_raw = row["threshold_raw"].as<std::string>();
-
-      std::transform(token_address.begin(), token_address.end(),
-                     token_address.begin(), ::tolower);
-
-      sentinel::risk::BridgeRuleConfig config{};
-      config.customer_id = customer_id;
-      config.chain_id = chain_id;
-      config.enabled = true;
-      sentinel::events::utils::parse_hex_bytes(token_address, config.token_address);
-      config.threshold_be = sentinel::events::utils::decimal_to_be_256(threshold_raw);
-
-      sentinel::risk::BridgeRuleKey key{config.chain_id, config.token_address};
-      bridge_configs_by_key_[key].push_back(config);
-      ++config_count;
-    }
+  std::unordered_map<uint64_t, std::size_t> chains_seen;
+  for (const auto &row : res1) {
+    uint64_t chain_id = row["chain_id"].as<uint64_t>();
+    std::string address = row["address"].as<std::string>();
+    std::string bridge_name = row["bridge_name"].as<std::string>();
 
-    tx.commit();
+    std::transform(address.begin(), address.end(), address.begin(), ::tolower);
 
-    if (config_count == 0) {
-      Ldb.warn("No customer bridge rules loaded — no bridge_transfer alerts will fire");
-    } else {
-      Ldb.info("Loaded {} customer bridge rule(s) across {} (chain, token) key(s)",
-               config_count, bridge_configs_by_key_.size());
-    }
+    std::array<uint8_t, 20> addr_bytes{};
+    sentinel::events::utils::parse_hex_bytes(address, addr_bytes);
 
-  } catch (const std::exception &e) {
-    Ldb.error("Error loading bridge configurations: {}", e.what());
+    sentinel::risk::BridgeAddressKey key{chain_id, addr_bytes};
+    bridge.bridge_addresses.insert(key);
+    bridge.bridge_names[key] = std::move(bridge_name);
+    chains_seen[chain_id]++;
   }
-}
 
-void App::load_oracle_configs_() {
-  auto &Ldb = sentinel::logger(sentinel::LogComponent::Db);
+  if (bridge.bridge_addresses.empty()) {
+    Ldb.warn("No bridge contracts loaded — bridge_transfer rule will never fire; "
+             "skipping customer_bridge_rules query");
+    tx.commit();
+    return bridge;
+  }
 
-  try {
-    pqxx::work tx(*conn_);
-
-    pqxx::result res = tx.exec(R"(
-      SELECT customer_id, chain_id, aggregator_address, feed_label,
-             spike_threshold_bps, decimals
-      FROM customer_oracle_rules
-      WHERE enabled = true
-    )");
-
-    std::size_t count = 0;
-    for (const auto &row : res) {
-      uint64_t customer_id = row["customer_id"].as<uint64_t>();
-      uint64_t chain_id = row["chain_id"].as<uint64_t>();
-      std::string aggregator_address = row["aggregator_address"].as<std::string>();
-      std::string feed_label = row["feed_label"].as<std::string>();
-      int spike_threshold_bps = row["spike_threshold_bps"].as<int>();
-      int decimals = row["decimals"].as<int>();
-
-      std::transform(aggregator_address.begin(), aggregator_address.end(),
-                     aggregator_address.begin(), ::tolower);
-
-      // The DB CHECK constraints guarantee these ranges, but we verify
-      // defensively to catch a malformed row before propagating it into
-      // the rule's hot path.
-      if (spike_threshold_bps <= 0 || spike_threshold_bps > 100000) {
-        Ldb.warn("Skipping oracle rule with out-of-range spike_threshold_bps={} "
-                 "for customer_id={} aggregator={}",
-                 spike_threshold_bps, customer_id, aggregator_address);
-        continue;
-      }
-      if (decimals < 0 || decimals > 255) {
-        Ldb.warn("Skipping oracle rule with out-of-range decimals={} "
-                 "for customer_id={} aggregator={}",
-                 decimals, customer_id, aggregator_address);
-        continue;
-      }
+  Ldb.info("Loaded {} bridge contracts across {} chain(s)",
+           bridge.bridge_addresses.size(), chains_seen.size());
+
+  // Query 2: load per-customer bridge transfer rules.
+  pqxx::result res2 = tx.exec(R"(
+    SELECT customer_id, chain_id, token_address, threshold_raw
+    FROM customer_bridge_rules
+    WHERE enabled = true
+  )");
+
+  std::size_t config_count = 0;
+  for (const auto &row : res2) {
+    uint64_t customer_id = row["customer_id"].as<uint64_t>();
+    uint64_t chain_id = row["chain_id"].as<uint64_t>();
+    std::string token_address = row["token_address"].as<std::string>();
+    std::string threshold_raw = row["threshold_raw"].as<std::string>();
+
+    std::transform(token_address.begin(), token_address.end(),
+                   token_address.begin(), ::tolower);
+
+    sentinel::risk::BridgeRuleConfig config{};
+    config.customer_id = customer_id;
+    config.chain_id = chain_id;
+    config.enabled = true;
+    sentinel::events::utils::parse_hex_bytes(token_address, config.token_address);
+    config.threshold = sentinel::events::utils::uint256::from_decimal(threshold_raw);
+
+    sentinel::risk::BridgeRuleKey key{config.chain_id, config.token_address};
+    bridge.configs_by_key[key].push_back(config);
+    ++config_count;
+  }
 
-      sentinel::risk::OracleRuleConfig cfg{};
-      cfg.customer_id = customer_id;
-      cfg.chain_id = chain_id;
-      cfg.feed_label = std::move(feed_label);
-      cfg.spike_threshold_bps = static_cast<uint32_t>(spike_threshold_bps);
-      cfg.decimals = static_cast<uint8_t>(decimals);
-      cfg.enabled = true;
+  tx.commit();
 
-      try {
-        sentinel::events::utils::parse_hex_bytes(aggregator_address,
-                                                 cfg.aggregator_address);
-      } catch (const std::exception &e) {
-        Ldb.warn("Skipping oracle rule with malformed aggregator_address='{}' "
-                 "for customer_id={}: {}",
-                 aggregator_address, customer_id, e.what());
-        continue;
-      }
+  if (config_count == 0) {
+    Ldb.warn("No customer bridge rules loaded — no bridge_transfer alerts will fire");
+  } else {
+    Ldb.info("Loaded {} customer bridge rule(s) across {} (chain, token) key(s)",
+             config_count, bridge.configs_by_key.size());
+  }
 
-      sentinel::risk::OracleFeedKey key{cfg.chain_id, cfg.aggregator_address};
-      oracle_configs_by_feed_[key].push_back(std::move(cfg));
-      ++count;
-    }
+  return bridge;
+}
 
-    tx.commit();
+sentinel::risk::OracleUpdateRule::ConfigMap
+App::load_oracle_configs_(pqxx::connection &conn) {
+  auto &Ldb = sentinel::logger(sentinel::LogComponent::Db);
+  sentinel::risk::OracleUpdateRule::ConfigMap oracle_configs_by_feed;
+
+  pqxx::work tx(conn);
+
+  pqxx::result res = tx.exec(R"(
+    SELECT customer_id, chain_id, aggregator_address, feed_label,
+           spike_threshold_bps, decimals
+    FROM customer_oracle_rules
+    WHERE enabled = true
+  )");
+
+  std::size_t count = 0;
+  for (const auto &row : res) {
+    uint64_t customer_id = row["customer_id"].as<uint64_t>();
+    uint64_t chain_id = row["chain_id"].as<uint64_t>();
+    std::string aggregator_address = row["aggregator_address"].as<std::string>();
+    std::string feed_label = row["feed_label"].as<std::string>();
+    int spike_threshold_bps = row["spike_threshold_bps"].as<int>();
+    int decimals = row["decimals"].as<int>();
+
+    std::transform(aggregator_address.begin(), aggregator_address.end(),
+                   aggregator_address.begin(), ::tolower);
+
+    // The DB CHECK constraints guarantee these ranges, but we verify
+    // defensively to catch a malformed row before propagating it into
+    // the rule's hot path.
+    if (spike_threshold_bps <= 0 || spike_threshold_bps > 100000) {
+      Ldb.warn("Skipping oracle rule with out-of-range spike_threshold_bps={} "
+               "for customer_id={} aggregator={}",
+               spike_threshold_bps, customer_id, aggregator_address);
+      continue;
+    }
+    if (decimals < 0 || decimals > 255) {
+      Ldb.warn("Skipping oracle rule with out-of-range decimals={} "
+               "for customer_id={} aggregator={}",
+               decimals, customer_id, aggregator_address);
+      continue;
+    }
 
-    if (count == 0) {
-      Ldb.warn("No oracle rules loaded — oracle_update alerts will not fire");
-    } else {
-      Ldb.info("Loaded {} oracle rule(s) across {} feed(s)", count,
-               oracle_configs_by_feed_.size());
+    sentinel::risk::OracleRuleConfig cfg{};
+    cfg.customer_id = customer_id;
+    cfg.chain_id = chain_id;
+    cfg.feed_label = std::move(feed_label);
+    cfg.spike_threshold_bps = static_cast<uint32_t>(spike_threshold_bps);
+    cfg.decimals = static_cast<uint8_t>(decimals);
+    cfg.enabled = true;
+
+    if (!parse_address(aggregator_address, cfg.aggregator_address, "oracle",
+                       "aggregator_address", customer_id)) {
+      continue;
     }
-  } catch (const std::exception &e) {
-    Ldb.error("Error loading oracle configurations: {}", e.what());
+
+    sentinel::risk::OracleFeedKey key{cfg.chain_id, cfg.aggregator_address};
+    oracle_configs_by_feed[key].push_back(std::move(cfg));
+    ++count;
+  }
+
+  tx.commit();
+
+  if (count == 0) {
+    Ldb.warn("No oracle rules loaded — oracle_update alerts will not fire");
+  } else {
+    Ldb.info("Loaded {} oracle rule(s) across {} feed(s)", count,
+             oracle_configs_by_feed.size());
   }
+
+  return oracle_configs_by_feed;
 }
 
-void App::load_customer_map_() {
+void App::load_customer_map_(pqxx::connection &conn) {
   auto &Ldb = sentinel::logger(sentinel::LogComponent::Db);
 
-  try {
-    pqxx::work tx(*conn_);
-    std::string query = "SELECT id, customer_key FROM customers;";
-    pqxx::result res = tx.exec(query);
-
-    for (const auto &row : res) {
-      uint64_t id = row["id"].as<uint64_t>();
-      std::string key = row["customer_key"].as<std::string>();
-      customer_id_to_key_[id] = key;
-    }
-    tx.commit();
-    Ldb.info("Loaded {} customer keys map", customer_id_to_key_.size());
-  } catch (const std::exception &e) {
-    Ldb.error("Error loading customer map: {}", e.what());
+  pqxx::work tx(conn);
+  std::string query = "SELECT id, customer_key FROM customers;";
+  pqxx::result res = tx.exec(query);
+
+  customer_id_to_key_.reserve(res.size());
+  for (const auto &row : res) {
+    uint64_t id = row["id"].as<uint64_t>();
+    customer_id_to_key_[id] = row["customer_key"].as<std::string>();
   }
+  tx.commit();
+  Ldb.info("Loaded {} customer keys map", customer_id_to_key_.size());
 }
 
 void App::load_token_map_() {
@@ -702,7 +986,7 @@ void App::load_token_map_() {
   token_addresses_to_symbols_[usdt_arb] = "USDT";
 }
 
-void App::load_webhook_channels_() {
+void App::load_webhook_channels_(pqxx::connection &conn) {
   auto &Ldb = sentinel::logger(sentinel::LogComponent::Db);
 
   const char *master_key_env = std::getenv("SENTINEL_SECRET_MASTER_KEY");
@@ -740,58 +1024,71 @@ void App::load_webhook_channels_() {
     return out;
   };
 
-  try {
-    pqxx::work tx(*conn_);
-
-    pqxx::result res = tx.exec(
-        "SELECT customer_id, url, hmac_secret_encrypted, hmac_secret_nonce "
-        "FROM customer_webhook_channels WHERE enabled = true");
-
-    size_t endpoint_count = 0;
-
-    for (const auto &row : res) {
-      uint64_t customer_id = row["customer_id"].as<uint64_t>();
-      std::string url = row["url"].as<std::string>();
-
-      std::string hmac_secret;
-
-      if (!row["hmac_secret_encrypted"].is_null() &&
-          !row["hmac_secret_nonce"].is_null()) {
-        try {
-          std::string enc_raw =
-              row["hmac_secret_encrypted"].as<std::string>();
-          std::string nonce_raw =
-              row["hmac_secret_nonce"].as<std::string>();
-
-          std::vector<uint8_t> enc_bytes = parse_pg_bytea(enc_raw);
-          std::vector<uint8_t> nonce_bytes = parse_pg_bytea(nonce_raw);
-
-          hmac_secret = sentinel::security::aes_gcm_decrypt(
-              std::span<const uint8_t>(master_key.data(), master_key.size()),
-              std::span<const uint8_t>(nonce_bytes.data(), nonce_bytes.size()),
-              std::span<const uint8_t>(enc_bytes.data(), enc_bytes.size()));
-        } catch (const std::exception &e) {
-          Ldb.error(
-              "Skipping webhook endpoint customer_id={} url={}: "
-              "decryption failed: {}",
-              customer_id, url, e.what());
-          continue;
-        }
-      }
-      // hmac_secret == "" means unsigned webhook (no secret configured)
+  pqxx::work tx(conn);
 
-      customer_webhooks_[customer_id].push_back(
-          sentinel::risk::WebhookEndpoint{url, hmac_secret});
-      ++endpoint_count;
-    }
+  pqxx::result res = tx.exec(
+      "SELECT customer_id, url, hmac_secret_encrypted, hmac_secret_nonce, "
+      "batch_max_items, batch_max_delay_ms "
+      "FROM customer_webhook_channels WHERE enabled = true");
 
-    tx.commit();
+  size_t endpoint_count = 0;
+  std::chrono::steady_clock::duration decrypt_time{};
 
-    Ldb.info("Loaded {} webhook endpoint(s) across {} customer(s)",
-             endpoint_count, customer_webhooks_.size());
-  } catch (const std::exception &e) {
-    Ldb.error("Error loading webhook channels: {}", e.what());
+  for (const auto &row : res) {
+    uint64_t customer_id = row["customer_id"].as<uint64_t>();
+    std::string url = row["url"].as<std::string>();
+
+    std::string hmac_secret;
+
+    if (!row["hmac_secret_encrypted"].is_null() &&
+        !row["hmac_secret_nonce"].is_null()) {
+      const auto decrypt_start = std::chrono::steady_clock::now();
+      try {
+        std::string enc_raw =
+            row["hmac_secret_encrypted"].as<std::string>();
+        std::string nonce_raw =
+            row["hmac_secret_nonce"].as<std::string>();
+
+        std::vector<uint8_t> enc_bytes = parse_pg_bytea(enc_raw);
+        std::vector<uint8_t> nonce_bytes = parse_pg_bytea(nonce_raw);
+
+        hmac_secret = sentinel::security::aes_gcm_decrypt(
+            std::span<const uint8_t>(master_key.data(), master_key.size()),
+            std::span<const uint8_t>(nonce_bytes.data(), nonce_bytes.size()),
+            std::span<const uint8_t>(enc_bytes.data(), enc_bytes.size()));
+      } catch (const std::exception &e) {
+        decrypt_time += std::chrono::steady_clock::now() - decrypt_start;
+        Ldb.error(
+            "Skipping webhook endpoint customer_id={} url={}: "
+            "decryption failed: {}",
+            customer_id, url, e.what());
+        continue;
+      }
+      decrypt_time += std::chrono::steady_clock::now() - decrypt_start;
+    }
+    // hmac_secret == "" means unsigned webhook (no secret configured)
+
+    sentinel::risk::WebhookEndpoint endpoint{url, hmac_secret};
+    endpoint.batch_max_items = static_cast<std::size_t>(
+        std::max(1, row["batch_max_items"].as<int>()));
+    endpoint.batch_max_delay =
+        std::chrono::milliseconds(row["batch_max_delay_ms"].as<int>());
+    if (endpoint.batch_max_items > 1) {
+      Ldb.info("Webhook endpoint customer_id={} url={} batches up to {} "
+               "alert(s) / {}ms",
+               customer_id, url, endpoint.batch_max_items,
+               endpoint.batch_max_delay.count());
+    }
+
+    customer_webhooks_[customer_id].push_back(std::move(endpoint));
+    ++endpoint_count;
   }
+
+  tx.commit();
+
+  Ldb.info("Loaded {} webhook endpoint(s) across {} customer(s)",
+           endpoint_count, customer_webhooks_.size());
+  record_startup_phase_("secret_decrypt", decrypt_time);
 }
 
 void App::start_threads_() {
@@ -815,6 +1112,11 @@ void App::start_threads_() {
     event_source_->run(st);
   });
 
+  if (config_listener_) {
+    Lcore.info("Starting rule config listener");
+    config_listener_->start();
+  }
+
   if (health_server_) {
     try {
       Lcore.info("Starting HealthServer on {}", cfg_.health_listen_address);
@@ -839,6 +1141,12 @@ void App::stop_orderly_() {
 
   auto &Lcore = sentinel::logger(sentinel::LogComponent::Core);
 
+  // No more reloads while the pipeline drains
+  if (config_listener_) {
+    Lcore.info("Stopping rule config listener...");
+    config_listener_.reset();
+  }
+
   // Stop the health server FIRST so no /readyz probe observes a
   // partially torn-down pipeline and so the server thread does not
   // outlive the captured resources (conn_, metrics_).
@@ -899,6 +1207,11 @@ void App::stop_orderly_() {
   }
 
   if (dispatcher_) {
+    // Alerts still queued get one attempt each; retry backoff would
+    // otherwise stretch the dispatcher's drain well past the HTTP timeouts
+    if (alert_http_) {
+      alert_http_->abandon_retries();
+    }
     Lcore.info("Stopping AlertDispatcher...");
     dispatcher_->stop();
   }
@@ -930,6 +1243,7 @@ void App::write_readiness_file_() {
   f << "ready\n";
   auto &Lcore = sentinel::logger(sentinel::LogComponent::Core);
   Lcore.info("sentinel is ready at {}", cfg_.readiness_file);
+  record_startup_phase_("ready", std::chrono::steady_clock::now() - started_at_);
 }
 
 void App::remove_readiness_file_() {
@@ -939,4 +1253,18 @@ void App::remove_readiness_file_() {
   }
 }
 
+void App::record_startup_phase_(const std::string &phase,
+                                std::chrono::duration<double> elapsed) {
+  sentinel::logger(sentinel::LogComponent::Core)
+      .info("startup phase {} took {:.3f}s", phase, elapsed.count());
+
+  std::lock_guard<std::mutex> lk(startup_phases_mutex_);
+  if (metrics_) {
+    metrics_->startup_phase_duration_seconds.Add({{"chain", cfg_.chain}, {"phase", phase}})
+        .Set(elapsed.count());
+  } else {
+    startup_phases_.emplace_back(phase, elapsed.count());
+  }
+}
+
 } // namespace sentinel::app
@@ -1,7 +1,9 @@
 #include "sentinel/chains/arbitrum/ArbitrumAdapter.hpp"
+#include "sentinel/events/log_stream_decoder.hpp"
 #include "sentinel/events/utils/hex.hpp"
 #include "sentinel/log.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 #include <string>
 
@@ -22,6 +24,24 @@ uint64_t parseHexU64(const std::string &hex, spdlog::logger &log) {
   }
 }
 
+// Each address chunk's logs arrive in chain order; `bounds` holds the offset
+// in `out` where each chunk's logs start (plus the end). Merges them into a
+// single (block, logIndex) ordered run.
+void mergeChunks(std::vector<sentinel::risk::Signal> &out,
+                 const std::vector<std::size_t> &bounds) {
+  auto before = [](const sentinel::risk::Signal &a,
+                   const sentinel::risk::Signal &b) {
+    return a.meta.block_number != b.meta.block_number
+               ? a.meta.block_number < b.meta.block_number
+               : a.meta.log_index < b.meta.log_index;
+  };
+
+  for (std::size_t i = 2; i < bounds.size(); ++i) {
+    std::inplace_merge(out.begin() + bounds[0], out.begin() + bounds[i - 1],
+                       out.begin() + bounds[i], before);
+  }
+}
+
 } // namespace
 
 ArbitrumAdapter::ArbitrumAdapter(JsonRpcClient &rpc)
@@ -30,6 +50,10 @@ ArbitrumAdapter::ArbitrumAdapter(JsonRpcClient &rpc)
   log_.info("ArbitrumAdapter initialized");
 }
 
+void ArbitrumAdapter::setRecorder(sentinel::replay::CorpusWriter *recorder) {
+  recorder_ = recorder;
+}
+
 std::string ArbitrumAdapter::name() const { return "arbitrum"; }
 
 uint64_t ArbitrumAdapter::chainId() {
@@ -44,14 +68,17 @@ uint64_t ArbitrumAdapter::chainId() {
 
   const uint64_t cid = parseHexU64(res.at("result").get<std::string>(), log_);
   log_.debug("eth_chainId -> {}", cid);
+  if (recorder_) {
+    recorder_->chain_id(cid);
+  }
 
   return cid;
 }
 
-uint64_t ArbitrumAdapter::latestBlock() {
-  log_.debug("RPC call: eth_blockNumber");
-
-  auto res = rpc_.call("eth_blockNumber");
+uint64_t ArbitrumAdapter::headFromResponse(const nlohmann::json &res) {
+  if (res.contains("error")) {
+    throw std::runtime_error("JSON-RPC error: " + res["error"].dump());
+  }
 
   if (!res.contains("result")) {
     log_.error("eth_blockNumber response missing 'result': {}", res.dump());
@@ -64,17 +91,11 @@ uint64_t ArbitrumAdapter::latestBlock() {
   return block;
 }
 
-uint64_t ArbitrumAdapter::blockTimestamp(uint64_t block_number) {
-  using nlohmann::json;
-
-  json params = json::array({
-      sentinel::events::utils::to_hex_quantity(block_number),
-      false // no full tx objects
-  });
-
-  log_.debug("RPC call: eth_getBlockByNumber block={}", block_number);
-
-  json res = rpc_.call("eth_getBlockByNumber", params);
+uint64_t ArbitrumAdapter::timestampFromResponse(const nlohmann::json &res,
+                                                uint64_t block_number) {
+  if (res.contains("error")) {
+    throw std::runtime_error("JSON-RPC error: " + res["error"].dump());
+  }
 
   if (!res.contains("result") || res["result"].is_null()) {
     log_.error("eth_getBlockByNumber missing or null for block {}",
@@ -94,6 +115,104 @@ uint64_t ArbitrumAdapter::blockTimestamp(uint64_t block_number) {
   return ts;
 }
 
+uint64_t ArbitrumAdapter::latestBlock() {
+  log_.debug("RPC call: eth_blockNumber");
+
+  const uint64_t head = headFromResponse(rpc_.call("eth_blockNumber"));
+  if (recorder_) {
+    recorder_->head(head);
+  }
+  return head;
+}
+
+uint64_t ArbitrumAdapter::blockTimestamp(uint64_t block_number) {
+  using nlohmann::json;
+
+  json params = json::array({
+      sentinel::events::utils::to_hex_quantity(block_number),
+      false // no full tx objects
+  });
+
+  log_.debug("RPC call: eth_getBlockByNumber block={}", block_number);
+
+  const uint64_t ts =
+      timestampFromResponse(rpc_.call("eth_getBlockByNumber", params), block_number);
+  if (recorder_) {
+    recorder_->block_timestamp(block_number, ts);
+  }
+  return ts;
+}
+
+void ArbitrumAdapter::setLogFilter(const sentinel::events::LogFilter &filter) {
+  using nlohmann::json;
+
+  auto prepared = std::make_shared<PreparedFilter>();
+
+  if (!filter.topic0s.empty()) {
+    json any_of = json::array();
+    for (const auto &topic : filter.topic0s) {
+      any_of.push_back(sentinel::events::utils::bytes_to_hex(topic));
+    }
+    // Position 0 matches any of the listed topics; later positions are free.
+    prepared->topics = json::array({std::move(any_of)});
+  }
+
+  const std::size_t per_request =
+      std::max<std::size_t>(filter.max_addresses_per_request, 1);
+  for (std::size_t i = 0; i < filter.addresses.size(); i += per_request) {
+    json chunk = json::array();
+    const std::size_t end = std::min(filter.addresses.size(), i + per_request);
+    for (std::size_t j = i; j < end; ++j) {
+      chunk.push_back(sentinel::events::utils::bytes_to_hex(filter.addresses[j]));
+    }
+    prepared->address_chunks.push_back(std::move(chunk));
+  }
+
+  log_.info("eth_getLogs filter: {} topic0(s), {} address(es) in {} "
+            "request(s) per range",
+            filter.topic0s.size(), filter.addresses.size(),
+            std::max<std::size_t>(prepared->address_chunks.size(), 1));
+
+  std::lock_guard<std::mutex> lock(filter_mutex_);
+  filter_ = std::move(prepared);
+}
+
+std::vector<nlohmann::json>
+ArbitrumAdapter::logsFilters(uint64_t from_block, uint64_t to_block) const {
+  using nlohmann::json;
+
+  std::shared_ptr<const PreparedFilter> prepared;
+  {
+    std::lock_guard<std::mutex> lock(filter_mutex_);
+    prepared = filter_;
+  }
+
+  json base{
+      {"fromBlock", sentinel::events::utils::to_hex_quantity(from_block)},
+      {"toBlock", sentinel::events::utils::to_hex_quantity(to_block)}};
+
+  if (!prepared) {
+    return {std::move(base)};
+  }
+
+  if (!prepared->topics.is_null()) {
+    base["topics"] = prepared->topics;
+  }
+
+  if (prepared->address_chunks.empty()) {
+    return {std::move(base)};
+  }
+
+  std::vector<json> filters;
+  filters.reserve(prepared->address_chunks.size());
+  for (const auto &chunk : prepared->address_chunks) {
+    json f = base;
+    f["address"] = chunk;
+    filters.push_back(std::move(f));
+  }
+  return filters;
+}
+
 std::vector<sentinel::events::RawLog>
 ArbitrumAdapter::getLogs(uint64_t from_block, uint64_t to_block) {
   using nlohmann::json;
@@ -103,51 +222,227 @@ ArbitrumAdapter::getLogs(uint64_t from_block, uint64_t to_block) {
     throw std::runtime_error("getLogs: to_block < from_block");
   }
 
-  json filter{
-      {"fromBlock", sentinel::events::utils::to_hex_quantity(from_block)},
-      {"toBlock", sentinel::events::utils::to_hex_quantity(to_block)}
-      // later:
-      // {"address", json::array({ "0x...", "0x..." })}
-      // {"topics",  json::array({ "0x<topic0>", nullptr, nullptr, nullptr })}
-  };
+  const std::vector<json> filters = logsFilters(from_block, to_block);
+  std::vector<RawLog> out;
 
-  log_.debug("RPC call: eth_getLogs filter={}", filter.dump());
+  for (const auto &filter : filters) {
+    log_.debug("RPC call: eth_getLogs filter={}", filter.dump());
 
-  // JSON-RPC params: [ filter ]
-  json params = json::array({filter});
+    // JSON-RPC params: [ filter ]
+    json params = json::array({filter});
 
-  // JsonRpcClient::call() returns the whole response
-  json res = rpc_.call("eth_getLogs", params);
+    // JsonRpcClient::call() returns the whole response
+    json res = rpc_.call("eth_getLogs", params);
 
-  if (!res.contains("result") || !res["result"].is_array()) {
-    log_.error("eth_getLogs: invalid response: {}", res.dump());
-    throw std::runtime_error("eth_getLogs: missing result array");
+    if (!res.contains("result") || !res["result"].is_array()) {
+      log_.error("eth_getLogs: invalid response: {}", res.dump());
+      throw std::runtime_error("eth_getLogs: missing result array");
+    }
+
+    const auto &arr = res["result"];
+    log_.debug("eth_getLogs -> {} logs", arr.size());
+
+    out.reserve(out.size() + arr.size());
+
+    for (const auto &jlog : arr) {
+      try {
+        out.push_back(jlog.get<RawLog>());
+      } catch (const std::exception &e) {
+        log_.error("RawLog parse failed: {} json={}", e.what(), jlog.dump());
+        throw;
+      }
+    }
+  }
+
+  if (filters.size() > 1) {
+    auto position = [](const RawLog &log) {
+      return std::pair{sentinel::events::utils::parse_hex_uint64(log.blockNumber),
+                       sentinel::events::utils::parse_hex_uint64(log.logIndex)};
+    };
+    std::stable_sort(out.begin(), out.end(),
+                     [&](const RawLog &a, const RawLog &b) {
+                       return position(a) < position(b);
+                     });
   }
 
-  const auto &arr = res["result"];
-  log_.debug("eth_getLogs -> {} logs", arr.size());
+  return out;
+}
 
-  // MVP debug; TODO : Remove later
-  // if (arr.size() > 0 && arr.size() <= 5) {
-  // log_.debug("eth_getLogs sample payload={}", arr.dump());
-  //}
+void ArbitrumAdapter::getSignals(uint64_t from_block, uint64_t to_block,
+                                 uint64_t chain_id,
+                                 std::vector<sentinel::risk::Signal> &out) {
+  using nlohmann::json;
 
-  // if (!arr.empty()) {
-  //  A .dump(4) 4 spaces indentation
-  // log_.debug("Sample log[0] structure:\n{}", arr[0].dump(4));
-  //}
+  if (to_block < from_block) {
+    throw std::runtime_error("getSignals: to_block < from_block");
+  }
 
-  std::vector<RawLog> out;
-  out.reserve(arr.size());
+  const std::vector<json> filters = logsFilters(from_block, to_block);
+  const std::size_t base = out.size();
+  std::vector<std::size_t> bounds{base};
+  // Copies of the bodies in capture mode; the client reuses its buffer
+  std::vector<std::string> captured;
 
-  for (const auto &jlog : arr) {
-    try {
-      out.push_back(jlog.get<RawLog>());
-    } catch (const std::exception &e) {
-      log_.error("RawLog parse failed: {} json={}", e.what(), jlog.dump());
+  try {
+    for (const auto &filter : filters) {
+      json params = json::array({filter});
+
+      log_.debug("RPC call: eth_getLogs (streaming) filter={}", filter.dump());
+
+      std::size_t decoded = 0;
+      rpc_.call_raw("eth_getLogs", params, [&](std::string_view body) {
+        try {
+          decoded =
+              sentinel::events::decode_get_logs_response(body, chain_id, out);
+          if (recorder_) {
+            captured.emplace_back(body);
+          }
+        } catch (const std::exception &e) {
+          log_.error("eth_getLogs decode failed: {} ({} bytes)", e.what(),
+                     body.size());
+          throw;
+        }
+      });
+
+      log_.debug("eth_getLogs -> {} logs", decoded);
+      bounds.push_back(out.size());
+    }
+  } catch (...) {
+    // A later chunk failed: drop the earlier ones too, the range is retried
+    // as a whole.
+    out.resize(base);
+    throw;
+  }
+
+  mergeChunks(out, bounds);
+
+  if (recorder_) {
+    recorder_->logs(from_block, to_block,
+                    std::vector<std::string_view>(captured.begin(), captured.end()));
+  }
+}
+
+bool ArbitrumAdapter::refusesBatch(long http_status) {
+  switch (http_status) {
+  case 400: // Bad Request: the body (an array) is not a request it accepts
+  case 405: // Method Not Allowed
+  case 413: // Payload Too Large: over the batch size limit
+  case 415: // Unsupported Media Type
+    return true;
+  default:
+    return false;
+  }
+}
+
+ChainAdapter::RangeFetch
+ArbitrumAdapter::fetchUnbatched(uint64_t from_block, uint64_t to_block,
+                                uint64_t chain_id,
+                                std::vector<sentinel::risk::Signal> &out,
+                                const std::string &reason) {
+  log_.warn("RPC endpoint rejected a JSON-RPC batch ({}); falling back to "
+            "one request per method",
+            reason);
+  batch_supported_ = false;
+  return ChainAdapter::fetchRange(from_block, to_block, chain_id, out);
+}
+
+ChainAdapter::RangeFetch
+ArbitrumAdapter::fetchRange(uint64_t from_block, uint64_t to_block,
+                            uint64_t chain_id,
+                            std::vector<sentinel::risk::Signal> &out) {
+  using nlohmann::json;
+
+  if (!batch_supported_) {
+    return ChainAdapter::fetchRange(from_block, to_block, chain_id, out);
+  }
+
+  if (to_block < from_block) {
+    throw std::runtime_error("fetchRange: to_block < from_block");
+  }
+
+  // Request ids are the indices: one eth_getLogs per address chunk, then
+  // the timestamp and head lookups.
+  const std::vector<json> filters = logsFilters(from_block, to_block);
+  const std::size_t n_logs = filters.size();
+
+  std::vector<JsonRpcClient::BatchCall> calls;
+  calls.reserve(n_logs + 2);
+  for (const auto &filter : filters) {
+    calls.push_back({"eth_getLogs", json::array({filter})});
+  }
+  calls.push_back(
+      {"eth_getBlockByNumber",
+       json::array({sentinel::events::utils::to_hex_quantity(to_block), false})});
+  calls.push_back({"eth_blockNumber", json::array()});
+
+  log_.debug("RPC call: batch [{} x eth_getLogs, eth_getBlockByNumber, "
+             "eth_blockNumber] blocks [{}..{}]",
+             n_logs, from_block, to_block);
+
+  RangeFetch res;
+  std::size_t decoded = 0;
+  const std::size_t base = out.size();
+
+  try {
+    rpc_.call_batch_raw(calls, [&](std::string_view body) {
+      res.response_bytes = body.size();
+      std::vector<std::string_view> parts(calls.size());
+      sentinel::events::split_batch_response(body, parts);
+
+      std::vector<std::size_t> bounds{base};
+      try {
+        for (std::size_t i = 0; i < n_logs; ++i) {
+          if (parts[i].empty()) {
+            throw std::runtime_error("batch response is missing eth_getLogs");
+          }
+          decoded += sentinel::events::decode_get_logs_response(
+              parts[i], chain_id, out);
+          bounds.push_back(out.size());
+        }
+      } catch (...) {
+        out.resize(base);
+        throw;
+      }
+      mergeChunks(out, bounds);
+
+      try {
+        res.to_block_timestamp =
+            timestampFromResponse(json::parse(parts[n_logs]), to_block);
+      } catch (const std::exception &e) {
+        res.timestamp_error = e.what();
+      }
+
+      try {
+        res.chain_head = headFromResponse(json::parse(parts[n_logs + 1]));
+      } catch (const std::exception &e) {
+        log_.warn("eth_blockNumber in batch failed: {}", e.what());
+      }
+
+      // Recorded while the parts still point into the client's buffer
+      if (recorder_) {
+        recorder_->logs(from_block, to_block,
+                        std::vector<std::string_view>(parts.begin(), parts.begin() + n_logs));
+        if (res.to_block_timestamp) {
+          recorder_->block_timestamp(to_block, *res.to_block_timestamp);
+        }
+        if (res.chain_head != 0) {
+          recorder_->head(res.chain_head);
+        }
+      }
+    });
+  } catch (const sentinel::events::BatchRejectedError &e) {
+    return fetchUnbatched(from_block, to_block, chain_id, out, e.what());
+  } catch (const JsonRpcHttpError &e) {
+    // Only statuses that mean the server refused the batch itself turn
+    // batching off for good; auth failures, rate limits and gateway errors
+    // would fail the same way one call at a time.
+    if (!refusesBatch(e.status)) {
       throw;
     }
+    return fetchUnbatched(from_block, to_block, chain_id, out, e.what());
   }
 
-  return out;
+  log_.debug("batch -> {} logs, head={}", decoded, res.chain_head);
+
+  return res;
 }
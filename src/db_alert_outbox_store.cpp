@@ -0,0 +1,128 @@
+#include "sentinel/db_alert_outbox_store.hpp"
+#include <pqxx/pqxx>
+#include <optional>
+#include <string>
+#include <type_traits>
+
+namespace sentinel {
+
+namespace {
+
+template <typename T>
+std::string sql_value(pqxx::work& tx, const std::optional<T>& v) {
+  if (!v.has_value()) return "NULL";
+  if constexpr (std::is_same_v<T, std::string>) {
+    return tx.quote(*v);
+  } else {
+    return std::to_string(*v);
+  }
+}
+
+} // namespace
+
+DbAlertOutboxStore::DbAlertOutboxStore(std::string database_url, std::string chain)
+  : database_url_(std::move(database_url)), chain_(std::move(chain)) {}
+
+DbAlertOutboxStore::~DbAlertOutboxStore() = default;
+
+pqxx::connection& DbAlertOutboxStore::conn_() {
+  if (!conn_ptr_ || !conn_ptr_->is_open()) {
+    conn_ptr_.reset();
+    conn_ptr_ = std::make_unique<pqxx::connection>(database_url_);
+  }
+  return *conn_ptr_;
+}
+
+void DbAlertOutboxStore::write(const std::vector<risk::OutboxRecord>& records,
+                               const std::vector<risk::OutboxCompletion>& completions) {
+  if (records.empty() && completions.empty()) return;
+
+  try {
+    pqxx::work tx(conn_());
+    const std::string chain = tx.quote(chain_);
+
+    // One multi-row statement per batch rather than a round trip per alert
+    if (!records.empty()) {
+      std::string sql =
+        "INSERT INTO alert_outbox (chain, id, customer_id, rule_type, message, "
+        "alert_timestamp_ms, chain_id, token_address, amount_decimal, "
+        "completed_at, delivered) VALUES ";
+      for (std::size_t i = 0; i < records.size(); ++i) {
+        const risk::Alert& a = records[i].alert;
+        const bool done = records[i].delivered.has_value();
+        if (i > 0) sql += ',';
+        sql += '(' + chain + ',' + std::to_string(a.outbox_id) + ',' +
+               std::to_string(a.customer_id) + ',' + tx.quote(a.rule_type) + ',' +
+               tx.quote(a.message) + ',' + std::to_string(a.timestamp_ms) + ',' +
+               sql_value(tx, a.chain_id) + ',' + sql_value(tx, a.token_address) + ',' +
+               sql_value(tx, a.amount_decimal) + ',' + (done ? "now()" : "NULL") + ',' +
+               (done ? (*records[i].delivered ? "true" : "false") : "NULL") + ')';
+      }
+      sql += " ON CONFLICT (chain, id) DO NOTHING";
+      tx.exec(sql);
+    }
+
+    if (!completions.empty()) {
+      std::string sql =
+        "UPDATE alert_outbox AS o SET completed_at = now(), delivered = v.delivered "
+        "FROM (VALUES ";
+      for (std::size_t i = 0; i < completions.size(); ++i) {
+        if (i > 0) sql += ',';
+        sql += "(" + std::to_string(completions[i].id) + "::BIGINT," +
+               (completions[i].delivered ? "true" : "false") + ")";
+      }
+      sql += ") AS v(id, delivered) WHERE o.chain = " + chain +
+             " AND o.id = v.id AND o.completed_at IS NULL";
+      tx.exec(sql);
+    }
+
+    tx.commit();
+  } catch (const pqxx::broken_connection&) {
+    conn_ptr_.reset();
+    throw;
+  }
+}
+
+std::vector<risk::Alert> DbAlertOutboxStore::load_pending(std::chrono::hours max_age) {
+  pqxx::work tx(conn_());
+
+  tx.exec_params(
+    R"SQL(
+      UPDATE alert_outbox SET completed_at = now(), delivered = false
+      WHERE chain = $1 AND completed_at IS NULL
+        AND created_at < now() - make_interval(hours => $2)
+    )SQL",
+    chain_,
+    static_cast<int>(max_age.count())
+  );
+
+  auto r = tx.exec_params(
+    R"SQL(
+      SELECT id, customer_id, rule_type, message, alert_timestamp_ms,
+             chain_id, token_address, amount_decimal
+      FROM alert_outbox
+      WHERE chain = $1 AND completed_at IS NULL
+      ORDER BY id
+    )SQL",
+    chain_
+  );
+
+  std::vector<risk::Alert> out;
+  out.reserve(r.size());
+  for (const auto& row : r) {
+    risk::Alert a{};
+    a.outbox_id = row["id"].as<std::uint64_t>();
+    a.customer_id = row["customer_id"].as<std::uint64_t>();
+    a.rule_type = row["rule_type"].as<std::string>();
+    a.message = row["message"].as<std::string>();
+    a.timestamp_ms = row["alert_timestamp_ms"].as<std::uint64_t>();
+    if (!row["chain_id"].is_null()) a.chain_id = row["chain_id"].as<std::uint64_t>();
+    if (!row["token_address"].is_null()) a.token_address = row["token_address"].as<std::string>();
+    if (!row["amount_decimal"].is_null()) a.amount_decimal = row["amount_decimal"].as<std::string>();
+    out.push_back(std::move(a));
+  }
+  tx.commit();
+  return out;
+}
+
+} // namespace sentinel
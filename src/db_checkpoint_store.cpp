@@ -77,4 +77,15 @@ void DbCheckpointStore::upsert_checkpoint(const std::string& chain, std::uint64_
   tx.commit();
 }
 
+DbCheckpointSink::DbCheckpointSink(std::string database_url, std::string chain)
+  : database_url_(std::move(database_url)), chain_(std::move(chain)) {}
+
+void DbCheckpointSink::save(std::uint64_t last_block) {
+  if (!conn_ || !conn_->is_open()) {
+    conn_.reset();
+    conn_ = std::make_shared<pqxx::connection>(database_url_);
+  }
+  DbCheckpointStore(conn_).upsert_checkpoint(chain_, last_block);
+}
+
 } // namespace sentinel
@@ -0,0 +1,119 @@
+#include "sentinel/db_config_listener.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+#include <pqxx/pqxx>
+
+#include "sentinel/log.hpp"
+
+namespace sentinel {
+
+namespace {
+// How long one wait for notifications may last; bounds the shutdown delay
+constexpr long kPollMicros = 250'000;
+} // namespace
+
+class DbConfigListener::Receiver : public pqxx::notification_receiver {
+public:
+  Receiver(pqxx::connection& conn, DbConfigListener& owner)
+    : pqxx::notification_receiver(conn, kChannel), owner_(owner) {}
+
+  void operator()(const std::string& payload, int /* backend_pid */) override {
+    if (owner_.pending_.empty()) {
+      owner_.first_pending_at_ = std::chrono::steady_clock::now();
+    }
+    if (std::find(owner_.pending_.begin(), owner_.pending_.end(), payload) ==
+        owner_.pending_.end()) {
+      owner_.pending_.push_back(payload);
+    }
+  }
+
+private:
+  DbConfigListener& owner_;
+};
+
+DbConfigListener::DbConfigListener(std::string database_url, Callback on_change,
+                                   std::chrono::milliseconds reconnect_backoff)
+  : database_url_(std::move(database_url)), on_change_(std::move(on_change)),
+    reconnect_backoff_(reconnect_backoff) {
+  if (!connect_()) {
+    // Whatever changed before the thread gets a connection is reloaded then
+    reload_all_ = true;
+  }
+}
+
+DbConfigListener::~DbConfigListener() {
+  {
+    std::lock_guard<std::mutex> lk(stop_mutex_);
+    stopping_.store(true, std::memory_order_release);
+  }
+  stop_cv_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  receiver_.reset();
+  conn_.reset();
+}
+
+void DbConfigListener::start() {
+  thread_ = std::thread([this] { run_(); });
+}
+
+bool DbConfigListener::connect_() {
+  receiver_.reset();
+  conn_.reset();
+  try {
+    conn_ = std::make_unique<pqxx::connection>(database_url_);
+    receiver_ = std::make_unique<Receiver>(*conn_, *this);
+    return true;
+  } catch (const std::exception& e) {
+    sentinel::logger(sentinel::LogComponent::Db)
+        .warn("Config listener could not subscribe to {}: {}", kChannel, e.what());
+    receiver_.reset();
+    conn_.reset();
+    return false;
+  }
+}
+
+void DbConfigListener::run_() {
+  auto& Ldb = sentinel::logger(sentinel::LogComponent::Db);
+
+  while (!stopping_.load(std::memory_order_acquire)) {
+    if (!conn_ && !connect_()) {
+      std::unique_lock<std::mutex> lk(stop_mutex_);
+      stop_cv_.wait_for(lk, reconnect_backoff_,
+                        [this] { return stopping_.load(std::memory_order_relaxed); });
+      continue;
+    }
+
+    try {
+      if (reload_all_) {
+        reload_all_ = false;
+        pending_.clear();
+        on_change_(*conn_, {}, std::chrono::steady_clock::now());
+        continue;
+      }
+
+      conn_->await_notification(0, kPollMicros);
+      if (pending_.empty()) {
+        continue;
+      }
+      // A burst of changes is reloaded once
+      conn_->get_notifs();
+      std::vector<std::string> tables = std::move(pending_);
+      pending_.clear();
+      on_change_(*conn_, tables, first_pending_at_);
+    } catch (const pqxx::broken_connection& e) {
+      Ldb.warn("Config listener lost its connection: {}; reconnecting", e.what());
+      receiver_.reset();
+      conn_.reset();
+      reload_all_ = true;
+    } catch (const std::exception& e) {
+      Ldb.error("Config listener: {}", e.what());
+    }
+  }
+}
+
+} // namespace sentinel
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "sentinel/chains/ChainAdapter.hpp"
+#include "sentinel/events/range_backfiller.hpp"
 #include "sentinel/log.hpp"
 #include "sentinel/metrics/metrics.hpp"
 
@@ -19,6 +20,14 @@ EventSource::EventSource(
     sentinel::health::Heartbeat *heartbeat)
     : adapter_(adapter), out_(out_queue), chain_name_(std::move(chain_name)), cfg_(cfg),
       next_block_(cfg.start_block), cold_start_(cfg_.start_block == 0),
+      range_ctl_(BlockRangeControllerConfig{
+          .min_range = cfg_.min_block_range,
+          .max_range = cfg_.max_block_range,
+          .initial_range = cfg_.initial_block_range,
+          .target_response_bytes = cfg_.target_response_bytes,
+          .target_logs = cfg_.target_logs_per_request,
+          .target_latency = cfg_.target_rpc_latency,
+      }),
       log_(sentinel::logger(sentinel::LogComponent::EventSource)),
       metrics_(metrics), heartbeat_(heartbeat) {
   chain_id_ = adapter_.chainId();
@@ -28,6 +37,9 @@ EventSource::EventSource(
     metrics_ring_buffer_depth_ = metrics_->ring_buffer_depth_chain;
     metrics_last_seen_block_ = metrics_->last_seen_block_chain;
     metrics_last_processed_block_ = metrics_->last_processed_block_chain;
+    metrics_backfill_blocks_per_second_ = metrics_->backfill_blocks_per_second_chain;
+    metrics_getlogs_block_range_ = metrics_->getlogs_block_range_chain;
+    metrics_getlogs_block_range_->Set(range_ctl_.range());
   }
 }
 
@@ -36,6 +48,7 @@ void EventSource::stop() { running_.store(false, std::memory_order_relaxed); }
 void EventSource::run(std::stop_token st) {
   log_.info("EventSource started (chain_name={}, chain_id={}, start_block={})", chain_name_, chain_id_,
             next_block_);
+  stop_token_ = st;
 
   while (running_ && !st.stop_requested()) {
     if (heartbeat_) heartbeat_->record();
@@ -58,9 +71,10 @@ void EventSource::run(std::stop_token st) {
   log_.info("EventSource stopped");
 }
 
-void EventSource::push_blocking(const sentinel::risk::Signal &ev) {
+void EventSource::push_blocking(sentinel::risk::Signal &&ev) {
   int retries = 0;
-  while (!out_.try_push(ev)) {
+  // try_push only moves from `ev` once a slot is free
+  while (!out_.try_push(std::move(ev))) {
     if ((retries++ % 1000) == 0) {
       log_.warn("RingBuffer full: blocking producer (retries={})", retries);
     }
@@ -68,6 +82,99 @@ void EventSource::push_blocking(const sentinel::risk::Signal &ev) {
   }
 }
 
+void EventSource::push_batch_(std::vector<sentinel::risk::Signal> &batch) {
+  if (metrics_events_ingested_) {
+    metrics_events_ingested_->Increment(batch.size());
+  }
+
+  for (sentinel::risk::Signal &ev : batch) {
+    ev.meta.internal_ingress_time_ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    if (metrics_signals_normalized_) {
+      metrics_signals_normalized_->Increment();
+    }
+    push_blocking(std::move(ev));
+    if (metrics_ring_buffer_depth_) {
+      metrics_ring_buffer_depth_->Increment();
+    }
+  }
+}
+
+void EventSource::push_sync_(uint64_t block) {
+  sentinel::risk::Signal barrier{};
+  barrier.type = sentinel::risk::SignalType::Control;
+  barrier.meta.block_number = block;
+  barrier.payload = sentinel::risk::ControlSignal{
+      .command = sentinel::risk::ControlSignal::Command::Sync, .block = block};
+  push_blocking(std::move(barrier));
+  if (metrics_ring_buffer_depth_) {
+    metrics_ring_buffer_depth_->Increment();
+  }
+}
+
+void EventSource::backfill_(uint64_t to_block) {
+  const uint64_t from_block = next_block_;
+  log_.info("Backfill: blocks [{}..{}] ({} blocks) in {}-block shards on {} "
+            "workers",
+            from_block, to_block, to_block - from_block + 1,
+            range_ctl_.range(), cfg_.backfill_parallelism);
+
+  // Shard size is the controller's current range; the backfiller splits
+  // shards the provider rejects on its own.
+  RangeBackfiller backfiller(adapter_, chain_id_, cfg_.backfill_parallelism,
+                             cfg_.backfill_max_inflight_bytes,
+                             range_ctl_.range(), cfg_.min_block_range);
+
+  const auto start = std::chrono::steady_clock::now();
+  uint64_t blocks_done = 0;
+
+  auto emit = [&](RangeBackfiller::Shard &shard) {
+    push_batch_(shard.signals);
+    push_sync_(shard.to_block);
+
+    next_block_ = shard.to_block + 1;
+    if (metrics_last_processed_block_) {
+      metrics_last_processed_block_->Set(shard.to_block);
+    }
+
+    blocks_done += shard.to_block - shard.from_block + 1;
+    const double secs = std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+    if (metrics_backfill_blocks_per_second_ && secs > 0) {
+      metrics_backfill_blocks_per_second_->Set(blocks_done / secs);
+    }
+    if (heartbeat_) heartbeat_->record();
+  };
+
+  auto should_continue = [this] {
+    if (heartbeat_) heartbeat_->record();
+    return running_.load(std::memory_order_relaxed) &&
+           !stop_token_.stop_requested();
+  };
+
+  try {
+    backfiller.run(from_block, to_block, emit, should_continue);
+  } catch (...) {
+    if (metrics_backfill_blocks_per_second_) {
+      metrics_backfill_blocks_per_second_->Set(0);
+    }
+    throw;
+  }
+
+  if (metrics_backfill_blocks_per_second_) {
+    metrics_backfill_blocks_per_second_->Set(0);
+  }
+
+  const double secs =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count();
+  log_.info("Backfill: {} blocks in {:.1f}s ({:.0f} blocks/s)", blocks_done,
+            secs, secs > 0 ? blocks_done / secs : 0.0);
+}
+
 bool EventSource::poll_once() {
   // return: true = there is work to do (catch-up), false = reached the head
   // (idle)
@@ -101,14 +208,23 @@ bool EventSource::poll_once() {
     return false; // idle
   }
 
-  // 2) Choose batch size based on distance to head, capped by max_block_range
+  // 2) Choose batch size based on distance to head, capped by the adaptive
+  // range
   const uint64_t distance = cached_chain_head_ - next_block_ + 1;
-  uint64_t range = std::min<uint64_t>(cfg_.max_block_range, distance);
+  // 2a) Far behind (e.g. after downtime): fetch the gap in parallel shards
+  if (cfg_.backfill_parallelism > 1 &&
+      distance >= range_ctl_.range() * cfg_.backfill_parallelism) {
+    backfill_(cached_chain_head_);
+    return (next_block_ <= cached_chain_head_);
+  }
+
+  uint64_t range = std::min<uint64_t>(range_ctl_.range(), distance);
   range = std::max<uint64_t>(range, cfg_.min_block_range);
 
-  // 3) Fetch logs with range-shrink retry on errors
-  std::vector<RawLog> logs;
+  // 3) Fetch logs (decoded straight into Signals), the batch timestamp and a
+  // fresh head in one adapter round trip, with range-shrink retry on errors
   uint64_t to_block = next_block_ + range - 1;
+  ChainAdapter::RangeFetch fetched;
 
   while (true) {
     to_block = next_block_ + range - 1;
@@ -116,8 +232,12 @@ bool EventSource::poll_once() {
     log_.debug("Polling blocks [{}..{}] (head={}, distance={}, range={})",
                next_block_, to_block, cached_chain_head_, distance, range);
 
+    batch_.clear();
+    const auto fetch_start = std::chrono::steady_clock::now();
     try {
-      logs = adapter_.getLogs(next_block_, to_block);
+      fetched = adapter_.fetchRange(next_block_, to_block, chain_id_, batch_);
+      range_ctl_.on_success(range, batch_.size(), fetched.response_bytes,
+                            std::chrono::steady_clock::now() - fetch_start);
       break;
     } catch (const std::exception &e) {
       log_.warn("getLogs error: {}", e.what());
@@ -126,45 +246,53 @@ bool EventSource::poll_once() {
         throw std::runtime_error("Persistent RPC failure even with min_range");
       }
 
-      range = std::max<uint64_t>(range / 2, cfg_.min_block_range);
+      // Retry at least at half the size; the controller may cut deeper
+      // (e.g. on "more than 10000 results").
+      range_ctl_.on_error(range, e.what());
+      range = std::min(range_ctl_.range(),
+                       std::max<uint64_t>(range / 2, cfg_.min_block_range));
+      if (metrics_getlogs_block_range_) {
+        metrics_getlogs_block_range_->Set(range_ctl_.range());
+      }
+    }
+  }
+
+  if (metrics_getlogs_block_range_) {
+    metrics_getlogs_block_range_->Set(range_ctl_.range());
+  }
+
+  // A head observed alongside the logs saves the next cycle a latestBlock()
+  // round trip while catching up. Never move it backwards (load-balanced
+  // providers can briefly lag each other).
+  if (fetched.chain_head > cached_chain_head_) {
+    cached_chain_head_ = fetched.chain_head;
+    log_.debug("Chain head updated: {}", cached_chain_head_);
+    if (metrics_last_seen_block_) {
+      metrics_last_seen_block_->Set(cached_chain_head_);
     }
   }
 
-  // 4) Fetch batch timestamp, then Normalize + push (with backpressure)
+  // 4) Stamp the batch timestamp, then push (with backpressure)
   uint64_t batch_timestamp_ms = 0;
-  try {
-    batch_timestamp_ms = adapter_.blockTimestamp(to_block) * 1000;
+  if (fetched.to_block_timestamp) {
+    batch_timestamp_ms = *fetched.to_block_timestamp * 1000;
     log_.debug("Batch timestamp: to_block={} ts_ms={}", to_block,
                batch_timestamp_ms);
-  } catch (const std::exception &e) {
+  } else {
     log_.warn("Failed to fetch blockTimestamp for batch to_block {}: {}. "
               "Falling back to system clock.",
-              to_block, e.what());
+              to_block, fetched.timestamp_error);
     batch_timestamp_ms =
         std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now().time_since_epoch())
             .count();
   }
 
-  if (metrics_events_ingested_) {
-    metrics_events_ingested_->Increment(logs.size());
-  }
-
-  for (const RawLog &raw : logs) {
-    sentinel::risk::Signal ev{};
-    normalize(raw, ev, chain_id_, batch_timestamp_ms);
-    ev.meta.internal_ingress_time_ms =
-        std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::steady_clock::now().time_since_epoch())
-            .count();
-    if (metrics_signals_normalized_) {
-      metrics_signals_normalized_->Increment();
-    }
-    push_blocking(ev);
-    if (metrics_ring_buffer_depth_) {
-      metrics_ring_buffer_depth_->Increment();
-    }
+  for (sentinel::risk::Signal &ev : batch_) {
+    ev.meta.timestamp_ms = batch_timestamp_ms;
   }
+  push_batch_(batch_);
+  push_sync_(to_block);
 
   // 5) Advance cursor (always based on the requested block range, not on logs)
   next_block_ = to_block + 1;
@@ -0,0 +1,149 @@
+#include "sentinel/events/block_range_controller.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+#include "sentinel/events/utils/hex.hpp"
+
+namespace sentinel::events {
+
+namespace {
+
+// Weight of the newest sample in the density averages.
+constexpr double kSmoothing = 0.5;
+
+double smooth(double avg, double sample) {
+  return avg < 0 ? sample : avg + kSmoothing * (sample - avg);
+}
+
+std::string lowercase(std::string_view s) {
+  std::string out(s);
+  std::transform(out.begin(), out.end(), out.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return out;
+}
+
+} // namespace
+
+BlockRangeController::BlockRangeController(BlockRangeControllerConfig cfg)
+    : cfg_(cfg), range_(0) {
+  cfg_.min_range = std::max<uint64_t>(cfg_.min_range, 1);
+  cfg_.max_range = std::max(cfg_.max_range, cfg_.min_range);
+  cfg_.max_growth = std::max(cfg_.max_growth, 1.0);
+  range_ = clamp_(static_cast<double>(cfg_.initial_range));
+}
+
+uint64_t BlockRangeController::clamp_(double range) const {
+  if (!(range >= static_cast<double>(cfg_.min_range))) { // also catches NaN
+    return cfg_.min_range;
+  }
+  if (range >= static_cast<double>(cfg_.max_range)) {
+    return cfg_.max_range;
+  }
+  return static_cast<uint64_t>(range);
+}
+
+void BlockRangeController::on_success(
+    uint64_t blocks, uint64_t logs, std::size_t response_bytes,
+    std::chrono::steady_clock::duration latency) {
+  if (blocks == 0) {
+    return;
+  }
+
+  const double n = static_cast<double>(blocks);
+  logs_per_block_ = smooth(logs_per_block_, static_cast<double>(logs) / n);
+  if (response_bytes > 0) {
+    bytes_per_block_ =
+        smooth(bytes_per_block_, static_cast<double>(response_bytes) / n);
+  }
+
+  // Only a request that covered the whole range earns growth: near the
+  // head, 1-block polls say nothing about how a larger range would fare.
+  double next = static_cast<double>(range_);
+  if (blocks >= range_) {
+    next *= cfg_.max_growth;
+  }
+
+  if (logs_per_block_ > 0) {
+    next = std::min(next, static_cast<double>(cfg_.target_logs) / logs_per_block_);
+  }
+  if (bytes_per_block_ > 0) {
+    next = std::min(next, static_cast<double>(cfg_.target_response_bytes) /
+                              bytes_per_block_);
+  }
+
+  // Latency only caps the range: below target a request is dominated by the
+  // round trip, not by its size.
+  const auto target = std::chrono::duration<double>(cfg_.target_latency);
+  const auto took = std::chrono::duration<double>(latency);
+  if (took > target && took.count() > 0) {
+    next = std::min(next, n * (target / took));
+  }
+
+  range_ = clamp_(next);
+}
+
+void BlockRangeController::on_error(uint64_t blocks, std::string_view error) {
+  blocks = std::max<uint64_t>(blocks, 1);
+
+  if (auto hint = suggested_range(error)) {
+    range_ = clamp_(static_cast<double>(std::min(*hint, blocks)));
+  } else if (is_result_limit_error(error)) {
+    range_ = clamp_(static_cast<double>(blocks) / 4);
+  } else {
+    range_ = clamp_(static_cast<double>(blocks) / 2);
+  }
+}
+
+bool BlockRangeController::is_result_limit_error(std::string_view error) {
+  const std::string e = lowercase(error);
+  constexpr std::string_view kMarkers[] = {
+      "more than 10000 results", "query returned more than",
+      "response size exceeded",  "response size should not",
+      "log response size",       "limit exceeded",
+      "too many results",        "block range is too wide",
+      "block range too large",
+  };
+  for (auto marker : kMarkers) {
+    if (e.find(marker) != std::string::npos) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::optional<uint64_t>
+BlockRangeController::suggested_range(std::string_view error) {
+  const std::size_t open = error.find("[0x");
+  if (open == std::string_view::npos) {
+    return std::nullopt;
+  }
+  const std::size_t comma = error.find(',', open);
+  const std::size_t close = error.find(']', open);
+  if (comma == std::string_view::npos || close == std::string_view::npos ||
+      comma > close) {
+    return std::nullopt;
+  }
+
+  auto trim = [](std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '"')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '"')) s.remove_suffix(1);
+    return s;
+  };
+
+  try {
+    const uint64_t from =
+        utils::parse_hex_uint64(trim(error.substr(open + 1, comma - open - 1)));
+    const uint64_t to =
+        utils::parse_hex_uint64(trim(error.substr(comma + 1, close - comma - 1)));
+    if (to < from) {
+      return std::nullopt;
+    }
+    return to - from + 1;
+  } catch (const std::exception &) {
+    return std::nullopt;
+  }
+}
+
+} // namespace sentinel::events
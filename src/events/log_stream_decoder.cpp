@@ -0,0 +1,359 @@
+#include "sentinel/events/log_stream_decoder.hpp"
+#include "sentinel/events/normalize.hpp"
+#include "sentinel/events/utils/hex.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace sentinel::events {
+
+namespace {
+
+// Minimal forward-only JSON scanner over the response body. It only
+// understands as much JSON as an eth_getLogs response needs: values we care
+// about are decoded in place, everything else is skipped structurally.
+class Cursor {
+public:
+  explicit Cursor(std::string_view s)
+      : begin_(s.data()), p_(s.data()), end_(s.data() + s.size()) {}
+
+  [[noreturn]] void fail(const char *what) const {
+    throw std::runtime_error(std::string("eth_getLogs decode: ") + what +
+                             " at offset " + std::to_string(p_ - begin_));
+  }
+
+  void skip_ws() {
+    while (p_ < end_ &&
+           (*p_ == ' ' || *p_ == '\n' || *p_ == '\r' || *p_ == '\t')) {
+      ++p_;
+    }
+  }
+
+  char peek() {
+    skip_ws();
+    if (p_ >= end_) {
+      fail("unexpected end of input");
+    }
+    return *p_;
+  }
+
+  void expect(char c) {
+    if (peek() != c) {
+      fail("unexpected character");
+    }
+    ++p_;
+  }
+
+  bool consume_if(char c) {
+    if (peek() != c) {
+      return false;
+    }
+    ++p_;
+    return true;
+  }
+
+  const char *position() const { return p_; }
+
+  bool at_end() {
+    skip_ws();
+    return p_ >= end_;
+  }
+
+  // Returns the raw (still escaped) contents of a JSON string. Hex values
+  // never contain escapes; if one does, the hex parser rejects it.
+  std::string_view string() {
+    expect('"');
+    const char *start = p_;
+    for (;;) {
+      const auto *q = static_cast<const char *>(
+          std::memchr(p_, '"', static_cast<std::size_t>(end_ - p_)));
+      if (q == nullptr) {
+        fail("unterminated string");
+      }
+      const char *b = q;
+      while (b > start && b[-1] == '\\') {
+        --b;
+      }
+      p_ = q + 1;
+      if (((q - b) & 1) == 0) {
+        return {start, static_cast<std::size_t>(q - start)};
+      }
+    }
+  }
+
+  bool boolean() {
+    skip_ws();
+    if (match_literal("true")) {
+      return true;
+    }
+    if (match_literal("false")) {
+      return false;
+    }
+    fail("expected boolean");
+  }
+
+  // Skips any JSON value and returns the span it occupied.
+  std::string_view skip_value() {
+    const char c = peek();
+    const char *start = p_;
+    if (c == '"') {
+      string();
+    } else if (c == '{' || c == '[') {
+      int depth = 0;
+      do {
+        const char d = peek();
+        if (d == '"') {
+          string();
+          continue;
+        }
+        if (d == '{' || d == '[') {
+          ++depth;
+        } else if (d == '}' || d == ']') {
+          --depth;
+        }
+        ++p_;
+      } while (depth > 0);
+    } else {
+      while (p_ < end_ && *p_ != ',' && *p_ != '}' && *p_ != ']' &&
+             *p_ != ' ' && *p_ != '\n' && *p_ != '\r' && *p_ != '\t') {
+        ++p_;
+      }
+      if (p_ == start) {
+        fail("expected value");
+      }
+    }
+    return {start, static_cast<std::size_t>(p_ - start)};
+  }
+
+private:
+  bool match_literal(std::string_view lit) {
+    if (static_cast<std::size_t>(end_ - p_) >= lit.size() &&
+        std::memcmp(p_, lit.data(), lit.size()) == 0) {
+      p_ += lit.size();
+      return true;
+    }
+    return false;
+  }
+
+  const char *begin_;
+  const char *p_;
+  const char *end_;
+};
+
+// Bit per RawLog field; every one of them is required, as with the
+// nlohmann RawLog conversion.
+enum Field : uint32_t {
+  kAddress = 1u << 0,
+  kTopics = 1u << 1,
+  kData = 1u << 2,
+  kBlockNumber = 1u << 3,
+  kTransactionHash = 1u << 4,
+  kLogIndex = 1u << 5,
+  kTransactionIndex = 1u << 6,
+  kRemoved = 1u << 7,
+  kAllFields = (1u << 8) - 1,
+};
+
+uint32_t parse_index(std::string_view hex) {
+  const uint64_t v = utils::parse_hex_uint64(hex);
+  if (v > std::numeric_limits<uint32_t>::max()) {
+    throw std::runtime_error("tx_index/log_index out of range");
+  }
+  return static_cast<uint32_t>(v);
+}
+
+// `evm` is scratch space reused across the logs of one response.
+void decode_log(Cursor &cur, uint64_t chain_id, DecodedLog &evm,
+                sentinel::risk::Signal &out) {
+  out.meta.is_final = false;
+  out.meta.source_id = static_cast<uint32_t>(chain_id);
+
+  evm = DecodedLog{};
+  evm.chain_id = chain_id;
+
+  uint32_t seen = 0;
+
+  cur.expect('{');
+  if (!cur.consume_if('}')) {
+    do {
+      const std::string_view key = cur.string();
+      cur.expect(':');
+
+      if (key == "address") {
+        utils::parse_hex_bytes(cur.string(), evm.address);
+        seen |= kAddress;
+      } else if (key == "topics") {
+        std::size_t n = 0;
+        cur.expect('[');
+        if (!cur.consume_if(']')) {
+          do {
+            const std::string_view topic = cur.string();
+            if (n < evm.topics.size()) {
+              utils::parse_hex_bytes(topic, evm.topics[n]);
+            }
+            ++n;
+          } while (cur.consume_if(','));
+          cur.expect(']');
+        }
+        evm.topic_count =
+            static_cast<uint8_t>(std::min<std::size_t>(n, evm.topics.size()));
+        seen |= kTopics;
+      } else if (key == "data") {
+        const std::string_view data = cur.string();
+        const std::size_t byte_len = utils::parse_hex_data(data, evm.data);
+        evm.truncated = byte_len > evm.data.size();
+        evm.data_size = static_cast<uint32_t>(
+            std::min<std::size_t>(byte_len, evm.data.size()));
+        seen |= kData;
+      } else if (key == "blockNumber") {
+        out.meta.block_number = utils::parse_hex_uint64(cur.string());
+        seen |= kBlockNumber;
+      } else if (key == "transactionHash") {
+        utils::parse_hex_bytes(cur.string(), out.meta.tx_hash);
+        seen |= kTransactionHash;
+      } else if (key == "logIndex") {
+        evm.log_index = parse_index(cur.string());
+        out.meta.log_index = evm.log_index;
+        seen |= kLogIndex;
+      } else if (key == "transactionIndex") {
+        evm.tx_index = parse_index(cur.string());
+        seen |= kTransactionIndex;
+      } else if (key == "removed") {
+        evm.removed = cur.boolean();
+        seen |= kRemoved;
+      } else {
+        cur.skip_value();
+      }
+    } while (cur.consume_if(','));
+    cur.expect('}');
+  }
+
+  if (seen != kAllFields) {
+    cur.fail("log object is missing a required field");
+  }
+
+  classify_log(evm, out);
+}
+
+std::size_t decode_result(Cursor &cur, uint64_t chain_id,
+                          std::vector<sentinel::risk::Signal> &out) {
+  if (cur.peek() != '[') {
+    cur.fail("result is not an array");
+  }
+  cur.expect('[');
+
+  DecodedLog scratch;
+  std::size_t n = 0;
+  if (!cur.consume_if(']')) {
+    do {
+      decode_log(cur, chain_id, scratch, out.emplace_back());
+      ++n;
+    } while (cur.consume_if(','));
+    cur.expect(']');
+  }
+  return n;
+}
+
+} // namespace
+
+std::size_t decode_get_logs_response(std::string_view body, uint64_t chain_id,
+                                     std::vector<sentinel::risk::Signal> &out) {
+  const std::size_t base = out.size();
+
+  try {
+    Cursor cur(body);
+    bool have_result = false;
+    std::size_t n = 0;
+
+    cur.expect('{');
+    if (!cur.consume_if('}')) {
+      do {
+        const std::string_view key = cur.string();
+        cur.expect(':');
+
+        if (key == "result") {
+          n = decode_result(cur, chain_id, out);
+          have_result = true;
+        } else if (key == "error") {
+          throw std::runtime_error("JSON-RPC error: " +
+                                   std::string(cur.skip_value()));
+        } else {
+          cur.skip_value();
+        }
+      } while (cur.consume_if(','));
+      cur.expect('}');
+    }
+
+    if (!cur.at_end()) {
+      cur.fail("trailing data after response");
+    }
+    if (!have_result) {
+      throw std::runtime_error("JSON-RPC response missing result field");
+    }
+    return n;
+  } catch (...) {
+    out.resize(base);
+    throw;
+  }
+}
+
+void split_batch_response(std::string_view body,
+                          std::vector<std::string_view> &by_id) {
+  Cursor cur(body);
+
+  if (cur.peek() != '[') {
+    throw BatchRejectedError("JSON-RPC batch rejected: " +
+                             std::string(body.substr(0, 512)));
+  }
+  cur.expect('[');
+
+  if (!cur.consume_if(']')) {
+    do {
+      cur.skip_ws();
+      const char *start = cur.position();
+      std::string_view id_text;
+
+      cur.expect('{');
+      if (!cur.consume_if('}')) {
+        do {
+          const std::string_view key = cur.string();
+          cur.expect(':');
+          const std::string_view value = cur.skip_value();
+          if (key == "id") {
+            id_text = value;
+          }
+        } while (cur.consume_if(','));
+        cur.expect('}');
+      }
+
+      // A batch refused element-wise (over a provider's batch size limit,
+      // say) answers with errors that cannot name the request they belong to
+      if (id_text.empty() || id_text == "null") {
+        const std::string_view element(
+            start, static_cast<std::size_t>(cur.position() - start));
+        throw BatchRejectedError("JSON-RPC batch rejected: " +
+                                 std::string(element.substr(0, 512)));
+      }
+      std::size_t id = 0;
+      const auto [ptr, ec] = std::from_chars(
+          id_text.data(), id_text.data() + id_text.size(), id);
+      if (ec != std::errc{} ||
+          ptr != id_text.data() + id_text.size() || id >= by_id.size()) {
+        cur.fail("batch element has an unexpected id");
+      }
+      by_id[id] = {start, static_cast<std::size_t>(cur.position() - start)};
+    } while (cur.consume_if(','));
+    cur.expect(']');
+  }
+
+  if (!cur.at_end()) {
+    cur.fail("trailing data after batch response");
+  }
+}
+
+} // namespace sentinel::events
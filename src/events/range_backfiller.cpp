@@ -0,0 +1,200 @@
+#include "sentinel/events/range_backfiller.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "sentinel/chains/ChainAdapter.hpp"
+
+namespace sentinel::events {
+
+RangeBackfiller::RangeBackfiller(ChainAdapter &adapter, uint64_t chain_id,
+                                 unsigned parallelism,
+                                 std::size_t max_inflight_bytes,
+                                 uint64_t shard_blocks,
+                                 uint64_t min_shard_blocks)
+    : adapter_(adapter), chain_id_(chain_id),
+      parallelism_(std::max(parallelism, 1u)),
+      max_inflight_bytes_(max_inflight_bytes),
+      shard_blocks_(std::max<uint64_t>(shard_blocks, 1)),
+      min_shard_blocks_(std::max<uint64_t>(min_shard_blocks, 1)),
+      log_(sentinel::logger(sentinel::LogComponent::EventSource)) {}
+
+void RangeBackfiller::fetch_into_(uint64_t from_block, uint64_t to_block,
+                                  std::vector<sentinel::risk::Signal> &out) {
+  const std::size_t base = out.size();
+  ChainAdapter::RangeFetch fetched;
+
+  try {
+    fetched = adapter_.fetchRange(from_block, to_block, chain_id_, out);
+  } catch (const std::exception &e) {
+    out.resize(base);
+    const uint64_t blocks = to_block - from_block + 1;
+    if (blocks <= min_shard_blocks_) {
+      throw;
+    }
+
+    log_.warn("Backfill shard [{}..{}] failed, splitting: {}", from_block,
+              to_block, e.what());
+    const uint64_t mid =
+        from_block + std::max<uint64_t>(blocks / 2, min_shard_blocks_) - 1;
+    fetch_into_(from_block, mid, out);
+    fetch_into_(mid + 1, to_block, out);
+    return;
+  }
+
+  uint64_t timestamp_ms = 0;
+  if (fetched.to_block_timestamp) {
+    timestamp_ms = *fetched.to_block_timestamp * 1000;
+  } else {
+    log_.warn("Failed to fetch blockTimestamp for backfill to_block {}: {}. "
+              "Falling back to system clock.",
+              to_block, fetched.timestamp_error);
+    timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::system_clock::now().time_since_epoch())
+                       .count();
+  }
+
+  for (std::size_t i = base; i < out.size(); ++i) {
+    out[i].meta.timestamp_ms = timestamp_ms;
+  }
+}
+
+uint64_t RangeBackfiller::run(uint64_t from_block, uint64_t to_block,
+                              const EmitFn &emit,
+                              const ContinueFn &should_continue) {
+  if (to_block < from_block) {
+    return 0;
+  }
+
+  const uint64_t total_blocks = to_block - from_block + 1;
+  const uint64_t shard_count =
+      (total_blocks + shard_blocks_ - 1) / shard_blocks_;
+
+  std::mutex mu;
+  std::condition_variable cv;
+  uint64_t next_dispatch = 0; // next shard index handed to a worker
+  uint64_t next_emit = 0;     // next shard index handed to `emit`
+  std::map<uint64_t, Shard> completed;
+  std::size_t buffered_bytes = 0;
+  std::exception_ptr error;
+  bool aborted = false;
+
+  auto worker = [&] {
+    for (;;) {
+      uint64_t index = 0;
+      {
+        std::unique_lock<std::mutex> lk(mu);
+        // Budget: do not start another shard while finished-but-unemitted
+        // shards exceed the byte budget, except the one the emitter is
+        // waiting for (otherwise the run could never make progress).
+        cv.wait(lk, [&] {
+          return aborted || error || next_dispatch >= shard_count ||
+                 buffered_bytes < max_inflight_bytes_ ||
+                 next_dispatch == next_emit;
+        });
+        if (aborted || error || next_dispatch >= shard_count) {
+          return;
+        }
+        index = next_dispatch++;
+      }
+
+      Shard shard;
+      shard.from_block = from_block + index * shard_blocks_;
+      shard.to_block =
+          std::min(to_block, shard.from_block + shard_blocks_ - 1);
+
+      try {
+        fetch_into_(shard.from_block, shard.to_block, shard.signals);
+      } catch (...) {
+        std::lock_guard<std::mutex> lk(mu);
+        if (!error) {
+          error = std::current_exception();
+        }
+        cv.notify_all();
+        return;
+      }
+
+      std::lock_guard<std::mutex> lk(mu);
+      buffered_bytes += shard.signals.size() * sizeof(sentinel::risk::Signal);
+      completed.emplace(index, std::move(shard));
+      cv.notify_all();
+    }
+  };
+
+  std::vector<std::jthread> workers;
+  const uint64_t worker_count =
+      std::min<uint64_t>(parallelism_, shard_count);
+  workers.reserve(worker_count);
+  for (uint64_t i = 0; i < worker_count; ++i) {
+    workers.emplace_back(worker);
+  }
+
+  auto stop_workers = [&] {
+    {
+      std::lock_guard<std::mutex> lk(mu);
+      aborted = true;
+    }
+    cv.notify_all();
+    workers.clear(); // joins
+  };
+
+  uint64_t emitted_blocks = 0;
+
+  try {
+    while (next_emit < shard_count) {
+      if (!should_continue()) {
+        break;
+      }
+
+      Shard shard;
+      {
+        std::unique_lock<std::mutex> lk(mu);
+        bool keep_waiting = true;
+        while (keep_waiting && !error &&
+               completed.find(next_emit) == completed.end()) {
+          cv.wait_for(lk, std::chrono::milliseconds(100), [&] {
+            return error || completed.find(next_emit) != completed.end();
+          });
+          if (!error && completed.find(next_emit) == completed.end()) {
+            lk.unlock();
+            keep_waiting = should_continue();
+            lk.lock();
+          }
+        }
+
+        auto it = completed.find(next_emit);
+        if (it == completed.end()) {
+          break; // error or aborted by should_continue()
+        }
+
+        shard = std::move(it->second);
+        completed.erase(it);
+        buffered_bytes -= shard.signals.size() * sizeof(sentinel::risk::Signal);
+        ++next_emit;
+      }
+      cv.notify_all();
+
+      emit(shard);
+      emitted_blocks += shard.to_block - shard.from_block + 1;
+    }
+  } catch (...) {
+    stop_workers();
+    throw;
+  }
+
+  stop_workers();
+
+  if (error && next_emit < shard_count) {
+    std::rethrow_exception(error);
+  }
+
+  return emitted_blocks;
+}
+
+} // namespace sentinel::events
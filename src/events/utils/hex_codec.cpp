@@ -0,0 +1,309 @@
+#include "sentinel/events/utils/hex_codec.hpp"
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+#if (defined(__GNUC__) || defined(__clang__)) &&                              \
+    (defined(__x86_64__) || defined(__i386__))
+#define SENTINEL_HEX_X86 1
+#include <immintrin.h>
+#endif
+
+namespace sentinel::events::utils {
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Scalar
+
+constexpr uint8_t kInvalid = 0xff;
+
+constexpr std::array<uint8_t, 256> make_nibble_table() {
+  std::array<uint8_t, 256> t{};
+  for (auto &v : t) v = kInvalid;
+  for (int c = '0'; c <= '9'; ++c) t[c] = static_cast<uint8_t>(c - '0');
+  for (int c = 'a'; c <= 'f'; ++c) t[c] = static_cast<uint8_t>(c - 'a' + 10);
+  for (int c = 'A'; c <= 'F'; ++c) t[c] = static_cast<uint8_t>(c - 'A' + 10);
+  return t;
+}
+
+constexpr auto kNibble = make_nibble_table();
+constexpr char kDigits[] = "0123456789abcdef";
+
+bool decode_scalar(const char *in, std::size_t n_bytes, uint8_t *out) {
+  uint8_t bad = 0;
+  for (std::size_t i = 0; i < n_bytes; ++i) {
+    const uint8_t hi = kNibble[static_cast<uint8_t>(in[2 * i])];
+    const uint8_t lo = kNibble[static_cast<uint8_t>(in[2 * i + 1])];
+    // Invalid digits are 0xff, so any of them sets the high bits here
+    bad |= static_cast<uint8_t>(hi | lo);
+    out[i] = static_cast<uint8_t>((hi << 4) | (lo & 0x0f));
+  }
+  return (bad & 0xf0) == 0;
+}
+
+bool validate_scalar(const char *in, std::size_t n_chars) {
+  uint8_t bad = 0;
+  for (std::size_t i = 0; i < n_chars; ++i) {
+    bad |= kNibble[static_cast<uint8_t>(in[i])];
+  }
+  return (bad & 0xf0) == 0;
+}
+
+void encode_scalar(const uint8_t *in, std::size_t n_bytes, char *out) {
+  for (std::size_t i = 0; i < n_bytes; ++i) {
+    out[2 * i] = kDigits[in[i] >> 4];
+    out[2 * i + 1] = kDigits[in[i] & 0x0f];
+  }
+}
+
+#ifdef SENTINEL_HEX_X86
+
+// ---------------------------------------------------------------------------
+// SSE4.1: 32 digits <-> 16 bytes per step. Inputs of at least one step end
+// with an overlapping step instead of a scalar tail; the overlapped bytes
+// are simply produced twice.
+
+// Per-digit nibble value and a validity mask (0xff where valid). Bytes >=
+// 0x80 compare as negative, so they fail both ranges.
+__attribute__((target("sse4.1"))) inline __m128i
+nibbles_sse(__m128i v, __m128i &valid) {
+  const __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20)); // 'A' -> 'a'
+  const __m128i is_digit =
+      _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+                    _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), v));
+  const __m128i is_alpha =
+      _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                    _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), lower));
+  valid = _mm_and_si128(valid, _mm_or_si128(is_digit, is_alpha));
+  return _mm_blendv_epi8(_mm_sub_epi8(lower, _mm_set1_epi8('a' - 10)),
+                         _mm_sub_epi8(v, _mm_set1_epi8('0')), is_digit);
+}
+
+// 32 digits -> 16 bytes: (hi, lo) nibble pairs become hi * 16 + lo.
+__attribute__((target("sse4.1"))) inline __m128i
+decode32_sse(const char *in, __m128i &valid) {
+  const __m128i weights = _mm_set1_epi16(0x0110);
+  const __m128i a = nibbles_sse(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(in)), valid);
+  const __m128i b = nibbles_sse(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 16)), valid);
+  return _mm_packus_epi16(_mm_maddubs_epi16(a, weights),
+                          _mm_maddubs_epi16(b, weights));
+}
+
+__attribute__((target("sse4.1"))) bool
+decode_sse41(const char *in, std::size_t n_bytes, uint8_t *out) {
+  if (n_bytes < 16) {
+    return decode_scalar(in, n_bytes, out);
+  }
+  __m128i valid = _mm_set1_epi8(-1);
+  std::size_t i = 0;
+  for (; i + 16 <= n_bytes; i += 16) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i),
+                     decode32_sse(in + 2 * i, valid));
+  }
+  if (i < n_bytes) {
+    i = n_bytes - 16;
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i),
+                     decode32_sse(in + 2 * i, valid));
+  }
+  return _mm_movemask_epi8(valid) == 0xffff;
+}
+
+__attribute__((target("sse4.1"))) bool validate_sse41(const char *in,
+                                                      std::size_t n_chars) {
+  if (n_chars < 16) {
+    return validate_scalar(in, n_chars);
+  }
+  __m128i valid = _mm_set1_epi8(-1);
+  std::size_t i = 0;
+  for (; i + 16 <= n_chars; i += 16) {
+    nibbles_sse(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i)),
+                valid);
+  }
+  if (i < n_chars) {
+    nibbles_sse(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + n_chars - 16)),
+        valid);
+  }
+  return _mm_movemask_epi8(valid) == 0xffff;
+}
+
+// 16 bytes -> 32 digits
+__attribute__((target("sse4.1"))) inline void encode16_sse(const uint8_t *in,
+                                                           char *out) {
+  const __m128i lut = _mm_loadu_si128(reinterpret_cast<const __m128i *>(kDigits));
+  const __m128i mask = _mm_set1_epi8(0x0f);
+  const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+  const __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(v, 4), mask));
+  const __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(v, mask));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_unpacklo_epi8(hi, lo));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 16), _mm_unpackhi_epi8(hi, lo));
+}
+
+__attribute__((target("sse4.1"))) void
+encode_sse41(const uint8_t *in, std::size_t n_bytes, char *out) {
+  if (n_bytes < 16) {
+    encode_scalar(in, n_bytes, out);
+    return;
+  }
+  std::size_t i = 0;
+  for (; i + 16 <= n_bytes; i += 16) {
+    encode16_sse(in + i, out + 2 * i);
+  }
+  if (i < n_bytes) {
+    i = n_bytes - 16;
+    encode16_sse(in + i, out + 2 * i);
+  }
+}
+
+// ---------------------------------------------------------------------------
+// AVX2: 64 digits <-> 32 bytes per step with the same overlapping tail.
+// Shorter inputs go to the SSE4.1 kernel.
+
+__attribute__((target("avx2"))) inline __m256i nibbles_avx2(__m256i v,
+                                                            __m256i &valid) {
+  const __m256i lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+  const __m256i is_digit =
+      _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('0' - 1)),
+                       _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), v));
+  const __m256i is_alpha =
+      _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)),
+                       _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), lower));
+  valid = _mm256_and_si256(valid, _mm256_or_si256(is_digit, is_alpha));
+  return _mm256_blendv_epi8(_mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10)),
+                            _mm256_sub_epi8(v, _mm256_set1_epi8('0')), is_digit);
+}
+
+// 64 digits -> 32 bytes
+__attribute__((target("avx2"))) inline void
+decode64_avx2(const char *in, uint8_t *out, __m256i &valid) {
+  const __m256i weights = _mm256_set1_epi16(0x0110);
+  const __m256i a = nibbles_avx2(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in)), valid);
+  const __m256i b = nibbles_avx2(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + 32)), valid);
+  // packus works per 128-bit lane: restore byte order across lanes
+  const __m256i packed = _mm256_packus_epi16(_mm256_maddubs_epi16(a, weights),
+                                             _mm256_maddubs_epi16(b, weights));
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(out),
+                      _mm256_permute4x64_epi64(packed, 0xd8));
+}
+
+__attribute__((target("avx2"))) bool decode_avx2(const char *in,
+                                                 std::size_t n_bytes,
+                                                 uint8_t *out) {
+  if (n_bytes < 32) {
+    return decode_sse41(in, n_bytes, out);
+  }
+  __m256i valid = _mm256_set1_epi8(-1);
+  std::size_t i = 0;
+  for (; i + 32 <= n_bytes; i += 32) {
+    decode64_avx2(in + 2 * i, out + i, valid);
+  }
+  if (i < n_bytes) {
+    i = n_bytes - 32;
+    decode64_avx2(in + 2 * i, out + i, valid);
+  }
+  return _mm256_movemask_epi8(valid) == -1;
+}
+
+__attribute__((target("avx2"))) bool validate_avx2(const char *in,
+                                                   std::size_t n_chars) {
+  if (n_chars < 32) {
+    return validate_sse41(in, n_chars);
+  }
+  __m256i valid = _mm256_set1_epi8(-1);
+  std::size_t i = 0;
+  for (; i + 32 <= n_chars; i += 32) {
+    nibbles_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i)),
+                 valid);
+  }
+  if (i < n_chars) {
+    nibbles_avx2(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + n_chars - 32)),
+        valid);
+  }
+  return _mm256_movemask_epi8(valid) == -1;
+}
+
+// 32 bytes -> 64 digits
+__attribute__((target("avx2"))) inline void encode32_avx2(const uint8_t *in,
+                                                         char *out) {
+  const __m256i lut = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(kDigits)));
+  const __m256i mask = _mm256_set1_epi8(0x0f);
+  const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in));
+  const __m256i hi =
+      _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), mask));
+  const __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(v, mask));
+  // unpack is per lane too: a = bytes 0-7 | 16-23, b = 8-15 | 24-31
+  const __m256i a = _mm256_unpacklo_epi8(hi, lo);
+  const __m256i b = _mm256_unpackhi_epi8(hi, lo);
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(out),
+                      _mm256_permute2x128_si256(a, b, 0x20));
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 32),
+                      _mm256_permute2x128_si256(a, b, 0x31));
+}
+
+__attribute__((target("avx2"))) void encode_avx2(const uint8_t *in,
+                                                 std::size_t n_bytes,
+                                                 char *out) {
+  if (n_bytes < 32) {
+    encode_sse41(in, n_bytes, out);
+    return;
+  }
+  std::size_t i = 0;
+  for (; i + 32 <= n_bytes; i += 32) {
+    encode32_avx2(in + i, out + 2 * i);
+  }
+  if (i < n_bytes) {
+    i = n_bytes - 32;
+    encode32_avx2(in + i, out + 2 * i);
+  }
+}
+
+#endif // SENTINEL_HEX_X86
+
+constexpr HexKernels kScalar{"scalar", decode_scalar, validate_scalar,
+                             encode_scalar};
+
+std::vector<HexKernels> detect_kernels() {
+  std::vector<HexKernels> out;
+#ifdef SENTINEL_HEX_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    out.push_back({"avx2", decode_avx2, validate_avx2, encode_avx2});
+  }
+  if (__builtin_cpu_supports("sse4.1")) {
+    out.push_back({"sse4.1", decode_sse41, validate_sse41, encode_sse41});
+  }
+#endif
+  out.push_back(kScalar);
+  return out;
+}
+
+const std::vector<HexKernels> &kernels() {
+  static const std::vector<HexKernels> k = detect_kernels();
+  return k;
+}
+
+} // namespace
+
+const HexKernels &hex_kernels() {
+  static const HexKernels &best = kernels().front();
+  return best;
+}
+
+std::span<const HexKernels> available_hex_kernels() { return kernels(); }
+
+std::string bytes_to_hex(const uint8_t *data, std::size_t n) {
+  std::string out(2 + 2 * n, '0');
+  out[1] = 'x';
+  encode_hex(data, n, out.data() + 2);
+  return out;
+}
+
+} // namespace sentinel::events::utils
@@ -0,0 +1,120 @@
+#include "sentinel/events/utils/uint256.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+namespace sentinel::events::utils {
+
+namespace {
+
+constexpr uint64_t kPow10_19 = 10'000'000'000'000'000'000ULL;
+
+constexpr uint64_t pow10(unsigned n) {
+  uint64_t p = 1;
+  while (n-- > 0) {
+    p *= 10;
+  }
+  return p;
+}
+
+// 2^256 - 1 has 78 digits.
+constexpr std::size_t kMaxDigits = 78;
+
+// Writes the digits right-aligned into buf[0, kMaxDigits) and returns the
+// index of the first one.
+std::size_t format_digits(uint256 v, char (&buf)[kMaxDigits]) {
+  std::size_t pos = kMaxDigits;
+  while (!v.fits_u64()) {
+    uint64_t chunk = v.div_small(kPow10_19);
+    for (int i = 0; i < 19; ++i) {
+      buf[--pos] = static_cast<char>('0' + chunk % 10);
+      chunk /= 10;
+    }
+  }
+  char head[20];
+  const auto res = std::to_chars(head, head + sizeof(head), v.low64());
+  const std::size_t n = static_cast<std::size_t>(res.ptr - head);
+  pos -= n;
+  std::memcpy(buf + pos, head, n);
+  return pos;
+}
+
+std::string scale_digits(std::string digits, unsigned decimals) {
+  if (decimals == 0) {
+    return digits;
+  }
+  if (digits.size() <= decimals) {
+    digits.insert(0, decimals + 1 - digits.size(), '0');
+  }
+  const std::size_t point = digits.size() - decimals;
+  std::size_t end = digits.size();
+  while (end > point && digits[end - 1] == '0') {
+    --end;
+  }
+  if (end == point) {
+    digits.resize(point);
+    return digits;
+  }
+  digits.resize(end);
+  digits.insert(point, 1, '.');
+  return digits;
+}
+
+} // namespace
+
+uint256 uint256::from_decimal(std::string_view decimal) {
+  if (decimal.empty()) {
+    throw std::runtime_error("empty decimal string");
+  }
+
+  uint256 result;
+  // Fold up to 19 digits at a time: result = result * 10^k + chunk
+  for (std::size_t i = 0; i < decimal.size();) {
+    const std::size_t k = std::min<std::size_t>(19, decimal.size() - i);
+    uint64_t chunk = 0;
+    for (std::size_t j = 0; j < k; ++j) {
+      const char c = decimal[i + j];
+      if (c < '0' || c > '9') {
+        throw std::runtime_error("invalid decimal digit");
+      }
+      chunk = chunk * 10 + static_cast<uint64_t>(c - '0');
+    }
+    if (result.mul_small(pow10(static_cast<unsigned>(k))) != 0 ||
+        (result += uint256(chunk)) < uint256(chunk)) {
+      throw std::runtime_error("decimal string too large for 256-bit int");
+    }
+    i += k;
+  }
+  return result;
+}
+
+std::string uint256::to_decimal() const {
+  if (fits_u64()) {
+    return std::to_string(limbs_[0]);
+  }
+  char buf[kMaxDigits];
+  const std::size_t pos = format_digits(*this, buf);
+  return std::string(buf + pos, kMaxDigits - pos);
+}
+
+std::string uint256::to_decimal(unsigned decimals) const {
+  return scale_digits(to_decimal(), decimals);
+}
+
+std::string int256::to_decimal() const {
+  if (!is_negative()) {
+    return bits_.to_decimal();
+  }
+  return "-" + magnitude().to_decimal();
+}
+
+std::string int256::to_decimal(unsigned decimals) const {
+  if (!is_negative()) {
+    return bits_.to_decimal(decimals);
+  }
+  return "-" + magnitude().to_decimal(decimals);
+}
+
+} // namespace sentinel::events::utils
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cerrno>
 #include <csignal>
 #include <cstdlib>
@@ -11,6 +12,7 @@
 
 #include "sentinel/admin/encrypt_secret.hpp"
 #include "sentinel/app/app.hpp"
+#include "sentinel/replay/replay_runner.hpp"
 
 static std::string getenv_or(const char *k, const char *defv) {
   if (const char *v = std::getenv(k))
@@ -34,6 +36,10 @@ int main(int argc, char **argv) {
     return 1;
   }
 
+  if (argc >= 2 && std::strcmp(argv[1], "replay") == 0) {
+    return sentinel::replay::replay_command(argc, argv);
+  }
+
   sentinel::app::AppConfig cfg;
 
   cfg.chain = getenv_or("CHAIN", "arbitrum");
@@ -44,7 +50,58 @@ int main(int argc, char **argv) {
   const std::string log_level = getenv_or("LOG_LEVEL", "info");
   cfg.debug = (log_level == "debug") || env_is_true("DEBUG");
 
-  cfg.event_source_cfg.max_block_range = 1000;
+  cfg.event_source_cfg.max_block_range =
+      std::stoull(getenv_or("MAX_BLOCK_RANGE", "10000"));
+  cfg.event_source_cfg.initial_block_range = std::min<uint64_t>(
+      1000, cfg.event_source_cfg.max_block_range);
+  cfg.event_source_cfg.backfill_parallelism =
+      static_cast<unsigned>(std::stoul(getenv_or("BACKFILL_PARALLELISM", "4")));
+  cfg.event_source_cfg.backfill_max_inflight_bytes =
+      std::stoull(getenv_or("BACKFILL_MAX_INFLIGHT_MB", "256")) << 20;
+
+  cfg.log_filter_topics =
+      !std::getenv("LOG_FILTER_TOPICS") || env_is_true("LOG_FILTER_TOPICS");
+  cfg.log_filter_addresses = env_is_true("LOG_FILTER_ADDRESSES");
+  cfg.log_filter_max_addresses =
+      std::stoull(getenv_or("LOG_FILTER_MAX_ADDRESSES", "500"));
+
+  cfg.risk_engine_workers =
+      static_cast<unsigned>(std::stoul(getenv_or("RISK_ENGINE_WORKERS", "1")));
+
+  cfg.alert_queue_cfg.capacity =
+      std::stoull(getenv_or("ALERT_QUEUE_CAPACITY", "16384"));
+  if (getenv_or("ALERT_QUEUE_OVERFLOW", "block") == "drop") {
+    cfg.alert_queue_cfg.overflow = sentinel::risk::AlertOverflowPolicy::DropNewest;
+  }
+  cfg.alert_http_cfg.max_per_endpoint =
+      std::stoull(getenv_or("ALERT_HTTP_MAX_PER_ENDPOINT", "4"));
+  cfg.alert_http_cfg.max_total_connections =
+      std::stol(getenv_or("ALERT_HTTP_MAX_CONNECTIONS", "64"));
+  cfg.alert_http_cfg.retry.max_attempts =
+      std::stoull(getenv_or("ALERT_RETRY_MAX_ATTEMPTS", "4"));
+  cfg.alert_http_cfg.retry.initial_backoff =
+      std::chrono::milliseconds(std::stoll(getenv_or("ALERT_RETRY_BACKOFF_MS", "500")));
+  cfg.alert_http_cfg.breaker.failure_threshold =
+      std::stoull(getenv_or("ALERT_BREAKER_FAILURES", "5"));
+  cfg.alert_http_cfg.breaker.open_duration =
+      std::chrono::milliseconds(std::stoll(getenv_or("ALERT_BREAKER_OPEN_MS", "30000")));
+
+  cfg.alert_outbox =
+      !std::getenv("ALERT_OUTBOX_ENABLED") || env_is_true("ALERT_OUTBOX_ENABLED");
+  cfg.alert_outbox_cfg.buffer_capacity =
+      std::stoull(getenv_or("ALERT_OUTBOX_BUFFER", "65536"));
+  cfg.alert_outbox_cfg.flush_interval =
+      std::chrono::milliseconds(std::stoll(getenv_or("ALERT_OUTBOX_FLUSH_MS", "200")));
+
+  cfg.checkpoint_cfg.min_interval =
+      std::chrono::milliseconds(std::stoll(getenv_or("CHECKPOINT_INTERVAL_MS", "1000")));
+
+  cfg.rule_reload =
+      !std::getenv("RULE_RELOAD_ENABLED") || env_is_true("RULE_RELOAD_ENABLED");
+  cfg.startup_db_connections =
+      std::stoull(getenv_or("STARTUP_DB_CONNECTIONS", "4"));
+
+  cfg.rpc_capture_path = getenv_or("RPC_CAPTURE_PATH", "");
 
   sigset_t set;
   sigemptyset(&set);
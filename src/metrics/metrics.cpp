@@ -31,10 +31,42 @@ Metrics::Metrics(const std::string& listen_address, const std::string& chain)
           .Name("alerts_deduplicated_total")
           .Help("Total number of alerts suppressed by the deduplicator")
           .Register(*registry)),
+      alerts_dropped_total(prometheus::BuildCounter()
+          .Name("alerts_dropped_total")
+          .Help("Alerts dropped before reaching the dispatcher queue")
+          .Register(*registry)),
+      alert_retry_attempts_total(prometheus::BuildCounter()
+          .Name("alert_retry_attempts_total")
+          .Help("Alert HTTP requests sent again after a failed attempt")
+          .Register(*registry)),
+      alert_circuit_rejections_total(prometheus::BuildCounter()
+          .Name("alert_circuit_rejections_total")
+          .Help("Alert HTTP requests failed without sending because the endpoint's circuit breaker was open")
+          .Register(*registry)),
+      alert_outbox_dropped_total(prometheus::BuildCounter()
+          .Name("alert_outbox_dropped_total")
+          .Help("Alert outbox writes given up: buffer full, or a failed write at shutdown")
+          .Register(*registry)),
+      checkpoint_write_failures_total(prometheus::BuildCounter()
+          .Name("checkpoint_write_failures_total")
+          .Help("Failed attempts to persist the block checkpoint")
+          .Register(*registry)),
+      rule_config_reload_failures_total(prometheus::BuildCounter()
+          .Name("rule_config_reload_failures_total")
+          .Help("Rule config reloads that failed; the rule keeps its previous configs")
+          .Register(*registry)),
       rpc_calls_total(prometheus::BuildCounter()
           .Name("rpc_calls_total")
           .Help("Total number of RPC calls made")
           .Register(*registry)),
+      risk_engine_shard_signals_total(prometheus::BuildCounter()
+          .Name("risk_engine_shard_signals_total")
+          .Help("Signals evaluated by each risk engine worker")
+          .Register(*registry)),
+      risk_engine_shard_busy_seconds_total(prometheus::BuildCounter()
+          .Name("risk_engine_shard_busy_seconds_total")
+          .Help("Time each risk engine worker spent evaluating rules")
+          .Register(*registry)),
 
       // Gauges
       ring_buffer_depth(prometheus::BuildGauge()
@@ -45,6 +77,34 @@ Metrics::Metrics(const std::string& listen_address, const std::string& chain)
           .Name("alert_queue_depth")
           .Help("Current number of items in the alert dispatcher queue")
           .Register(*registry)),
+      alert_deliveries_in_flight(prometheus::BuildGauge()
+          .Name("alert_deliveries_in_flight")
+          .Help("Alert deliveries handed to a channel and not yet completed")
+          .Register(*registry)),
+      alert_circuit_breakers(prometheus::BuildGauge()
+          .Name("alert_circuit_breakers")
+          .Help("Alert endpoints per circuit breaker state")
+          .Register(*registry)),
+      alert_retry_queue_depth(prometheus::BuildGauge()
+          .Name("alert_retry_queue_depth")
+          .Help("Alert HTTP requests waiting for their next retry")
+          .Register(*registry)),
+      alert_outbox_backlog(prometheus::BuildGauge()
+          .Name("alert_outbox_backlog")
+          .Help("Alert outbox records and completions not yet written to the database")
+          .Register(*registry)),
+      checkpoint_block(prometheus::BuildGauge()
+          .Name("checkpoint_block")
+          .Help("Last block persisted as fully processed; a restart resumes after it")
+          .Register(*registry)),
+      rule_config_generation(prometheus::BuildGauge()
+          .Name("rule_config_generation")
+          .Help("Config snapshots each rule has published since startup")
+          .Register(*registry)),
+      startup_phase_duration_seconds(prometheus::BuildGauge()
+          .Name("startup_phase_duration_seconds")
+          .Help("Seconds spent in each startup phase; ready and first_rpc count from startup")
+          .Register(*registry)),
       last_rpc_success_timestamp_seconds(prometheus::BuildGauge()
           .Name("last_rpc_success_timestamp_seconds")
           .Help("Unix timestamp of the last successful RPC call")
@@ -61,6 +121,18 @@ Metrics::Metrics(const std::string& listen_address, const std::string& chain)
           .Name("last_processed_block")
           .Help("Highest block number successfully processed by the system")
           .Register(*registry)),
+      backfill_blocks_per_second(prometheus::BuildGauge()
+          .Name("backfill_blocks_per_second")
+          .Help("Average throughput of the running parallel backfill (0 when idle)")
+          .Register(*registry)),
+      getlogs_block_range(prometheus::BuildGauge()
+          .Name("getlogs_block_range")
+          .Help("Block range the adaptive controller will use for the next eth_getLogs")
+          .Register(*registry)),
+      risk_engine_shard_queue_depth(prometheus::BuildGauge()
+          .Name("risk_engine_shard_queue_depth")
+          .Help("Current number of signals queued for each risk engine worker")
+          .Register(*registry)),
 
       // Histograms
       alert_send_duration_seconds(prometheus::BuildHistogram()
@@ -71,9 +143,25 @@ Metrics::Metrics(const std::string& listen_address, const std::string& chain)
           .Name("signal_to_alert_seconds")
           .Help("End-to-end latency from signal ingress to alert sent")
           .Register(*registry)),
+      alert_enqueue_duration_seconds(prometheus::BuildHistogram()
+          .Name("alert_enqueue_duration_seconds")
+          .Help("Time AlertDispatcher::dispatch() spent queueing an alert")
+          .Register(*registry)),
+      alert_outbox_flush_duration_seconds(prometheus::BuildHistogram()
+          .Name("alert_outbox_flush_duration_seconds")
+          .Help("Time to write one batch of alert outbox rows")
+          .Register(*registry)),
+      rule_config_reload_duration_seconds(prometheus::BuildHistogram()
+          .Name("rule_config_reload_duration_seconds")
+          .Help("Time from a rule config change notification until the new configs are published")
+          .Register(*registry)),
       rpc_call_duration_seconds(prometheus::BuildHistogram()
           .Name("rpc_call_duration_seconds")
           .Help("Duration of RPC calls in seconds")
+          .Register(*registry)),
+      rpc_call_phase_seconds(prometheus::BuildHistogram()
+          .Name("rpc_call_phase_seconds")
+          .Help("RPC call time split into connect (TCP+TLS setup) and transfer phases")
           .Register(*registry))
 {
     // Register the registry with the exposer
@@ -90,6 +178,8 @@ Metrics::Metrics(const std::string& listen_address, const std::string& chain)
     last_alert_success_timestamp_seconds_chain = &last_alert_success_timestamp_seconds.Add(chain_label);
     last_seen_block_chain = &last_seen_block.Add(chain_label);
     last_processed_block_chain = &last_processed_block.Add(chain_label);
+    backfill_blocks_per_second_chain = &backfill_blocks_per_second.Add(chain_label);
+    getlogs_block_range_chain = &getlogs_block_range.Add(chain_label);
 }
 
 } // namespace sentinel::metrics
@@ -0,0 +1,231 @@
+#include "sentinel/replay/corpus.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include <zlib.h>
+
+#include "sentinel/log.hpp"
+
+namespace sentinel::replay {
+
+namespace {
+
+constexpr char kMagic[8] = {'S', 'N', 'T', 'L', 'R', 'P', 'C', '1'};
+// kind, offset_us, a, b, part, body_len
+constexpr std::size_t kHeaderSize = 1 + 8 + 8 + 8 + 4 + 4;
+// Larger bodies are treated as corruption rather than allocated
+constexpr uint32_t kMaxBodySize = 1u << 30;
+
+void put_u64(uint8_t *p, uint64_t v) {
+  for (int i = 0; i < 8; ++i) {
+    p[i] = static_cast<uint8_t>(v >> (8 * i));
+  }
+}
+
+void put_u32(uint8_t *p, uint32_t v) {
+  for (int i = 0; i < 4; ++i) {
+    p[i] = static_cast<uint8_t>(v >> (8 * i));
+  }
+}
+
+uint64_t get_u64(const uint8_t *p) {
+  uint64_t v = 0;
+  for (int i = 0; i < 8; ++i) {
+    v |= static_cast<uint64_t>(p[i]) << (8 * i);
+  }
+  return v;
+}
+
+uint32_t get_u32(const uint8_t *p) {
+  uint32_t v = 0;
+  for (int i = 0; i < 4; ++i) {
+    v |= static_cast<uint32_t>(p[i]) << (8 * i);
+  }
+  return v;
+}
+
+} // namespace
+
+CorpusWriter::CorpusWriter(const std::string &path)
+  : started_at_(std::chrono::steady_clock::now()) {
+  // Level 1: the corpus is written on the fetch threads
+  file_ = gzopen(path.c_str(), "wb1");
+  if (!file_) {
+    throw std::runtime_error("cannot create RPC capture file " + path);
+  }
+  if (gzwrite(file_, kMagic, sizeof(kMagic)) != static_cast<int>(sizeof(kMagic))) {
+    gzclose(file_);
+    throw std::runtime_error("cannot write RPC capture file " + path);
+  }
+}
+
+CorpusWriter::~CorpusWriter() {
+  if (file_) {
+    gzclose(file_);
+  }
+}
+
+uint64_t CorpusWriter::offset_us_() const {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                   std::chrono::steady_clock::now() - started_at_)
+                                   .count());
+}
+
+void CorpusWriter::chain_id(uint64_t chain_id) {
+  const uint64_t offset = offset_us_();
+  std::lock_guard<std::mutex> lk(mutex_);
+  write_(RecordKind::ChainId, offset, chain_id, 0, 0, {});
+}
+
+void CorpusWriter::head(uint64_t block) {
+  const uint64_t offset = offset_us_();
+  std::lock_guard<std::mutex> lk(mutex_);
+  write_(RecordKind::Head, offset, block, 0, 0, {});
+}
+
+void CorpusWriter::block_timestamp(uint64_t block, uint64_t timestamp) {
+  const uint64_t offset = offset_us_();
+  std::lock_guard<std::mutex> lk(mutex_);
+  write_(RecordKind::BlockTimestamp, offset, block, timestamp, 0, {});
+}
+
+void CorpusWriter::logs(uint64_t from_block, uint64_t to_block,
+                        const std::vector<std::string_view> &bodies) {
+  const uint64_t offset = offset_us_();
+  std::lock_guard<std::mutex> lk(mutex_);
+  for (std::size_t i = 0; i < bodies.size(); ++i) {
+    write_(RecordKind::Logs, offset, from_block, to_block, static_cast<uint32_t>(i), bodies[i]);
+  }
+}
+
+std::size_t CorpusWriter::records() const {
+  std::lock_guard<std::mutex> lk(mutex_);
+  return records_;
+}
+
+void CorpusWriter::write_(RecordKind kind, uint64_t offset_us, uint64_t a, uint64_t b,
+                          uint32_t part, std::string_view body) {
+  if (failed_) {
+    return;
+  }
+
+  std::array<uint8_t, kHeaderSize> header{};
+  header[0] = static_cast<uint8_t>(kind);
+  put_u64(&header[1], offset_us);
+  put_u64(&header[9], a);
+  put_u64(&header[17], b);
+  put_u32(&header[25], part);
+  put_u32(&header[29], static_cast<uint32_t>(body.size()));
+
+  const bool ok =
+      body.size() < kMaxBodySize &&
+      gzwrite(file_, header.data(), header.size()) == static_cast<int>(header.size()) &&
+      (body.empty() ||
+       gzwrite(file_, body.data(), static_cast<unsigned>(body.size())) ==
+           static_cast<int>(body.size()));
+  if (!ok) {
+    failed_ = true;
+    int err = Z_OK;
+    const char *msg = gzerror(file_, &err);
+    sentinel::logger(sentinel::LogComponent::Adapter)
+        .error("RPC capture stopped: write failed ({})", msg ? msg : "unknown error");
+    return;
+  }
+  ++records_;
+}
+
+CorpusReader::CorpusReader(const std::string &path) {
+  file_ = gzopen(path.c_str(), "rb");
+  if (!file_) {
+    throw std::runtime_error("cannot open RPC corpus " + path);
+  }
+  // Bodies can be several MB; a larger buffer saves read calls
+  gzbuffer(file_, 1u << 20);
+
+  char magic[sizeof(kMagic)];
+  if (!read_(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+    gzclose(file_);
+    throw std::runtime_error(path + " is not an RPC corpus");
+  }
+}
+
+CorpusReader::~CorpusReader() {
+  if (file_) {
+    gzclose(file_);
+  }
+}
+
+bool CorpusReader::read_(void *buf, std::size_t n) {
+  auto *out = static_cast<char *>(buf);
+  while (n > 0) {
+    const unsigned chunk =
+        static_cast<unsigned>(std::min<std::size_t>(n, std::numeric_limits<int>::max()));
+    const int got = gzread(file_, out, chunk);
+    if (got <= 0) {
+      return false;
+    }
+    out += got;
+    n -= static_cast<std::size_t>(got);
+  }
+  return true;
+}
+
+bool CorpusReader::next(CorpusRecord &record) {
+  std::array<uint8_t, kHeaderSize> header{};
+
+  // Distinguish a clean end from a record cut short
+  const int first = gzread(file_, header.data(), 1);
+  if (first <= 0) {
+    int err = Z_OK;
+    gzerror(file_, &err);
+    truncated_ = err != Z_OK && err != Z_STREAM_END;
+    return false;
+  }
+  if (!read_(header.data() + 1, header.size() - 1)) {
+    truncated_ = true;
+    return false;
+  }
+
+  const uint8_t kind = header[0];
+  if (kind < static_cast<uint8_t>(RecordKind::ChainId) ||
+      kind > static_cast<uint8_t>(RecordKind::Logs)) {
+    throw std::runtime_error("RPC corpus: unknown record kind " + std::to_string(kind));
+  }
+  const uint32_t body_len = get_u32(&header[29]);
+  if (body_len >= kMaxBodySize) {
+    throw std::runtime_error("RPC corpus: record body too large");
+  }
+
+  record.kind = static_cast<RecordKind>(kind);
+  record.offset_us = get_u64(&header[1]);
+  record.a = get_u64(&header[9]);
+  record.b = get_u64(&header[17]);
+  record.part = get_u32(&header[25]);
+  record.body.resize(body_len);
+  if (body_len > 0 && !read_(record.body.data(), body_len)) {
+    truncated_ = true;
+    return false;
+  }
+  return true;
+}
+
+std::vector<CorpusRecord> read_corpus(const std::string &path) {
+  CorpusReader reader(path);
+  std::vector<CorpusRecord> records;
+  CorpusRecord record;
+  while (reader.next(record)) {
+    records.push_back(std::move(record));
+  }
+  if (reader.truncated()) {
+    sentinel::logger(sentinel::LogComponent::Adapter)
+        .warn("RPC corpus {} ends in a partial record; replaying the {} complete ones",
+              path, records.size());
+  }
+  return records;
+}
+
+} // namespace sentinel::replay
@@ -0,0 +1,56 @@
+#include "sentinel/replay/latency_histogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace sentinel::replay {
+
+std::size_t LatencyHistogram::bucket_of(uint64_t ns) noexcept {
+  if (ns < 32) {
+    return static_cast<std::size_t>(ns);
+  }
+  // ns in [2^octave, 2^(octave+1)), octave >= 5; the 3 bits below the
+  // leading one pick the sub-bucket
+  const unsigned octave = static_cast<unsigned>(std::bit_width(ns)) - 1;
+  const unsigned sub = static_cast<unsigned>(ns >> (octave - 3)) & 7u;
+  return 32 + (octave - 5) * 8 + sub;
+}
+
+uint64_t LatencyHistogram::bucket_upper(std::size_t bucket) noexcept {
+  if (bucket < 32) {
+    return bucket;
+  }
+  const unsigned octave = 5 + static_cast<unsigned>((bucket - 32) / 8);
+  const uint64_t sub = (bucket - 32) % 8;
+  const uint64_t width = uint64_t{1} << (octave - 3);
+  return ((8 + sub) << (octave - 3)) + (width - 1);
+}
+
+uint64_t LatencyHistogram::count() const noexcept {
+  uint64_t n = 0;
+  for (const auto &b : buckets_) {
+    n += b.load(std::memory_order_relaxed);
+  }
+  return n;
+}
+
+uint64_t LatencyHistogram::percentile(double p) const noexcept {
+  const uint64_t total = count();
+  if (total == 0) {
+    return 0;
+  }
+  const auto rank = std::max<uint64_t>(
+      1, static_cast<uint64_t>(std::ceil(static_cast<double>(total) * p / 100.0)));
+
+  uint64_t seen = 0;
+  for (std::size_t i = 0; i < kBuckets; ++i) {
+    seen += buckets_[i].load(std::memory_order_relaxed);
+    if (seen >= rank) {
+      return std::min(bucket_upper(i), max());
+    }
+  }
+  return max();
+}
+
+} // namespace sentinel::replay
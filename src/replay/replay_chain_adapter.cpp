@@ -0,0 +1,248 @@
+#include "sentinel/replay/replay_chain_adapter.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include <nlohmann/json.hpp>
+
+#include "sentinel/events/log_stream_decoder.hpp"
+#include "sentinel/events/utils/hex.hpp"
+
+namespace sentinel::replay {
+
+namespace {
+
+int64_t steady_now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+bool before(const sentinel::risk::Signal &a, const sentinel::risk::Signal &b) {
+  return a.meta.block_number != b.meta.block_number ? a.meta.block_number < b.meta.block_number
+                                                    : a.meta.log_index < b.meta.log_index;
+}
+
+} // namespace
+
+ReplayChainAdapter::ReplayChainAdapter(std::vector<CorpusRecord> records, ReplayPace pace)
+  : pace_(pace) {
+  std::vector<std::pair<uint64_t, Range>> recorded;
+  bool have_chain_id = false;
+
+  for (auto &record : records) {
+    switch (record.kind) {
+    case RecordKind::ChainId:
+      if (!have_chain_id) {
+        chain_id_ = record.a;
+        have_chain_id = true;
+      }
+      break;
+    case RecordKind::Head:
+      availability_.emplace_back(record.offset_us, record.a);
+      break;
+    case RecordKind::BlockTimestamp:
+      timestamps_.emplace(record.a, record.b);
+      break;
+    case RecordKind::Logs:
+      if (record.part == 0) {
+        recorded.push_back({record.a, Range{record.b, record.offset_us, {}}});
+      } else if (recorded.empty() || recorded.back().first != record.a ||
+                 recorded.back().second.to_block != record.b ||
+                 recorded.back().second.bodies.size() != record.part) {
+        throw std::runtime_error("RPC corpus: logs chunk " + std::to_string(record.part) +
+                                 " of blocks [" + std::to_string(record.a) + ".." +
+                                 std::to_string(record.b) + "] is out of sequence");
+      }
+      corpus_bytes_ += record.body.size();
+      recorded.back().second.bodies.push_back(std::move(record.body));
+      availability_.emplace_back(record.offset_us, record.b);
+      break;
+    }
+  }
+
+  if (!have_chain_id) {
+    throw std::runtime_error("RPC corpus has no chain id record");
+  }
+
+  // A range fetched twice (or overlapping an earlier one) is served once
+  for (auto &[from, range] : recorded) {
+    auto next = ranges_.lower_bound(from);
+    const bool overlaps_next = next != ranges_.end() && next->first <= range.to_block;
+    const bool overlaps_prev =
+        next != ranges_.begin() && std::prev(next)->second.to_block >= from;
+    if (overlaps_next || overlaps_prev) {
+      ++overlapping_ranges_;
+      continue;
+    }
+    last_block_ = std::max(last_block_, range.to_block);
+    ranges_.emplace(from, std::move(range));
+  }
+
+  if (ranges_.empty()) {
+    throw std::runtime_error("RPC corpus has no eth_getLogs responses");
+  }
+  first_block_ = ranges_.begin()->first;
+
+  // Running maximum, so a later head never goes backwards
+  std::stable_sort(availability_.begin(), availability_.end(),
+                   [](const auto &a, const auto &b) { return a.first < b.first; });
+  uint64_t highest = 0;
+  for (auto &[offset, block] : availability_) {
+    highest = std::max(highest, std::min(block, last_block_));
+    block = highest;
+  }
+}
+
+std::string ReplayChainAdapter::name() const { return "replay"; }
+
+uint64_t ReplayChainAdapter::chainId() { return chain_id_; }
+
+uint64_t ReplayChainAdapter::latestBlock() {
+  if (pace_ == ReplayPace::Fast || availability_.empty()) {
+    return last_block_;
+  }
+
+  int64_t start = replay_start_ns_.load(std::memory_order_relaxed);
+  if (start == 0) {
+    const int64_t now = steady_now_ns();
+    start = replay_start_ns_.compare_exchange_strong(start, now) ? now : start;
+  }
+
+  // The capture's startup before its first fetch is not replayed
+  const uint64_t elapsed_us =
+      static_cast<uint64_t>((steady_now_ns() - start) / 1000) + availability_.front().first;
+  auto it = std::upper_bound(availability_.begin(), availability_.end(), elapsed_us,
+                             [](uint64_t t, const auto &point) { return t < point.first; });
+  if (it == availability_.begin()) {
+    return first_block_ > 0 ? first_block_ - 1 : 0;
+  }
+  return std::prev(it)->second;
+}
+
+uint64_t ReplayChainAdapter::blockTimestamp(uint64_t block_number) {
+  if (timestamps_.empty()) {
+    throw std::runtime_error("RPC corpus has no block timestamps");
+  }
+  auto it = timestamps_.upper_bound(block_number);
+  if (it == timestamps_.begin()) {
+    return it->second;
+  }
+  return std::prev(it)->second;
+}
+
+std::size_t ReplayChainAdapter::decode_(uint64_t from_block, uint64_t to_block,
+                                        uint64_t chain_id,
+                                        std::vector<sentinel::risk::Signal> &out) {
+  if (to_block < from_block) {
+    throw std::runtime_error("replay: to_block < from_block");
+  }
+
+  auto it = ranges_.upper_bound(from_block);
+  if (it != ranges_.begin() && std::prev(it)->second.to_block >= from_block) {
+    --it;
+  }
+
+  const std::size_t base = out.size();
+  std::size_t bytes = 0;
+  bool partial = false;
+  bool chunked = false;
+  try {
+    for (; it != ranges_.end() && it->first <= to_block; ++it) {
+      const Range &range = it->second;
+      partial |= it->first < from_block || range.to_block > to_block;
+      chunked |= range.bodies.size() > 1;
+      for (const auto &body : range.bodies) {
+        sentinel::events::decode_get_logs_response(body, chain_id, out);
+        bytes += body.size();
+      }
+    }
+  } catch (...) {
+    out.resize(base);
+    throw;
+  }
+
+  if (partial) {
+    out.erase(std::remove_if(out.begin() + static_cast<std::ptrdiff_t>(base), out.end(),
+                             [&](const sentinel::risk::Signal &s) {
+                               return s.meta.block_number < from_block ||
+                                      s.meta.block_number > to_block;
+                             }),
+              out.end());
+  }
+  if (chunked) {
+    std::stable_sort(out.begin() + static_cast<std::ptrdiff_t>(base), out.end(), before);
+  }
+  return bytes;
+}
+
+std::vector<sentinel::events::RawLog> ReplayChainAdapter::getLogs(uint64_t from_block,
+                                                                  uint64_t to_block) {
+  using sentinel::events::RawLog;
+  using sentinel::events::utils::parse_hex_uint64;
+
+  std::vector<RawLog> out;
+  auto it = ranges_.upper_bound(from_block);
+  if (it != ranges_.begin() && std::prev(it)->second.to_block >= from_block) {
+    --it;
+  }
+  for (; it != ranges_.end() && it->first <= to_block; ++it) {
+    for (const auto &body : it->second.bodies) {
+      const auto res = nlohmann::json::parse(body);
+      if (!res.contains("result") || !res["result"].is_array()) {
+        throw std::runtime_error("eth_getLogs: missing result array");
+      }
+      for (const auto &jlog : res["result"]) {
+        RawLog log = jlog.get<RawLog>();
+        const uint64_t block = parse_hex_uint64(log.blockNumber);
+        if (block >= from_block && block <= to_block) {
+          out.push_back(std::move(log));
+        }
+      }
+    }
+  }
+
+  auto position = [](const RawLog &log) {
+    return std::pair{parse_hex_uint64(log.blockNumber), parse_hex_uint64(log.logIndex)};
+  };
+  std::stable_sort(out.begin(), out.end(),
+                   [&](const RawLog &a, const RawLog &b) { return position(a) < position(b); });
+  return out;
+}
+
+void ReplayChainAdapter::getSignals(uint64_t from_block, uint64_t to_block, uint64_t chain_id,
+                                    std::vector<sentinel::risk::Signal> &out) {
+  const auto start = std::chrono::steady_clock::now();
+  const std::size_t base = out.size();
+  decode_(from_block, to_block, chain_id, out);
+  signals_served_.fetch_add(out.size() - base, std::memory_order_relaxed);
+  fetch_latency_.record(static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+          .count()));
+}
+
+ChainAdapter::RangeFetch ReplayChainAdapter::fetchRange(uint64_t from_block, uint64_t to_block,
+                                                        uint64_t chain_id,
+                                                        std::vector<sentinel::risk::Signal> &out) {
+  const auto start = std::chrono::steady_clock::now();
+  const std::size_t base = out.size();
+
+  RangeFetch res;
+  res.response_bytes = decode_(from_block, to_block, chain_id, out);
+  res.chain_head = latestBlock();
+  try {
+    res.to_block_timestamp = blockTimestamp(to_block);
+  } catch (const std::exception &e) {
+    res.timestamp_error = e.what();
+  }
+
+  signals_served_.fetch_add(out.size() - base, std::memory_order_relaxed);
+  fetch_latency_.record(static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+          .count()));
+  return res;
+}
+
+} // namespace sentinel::replay
@@ -0,0 +1,328 @@
+#include "sentinel/replay/replay_runner.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+
+#include "sentinel/events/EventSource.hpp"
+#include "sentinel/log.hpp"
+#include "sentinel/replay/corpus.hpp"
+#include "sentinel/replay/latency_histogram.hpp"
+#include "sentinel/replay/rules_file.hpp"
+#include "sentinel/risk/alert_channel.hpp"
+#include "sentinel/risk/alert_dispatcher.hpp"
+#include "sentinel/risk/checkpoint_writer.hpp"
+#include "sentinel/risk/risk_engine.hpp"
+
+namespace sentinel::replay {
+
+namespace {
+
+using sentinel::risk::Alert;
+using sentinel::risk::IRiskRule;
+using sentinel::risk::Signal;
+
+uint64_t elapsed_ns(std::chrono::steady_clock::time_point since) {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now() - since)
+                                   .count());
+}
+
+// Times each evaluate() of the wrapped rule and counts its alerts
+class TimedRule : public IRiskRule {
+public:
+  explicit TimedRule(std::unique_ptr<IRiskRule> inner) : inner_(std::move(inner)) {}
+
+  sentinel::risk::SignalMask interests() const override { return inner_->interests(); }
+  std::string_view rule_type_name() const override { return inner_->rule_type_name(); }
+
+  void evaluate(const Signal &signal, sentinel::risk::StateStore &state_store,
+                std::vector<Alert> &out) override {
+    const std::size_t before = out.size();
+    const auto start = std::chrono::steady_clock::now();
+    inner_->evaluate(signal, state_store, out);
+    latency_.record(elapsed_ns(start));
+    if (out.size() != before) {
+      alerts_.fetch_add(out.size() - before, std::memory_order_relaxed);
+    }
+  }
+
+  const LatencyHistogram &latency() const { return latency_; }
+  uint64_t alerts() const { return alerts_.load(std::memory_order_relaxed); }
+
+private:
+  std::unique_ptr<IRiskRule> inner_;
+  LatencyHistogram latency_;
+  std::atomic<uint64_t> alerts_{0};
+};
+
+class CountingChannel : public sentinel::risk::IAlertChannel {
+public:
+  CountingChannel(std::atomic<uint64_t> &delivered, LatencyHistogram &latency)
+    : delivered_(delivered), latency_(latency) {}
+
+  std::string name() const override { return "replay"; }
+
+  void send(const Alert &alert) override {
+    delivered_.fetch_add(1, std::memory_order_relaxed);
+    if (alert.internal_ingress_time_ms == 0) {
+      return;
+    }
+    const auto now_ms = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+    if (now_ms >= alert.internal_ingress_time_ms) {
+      latency_.record((now_ms - alert.internal_ingress_time_ms) * 1'000'000);
+    }
+  }
+
+private:
+  std::atomic<uint64_t> &delivered_;
+  LatencyHistogram &latency_;
+};
+
+// Progress is read from CheckpointWriter::latest(); nothing is persisted
+class NullCheckpointSink : public sentinel::risk::ICheckpointSink {
+public:
+  void save(uint64_t) override {}
+};
+
+StageLatency summarize(std::string stage, const LatencyHistogram &h) {
+  return StageLatency{.stage = std::move(stage),
+                      .count = h.count(),
+                      .p50_ns = h.percentile(50),
+                      .p90_ns = h.percentile(90),
+                      .p99_ns = h.percentile(99),
+                      .p999_ns = h.percentile(99.9),
+                      .max_ns = h.max()};
+}
+
+std::string human_duration(uint64_t ns) {
+  std::ostringstream s;
+  s << std::fixed << std::setprecision(1);
+  if (ns < 1'000) {
+    s << ns << "ns";
+  } else if (ns < 1'000'000) {
+    s << static_cast<double>(ns) / 1e3 << "us";
+  } else if (ns < 1'000'000'000) {
+    s << static_cast<double>(ns) / 1e6 << "ms";
+  } else {
+    s << static_cast<double>(ns) / 1e9 << "s";
+  }
+  return s.str();
+}
+
+void print_usage(const char *prog) {
+  std::cerr << "Usage: " << prog
+            << " replay <corpus> [--rules <rules.json>] [--paced]"
+               " [--workers <n>] [--backfill <n>] [--max-block-range <n>]"
+               " [--timeout-s <n>] [--verbose]\n"
+               "\n"
+               "  Feeds an RPC capture (RPC_CAPTURE_PATH) through the pipeline and\n"
+               "  reports throughput and per-stage latency percentiles.\n"
+               "  --paced   advance the chain head as during the capture instead of\n"
+               "            making every block available at once\n";
+}
+
+} // namespace
+
+double ReplayReport::signals_per_second() const {
+  return wall_seconds > 0 ? static_cast<double>(signals) / wall_seconds : 0;
+}
+
+double ReplayReport::alerts_per_second() const {
+  return wall_seconds > 0 ? static_cast<double>(alerts_delivered) / wall_seconds : 0;
+}
+
+ReplayReport run_replay(ReplayChainAdapter &adapter, std::vector<std::unique_ptr<IRiskRule>> rules,
+                        const ReplayOptions &options) {
+  using namespace sentinel::risk;
+  const std::string chain = "replay";
+
+  std::vector<std::unique_ptr<TimedRule>> timed;
+  std::vector<std::string> rule_types;
+  for (auto &rule : rules) {
+    rule_types.emplace_back(rule->rule_type_name());
+    timed.push_back(std::make_unique<TimedRule>(std::move(rule)));
+  }
+
+  std::atomic<uint64_t> delivered{0};
+  LatencyHistogram signal_to_alert;
+
+  RingBuffer<Signal> ring(65536);
+  AlertDispatcher dispatcher(chain, nullptr, DeduplicatorConfig{}, rule_types);
+  dispatcher.add_channel(std::make_unique<CountingChannel>(delivered, signal_to_alert));
+
+  const uint64_t first = adapter.first_block();
+  CheckpointWriter checkpoints(std::make_unique<NullCheckpointSink>(), first > 0 ? first - 1 : 0,
+                               CheckpointWriterConfig{.min_interval = std::chrono::milliseconds(0)});
+  dispatcher.set_checkpoint_writer(&checkpoints);
+
+  RiskEngine engine(ring, dispatcher, chain, nullptr, nullptr,
+                    RiskEngineConfig{.workers = std::max(1u, options.risk_engine_workers)});
+  for (auto &rule : timed) {
+    engine.register_rule(rule.get());
+  }
+
+  sentinel::events::EventSourceConfig source_cfg;
+  // 0 would mean "start at the head"
+  source_cfg.start_block = std::max<uint64_t>(first, 1);
+  source_cfg.max_block_range = std::max<uint64_t>(options.max_block_range, 1);
+  source_cfg.initial_block_range = std::min<uint64_t>(1000, source_cfg.max_block_range);
+  source_cfg.backfill_parallelism = std::max(1u, options.backfill_parallelism);
+  source_cfg.idle_sleep = std::chrono::milliseconds(1);
+  source_cfg.error_backoff = std::chrono::milliseconds(10);
+  sentinel::events::EventSource source(adapter, ring, source_cfg, chain);
+
+  ReplayReport report;
+  report.first_block = first;
+  report.last_block = adapter.last_block();
+  report.ranges = adapter.ranges();
+  report.corpus_bytes = adapter.corpus_bytes();
+
+  const auto start = std::chrono::steady_clock::now();
+  std::jthread dispatcher_thread([&](std::stop_token st) { dispatcher.run(st); });
+  std::jthread engine_thread([&](std::stop_token st) { engine.run(st); });
+  std::jthread source_thread([&](std::stop_token st) { source.run(st); });
+
+  while (checkpoints.latest() < report.last_block) {
+    if (options.timeout.count() > 0 && std::chrono::steady_clock::now() - start > options.timeout) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+  }
+  report.completed = checkpoints.latest() >= report.last_block;
+  report.wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  // Same order as the app: source, then a Stop through the ring, then the
+  // dispatcher
+  source.stop();
+  source_thread.request_stop();
+  source_thread.join();
+
+  Signal stop;
+  stop.type = SignalType::Control;
+  stop.payload = ControlSignal{ControlSignal::Command::Stop};
+  while (!ring.try_push(stop)) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  engine_thread.join();
+
+  dispatcher.stop();
+  dispatcher_thread.request_stop();
+  dispatcher_thread.join();
+
+  report.signals = adapter.signals_served();
+  report.alerts_delivered = delivered.load();
+  report.stages.push_back(summarize("fetch", adapter.fetch_latency()));
+  for (const auto &rule : timed) {
+    report.alerts_generated += rule->alerts();
+    report.stages.push_back(
+        summarize("rule:" + std::string(rule->rule_type_name()), rule->latency()));
+  }
+  report.stages.push_back(summarize("signal_to_alert", signal_to_alert));
+  return report;
+}
+
+void print_report(const ReplayReport &report, std::ostream &out) {
+  out << std::fixed << std::setprecision(3);
+  out << "blocks      " << report.first_block << ".." << report.last_block << " ("
+      << report.ranges << " recorded ranges, " << report.corpus_bytes << " response bytes)\n";
+  out << "wall        " << report.wall_seconds << " s" << (report.completed ? "" : " (timed out)")
+      << "\n";
+  out << std::setprecision(1);
+  out << "signals     " << report.signals << " (" << report.signals_per_second() << "/s)\n";
+  out << "alerts      " << report.alerts_delivered << " delivered, " << report.alerts_generated
+      << " generated (" << report.alerts_per_second() << "/s)\n\n";
+
+  out << std::left << std::setw(24) << "stage" << std::right << std::setw(12) << "count";
+  for (const char *col : {"p50", "p90", "p99", "p99.9", "max"}) {
+    out << std::setw(11) << col;
+  }
+  out << "\n";
+  for (const auto &s : report.stages) {
+    out << std::left << std::setw(24) << s.stage << std::right << std::setw(12) << s.count;
+    for (uint64_t v : {s.p50_ns, s.p90_ns, s.p99_ns, s.p999_ns, s.max_ns}) {
+      out << std::setw(11) << human_duration(v);
+    }
+    out << "\n";
+  }
+}
+
+int replay_command(int argc, char **argv) {
+  // argv: [sentinel, replay, <corpus>, ...]
+  if (argc < 3 || argv[2][0] == '-') {
+    print_usage(argv[0]);
+    return 1;
+  }
+  const std::string corpus_path = argv[2];
+  std::string rules_path;
+  ReplayPace pace = ReplayPace::Fast;
+  ReplayOptions options;
+  bool verbose = false;
+
+  for (int i = 3; i < argc; ++i) {
+    const std::string_view arg(argv[i]);
+    try {
+      if (arg == "--rules" && i + 1 < argc) {
+        rules_path = argv[++i];
+      } else if (arg == "--paced") {
+        pace = ReplayPace::Recorded;
+      } else if (arg == "--workers" && i + 1 < argc) {
+        options.risk_engine_workers = static_cast<unsigned>(std::stoul(argv[++i]));
+      } else if (arg == "--backfill" && i + 1 < argc) {
+        options.backfill_parallelism = static_cast<unsigned>(std::stoul(argv[++i]));
+      } else if (arg == "--max-block-range" && i + 1 < argc) {
+        options.max_block_range = std::stoull(argv[++i]);
+      } else if (arg == "--timeout-s" && i + 1 < argc) {
+        options.timeout = std::chrono::seconds(std::stoll(argv[++i]));
+      } else if (arg == "--verbose") {
+        verbose = true;
+      } else {
+        std::cerr << "Error: unknown argument '" << arg << "'\n";
+        print_usage(argv[0]);
+        return 1;
+      }
+    } catch (const std::exception &) {
+      std::cerr << "Error: invalid value for " << arg << "\n";
+      return 1;
+    }
+  }
+
+  // A full ring logs a warning per blocked push, which at replay speed is
+  // the normal case
+  sentinel::init_logging(false);
+  if (!verbose) {
+    for (int c = 0; c < static_cast<int>(sentinel::LogComponent::_Count); ++c) {
+      sentinel::logger(static_cast<sentinel::LogComponent>(c)).set_level(spdlog::level::err);
+    }
+  }
+
+  std::unique_ptr<ReplayChainAdapter> adapter;
+  std::vector<std::unique_ptr<IRiskRule>> rules;
+  try {
+    adapter = std::make_unique<ReplayChainAdapter>(read_corpus(corpus_path), pace);
+    if (!rules_path.empty()) {
+      rules = load_rules_file(rules_path);
+    }
+  } catch (const std::exception &e) {
+    std::cerr << "Error: " << e.what() << "\n";
+    return 2;
+  }
+  if (adapter->overlapping_ranges() > 0) {
+    std::cerr << "note: " << adapter->overlapping_ranges()
+              << " recorded range(s) overlapped earlier ones and are not replayed\n";
+  }
+
+  const ReplayReport report = run_replay(*adapter, std::move(rules), options);
+  print_report(report, std::cout);
+  return report.completed ? 0 : 3;
+}
+
+} // namespace sentinel::replay
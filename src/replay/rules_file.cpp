@@ -0,0 +1,149 @@
+#include "sentinel/replay/rules_file.hpp"
+
+#include <array>
+#include <fstream>
+#include <stdexcept>
+
+#include "sentinel/events/utils/hex.hpp"
+#include "sentinel/events/utils/uint256.hpp"
+#include "sentinel/risk/rules/approval_rule.hpp"
+#include "sentinel/risk/rules/bridge_transfer_rule.hpp"
+#include "sentinel/risk/rules/governance_rule.hpp"
+#include "sentinel/risk/rules/large_transfer_rule.hpp"
+#include "sentinel/risk/rules/mint_burn_rule.hpp"
+#include "sentinel/risk/rules/oracle_update_rule.hpp"
+
+namespace sentinel::replay {
+
+namespace {
+
+using sentinel::events::utils::uint256;
+using Address = std::array<uint8_t, 20>;
+
+Address address(const nlohmann::json &entry, const char *field) {
+  const std::string hex = entry.at(field).get<std::string>();
+  if (hex.size() != 42) {
+    throw std::runtime_error(std::string(field) + " must be a 20-byte 0x address: " + hex);
+  }
+  Address out{};
+  sentinel::events::utils::parse_hex_bytes(hex, out);
+  return out;
+}
+
+uint256 amount(const nlohmann::json &entry, const char *field) {
+  return uint256::from_decimal(entry.at(field).get<std::string>());
+}
+
+} // namespace
+
+std::vector<std::unique_ptr<sentinel::risk::IRiskRule>> rules_from_json(const nlohmann::json &doc) {
+  using namespace sentinel::risk;
+
+  if (!doc.is_object()) {
+    throw std::runtime_error("rules file must hold a JSON object");
+  }
+  std::vector<std::unique_ptr<IRiskRule>> rules;
+
+  if (doc.contains("large_transfer")) {
+    std::vector<LargeTransferRuleConfig> configs;
+    for (const auto &e : doc["large_transfer"]) {
+      configs.push_back({.customer_id = e.at("customer_id").get<uint64_t>(),
+                         .chain_id = e.at("chain_id").get<uint64_t>(),
+                         .token_address = address(e, "token_address"),
+                         .threshold = amount(e, "threshold")});
+    }
+    rules.push_back(std::make_unique<LargeTransferRule>(std::move(configs)));
+  }
+
+  if (doc.contains("governance")) {
+    GovernanceRule::ConfigMap configs;
+    for (const auto &e : doc["governance"]) {
+      GovernanceRuleConfig cfg{.customer_id = e.at("customer_id").get<uint64_t>(),
+                               .chain_id = e.at("chain_id").get<uint64_t>(),
+                               .contract_address = address(e, "contract_address"),
+                               .enabled = true,
+                               .action_filter = std::nullopt};
+      configs[GovernanceContractKey{cfg.chain_id, cfg.contract_address}].push_back(cfg);
+    }
+    rules.push_back(std::make_unique<GovernanceRule>(std::move(configs)));
+  }
+
+  if (doc.contains("mint_burn")) {
+    MintBurnRule::ConfigMap configs;
+    for (const auto &e : doc["mint_burn"]) {
+      MintBurnRuleConfig cfg{.customer_id = e.at("customer_id").get<uint64_t>(),
+                             .chain_id = e.at("chain_id").get<uint64_t>(),
+                             .contract_address = address(e, "contract_address"),
+                             .mint_threshold = amount(e, "mint_threshold"),
+                             .burn_threshold = amount(e, "burn_threshold"),
+                             .enabled = true};
+      configs[MintBurnContractKey{cfg.chain_id, cfg.contract_address}].push_back(cfg);
+    }
+    rules.push_back(std::make_unique<MintBurnRule>(std::move(configs)));
+  }
+
+  if (doc.contains("approval")) {
+    ApprovalRule::ConfigMap configs;
+    for (const auto &e : doc["approval"]) {
+      ApprovalRuleConfig cfg{};
+      cfg.customer_id = e.at("customer_id").get<uint64_t>();
+      cfg.chain_id = e.at("chain_id").get<uint64_t>();
+      cfg.token_address = address(e, "token_address");
+      cfg.threshold = amount(e, "threshold");
+      cfg.alert_on_infinite = e.value("alert_on_infinite", true);
+      cfg.enabled = true;
+      configs[ApprovalContractKey{cfg.chain_id, cfg.token_address}].push_back(cfg);
+    }
+    rules.push_back(std::make_unique<ApprovalRule>(std::move(configs)));
+  }
+
+  if (doc.contains("bridge")) {
+    const auto &bridge = doc["bridge"];
+    BridgeTransferRule::Config config;
+    for (const auto &e : bridge.at("contracts")) {
+      BridgeAddressKey key{e.at("chain_id").get<uint64_t>(), address(e, "address")};
+      config.bridge_addresses.insert(key);
+      config.bridge_names[key] = e.at("name").get<std::string>();
+    }
+    for (const auto &e : bridge.at("rules")) {
+      BridgeRuleConfig cfg{};
+      cfg.customer_id = e.at("customer_id").get<uint64_t>();
+      cfg.chain_id = e.at("chain_id").get<uint64_t>();
+      cfg.token_address = address(e, "token_address");
+      cfg.threshold = amount(e, "threshold");
+      cfg.enabled = true;
+      config.configs_by_key[BridgeRuleKey{cfg.chain_id, cfg.token_address}].push_back(cfg);
+    }
+    rules.push_back(std::make_unique<BridgeTransferRule>(std::move(config.configs_by_key),
+                                                         std::move(config.bridge_addresses),
+                                                         std::move(config.bridge_names)));
+  }
+
+  if (doc.contains("oracle")) {
+    OracleUpdateRule::ConfigMap configs;
+    for (const auto &e : doc["oracle"]) {
+      OracleRuleConfig cfg{};
+      cfg.customer_id = e.at("customer_id").get<uint64_t>();
+      cfg.chain_id = e.at("chain_id").get<uint64_t>();
+      cfg.aggregator_address = address(e, "aggregator_address");
+      cfg.feed_label = e.at("feed_label").get<std::string>();
+      cfg.spike_threshold_bps = e.at("spike_threshold_bps").get<uint32_t>();
+      cfg.decimals = e.at("decimals").get<uint8_t>();
+      cfg.enabled = true;
+      configs[OracleFeedKey{cfg.chain_id, cfg.aggregator_address}].push_back(std::move(cfg));
+    }
+    rules.push_back(std::make_unique<OracleUpdateRule>(std::move(configs)));
+  }
+
+  return rules;
+}
+
+std::vector<std::unique_ptr<sentinel::risk::IRiskRule>> load_rules_file(const std::string &path) {
+  std::ifstream in(path);
+  if (!in) {
+    throw std::runtime_error("cannot open rules file " + path);
+  }
+  return rules_from_json(nlohmann::json::parse(in));
+}
+
+} // namespace sentinel::replay
@@ -1,27 +1,49 @@
 #include "sentinel/risk/alert_deduplicator.hpp"
+#include "sentinel/events/utils/hex_codec.hpp"
+#include "sentinel/risk/address_hash.hpp"
 #include "sentinel/risk/alert_dispatcher.hpp"
 
 #include <algorithm>
-#include <string>
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <string_view>
 
 namespace sentinel::risk {
 
 namespace {
 
-// Format: "<customer_id>|<rule_type>|<chain_id>|<token_address>"
-// chain_id uses "-" when std::nullopt; token_address uses "" when std::nullopt.
-// "|" cannot appear in any component, so keys are unambiguous.
-std::string build_key(const Alert& a) {
-    std::string key;
-    key.reserve(64);
-    key += std::to_string(a.customer_id);
-    key += '|';
-    key += a.rule_type;
-    key += '|';
-    key += a.chain_id.has_value() ? std::to_string(*a.chain_id) : "-";
-    key += '|';
-    key += a.token_address.value_or("");
-    return key;
+// Key::token_kind; 0 means no token
+constexpr uint8_t kTokenAddress = 1;  // "0x" + 40 hex digits, decoded
+constexpr uint8_t kTokenHashed = 2;   // any other string
+
+// Two independent 64-bit hashes and the length, for token strings that are
+// not addresses (only tests use these).
+void hash_token(std::string_view s, std::array<uint8_t, 20>& out) {
+    const uint64_t h1 = std::hash<std::string_view>{}(s);
+    uint64_t h2 = 0xcbf29ce484222325ULL;  // FNV-1a
+    for (const char c : s) {
+        h2 = (h2 ^ static_cast<uint8_t>(c)) * 0x100000001b3ULL;
+    }
+    const uint32_t len = static_cast<uint32_t>(s.size());
+    std::memcpy(out.data(), &h1, sizeof(h1));
+    std::memcpy(out.data() + 8, &h2, sizeof(h2));
+    std::memcpy(out.data() + 16, &len, sizeof(len));
+}
+
+// Index of the first set bit at or after `from`, or -1.
+template <size_t Words>
+int next_occupied(const std::array<uint64_t, Words>& bits, int from) {
+    for (int w = from / 64; w < static_cast<int>(Words); ++w) {
+        uint64_t word = bits[w];
+        if (w == from / 64) {
+            word &= ~uint64_t{0} << (from % 64);
+        }
+        if (word != 0) {
+            return w * 64 + std::countr_zero(word);
+        }
+    }
+    return -1;
 }
 
 } // namespace
@@ -30,27 +52,73 @@ AlertDeduplicator::AlertDeduplicator(DeduplicatorConfig cfg)
     : cfg_(std::move(cfg)), max_configured_window_ms_(cfg_.default_window_ms) {
     for (const auto& [rule_type, window] : cfg_.per_rule_window_ms) {
         max_configured_window_ms_ = std::max(max_configured_window_ms_, window);
+        rules_.push_back(Rule{rule_type, window});
+    }
+    for (auto& level : wheel_) {
+        level.fill(kNone);
     }
+    buckets_.resize(64);
 }
 
-bool AlertDeduplicator::should_suppress(const Alert& alert, uint64_t now_ms) {
-    const std::string key = build_key(alert);
+uint32_t AlertDeduplicator::rule_id_(const std::string& rule_type) {
+    // A handful of rule types; a scan beats hashing the string
+    for (size_t i = 0; i < rules_.size(); ++i) {
+        if (rules_[i].name == rule_type) {
+            return static_cast<uint32_t>(i);
+        }
+    }
+    rules_.push_back(Rule{rule_type, cfg_.default_window_ms});
+    return static_cast<uint32_t>(rules_.size() - 1);
+}
 
-    auto window_it = cfg_.per_rule_window_ms.find(alert.rule_type);
-    const uint64_t window = (window_it != cfg_.per_rule_window_ms.end())
-                                ? window_it->second
-                                : cfg_.default_window_ms;
+AlertDeduplicator::Key AlertDeduplicator::make_key_(const Alert& a) {
+    Key key;
+    key.customer_id = a.customer_id;
+    key.rule = rule_id_(a.rule_type);
+    if (a.chain_id.has_value()) {
+        key.has_chain = 1;
+        key.chain_id = *a.chain_id;
+    }
+    // An empty token_address dedups together with a missing one
+    if (a.token_address.has_value() && !a.token_address->empty()) {
+        const std::string_view t = *a.token_address;
+        if (t.size() == 42 && t[0] == '0' && (t[1] == 'x' || t[1] == 'X') &&
+            sentinel::events::utils::decode_hex(t.data() + 2, 20, key.token.data())) {
+            key.token_kind = kTokenAddress;
+        } else {
+            key.token_kind = kTokenHashed;
+            hash_token(t, key.token);
+        }
+    }
+    return key;
+}
+
+uint32_t AlertDeduplicator::hash_(const Key& key) {
+    const uint64_t seed = (key.customer_id * 0xff51afd7ed558ccdULL) ^ key.chain_id ^
+                          (uint64_t{key.rule} << 48) ^ (uint64_t{key.has_chain} << 46) ^
+                          (uint64_t{key.token_kind} << 44);
+    return static_cast<uint32_t>(hash_address_key(seed, key.token));
+}
+
+bool AlertDeduplicator::should_suppress(const Alert& alert, uint64_t now_ms) {
+    const Key key = make_key_(alert);
+    const uint32_t hash = hash_(key);
+    const uint64_t window = rules_[key.rule].window_ms;
 
     bool suppress = false;
-    auto map_it = last_fired_ms_.find(key);
-    if (map_it == last_fired_ms_.end()) {
-        last_fired_ms_.emplace(key, now_ms);
-    } else if (now_ms < map_it->second || now_ms - map_it->second < window) {
-        // Suppress if the clock went backwards (now_ms < stored) or if the
-        // stored timestamp is still within the dedup window.
-        suppress = true;
+    const uint32_t entry = find_(key, hash);
+    if (entry == kNone) {
+        insert_(key, hash, now_ms);
     } else {
-        map_it->second = now_ms;
+        uint64_t& last = entries_[entry].last_fired_ms;
+        if (now_ms < last || now_ms - last < window) {
+            // Suppress if the clock went backwards (now_ms < stored) or if the
+            // stored timestamp is still within the dedup window.
+            suppress = true;
+        } else {
+            // The wheel entry stays put and is moved when its old tick comes up
+            last = now_ms;
+        }
     }
 
     ++alerts_processed_since_cleanup_;
@@ -63,14 +131,181 @@ bool AlertDeduplicator::should_suppress(const Alert& alert, uint64_t now_ms) {
 }
 
 size_t AlertDeduplicator::cleanup_stale_entries(uint64_t now_ms) {
+    // If the clock went backwards nothing is removed — we cannot determine age.
+    return advance_(now_ms);
+}
+
+uint32_t AlertDeduplicator::find_(const Key& key, uint32_t hash) const {
+    const size_t mask = buckets_.size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        const Bucket& b = buckets_[i];
+        if (b.entry == kNone) {
+            return kNone;
+        }
+        if (b.hash == hash && entries_[b.entry].key == key) {
+            return b.entry;
+        }
+    }
+}
+
+void AlertDeduplicator::insert_(const Key& key, uint32_t hash, uint64_t now_ms) {
+    if ((size_ + 1) * 4 > buckets_.size() * 3) {
+        grow_();
+    }
+    // Nothing to expire before now; skip the ticks in between
+    if (size_ == 0 && now_ms > current_tick_) {
+        current_tick_ = now_ms;
+    }
+
+    uint32_t entry = free_;
+    if (entry != kNone) {
+        free_ = entries_[entry].next;
+    } else {
+        entry = static_cast<uint32_t>(entries_.size());
+        entries_.emplace_back();
+    }
+    entries_[entry] = Entry{key, now_ms, hash, kNone};
+
+    const size_t mask = buckets_.size() - 1;
+    size_t i = hash & mask;
+    while (buckets_[i].entry != kNone) {
+        i = (i + 1) & mask;
+    }
+    buckets_[i] = Bucket{hash, entry};
+    ++size_;
+    schedule_(entry);
+}
+
+void AlertDeduplicator::erase_(uint32_t entry) {
+    const size_t mask = buckets_.size() - 1;
+    size_t i = entries_[entry].hash & mask;
+    while (buckets_[i].entry != entry) {
+        i = (i + 1) & mask;
+    }
+    // Backward-shift deletion: pull later buckets of the run into the hole
+    // unless that would move them before their home bucket
+    for (size_t j = (i + 1) & mask; buckets_[j].entry != kNone; j = (j + 1) & mask) {
+        const size_t home = buckets_[j].hash & mask;
+        const bool movable = (j > i) ? (home <= i || home > j) : (home <= i && home > j);
+        if (movable) {
+            buckets_[i] = buckets_[j];
+            i = j;
+        }
+    }
+    buckets_[i] = Bucket{};
+
+    entries_[entry].next = free_;
+    free_ = entry;
+    --size_;
+}
+
+void AlertDeduplicator::grow_() {
+    std::vector<Bucket> old = std::move(buckets_);
+    buckets_.assign(old.size() * 2, Bucket{});
+    const size_t mask = buckets_.size() - 1;
+    for (const Bucket& b : old) {
+        if (b.entry == kNone) {
+            continue;
+        }
+        size_t i = b.hash & mask;
+        while (buckets_[i].entry != kNone) {
+            i = (i + 1) & mask;
+        }
+        buckets_[i] = b;
+    }
+}
+
+uint64_t AlertDeduplicator::due_tick_(uint32_t entry) const {
+    // Stale once more than the longest window has passed
+    const uint64_t last = entries_[entry].last_fired_ms;
+    const uint64_t retention = max_configured_window_ms_ + 1;
+    return last > UINT64_MAX - retention ? UINT64_MAX : last + retention;
+}
+
+void AlertDeduplicator::schedule_(uint32_t entry) {
+    const uint64_t due = std::max(due_tick_(entry), current_tick_ + 1);
+    // The level is the highest 8-bit digit in which `due` differs from the
+    // current tick; the entry cascades down a level each time the clock
+    // reaches the start of its slot.
+    const int level = (std::bit_width(due ^ current_tick_) - 1) / kSlotBits;
+    if (level >= kLevels) {
+        entries_[entry].next = overflow_;
+        overflow_ = entry;
+        return;
+    }
+    const int slot = static_cast<int>((due >> (level * kSlotBits)) & (kSlots - 1));
+    entries_[entry].next = wheel_[level][slot];
+    wheel_[level][slot] = entry;
+    occupied_[level][slot / 64] |= uint64_t{1} << (slot % 64);
+}
+
+size_t AlertDeduplicator::fire_(uint32_t head) {
     size_t removed = 0;
-    std::erase_if(last_fired_ms_, [&](const auto& pair) {
-        // If the clock went backwards keep the entry — we cannot determine age.
-        if (now_ms < pair.second) return false;
-        const bool stale = (now_ms - pair.second) > max_configured_window_ms_;
-        if (stale) ++removed;
-        return stale;
-    });
+    while (head != kNone) {
+        const uint32_t entry = head;
+        head = entries_[entry].next;
+        if (due_tick_(entry) <= current_tick_) {
+            erase_(entry);
+            ++removed;
+        } else {
+            schedule_(entry);  // refreshed since it was scheduled
+        }
+    }
+    return removed;
+}
+
+size_t AlertDeduplicator::advance_(uint64_t now_ms) {
+    constexpr int kTopBits = kLevels * kSlotBits;
+    size_t removed = 0;
+
+    // Jump from one occupied slot to the next instead of ticking through
+    // every millisecond in between
+    while (size_ > 0 && current_tick_ < now_ms) {
+        uint64_t next = UINT64_MAX;
+        for (int level = 0; level < kLevels; ++level) {
+            const int shift = level * kSlotBits;
+            const int digit = static_cast<int>((current_tick_ >> shift) & (kSlots - 1));
+            const int slot = next_occupied(occupied_[level], digit + 1);
+            if (slot < 0) {
+                continue;
+            }
+            const int span = shift + kSlotBits;
+            next = std::min(next, ((current_tick_ >> span) << span) |
+                                      (static_cast<uint64_t>(slot) << shift));
+        }
+        if (overflow_ != kNone) {
+            next = std::min(next, ((current_tick_ >> kTopBits) + 1) << kTopBits);
+        }
+        if (next > now_ms) {
+            break;
+        }
+        current_tick_ = next;
+
+        // Every level whose slot starts at this tick gives up its entries:
+        // due ones are erased, the others drop to a lower level
+        if (overflow_ != kNone && (current_tick_ & ((uint64_t{1} << kTopBits) - 1)) == 0) {
+            const uint32_t head = overflow_;
+            overflow_ = kNone;
+            removed += fire_(head);
+        }
+        for (int level = kLevels - 1; level >= 0; --level) {
+            const int shift = level * kSlotBits;
+            if ((current_tick_ & ((uint64_t{1} << shift) - 1)) != 0) {
+                continue;
+            }
+            const int slot = static_cast<int>((current_tick_ >> shift) & (kSlots - 1));
+            const uint32_t head = wheel_[level][slot];
+            if (head == kNone) {
+                continue;
+            }
+            wheel_[level][slot] = kNone;
+            occupied_[level][slot / 64] &= ~(uint64_t{1} << (slot % 64));
+            removed += fire_(head);
+        }
+    }
+    if (current_tick_ < now_ms) {
+        current_tick_ = now_ms;
+    }
     return removed;
 }
 
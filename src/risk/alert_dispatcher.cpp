@@ -2,9 +2,12 @@
 #include "sentinel/metrics/metrics.hpp"
 #include "sentinel/log.hpp"
 #include "sentinel/risk/alert_channel.hpp"
+#include "sentinel/risk/alert_outbox.hpp"
+#include "sentinel/risk/checkpoint_writer.hpp"
 #include <cassert>
 #include <chrono>
 #include <exception>
+#include <thread>
 
 namespace sentinel::risk {
 
@@ -12,20 +15,29 @@ AlertDispatcher::AlertDispatcher(std::string chain_name,
                                  sentinel::metrics::Metrics* metrics,
                                  DeduplicatorConfig dedup_cfg,
                                  std::vector<std::string> rule_types,
-                                 sentinel::health::Heartbeat* heartbeat)
-    : chain_name_(std::move(chain_name)),
+                                 sentinel::health::Heartbeat* heartbeat,
+                                 AlertQueueConfig queue_cfg)
+    : queue_cfg_(queue_cfg),
+      queue_(queue_cfg.capacity),
+      chain_name_(std::move(chain_name)),
       metrics_(metrics),
       heartbeat_(heartbeat),
       deduplicator_(std::move(dedup_cfg)) {
     if (metrics_) {
         last_alert_success_gauge_ = metrics_->last_alert_success_timestamp_seconds_chain;
         alert_queue_depth_gauge_ = metrics_->alert_queue_depth_chain;
-        alert_send_duration_hist_ = &metrics_->alert_send_duration_seconds.Add(
-            {{"chain", chain_name_}},
-            prometheus::Histogram::BucketBoundaries{0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0});
+        deliveries_in_flight_gauge_ = &metrics_->alert_deliveries_in_flight.Add(
+            {{"chain", chain_name_}});
         signal_to_alert_hist_ = &metrics_->signal_to_alert_seconds.Add(
             {{"chain", chain_name_}},
             prometheus::Histogram::BucketBoundaries{0.01, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 30.0, 60.0});
+        enqueue_duration_hist_ = &metrics_->alert_enqueue_duration_seconds.Add(
+            {{"chain", chain_name_}},
+            prometheus::Histogram::BucketBoundaries{1e-7, 2.5e-7, 5e-7, 1e-6, 5e-6, 2.5e-5, 1e-4, 1e-3, 1e-2, 0.1, 1.0});
+        dropped_queue_full_counter_ = &metrics_->alerts_dropped_total.Add(
+            {{"chain", chain_name_}, {"reason", "queue_full"}});
+        dropped_shutdown_counter_ = &metrics_->alerts_dropped_total.Add(
+            {{"chain", chain_name_}, {"reason", "shutdown"}});
 
         for (const auto& rule_type : rule_types) {
             alerts_deduplicated_counters_[rule_type] =
@@ -48,114 +60,319 @@ void AlertDispatcher::add_channel(std::unique_ptr<IAlertChannel> channel) {
           &metrics_->alerts_sent_total.Add({{"chain", chain_name_}, {"channel", ch_name}});
       alerts_send_failures_counters_[ch_name] =
           &metrics_->alerts_send_failures_total.Add({{"chain", chain_name_}, {"channel", ch_name}});
+      alert_send_duration_hists_[ch_name] = &metrics_->alert_send_duration_seconds.Add(
+          {{"chain", chain_name_}, {"channel", ch_name}},
+          prometheus::Histogram::BucketBoundaries{0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0});
     }
     channels_.push_back(std::move(channel));
   }
 }
 
+void AlertDispatcher::set_outbox(AlertOutbox *outbox) {
+  assert(!running_.load(std::memory_order_relaxed));
+  outbox_ = outbox;
+}
+
+void AlertDispatcher::set_checkpoint_writer(CheckpointWriter *writer) {
+  assert(!running_.load(std::memory_order_relaxed));
+  checkpoint_writer_ = writer;
+  epochs_.assign(1, Epoch{});
+}
+
+void AlertDispatcher::replay(std::vector<Alert> alerts) {
+  assert(!running_.load(std::memory_order_relaxed));
+  replay_ = std::move(alerts);
+}
+
 void AlertDispatcher::stop() {
   running_.store(false, std::memory_order_relaxed);
-  cv_.notify_all();
+  stop_requested_.store(true, std::memory_order_relaxed);
+  queue_.notify();
 }
 
 void AlertDispatcher::dispatch(Alert alert) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  queue_.push(std::move(alert));
-  if (alert_queue_depth_gauge_) alert_queue_depth_gauge_->Set(queue_.size());
-  cv_.notify_one();
+  // The histogram locks internally, so only 1 in 64 uncontended enqueues
+  // per thread is timed; every enqueue that finds the queue full is.
+  thread_local uint32_t sample = 0;
+  const bool timed = enqueue_duration_hist_ && (++sample & 63) == 0;
+  const auto start = timed ? std::chrono::steady_clock::now()
+                           : std::chrono::steady_clock::time_point{};
+
+  QueueItem item{std::move(alert), std::nullopt};
+  if (queue_.try_push(std::move(item))) {
+    if (timed) {
+      enqueue_duration_hist_->Observe(
+          std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return;
+  }
+
+  if (queue_cfg_.overflow == AlertOverflowPolicy::DropNewest) {
+    if (dropped_queue_full_counter_) dropped_queue_full_counter_->Increment();
+    return;
+  }
+
+  const auto blocked_since = std::chrono::steady_clock::now();
+  for (unsigned attempt = 0; !queue_.try_push(std::move(item)); ++attempt) {
+    if (stop_requested_.load(std::memory_order_relaxed)) {
+      // Nobody will drain the queue any more
+      if (dropped_shutdown_counter_) dropped_shutdown_counter_->Increment();
+      return;
+    }
+    if (attempt < 64) {
+      std::this_thread::yield();
+    } else {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  }
+  if (enqueue_duration_hist_) {
+    enqueue_duration_hist_->Observe(
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - blocked_since).count());
+  }
+}
+
+void AlertDispatcher::checkpoint(uint64_t block) {
+  QueueItem item{Alert{}, block};
+  while (!queue_.try_push(std::move(item))) {
+    if (queue_cfg_.overflow == AlertOverflowPolicy::DropNewest ||
+        stop_requested_.load(std::memory_order_relaxed)) {
+      return;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
 }
 
 void AlertDispatcher::run(std::stop_token st) {
   running_.store(true, std::memory_order_relaxed);
+  std::stop_callback on_stop(st, [this] { stop(); });
+
+  if (!replay_.empty()) {
+    sentinel::logger(sentinel::LogComponent::Alert)
+        .info("Redelivering {} alert(s) left undelivered by the previous run", replay_.size());
+    const uint64_t now_ms = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count());
+    for (const Alert &alert : replay_) {
+      // Always redelivered, but noted by the deduplicator: the blocks of an
+      // unsettled epoch are processed again after a restart, and the alert
+      // they rebuild must not reach the customer a second time.
+      (void)deduplicator_.should_suppress(alert, now_ms);
+      fan_out_(alert, false);
+    }
+    replay_.clear();
+    replay_.shrink_to_fit();
+  }
+
+  std::vector<QueueItem> batch;
+  batch.reserve(queue_cfg_.batch_size);
+
   while (true) {
     if (heartbeat_) heartbeat_->record();
-    Alert alert;
-    {
-      std::unique_lock<std::mutex> lock(mutex_);
+
+    batch.clear();
+    queue_.pop_batch(batch, queue_cfg_.batch_size);
+
+    if (batch.empty()) {
+      if (stop_requested_.load(std::memory_order_relaxed)) {
+        break;
+      }
       // The heartbeat requires this thread to wake periodically even when
       // idle, otherwise a quiet dispatcher would appear stuck to /readyz.
-      // cv_.wait_for returns immediately on notify_one() from dispatch(),
-      // so alert latency is unaffected — the 1-second timeout only triggers
-      // when the queue has been empty for a second, which is exactly when
-      // the heartbeat needs refreshing. This is a deliberate tradeoff of
-      // "no loop changes" for correct liveness reporting.
-      cv_.wait_for(lock, std::chrono::seconds(1), [this, &st]() {
-        return !queue_.empty() || !running_.load(std::memory_order_relaxed) ||
-               st.stop_requested();
+      // A push or stop() wakes it at once, so the timeout only matters
+      // when there is nothing to do.
+      queue_.wait_for(std::chrono::seconds(1), [this] {
+        return stop_requested_.load(std::memory_order_relaxed);
       });
+      continue;
+    }
 
-      bool is_shutdown =
-          !running_.load(std::memory_order_relaxed) || st.stop_requested();
+    if (alert_queue_depth_gauge_) {
+      alert_queue_depth_gauge_->Set(static_cast<double>(queue_.size()));
+    }
 
-      if (queue_.empty() && is_shutdown) {
-        break;
+    for (QueueItem &item : batch) {
+      if (item.checkpoint) {
+        close_epoch_(*item.checkpoint);
+      } else {
+        deliver_(item.alert);
       }
+    }
+  }
 
-      if (queue_.empty()) {
-        continue;
-      }
+  if (alert_queue_depth_gauge_) alert_queue_depth_gauge_->Set(0);
+
+  // Channels report back from their own threads; wait so none does so
+  // after the dispatcher is gone. HTTP timeouts bound the wait.
+  while (deliveries_in_flight_.load(std::memory_order_acquire) > 0) {
+    if (heartbeat_) heartbeat_->record();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+}
 
-      alert = std::move(queue_.front());
-      queue_.pop();
-      if (alert_queue_depth_gauge_) alert_queue_depth_gauge_->Set(queue_.size());
+struct AlertDispatcher::PendingAlert {
+  std::atomic<std::size_t> remaining;
+  std::atomic<bool> any_success{false};
+  std::atomic<bool> any_failure{false};
+  uint64_t ingress_ms;
+  uint64_t outbox_id;
+  uint64_t epoch = kNoEpoch;
+
+  PendingAlert(std::size_t channels, uint64_t ingress, uint64_t outbox)
+      : remaining(channels), ingress_ms(ingress), outbox_id(outbox) {}
+};
+
+void AlertDispatcher::deliver_(Alert &alert) {
+  const uint64_t now_ms = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count());
+
+  if (deduplicator_.should_suppress(alert, now_ms)) {
+    auto it = alerts_deduplicated_counters_.find(alert.rule_type);
+    if (it != alerts_deduplicated_counters_.end() && it->second) {
+      it->second->Increment();
     }
+    return;
+  }
 
-    const uint64_t now_ms = static_cast<uint64_t>(
-        std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now().time_since_epoch())
-            .count());
+  if (channels_.empty()) {
+    return;
+  }
+  if (outbox_) {
+    outbox_->record(alert);
+  }
+  fan_out_(alert);
+}
 
-    if (deduplicator_.should_suppress(alert, now_ms)) {
-      auto it = alerts_deduplicated_counters_.find(alert.rule_type);
-      if (it != alerts_deduplicated_counters_.end() && it->second) {
-        it->second->Increment();
-      }
-      continue;
+void AlertDispatcher::fan_out_(const Alert &alert, bool track) {
+  if (channels_.empty()) {
+    return;
+  }
+
+  auto pending = std::make_shared<PendingAlert>(channels_.size(),
+                                                alert.internal_ingress_time_ms,
+                                                alert.outbox_id);
+  if (checkpoint_writer_ && track) {
+    std::lock_guard<std::mutex> lk(epochs_mutex_);
+    ++epochs_.back().outstanding;
+    pending->epoch = first_epoch_ + epochs_.size() - 1;
+  }
+
+  for (const auto &channel : channels_) {
+    const std::string ch_name = channel->name();
+    const auto start = std::chrono::steady_clock::now();
+
+    deliveries_in_flight_.fetch_add(1, std::memory_order_relaxed);
+    if (deliveries_in_flight_gauge_) deliveries_in_flight_gauge_->Increment();
+
+    try {
+      channel->send_async(alert, [this, pending, ch_name, start](const DeliveryResult &r) {
+        on_delivered_(*pending, ch_name, start, r);
+      });
+    } catch (const std::exception &e) {
+      sentinel::logger(sentinel::LogComponent::Alert)
+          .error("Exception in alert channel send: {}", e.what());
+      on_delivered_(*pending, ch_name, start, DeliveryResult{false, e.what()});
+    } catch (...) {
+      sentinel::logger(sentinel::LogComponent::Alert)
+          .error("Unknown exception in alert channel send");
+      on_delivered_(*pending, ch_name, start, DeliveryResult{false, "unknown exception"});
     }
+  }
+}
 
-    auto send_start = std::chrono::steady_clock::now();
-    bool any_success = false;
-
-    for (const auto &channel : channels_) {
-      if (channel) {
-        try {
-          channel->send(alert);
-          any_success = true;
-          auto it = alerts_sent_counters_.find(channel->name());
-          if (it != alerts_sent_counters_.end()) it->second->Increment();
-        } catch (const std::exception &e) {
-          auto it = alerts_send_failures_counters_.find(channel->name());
-          if (it != alerts_send_failures_counters_.end()) it->second->Increment();
-          sentinel::logger(sentinel::LogComponent::Alert)
-              .error("Exception in alert channel send: {}", e.what());
-        } catch (...) {
-          auto it = alerts_send_failures_counters_.find(channel->name());
-          if (it != alerts_send_failures_counters_.end()) it->second->Increment();
-          sentinel::logger(sentinel::LogComponent::Alert)
-              .error("Unknown exception in alert channel send");
-        }
-      }
+void AlertDispatcher::on_delivered_(PendingAlert &pending, const std::string &channel,
+                                    std::chrono::steady_clock::time_point start,
+                                    const DeliveryResult &result) {
+  const auto end = std::chrono::steady_clock::now();
+
+  // The maps are only written by add_channel(), before run() starts
+  const auto &counters = result.ok ? alerts_sent_counters_ : alerts_send_failures_counters_;
+  if (auto it = counters.find(channel); it != counters.end()) {
+    it->second->Increment();
+  }
+  if (auto it = alert_send_duration_hists_.find(channel); it != alert_send_duration_hists_.end()) {
+    it->second->Observe(std::chrono::duration<double>(end - start).count());
+  }
+
+  if (result.ok) {
+    pending.any_success.store(true, std::memory_order_relaxed);
+  } else {
+    pending.any_failure.store(true, std::memory_order_relaxed);
+  }
+
+  // The last channel to finish records the alert-level metrics
+  if (pending.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    const bool failed = pending.any_failure.load(std::memory_order_relaxed);
+    // A failure while stopping is most likely an abandoned retry; leaving
+    // the row open gets the alert redelivered by the next run
+    if (outbox_ && pending.outbox_id != 0 &&
+        !(failed && stop_requested_.load(std::memory_order_relaxed))) {
+      outbox_->complete(pending.outbox_id, !failed);
     }
 
-    if (metrics_) {
-      if (any_success && last_alert_success_gauge_) {
-        last_alert_success_gauge_->Set(
-            static_cast<double>(std::chrono::duration_cast<std::chrono::seconds>(
-                std::chrono::system_clock::now().time_since_epoch()).count())
-        );
-      }
+    if (pending.any_success.load(std::memory_order_relaxed) && last_alert_success_gauge_) {
+      last_alert_success_gauge_->Set(
+          static_cast<double>(std::chrono::duration_cast<std::chrono::seconds>(
+              std::chrono::system_clock::now().time_since_epoch()).count())
+      );
+    }
 
-      auto send_end = std::chrono::steady_clock::now();
-      double send_duration = std::chrono::duration<double>(send_end - send_start).count();
-      if (alert_send_duration_hist_) alert_send_duration_hist_->Observe(send_duration);
+    if (pending.ingress_ms > 0 && signal_to_alert_hist_) {
+      const auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+          end.time_since_epoch()).count();
+      signal_to_alert_hist_->Observe(
+          static_cast<double>(now_ms - static_cast<int64_t>(pending.ingress_ms)) / 1000.0);
+    }
 
-      if (alert.internal_ingress_time_ms > 0 && signal_to_alert_hist_) {
-        double e2e_duration = (std::chrono::duration_cast<std::chrono::milliseconds>(
-            send_end.time_since_epoch()).count() - alert.internal_ingress_time_ms) / 1000.0;
-        signal_to_alert_hist_->Observe(e2e_duration);
-      }
+    if (pending.epoch != kNoEpoch) {
+      settle_(pending.epoch);
     }
   }
+
+  if (deliveries_in_flight_gauge_) deliveries_in_flight_gauge_->Decrement();
+  deliveries_in_flight_.fetch_sub(1, std::memory_order_release);
+}
+
+void AlertDispatcher::close_epoch_(uint64_t block) {
+  if (!checkpoint_writer_) {
+    return;
+  }
+  std::optional<uint64_t> settled;
+  {
+    std::lock_guard<std::mutex> lk(epochs_mutex_);
+    epochs_.back().block = block;
+    epochs_.emplace_back();
+    settled = pop_settled_locked_();
+  }
+  if (settled) {
+    checkpoint_writer_->advance(*settled);
+  }
+}
+
+void AlertDispatcher::settle_(uint64_t epoch) {
+  std::optional<uint64_t> settled;
+  {
+    std::lock_guard<std::mutex> lk(epochs_mutex_);
+    --epochs_[epoch - first_epoch_].outstanding;
+    settled = pop_settled_locked_();
+  }
+  if (settled) {
+    checkpoint_writer_->advance(*settled);
+  }
+}
+
+std::optional<uint64_t> AlertDispatcher::pop_settled_locked_() {
+  // A checkpoint only moves past a block once everything before it has
+  // settled, so a slow delivery holds back the later epochs too
+  std::optional<uint64_t> settled;
+  while (epochs_.front().block && epochs_.front().outstanding == 0) {
+    settled = epochs_.front().block;
+    epochs_.pop_front();
+    ++first_epoch_;
+  }
+  return settled;
 }
 
 } // namespace sentinel::risk
@@ -0,0 +1,160 @@
+#include "sentinel/risk/alert_outbox.hpp"
+
+#include <exception>
+#include <unordered_map>
+
+#include "sentinel/log.hpp"
+#include "sentinel/metrics/metrics.hpp"
+
+namespace sentinel::risk {
+
+namespace {
+
+// Ids are unique across restarts without asking the database: the start
+// time in ms leaves room for 2^20 alerts per ms of uptime before two
+// processes could overlap.
+uint64_t first_id() {
+  const auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::system_clock::now().time_since_epoch())
+                          .count();
+  return (static_cast<uint64_t>(now_ms) << 20) + 1;
+}
+
+} // namespace
+
+AlertOutbox::AlertOutbox(std::unique_ptr<IAlertOutboxStore> store, OutboxConfig cfg,
+                         std::string chain_name, sentinel::metrics::Metrics *metrics)
+    : store_(std::move(store)), cfg_(cfg), queue_(cfg.buffer_capacity), next_id_(first_id()) {
+  if (cfg_.max_batch == 0) {
+    cfg_.max_batch = 1;
+  }
+  if (metrics) {
+    flush_duration_hist_ = &metrics->alert_outbox_flush_duration_seconds.Add(
+        {{"chain", chain_name}},
+        prometheus::Histogram::BucketBoundaries{0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1,
+                                                0.25, 0.5, 1.0, 5.0});
+    backlog_gauge_ = &metrics->alert_outbox_backlog.Add({{"chain", chain_name}});
+    dropped_buffer_full_counter_ = &metrics->alert_outbox_dropped_total.Add(
+        {{"chain", chain_name}, {"reason", "buffer_full"}});
+    dropped_write_failed_counter_ = &metrics->alert_outbox_dropped_total.Add(
+        {{"chain", chain_name}, {"reason", "write_failed"}});
+  }
+  thread_ = std::thread([this] { run_(); });
+}
+
+AlertOutbox::~AlertOutbox() {
+  {
+    std::lock_guard<std::mutex> lk(stop_mutex_);
+    stopping_.store(true, std::memory_order_release);
+  }
+  stop_cv_.notify_all();
+  thread_.join();
+}
+
+std::vector<Alert> AlertOutbox::load_pending() {
+  try {
+    return store_->load_pending(cfg_.replay_max_age);
+  } catch (const std::exception &e) {
+    sentinel::logger(sentinel::LogComponent::Db)
+        .error("Failed to load undelivered alerts from the outbox: {}", e.what());
+    return {};
+  }
+}
+
+void AlertOutbox::record(Alert &alert) {
+  alert.outbox_id = next_id_.fetch_add(1, std::memory_order_relaxed);
+  Op op;
+  op.alert = alert;
+  op.id = alert.outbox_id;
+  push_(std::move(op));
+}
+
+void AlertOutbox::complete(uint64_t id, bool delivered) {
+  Op op;
+  op.id = id;
+  op.delivered = delivered;
+  push_(std::move(op));
+}
+
+void AlertOutbox::push_(Op op) {
+  if (!queue_.try_push(std::move(op))) {
+    if (dropped_buffer_full_counter_) dropped_buffer_full_counter_->Increment();
+  }
+}
+
+std::size_t AlertOutbox::backlog() const noexcept {
+  return queue_.size() + carried_.load(std::memory_order_relaxed);
+}
+
+void AlertOutbox::run_() {
+  std::vector<Op> batch;
+  batch.reserve(cfg_.max_batch);
+
+  while (true) {
+    const bool stopping = stopping_.load(std::memory_order_acquire);
+    queue_.pop_batch(batch, cfg_.max_batch - batch.size());
+    const bool full = batch.size() == cfg_.max_batch;
+
+    if (!batch.empty()) {
+      if (flush_(batch)) {
+        batch.clear();
+      } else if (stopping) {
+        // Last chance was taken; on restart these alerts are replayed or,
+        // for lost completions, delivered again
+        if (dropped_write_failed_counter_) {
+          dropped_write_failed_counter_->Increment(static_cast<double>(batch.size()));
+        }
+        batch.clear();
+      }
+    }
+    carried_.store(batch.size(), std::memory_order_relaxed);
+    if (backlog_gauge_) backlog_gauge_->Set(static_cast<double>(backlog()));
+
+    if (stopping && batch.empty() && queue_.empty()) {
+      break;
+    }
+    if (batch.empty() && (full || stopping)) {
+      continue; // more is waiting; write it now
+    }
+
+    // Let the next batch accumulate, or back off after a failed write
+    const auto pause = batch.empty() ? cfg_.flush_interval : cfg_.retry_backoff;
+    std::unique_lock<std::mutex> lk(stop_mutex_);
+    stop_cv_.wait_for(lk, pause, [this] { return stopping_.load(std::memory_order_relaxed); });
+  }
+}
+
+bool AlertOutbox::flush_(const std::vector<Op> &ops) {
+  std::vector<OutboxRecord> records;
+  std::vector<OutboxCompletion> completions;
+  std::unordered_map<uint64_t, std::size_t> record_index;
+
+  // A delivery that finished before its row was written is folded into
+  // the insert
+  for (const Op &op : ops) {
+    if (op.alert) {
+      record_index[op.id] = records.size();
+      records.push_back(OutboxRecord{*op.alert, std::nullopt});
+    } else if (auto it = record_index.find(op.id); it != record_index.end()) {
+      records[it->second].delivered = op.delivered;
+    } else {
+      completions.push_back(OutboxCompletion{op.id, op.delivered});
+    }
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  try {
+    store_->write(records, completions);
+  } catch (const std::exception &e) {
+    sentinel::logger(sentinel::LogComponent::Db)
+        .error("Alert outbox write of {} row(s) failed: {}", ops.size(), e.what());
+    return false;
+  }
+  if (flush_duration_hist_) {
+    flush_duration_hist_->Observe(
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+  }
+  return true;
+}
+
+} // namespace sentinel::risk
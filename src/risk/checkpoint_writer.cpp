@@ -0,0 +1,71 @@
+#include "sentinel/risk/checkpoint_writer.hpp"
+
+#include <exception>
+
+#include "sentinel/log.hpp"
+#include "sentinel/metrics/metrics.hpp"
+
+namespace sentinel::risk {
+
+CheckpointWriter::CheckpointWriter(std::unique_ptr<ICheckpointSink> sink,
+                                   uint64_t initial_block, CheckpointWriterConfig cfg,
+                                   std::string chain_name, sentinel::metrics::Metrics *metrics)
+    : sink_(std::move(sink)), cfg_(cfg), latest_(initial_block), persisted_(initial_block) {
+  if (metrics) {
+    block_gauge_ = &metrics->checkpoint_block.Add({{"chain", chain_name}});
+    block_gauge_->Set(static_cast<double>(initial_block));
+    failures_counter_ = &metrics->checkpoint_write_failures_total.Add({{"chain", chain_name}});
+  }
+  thread_ = std::thread([this] { run_(); });
+}
+
+CheckpointWriter::~CheckpointWriter() {
+  {
+    std::lock_guard<std::mutex> lk(stop_mutex_);
+    stopping_.store(true, std::memory_order_release);
+  }
+  stop_cv_.notify_all();
+  thread_.join();
+}
+
+void CheckpointWriter::advance(uint64_t block) noexcept {
+  uint64_t current = latest_.load(std::memory_order_relaxed);
+  while (block > current &&
+         !latest_.compare_exchange_weak(current, block, std::memory_order_relaxed)) {
+  }
+}
+
+void CheckpointWriter::run_() {
+  while (true) {
+    const bool stopping = stopping_.load(std::memory_order_acquire);
+    const uint64_t target = latest_.load(std::memory_order_relaxed);
+
+    bool ok = true;
+    if (target > persisted_.load(std::memory_order_relaxed)) {
+      ok = save_(target);
+    }
+    if (stopping) {
+      break;
+    }
+
+    const auto pause = ok ? cfg_.min_interval : cfg_.retry_backoff;
+    std::unique_lock<std::mutex> lk(stop_mutex_);
+    stop_cv_.wait_for(lk, pause, [this] { return stopping_.load(std::memory_order_relaxed); });
+  }
+}
+
+bool CheckpointWriter::save_(uint64_t block) {
+  try {
+    sink_->save(block);
+  } catch (const std::exception &e) {
+    if (failures_counter_) failures_counter_->Increment();
+    sentinel::logger(sentinel::LogComponent::Db)
+        .error("Checkpoint write of block {} failed: {}", block, e.what());
+    return false;
+  }
+  persisted_.store(block, std::memory_order_relaxed);
+  if (block_gauge_) block_gauge_->Set(static_cast<double>(block));
+  return true;
+}
+
+} // namespace sentinel::risk
@@ -0,0 +1,77 @@
+#include "sentinel/risk/circuit_breaker.hpp"
+
+#include <algorithm>
+
+namespace sentinel::risk {
+
+CircuitBreaker::CircuitBreaker(CircuitBreakerConfig cfg) : cfg_(cfg) {
+  cfg_.failure_threshold = std::max<std::size_t>(cfg_.failure_threshold, 1);
+  cfg_.half_open_probes = std::max<std::size_t>(cfg_.half_open_probes, 1);
+}
+
+bool CircuitBreaker::allow(Clock::time_point now) {
+  switch (state_) {
+  case State::Closed:
+    return true;
+  case State::Open:
+    if (now < reopens_at()) {
+      return false;
+    }
+    state_ = State::HalfOpen;
+    probes_ = 0;
+    [[fallthrough]];
+  case State::HalfOpen:
+    if (probes_ >= cfg_.half_open_probes) {
+      return false;
+    }
+    ++probes_;
+    return true;
+  }
+  return false;
+}
+
+void CircuitBreaker::record_success() {
+  // A late success from before the breaker opened proves nothing about now
+  if (state_ == State::Open) {
+    return;
+  }
+  state_ = State::Closed;
+  failures_ = 0;
+  probes_ = 0;
+}
+
+void CircuitBreaker::record_failure(Clock::time_point now) {
+  switch (state_) {
+  case State::Closed:
+    if (++failures_ >= cfg_.failure_threshold) {
+      open_(now);
+    }
+    break;
+  case State::HalfOpen:
+    open_(now);
+    break;
+  case State::Open:
+    break;
+  }
+}
+
+void CircuitBreaker::open_(Clock::time_point now) {
+  state_ = State::Open;
+  opened_at_ = now;
+  failures_ = 0;
+  probes_ = 0;
+}
+
+const char *to_string(CircuitBreaker::State state) noexcept {
+  switch (state) {
+  case CircuitBreaker::State::Closed:
+    return "closed";
+  case CircuitBreaker::State::Open:
+    return "open";
+  case CircuitBreaker::State::HalfOpen:
+    return "half_open";
+  }
+  return "unknown";
+}
+
+} // namespace sentinel::risk
@@ -0,0 +1,497 @@
+#include "sentinel/risk/http_delivery.hpp"
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <exception>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <curl/curl.h>
+
+#include "sentinel/log.hpp"
+#include "sentinel/metrics/metrics.hpp"
+#include "sentinel/risk/timer_wheel.hpp"
+
+namespace sentinel::risk {
+
+namespace {
+
+size_t append_cb(char *ptr, size_t size, size_t nmemb, void *userdata) noexcept {
+  auto *out = static_cast<std::string *>(userdata);
+  const size_t total = size * nmemb;
+  try {
+    out->append(ptr, total);
+    return total;
+  } catch (...) {
+    return 0;
+  }
+}
+
+// Easy handles kept for reuse once a burst is over.
+constexpr std::size_t kMaxIdleHandles = 16;
+
+HttpResponse failed(std::string error) {
+  HttpResponse resp;
+  resp.error = std::move(error);
+  return resp;
+}
+
+// Failures that say something about the endpoint rather than the request;
+// these count against its breaker and are worth retrying.
+bool endpoint_failure(const HttpResponse &resp) {
+  return !resp.ok && (resp.status == 0 || resp.status == 408 || resp.status == 429 ||
+                      resp.status >= 500);
+}
+
+std::size_t state_index(CircuitBreaker::State state) {
+  return static_cast<std::size_t>(state);
+}
+
+} // namespace
+
+struct HttpDeliveryLoop::State {
+  using Clock = std::chrono::steady_clock;
+
+  struct ChannelMetrics {
+    std::array<prometheus::Gauge *, 3> breakers{}; // by CircuitBreaker::State
+    prometheus::Gauge *retry_queue_depth = nullptr;
+    prometheus::Counter *retry_attempts = nullptr;
+    prometheus::Counter *rejections = nullptr;
+  };
+
+  struct Health {
+    CircuitBreaker breaker;
+    ChannelMetrics *metrics = nullptr;
+  };
+
+  struct Retry {
+    Submission job;
+    HttpResponse last;
+    ChannelMetrics *metrics = nullptr;
+  };
+
+  struct Transfer {
+    CURL *curl = nullptr;
+    curl_slist *headers = nullptr;
+    std::string endpoint;
+    Submission job;
+    std::string response;
+    char error[CURL_ERROR_SIZE] = {};
+  };
+
+  struct Endpoint {
+    std::size_t active = 0;
+    std::deque<Submission> waiting;
+  };
+
+  State(const HttpDeliveryConfig &cfg, std::atomic<std::size_t> &pending,
+        sentinel::metrics::Metrics *metrics)
+      : cfg(cfg), pending(pending), metrics(metrics), rng(std::random_device{}()) {
+    multi = curl_multi_init();
+    if (!multi) {
+      throw std::runtime_error("curl_multi_init failed");
+    }
+    curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, cfg.max_host_connections);
+    curl_multi_setopt(multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, cfg.max_total_connections);
+    curl_multi_setopt(multi, CURLMOPT_PIPELINING, static_cast<long>(CURLPIPE_MULTIPLEX));
+  }
+
+  ~State() {
+    for (CURL *curl : idle) {
+      curl_easy_cleanup(curl);
+    }
+    curl_multi_cleanup(multi);
+  }
+
+  ChannelMetrics *channel_metrics(const std::string &channel) {
+    if (!metrics) {
+      return nullptr;
+    }
+    auto [it, inserted] = channels.try_emplace(channel.empty() ? "other" : channel);
+    if (inserted) {
+      const prometheus::Labels labels{{"chain", metrics->chain_name}, {"channel", it->first}};
+      ChannelMetrics &m = it->second;
+      for (auto state : {CircuitBreaker::State::Closed, CircuitBreaker::State::Open,
+                         CircuitBreaker::State::HalfOpen}) {
+        prometheus::Labels with_state = labels;
+        with_state.emplace("state", to_string(state));
+        m.breakers[state_index(state)] = &metrics->alert_circuit_breakers.Add(with_state);
+      }
+      m.retry_queue_depth = &metrics->alert_retry_queue_depth.Add(labels);
+      m.retry_attempts = &metrics->alert_retry_attempts_total.Add(labels);
+      m.rejections = &metrics->alert_circuit_rejections_total.Add(labels);
+    }
+    return &it->second;
+  }
+
+  Health &health_of(const std::string &key, const std::string &channel) {
+    auto it = health.find(key);
+    if (it == health.end()) {
+      it = health.emplace(key, Health{CircuitBreaker(cfg.breaker), channel_metrics(channel)}).first;
+      if (it->second.metrics) {
+        it->second.metrics->breakers[state_index(CircuitBreaker::State::Closed)]->Increment();
+      }
+    }
+    return it->second;
+  }
+
+  // Keeps the per-state gauges in step with a breaker that may have moved.
+  void note_transition(const std::string &key, Health &h, CircuitBreaker::State before) {
+    const CircuitBreaker::State after = h.breaker.state();
+    if (after == before) {
+      return;
+    }
+    if (h.metrics) {
+      h.metrics->breakers[state_index(before)]->Decrement();
+      h.metrics->breakers[state_index(after)]->Increment();
+    }
+    auto &Lalert = sentinel::logger(sentinel::LogComponent::Alert);
+    switch (after) {
+    case CircuitBreaker::State::Open:
+      Lalert.warn("Circuit breaker open for {}: failing fast for {}ms", key,
+                  cfg.breaker.open_duration.count());
+      break;
+    case CircuitBreaker::State::HalfOpen:
+      Lalert.info("Circuit breaker half-open for {}: probing", key);
+      break;
+    case CircuitBreaker::State::Closed:
+      Lalert.info("Circuit breaker closed for {}", key);
+      break;
+    }
+  }
+
+  void enqueue(Submission job) {
+    std::string key = job.request.endpoint.empty() ? job.request.url : job.request.endpoint;
+    Health &h = health_of(key, job.request.channel);
+    const CircuitBreaker::State before = h.breaker.state();
+    const bool allowed = h.breaker.allow(Clock::now());
+    note_transition(key, h, before);
+    if (!allowed) {
+      if (h.metrics) h.metrics->rejections->Increment();
+      settle(std::move(job), h, failed("circuit open"));
+      return;
+    }
+
+    Endpoint &ep = endpoints[key];
+    if (ep.active < cfg.max_per_endpoint) {
+      start(std::move(key), ep, std::move(job));
+    } else {
+      ep.waiting.push_back(std::move(job));
+    }
+  }
+
+  void start(std::string key, Endpoint &ep, Submission job) {
+    CURL *curl = nullptr;
+    if (!idle.empty()) {
+      curl = idle.back();
+      idle.pop_back();
+    } else {
+      curl = curl_easy_init();
+    }
+    if (!curl) {
+      complete(job.done, failed("curl_easy_init failed"));
+      return;
+    }
+
+    auto t = std::make_unique<Transfer>();
+    t->curl = curl;
+    t->endpoint = std::move(key);
+    t->job = std::move(job);
+    for (const auto &h : t->job.request.headers) {
+      t->headers = curl_slist_append(t->headers, h.c_str());
+    }
+
+    const HttpRequest &req = t->job.request;
+    curl_easy_setopt(curl, CURLOPT_URL, req.url.c_str());
+    curl_easy_setopt(curl, CURLOPT_POST, 1L);
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, req.body.data());
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE,
+                     static_cast<curl_off_t>(req.body.size()));
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, t->headers);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, append_cb);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &t->response);
+    curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, t->error);
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS,
+                     static_cast<long>(cfg.connect_timeout.count()));
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, static_cast<long>(cfg.timeout.count()));
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_2TLS));
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl, CURLOPT_PRIVATE, t.get());
+
+    if (curl_multi_add_handle(multi, curl) != CURLM_OK) {
+      curl_slist_free_all(t->headers);
+      recycle(curl);
+      complete(t->job.done, failed("curl_multi_add_handle failed"));
+      return;
+    }
+    ++ep.active;
+    ++active;
+    t.release(); // owned through CURLOPT_PRIVATE until finish()
+  }
+
+  void finish(CURLMsg *msg) {
+    Transfer *raw = nullptr;
+    curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &raw);
+    std::unique_ptr<Transfer> t(raw);
+
+    HttpResponse resp;
+    if (msg->data.result == CURLE_OK) {
+      curl_easy_getinfo(t->curl, CURLINFO_RESPONSE_CODE, &resp.status);
+      resp.ok = resp.status >= 200 && resp.status < 300;
+    } else {
+      resp.error = t->error[0] ? t->error : curl_easy_strerror(msg->data.result);
+    }
+    resp.body = std::move(t->response);
+
+    curl_multi_remove_handle(multi, t->curl);
+    curl_slist_free_all(t->headers);
+    recycle(t->curl);
+    --active;
+
+    Health &h = health_of(t->endpoint, t->job.request.channel);
+    const CircuitBreaker::State before = h.breaker.state();
+    if (endpoint_failure(resp)) {
+      h.breaker.record_failure(Clock::now());
+    } else {
+      h.breaker.record_success();
+    }
+    note_transition(t->endpoint, h, before);
+
+    auto it = endpoints.find(t->endpoint);
+    Endpoint &ep = it->second;
+    --ep.active;
+    // Requests queued behind a failing endpoint fail fast as well
+    std::deque<Submission> rejected;
+    if (h.breaker.state() == CircuitBreaker::State::Open) {
+      rejected.swap(ep.waiting);
+    }
+    if (!ep.waiting.empty()) {
+      Submission next = std::move(ep.waiting.front());
+      ep.waiting.pop_front();
+      start(t->endpoint, ep, std::move(next));
+    } else if (ep.active == 0) {
+      endpoints.erase(it);
+    }
+
+    for (auto &job : rejected) {
+      if (h.metrics) h.metrics->rejections->Increment();
+      settle(std::move(job), h, failed("circuit open"));
+    }
+    settle(std::move(t->job), h, std::move(resp));
+  }
+
+  // Completes `job` with `resp`, unless it is a failure worth another
+  // attempt: then the job waits in `retries` for its backoff, and for an
+  // open breaker to admit probes again.
+  void settle(Submission job, Health &h, HttpResponse resp) {
+    ++job.attempts;
+    if (!endpoint_failure(resp) || !retries_enabled || job.attempts >= cfg.retry.max_attempts) {
+      complete(job.done, std::move(resp));
+      return;
+    }
+
+    Clock::time_point due = Clock::now() + backoff(job.attempts);
+    if (h.breaker.state() == CircuitBreaker::State::Open) {
+      due = std::max(due, h.breaker.reopens_at());
+    }
+    const uint64_t id = next_retry_id++;
+    retries.emplace(id, Retry{std::move(job), std::move(resp), h.metrics});
+    if (h.metrics) h.metrics->retry_queue_depth->Increment();
+    wheel.schedule(due, [this, id] { resume(id); });
+  }
+
+  void resume(uint64_t id) {
+    auto it = retries.find(id);
+    if (it == retries.end()) {
+      return; // abandoned
+    }
+    Retry retry = std::move(it->second);
+    retries.erase(it);
+    if (retry.metrics) {
+      retry.metrics->retry_queue_depth->Decrement();
+      retry.metrics->retry_attempts->Increment();
+    }
+    enqueue(std::move(retry.job));
+  }
+
+  void fail_retries() {
+    auto abandoned = std::move(retries);
+    retries.clear();
+    for (auto &[id, retry] : abandoned) {
+      if (retry.metrics) retry.metrics->retry_queue_depth->Decrement();
+      complete(retry.job.done, std::move(retry.last));
+    }
+  }
+
+  // initial_backoff * 2^(attempt-1), capped, with the upper half jittered.
+  std::chrono::milliseconds backoff(std::size_t attempt) {
+    auto delay = cfg.retry.max_backoff;
+    if (attempt - 1 < 32) {
+      delay = std::min(delay, cfg.retry.initial_backoff * (int64_t{1} << (attempt - 1)));
+    }
+    const int64_t half = delay.count() / 2;
+    std::uniform_int_distribution<int64_t> jitter(0, half);
+    return std::chrono::milliseconds(delay.count() - half + jitter(rng));
+  }
+
+  void fail_waiting() {
+    for (auto it = endpoints.begin(); it != endpoints.end();) {
+      auto waiting = std::move(it->second.waiting);
+      it->second.waiting.clear();
+      for (auto &job : waiting) {
+        complete(job.done, failed("delivery loop stopped"));
+      }
+      it = it->second.active == 0 ? endpoints.erase(it) : std::next(it);
+    }
+  }
+
+  void recycle(CURL *curl) {
+    if (idle.size() < kMaxIdleHandles) {
+      // Connections stay in the multi handle's cache, not in the easy handle
+      curl_easy_reset(curl);
+      idle.push_back(curl);
+    } else {
+      curl_easy_cleanup(curl);
+    }
+  }
+
+  void complete(Callback &done, HttpResponse resp) {
+    try {
+      done(std::move(resp));
+    } catch (const std::exception &e) {
+      sentinel::logger(sentinel::LogComponent::Alert)
+          .error("Exception in HTTP delivery callback: {}", e.what());
+    } catch (...) {
+      sentinel::logger(sentinel::LogComponent::Alert)
+          .error("Unknown exception in HTTP delivery callback");
+    }
+    pending.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  const HttpDeliveryConfig &cfg;
+  std::atomic<std::size_t> &pending;
+  sentinel::metrics::Metrics *metrics;
+  CURLM *multi = nullptr;
+  std::vector<CURL *> idle;
+  std::unordered_map<std::string, Endpoint> endpoints;
+  std::size_t active = 0;
+
+  std::unordered_map<std::string, Health> health;          // by endpoint key
+  std::unordered_map<std::string, ChannelMetrics> channels; // by channel label
+  std::unordered_map<uint64_t, Retry> retries;
+  uint64_t next_retry_id = 0;
+  bool retries_enabled = true;
+  std::mt19937_64 rng;
+
+  TimerWheel wheel; // retries and schedule() timers
+};
+
+HttpDeliveryLoop::HttpDeliveryLoop(HttpDeliveryConfig cfg, sentinel::metrics::Metrics *metrics)
+    : cfg_(cfg), metrics_(metrics) {
+  if (cfg_.max_per_endpoint == 0) {
+    cfg_.max_per_endpoint = 1;
+  }
+  curl_global_init(CURL_GLOBAL_DEFAULT);
+  state_ = std::make_unique<State>(cfg_, pending_, metrics_);
+  thread_ = std::thread([this] { run_(); });
+}
+
+HttpDeliveryLoop::~HttpDeliveryLoop() {
+  stopping_.store(true, std::memory_order_release);
+  curl_multi_wakeup(state_->multi);
+  thread_.join();
+}
+
+void HttpDeliveryLoop::submit(HttpRequest request, Callback done) {
+  pending_.fetch_add(1, std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lk(incoming_mutex_);
+    incoming_.push_back(Submission{std::move(request), std::move(done)});
+  }
+  curl_multi_wakeup(state_->multi);
+}
+
+void HttpDeliveryLoop::schedule(std::chrono::milliseconds delay, std::function<void()> fn) {
+  {
+    std::lock_guard<std::mutex> lk(incoming_mutex_);
+    incoming_timers_.push_back(Timer{std::chrono::steady_clock::now() + delay, std::move(fn)});
+  }
+  curl_multi_wakeup(state_->multi);
+}
+
+void HttpDeliveryLoop::abandon_retries() {
+  retries_abandoned_.store(true, std::memory_order_release);
+  curl_multi_wakeup(state_->multi);
+}
+
+void HttpDeliveryLoop::run_() {
+  auto &wheel = state_->wheel;
+
+  std::vector<Submission> batch;
+  std::vector<Timer> new_timers;
+  while (true) {
+    {
+      std::lock_guard<std::mutex> lk(incoming_mutex_);
+      batch.swap(incoming_);
+      new_timers.swap(incoming_timers_);
+    }
+    const bool stopping = stopping_.load(std::memory_order_acquire);
+    state_->retries_enabled = !stopping && !retries_abandoned_.load(std::memory_order_acquire);
+    if (!state_->retries_enabled) {
+      state_->fail_retries();
+    }
+
+    for (auto &job : batch) {
+      state_->enqueue(std::move(job));
+    }
+    batch.clear();
+    for (auto &timer : new_timers) {
+      wheel.schedule(timer.due, std::move(timer.fn));
+    }
+    new_timers.clear();
+
+    for (auto &fn : wheel.expire(std::chrono::steady_clock::now())) {
+      try {
+        fn();
+      } catch (const std::exception &e) {
+        sentinel::logger(sentinel::LogComponent::Alert)
+            .error("Exception in HTTP delivery timer: {}", e.what());
+      }
+    }
+
+    if (stopping) {
+      state_->fail_waiting();
+      if (state_->active == 0) {
+        std::lock_guard<std::mutex> lk(incoming_mutex_);
+        if (incoming_.empty()) {
+          break;
+        }
+      }
+    }
+
+    int running = 0;
+    curl_multi_perform(state_->multi, &running);
+
+    int left = 0;
+    while (CURLMsg *msg = curl_multi_info_read(state_->multi, &left)) {
+      if (msg->msg == CURLMSG_DONE) {
+        state_->finish(msg);
+      }
+    }
+
+    // Returns early on socket activity, a curl timer or a wakeup from
+    // submit() / schedule()
+    int timeout_ms = 1000;
+    if (const auto next = wheel.next_due()) {
+      const auto until = std::chrono::ceil<std::chrono::milliseconds>(
+          *next - std::chrono::steady_clock::now());
+      timeout_ms = static_cast<int>(std::clamp<int64_t>(until.count(), 0, timeout_ms));
+    }
+    curl_multi_poll(state_->multi, nullptr, 0, timeout_ms, nullptr);
+  }
+}
+
+} // namespace sentinel::risk
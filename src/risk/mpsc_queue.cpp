@@ -0,0 +1,51 @@
+#include "sentinel/risk/mpsc_queue.hpp"
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <ctime>
+#else
+#include <thread>
+#endif
+
+namespace sentinel::risk {
+
+#if defined(__linux__)
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) &&
+                  std::atomic<uint32_t>::is_always_lock_free,
+              "futex needs a plain 32-bit word");
+
+void EventCount::park_(uint32_t key, std::chrono::milliseconds timeout) {
+  const auto ms = timeout.count();
+  timespec ts{.tv_sec = static_cast<time_t>(ms / 1000),
+              .tv_nsec = static_cast<long>((ms % 1000) * 1'000'000)};
+  // Returns at once if epoch_ already moved past `key`; spurious wakeups
+  // and EINTR are fine, the caller re-checks its queue.
+  syscall(SYS_futex, reinterpret_cast<uint32_t *>(&epoch_), FUTEX_WAIT_PRIVATE, key, &ts,
+          nullptr, 0);
+}
+
+void EventCount::wake_() noexcept {
+  syscall(SYS_futex, reinterpret_cast<uint32_t *>(&epoch_), FUTEX_WAKE_PRIVATE, 1, nullptr,
+          nullptr, 0);
+}
+
+#else
+
+// Portable fallback: poll the epoch in short sleeps.
+void EventCount::park_(uint32_t key, std::chrono::milliseconds timeout) {
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (epoch_.load(std::memory_order_acquire) == key &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+  }
+}
+
+void EventCount::wake_() noexcept {}
+
+#endif
+
+} // namespace sentinel::risk
@@ -0,0 +1,71 @@
+#include "sentinel/risk/rcu.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace sentinel::risk {
+
+RcuDomain::RcuDomain() = default;
+
+RcuDomain::~RcuDomain() {
+  for (auto &r : retired_) {
+    r.destroy();
+  }
+}
+
+std::size_t RcuDomain::register_reader() {
+  for (std::size_t i = 0; i < slots_.size(); ++i) {
+    bool expected = false;
+    if (slots_[i].taken.compare_exchange_strong(expected, true)) {
+      // Either a writer scanning the slots sees this epoch, or everything
+      // it published before its scan is visible to the reader's loads
+      slots_[i].seen.store(epoch_.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      return i;
+    }
+  }
+  throw std::runtime_error("RcuDomain: too many readers");
+}
+
+void RcuDomain::unregister_reader(std::size_t slot) noexcept {
+  slots_[slot].seen.store(kIdle, std::memory_order_release);
+  slots_[slot].taken.store(false, std::memory_order_release);
+}
+
+void RcuDomain::retire(std::function<void()> destroy) {
+  {
+    std::lock_guard<std::mutex> lk(retired_mutex_);
+    // Readers that have seen the new epoch have seen the new value too
+    const uint64_t epoch = epoch_.fetch_add(1, std::memory_order_seq_cst) + 1;
+    retired_.push_back(Retired{epoch, std::move(destroy)});
+  }
+  collect();
+}
+
+std::size_t RcuDomain::collect() {
+  std::vector<Retired> ready;
+  {
+    std::lock_guard<std::mutex> lk(retired_mutex_);
+    uint64_t oldest = kIdle;
+    for (const auto &slot : slots_) {
+      oldest = std::min(oldest, slot.seen.load(std::memory_order_seq_cst));
+    }
+    auto keep = std::partition(retired_.begin(), retired_.end(),
+                               [oldest](const Retired &r) { return r.epoch > oldest; });
+    ready.assign(std::make_move_iterator(keep), std::make_move_iterator(retired_.end()));
+    retired_.erase(keep, retired_.end());
+  }
+  // Outside the lock: destructors of large snapshots take a while
+  for (auto &r : ready) {
+    r.destroy();
+  }
+  return ready.size();
+}
+
+std::size_t RcuDomain::pending() const {
+  std::lock_guard<std::mutex> lk(retired_mutex_);
+  return retired_.size();
+}
+
+} // namespace sentinel::risk
@@ -1,21 +1,99 @@
 #include "sentinel/risk/risk_engine.hpp"
 #include "sentinel/health/heartbeat.hpp"
 #include "sentinel/metrics/metrics.hpp"
+#include "sentinel/risk/address_hash.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 
 namespace sentinel::risk {
 
+namespace {
+
+// Busy time and signal counts are flushed to Prometheus in batches; a
+// counter update per signal would cost about as much as a cheap rule.
+constexpr uint64_t kShardMetricsBatch = 1024;
+
+bool is_stop(const Signal &signal) {
+  if (signal.type != SignalType::Control) {
+    return false;
+  }
+  const auto *control = std::get_if<ControlSignal>(&signal.payload);
+  return control && control->command == ControlSignal::Command::Stop;
+}
+
+// The barrier's block for a Sync signal, otherwise nullopt.
+std::optional<uint64_t> sync_block(const Signal &signal) {
+  if (signal.type != SignalType::Control) {
+    return std::nullopt;
+  }
+  const auto *control = std::get_if<ControlSignal>(&signal.payload);
+  if (!control || control->command != ControlSignal::Command::Sync) {
+    return std::nullopt;
+  }
+  return control->block;
+}
+
+} // namespace
+
+uint64_t partition_key(const Signal &signal) {
+  return std::visit(
+      [](const auto &p) -> uint64_t {
+        using T = std::decay_t<decltype(p)>;
+        if constexpr (std::is_same_v<T, EvmLogEvent>) {
+          return hash_address_key(p.chain_id, p.address);
+        } else if constexpr (std::is_same_v<T, TransferEvent> ||
+                             std::is_same_v<T, ApprovalEvent> ||
+                             std::is_same_v<T, MintBurnEvent>) {
+          return hash_address_key(p.chain_id, p.token_address);
+        } else if constexpr (std::is_same_v<T, GovernanceEvent>) {
+          return hash_address_key(p.chain_id, p.contract_address);
+        } else if constexpr (std::is_same_v<T, OracleUpdateEvent>) {
+          return hash_address_key(p.chain_id, p.aggregator_address);
+        } else {
+          return 0;
+        }
+      },
+      signal.payload);
+}
+
 RiskEngine::RiskEngine(RingBuffer<Signal> &input_queue,
                        AlertDispatcher &dispatcher,
                        std::string chain_name,
                        sentinel::metrics::Metrics* metrics,
-                       sentinel::health::Heartbeat* heartbeat)
+                       sentinel::health::Heartbeat* heartbeat,
+                       RiskEngineConfig cfg)
     : input_queue_(input_queue), dispatcher_(dispatcher), chain_name_(std::move(chain_name)),
-      metrics_(metrics), heartbeat_(heartbeat) {
+      metrics_(metrics), heartbeat_(heartbeat), rcu_(cfg.rcu) {
     if (metrics_) {
         ring_buffer_depth_gauge_ = metrics_->ring_buffer_depth_chain;
     }
+
+    if (rcu_ && cfg.workers > RcuDomain::kMaxReaders) {
+        throw std::runtime_error("RiskEngine: at most " +
+                                 std::to_string(RcuDomain::kMaxReaders) +
+                                 " workers when rule configs are reloadable");
+    }
+
+    if (cfg.workers > 1) {
+        shards_.reserve(cfg.workers);
+        for (unsigned i = 0; i < cfg.workers; ++i) {
+            auto shard = std::make_unique<Shard>(cfg.shard_queue_capacity);
+            if (metrics_) {
+                const prometheus::Labels labels{{"chain", chain_name_},
+                                                {"shard", std::to_string(i)}};
+                shard->depth_gauge = &metrics_->risk_engine_shard_queue_depth.Add(labels);
+                shard->signals_counter = &metrics_->risk_engine_shard_signals_total.Add(labels);
+                shard->busy_seconds_counter =
+                    &metrics_->risk_engine_shard_busy_seconds_total.Add(labels);
+            }
+            shards_.push_back(std::move(shard));
+        }
+    }
 }
 
 RiskEngine::~RiskEngine() { stop(); }
@@ -39,14 +117,56 @@ void RiskEngine::register_rule(IRiskRule *rule) {
 void RiskEngine::stop() { running_.store(false, std::memory_order_relaxed); }
 
 void RiskEngine::run(std::stop_token st) {
+  if (shards_.empty()) {
+    run_single_(st);
+  } else {
+    run_sharded_(st);
+  }
+  finished_.store(true, std::memory_order_release);
+}
+
+void RiskEngine::evaluate_(const Signal &signal, StateStore &state_store,
+                           std::vector<Alert> &alerts) {
+  alerts.clear();
+
+  // Spec 7: Reorg handling occurs before engine.
+  // Engine sees signal.meta.is_final = true or a ControlSignal.
+  // Engine must not implement rollback logic in MVP.
+
+  // Spec 5.2: Routing - lookup by signal.type
+  uint8_t type_idx = static_cast<uint8_t>(signal.type);
+
+  if (type_idx < SignalTypeCount) {
+    // Execute only the rules matching the signal type
+    for (IRiskRule *rule : routing_table_[type_idx]) {
+      rule->evaluate(signal, state_store, alerts);
+    }
+  }
+
+  // Push alerts to Dispatcher Thread. They carry the signal's ingress time
+  // for the signal-to-alert latency.
+  for (auto &alert : alerts) {
+    if (alert.internal_ingress_time_ms == 0) {
+      alert.internal_ingress_time_ms = signal.meta.internal_ingress_time_ms;
+    }
+    auto it = alerts_generated_counters_.find(alert.rule_type);
+    if (it != alerts_generated_counters_.end()) it->second->Increment();
+    dispatcher_.dispatch(alert);
+  }
+}
+
+void RiskEngine::run_single_(std::stop_token st) {
   // Pre-allocate alerts vector to avoid heap allocations in the hot path
   std::vector<Alert> alerts;
   alerts.reserve(64);
 
   bool drain_mode = false;
+  const std::size_t rcu_slot = rcu_ ? rcu_->register_reader() : 0;
 
   while (running_ && !st.stop_requested()) {
     if (heartbeat_) heartbeat_->record();
+    // No rule config from the previous signal is held any more
+    if (rcu_) rcu_->quiescent(rcu_slot);
     // Read from lock-free queue
     auto *signal_ptr = input_queue_.front();
     if (signal_ptr) {
@@ -56,51 +176,184 @@ void RiskEngine::run(std::stop_token st) {
       input_queue_.pop();
 
       // Check if it's a poison pill
-      if (signal.type == SignalType::Control) {
-        if (std::holds_alternative<ControlSignal>(signal.payload)) {
-          if (std::get<ControlSignal>(signal.payload).command ==
-              ControlSignal::Command::Stop) {
-            // Initiate drain phase
-            drain_mode = true;
-            // No more rules routing for ControlSignal MVP
-            continue;
-          }
-        }
+      if (is_stop(signal)) {
+        // Initiate drain phase
+        drain_mode = true;
+        // No more rules routing for ControlSignal MVP
+        continue;
+      }
+      if (const auto block = sync_block(signal)) {
+        dispatcher_.checkpoint(*block);
+        continue;
       }
 
-      alerts.clear();
+      evaluate_(signal, state_store_, alerts);
+    } else {
+      if (drain_mode) {
+        // Queue is completely empty and we are draining, clean exit
+        break;
+      }
+      // Queue is empty, yield to save CPU
+      std::this_thread::yield();
+    }
+  }
+
+  if (rcu_) rcu_->unregister_reader(rcu_slot);
+}
 
-      // Spec 7: Reorg handling occurs before engine.
-      // Engine sees signal.meta.is_final = true or a ControlSignal.
-      // Engine must not implement rollback logic in MVP.
+bool RiskEngine::push_to_shard_(Shard &shard, Signal &&signal) {
+  // Count before publishing so the worker never decrements below zero
+  if (shard.depth_gauge) shard.depth_gauge->Increment();
+  while (!shard.queue.try_push(std::move(signal))) {
+    if (!running_.load(std::memory_order_relaxed)) {
+      if (shard.depth_gauge) shard.depth_gauge->Decrement();
+      return false;
+    }
+    std::this_thread::yield();
+  }
+  return true;
+}
 
-      // Spec 5.2: Routing - lookup by signal.type
-      uint8_t type_idx = static_cast<uint8_t>(signal.type);
+void RiskEngine::run_sharded_(std::stop_token st) {
+  std::vector<std::jthread> workers;
+  workers.reserve(shards_.size());
+  for (auto &shard : shards_) {
+    workers.emplace_back([this, s = shard.get()] { run_shard_(*s); });
+  }
 
-      if (type_idx < SignalTypeCount) {
-        // Execute only the rules matching the signal type
-        for (IRiskRule *rule : routing_table_[type_idx]) {
-          // Rule evaluation is single-threaded, cache-friendly
-          rule->evaluate(signal, state_store_, alerts);
-        }
+  bool drain_mode = false;
+
+  while (running_ && !st.stop_requested()) {
+    if (heartbeat_) heartbeat_->record();
+    auto *signal_ptr = input_queue_.front();
+    if (!signal_ptr) {
+      if (drain_mode) {
+        break;
       }
+      std::this_thread::yield();
+      continue;
+    }
+
+    if (ring_buffer_depth_gauge_) ring_buffer_depth_gauge_->Decrement();
+
+    if (is_stop(*signal_ptr)) {
+      drain_mode = true;
+      input_queue_.pop();
+      continue;
+    }
 
-      // Push alerts to Dispatcher Thread
-      for (const auto &alert : alerts) {
-        auto it = alerts_generated_counters_.find(alert.rule_type);
-        if (it != alerts_generated_counters_.end()) it->second->Increment();
-        dispatcher_.dispatch(alert);
+    // Every worker gets its own copy of a barrier
+    if (sync_block(*signal_ptr)) {
+      bool pushed = true;
+      for (auto &shard : shards_) {
+        Signal copy = *signal_ptr;
+        if (!push_to_shard_(*shard, std::move(copy))) {
+          pushed = false;
+          break;
+        }
       }
-    } else {
-      if (drain_mode) {
-        // Queue is completely empty and we are draining, clean exit
+      if (!pushed) {
         break;
       }
-      // Queue is empty, yield to save CPU
+      input_queue_.pop();
+      continue;
+    }
+
+    Shard &shard = *shards_[partition_key(*signal_ptr) % shards_.size()];
+    if (!push_to_shard_(shard, std::move(*signal_ptr))) {
+      break;
+    }
+    input_queue_.pop();
+  }
+
+  if (drain_mode) {
+    // Each worker sees the marker only after everything routed to it, so
+    // joining below waits for a full drain.
+    for (auto &shard : shards_) {
+      Signal stop_signal{};
+      stop_signal.type = SignalType::Control;
+      stop_signal.payload = ControlSignal{ControlSignal::Command::Stop};
+      push_to_shard_(*shard, std::move(stop_signal));
+    }
+  } else {
+    // Forced stop: workers drop whatever is still queued
+    stop();
+  }
+
+  workers.clear(); // joins
+}
+
+void RiskEngine::shard_synced_(Shard &shard, uint64_t block) {
+  // Forwarded under the lock so barriers reach the dispatcher in order
+  std::lock_guard<std::mutex> lk(sync_mutex_);
+  shard.synced_block = block;
+  uint64_t all_synced = block;
+  for (const auto &s : shards_) {
+    all_synced = std::min(all_synced, s->synced_block);
+  }
+  if (all_synced > forwarded_block_) {
+    forwarded_block_ = all_synced;
+    dispatcher_.checkpoint(all_synced);
+  }
+}
+
+void RiskEngine::run_shard_(Shard &shard) {
+  std::vector<Alert> alerts;
+  alerts.reserve(64);
+
+  std::chrono::steady_clock::duration busy{};
+  uint64_t evaluated = 0;
+  auto flush_metrics = [&] {
+    if (evaluated == 0) {
+      return;
+    }
+    if (shard.signals_counter) {
+      shard.signals_counter->Increment(static_cast<double>(evaluated));
+    }
+    if (shard.busy_seconds_counter) {
+      shard.busy_seconds_counter->Increment(
+          std::chrono::duration<double>(busy).count());
+    }
+    busy = {};
+    evaluated = 0;
+  };
+
+  const std::size_t rcu_slot = rcu_ ? rcu_->register_reader() : 0;
+
+  while (running_.load(std::memory_order_relaxed)) {
+    if (rcu_) rcu_->quiescent(rcu_slot);
+    // Evaluated in place: the slot is not reused until pop()
+    auto *signal_ptr = shard.queue.front();
+    if (!signal_ptr) {
+      flush_metrics();
       std::this_thread::yield();
+      continue;
+    }
+
+    if (shard.depth_gauge) shard.depth_gauge->Decrement();
+
+    if (is_stop(*signal_ptr)) {
+      shard.queue.pop();
+      break;
+    }
+    if (const auto block = sync_block(*signal_ptr)) {
+      shard.queue.pop();
+      shard_synced_(shard, *block);
+      continue;
+    }
+
+    const auto started = std::chrono::steady_clock::now();
+    evaluate_(*signal_ptr, shard.state_store, alerts);
+    busy += std::chrono::steady_clock::now() - started;
+    shard.queue.pop();
+
+    if (++evaluated >= kShardMetricsBatch) {
+      flush_metrics();
     }
   }
-  finished_.store(true, std::memory_order_release);
+
+  flush_metrics();
+  if (rcu_) rcu_->unregister_reader(rcu_slot);
 }
 
 } // namespace sentinel::risk
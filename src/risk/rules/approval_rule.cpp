@@ -1,14 +1,18 @@
 #include "sentinel/risk/rules/approval_rule.hpp"
-#include "sentinel/events/utils/hex.hpp"
-#include <algorithm>
-#include <cstdio>
+#include "sentinel/events/utils/hex_codec.hpp"
+#include "sentinel/events/utils/uint256.hpp"
+#include <optional>
+#include <string>
+#include <utility>
 
 namespace sentinel::risk {
 
-ApprovalRule::ApprovalRule(
-    const std::unordered_map<ApprovalContractKey,
-                             std::vector<ApprovalRuleConfig>> &config_map)
-    : config_map_(config_map) {}
+ApprovalRule::ApprovalRule(ConfigMap config_map)
+    : config_map_(std::make_unique<const ConfigMap>(std::move(config_map))) {}
+
+void ApprovalRule::reload(ConfigMap config_map, RcuDomain &rcu) {
+    config_map_.publish(std::make_unique<const ConfigMap>(std::move(config_map)), rcu);
+}
 
 SignalMask ApprovalRule::interests() const {
     return make_mask(SignalType::Approval);
@@ -23,49 +27,48 @@ void ApprovalRule::evaluate(const Signal &signal,
         return;
     }
 
-    const auto *evm = std::get_if<EvmLogEvent>(&signal.payload);
-    if (!evm || evm->removed || evm->topic_count < 3 ||
-        evm->data_size < 32 || evm->truncated) {
+    const auto *ap = std::get_if<ApprovalEvent>(&signal.payload);
+    if (!ap || ap->removed) {
         return;
     }
 
-    std::string token_address_hex = "0x";
-    for (uint8_t b : evm->address) {
-        char buf[3];
-        std::snprintf(buf, sizeof(buf), "%02x", b);
-        token_address_hex += buf;
-    }
-
-    ApprovalContractKey key{evm->chain_id, token_address_hex};
-    auto it = config_map_.find(key);
-    if (it == config_map_.end()) {
+    ApprovalContractKey key{ap->chain_id, ap->token_address};
+    const ConfigMap &config_map = config_map_.read();
+    auto it = config_map.find(key);
+    if (it == config_map.end()) {
         return;
     }
 
-    bool is_infinite = std::all_of(evm->data.begin(), evm->data.begin() + 32,
-                                   [](uint8_t b) { return b == 0xFF; });
+    const auto amount = sentinel::events::utils::uint256::from_be_bytes(ap->amount);
+    const bool is_infinite = amount == sentinel::events::utils::uint256::max();
+
+    // Built lazily for the alert text
+    std::optional<std::string> token_address_hex;
+    std::optional<std::string> amount_dec;
 
     for (const auto &cfg : it->second) {
         if (!cfg.enabled) {
             continue;
         }
 
-        bool exceeds = sentinel::events::utils::greater_be_256(
-            evm->data.data(), cfg.threshold_be.data());
-        bool is_alert = (cfg.alert_on_infinite && is_infinite) || exceeds;
+        bool is_alert = (cfg.alert_on_infinite && is_infinite) || amount > cfg.threshold;
 
         if (!is_alert) {
             continue;
         }
 
+        if (!token_address_hex) {
+            token_address_hex = sentinel::events::utils::bytes_to_hex(ap->token_address);
+            amount_dec = amount.to_decimal();
+        }
+
         Alert alert{};
         alert.customer_id = cfg.customer_id;
         alert.rule_type = "approval";
         alert.timestamp_ms = signal.meta.timestamp_ms;
-        alert.chain_id = evm->chain_id;
-        alert.token_address = token_address_hex;
-        alert.amount_decimal =
-            sentinel::events::utils::uint256_be_to_decimal(evm->data.data());
+        alert.chain_id = ap->chain_id;
+        alert.token_address = *token_address_hex;
+        alert.amount_decimal = *amount_dec;
         alert.message = is_infinite ? "Infinite approval detected"
                                     : "Large approval detected";
 
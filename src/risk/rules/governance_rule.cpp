@@ -1,6 +1,8 @@
 #include "sentinel/risk/rules/governance_rule.hpp"
 #include "sentinel/events/utils/hex.hpp"
-#include <cstdio>
+#include <optional>
+#include <string>
+#include <utility>
 
 namespace sentinel::risk {
 
@@ -28,10 +30,12 @@ std::string action_to_string(GovernanceAction action) {
 
 } // namespace
 
-GovernanceRule::GovernanceRule(
-    const std::unordered_map<GovernanceContractKey,
-                             std::vector<GovernanceRuleConfig>> &config_map)
-    : config_map_(config_map) {}
+GovernanceRule::GovernanceRule(ConfigMap config_map)
+    : config_map_(std::make_unique<const ConfigMap>(std::move(config_map))) {}
+
+void GovernanceRule::reload(ConfigMap config_map, RcuDomain &rcu) {
+  config_map_.publish(std::make_unique<const ConfigMap>(std::move(config_map)), rcu);
+}
 
 SignalMask GovernanceRule::interests() const {
   return make_mask(SignalType::Governance);
@@ -51,21 +55,17 @@ void GovernanceRule::evaluate(const Signal &signal,
     return;
   }
 
-  // Format the contract address to hex (lowercase) for lookup
-  std::string contract_address_hex = "0x";
-  for (uint8_t b : gov_event->contract_address) {
-    char buf[3];
-    std::snprintf(buf, sizeof(buf), "%02x", b);
-    contract_address_hex += buf;
-  }
-
-  GovernanceContractKey key{gov_event->chain_id, contract_address_hex};
+  GovernanceContractKey key{gov_event->chain_id, gov_event->contract_address};
 
-  auto it = config_map_.find(key);
-  if (it == config_map_.end()) {
+  const ConfigMap &config_map = config_map_.read();
+  auto it = config_map.find(key);
+  if (it == config_map.end()) {
     return; // No customers listening to this contract
   }
 
+  // Formatted on the first alert only; most signals match no customer
+  std::optional<std::string> contract_address_hex;
+
   for (const auto &cfg : it->second) {
     if (!cfg.enabled) {
       continue;
@@ -77,16 +77,20 @@ void GovernanceRule::evaluate(const Signal &signal,
       continue;
     }
 
+    if (!contract_address_hex) {
+      contract_address_hex = sentinel::events::utils::bytes_to_hex(gov_event->contract_address);
+    }
+
     // Match! Create an alert.
     Alert alert{};
     alert.customer_id = cfg.customer_id;
     alert.rule_type = "governance";
     alert.timestamp_ms = signal.meta.timestamp_ms;
     alert.chain_id = gov_event->chain_id;
-    alert.token_address = contract_address_hex;
+    alert.token_address = *contract_address_hex;
 
     alert.message = std::string("Governance action '") + action_to_string(gov_event->action) +
-                    "' detected on contract " + contract_address_hex;
+                    "' detected on contract " + *contract_address_hex;
 
     out.push_back(std::move(alert));
   }
@@ -0,0 +1,83 @@
+#include "sentinel/risk/rules/large_transfer_rule.hpp"
+
+#include "sentinel/events/utils/hex_codec.hpp"
+#include "sentinel/events/utils/uint256.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace sentinel::risk {
+
+LargeTransferRule::LargeTransferRule(std::vector<LargeTransferRuleConfig> configs)
+    : buckets_(build_buckets_(configs)), log_(sentinel::logger(sentinel::LogComponent::Risk)) {}
+
+void LargeTransferRule::reload(std::vector<LargeTransferRuleConfig> configs, RcuDomain &rcu) {
+  buckets_.publish(build_buckets_(configs), rcu);
+}
+
+std::unique_ptr<const LargeTransferRule::Buckets>
+LargeTransferRule::build_buckets_(const std::vector<LargeTransferRuleConfig> &configs) {
+  auto buckets = std::make_unique<Buckets>();
+  // Stable so customers with equal thresholds keep their config order
+  std::vector<std::size_t> order(configs.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+    return configs[a].threshold < configs[b].threshold;
+  });
+
+  for (std::size_t i : order) {
+    const auto &config = configs[i];
+    Bucket &bucket =
+        (*buckets)[LargeTransferTokenKey{config.chain_id, config.token_address}];
+    if (bucket.token_address_hex.empty()) {
+      bucket.token_address_hex =
+          sentinel::events::utils::bytes_to_hex(config.token_address);
+    }
+    bucket.thresholds.push_back(config.threshold);
+    bucket.customer_ids.push_back(config.customer_id);
+  }
+  return buckets;
+}
+
+void LargeTransferRule::evaluate(const Signal &signal, StateStore & /* state_store */,
+                                 std::vector<Alert> &out) {
+  const auto *tr = std::get_if<TransferEvent>(&signal.payload);
+  if (!tr || tr->removed) {
+    return;
+  }
+
+  const Buckets &buckets = buckets_.read();
+  auto it = buckets.find(LargeTransferTokenKey{tr->chain_id, tr->token_address});
+  if (it == buckets.end()) {
+    return;
+  }
+  const Bucket &bucket = it->second;
+
+  const auto amount = sentinel::events::utils::uint256::from_be_bytes(tr->amount);
+
+  // First threshold >= amount; everything before it is strictly below
+  const std::size_t exceeded = static_cast<std::size_t>(
+      std::lower_bound(bucket.thresholds.begin(), bucket.thresholds.end(), amount) -
+      bucket.thresholds.begin());
+  if (exceeded == 0) {
+    return;
+  }
+
+  const std::string amount_dec = amount.to_decimal();
+
+  for (std::size_t i = 0; i < exceeded; ++i) {
+    log_.debug("[{}] Large transfer detected: amount={}, timestamp_ms={}",
+               bucket.customer_ids[i], amount_dec, signal.meta.timestamp_ms);
+
+    out.push_back(Alert{.customer_id = bucket.customer_ids[i],
+                        .rule_type = "large_transfer",
+                        .message = "Large transfer detected",
+                        .timestamp_ms = signal.meta.timestamp_ms,
+                        .amount_decimal = amount_dec,
+                        .token_address = bucket.token_address_hex,
+                        .chain_id = tr->chain_id});
+  }
+}
+
+} // namespace sentinel::risk
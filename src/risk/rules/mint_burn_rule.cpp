@@ -1,14 +1,18 @@
 #include "sentinel/risk/rules/mint_burn_rule.hpp"
-#include "sentinel/events/utils/hex.hpp"
-#include <cstdio>
-#include <cstring>
+#include "sentinel/events/utils/hex_codec.hpp"
+#include "sentinel/events/utils/uint256.hpp"
+#include <optional>
+#include <string>
+#include <utility>
 
 namespace sentinel::risk {
 
-MintBurnRule::MintBurnRule(
-    const std::unordered_map<MintBurnContractKey,
-                             std::vector<MintBurnRuleConfig>> &config_map)
-    : config_map_(config_map) {}
+MintBurnRule::MintBurnRule(ConfigMap config_map)
+    : config_map_(std::make_unique<const ConfigMap>(std::move(config_map))) {}
+
+void MintBurnRule::reload(ConfigMap config_map, RcuDomain &rcu) {
+  config_map_.publish(std::make_unique<const ConfigMap>(std::move(config_map)), rcu);
+}
 
 SignalMask MintBurnRule::interests() const {
   return make_mask(SignalType::MintBurn);
@@ -27,19 +31,19 @@ void MintBurnRule::evaluate(const Signal &signal, StateStore & /* state_store */
     return;
   }
 
-  std::string contract_address_hex = "0x";
-  for (uint8_t b : mb_event->token_address) {
-    char buf[3];
-    std::snprintf(buf, sizeof(buf), "%02x", b);
-    contract_address_hex += buf;
-  }
-
-  MintBurnContractKey key{mb_event->chain_id, contract_address_hex};
-  auto it = config_map_.find(key);
-  if (it == config_map_.end()) {
+  MintBurnContractKey key{mb_event->chain_id, mb_event->token_address};
+  const ConfigMap &config_map = config_map_.read();
+  auto it = config_map.find(key);
+  if (it == config_map.end()) {
     return;
   }
 
+  const auto amount = sentinel::events::utils::uint256::from_be_bytes(mb_event->amount);
+
+  // Only needed once an alert fires
+  std::optional<std::string> contract_address_hex;
+  std::optional<std::string> amount_dec;
+
   for (const auto &cfg : it->second) {
     if (!cfg.enabled) {
       continue;
@@ -47,19 +51,24 @@ void MintBurnRule::evaluate(const Signal &signal, StateStore & /* state_store */
 
     bool is_alert = false;
     if (mb_event->direction == MintBurnDirection::Mint) {
-      is_alert = !sentinel::events::utils::greater_be_256(cfg.mint_threshold_be.data(), mb_event->amount.data());
+      is_alert = amount >= cfg.mint_threshold;
     } else if (mb_event->direction == MintBurnDirection::Burn) {
-      is_alert = !sentinel::events::utils::greater_be_256(cfg.burn_threshold_be.data(), mb_event->amount.data());
+      is_alert = amount >= cfg.burn_threshold;
     }
 
     if (is_alert) {
+      if (!contract_address_hex) {
+        contract_address_hex = sentinel::events::utils::bytes_to_hex(mb_event->token_address);
+        amount_dec = amount.to_decimal();
+      }
+
       Alert alert{};
       alert.customer_id = cfg.customer_id;
       alert.rule_type = "mint_burn";
       alert.timestamp_ms = signal.meta.timestamp_ms;
       alert.chain_id = mb_event->chain_id;
-      alert.token_address = contract_address_hex;
-      alert.amount_decimal = sentinel::events::utils::uint256_be_to_decimal(mb_event->amount.data());
+      alert.token_address = *contract_address_hex;
+      alert.amount_decimal = *amount_dec;
 
       std::string dir_str = mb_event->direction == MintBurnDirection::Mint ? "Mint" : "Burn";
       alert.message = "Large " + dir_str + " detected";
@@ -1,18 +1,43 @@
 #include "sentinel/risk/rules/oracle_update_rule.hpp"
 
+#include "sentinel/events/utils/hex_codec.hpp"
+#include "sentinel/events/utils/uint256.hpp"
 #include "sentinel/log.hpp"
 
 #include <cstdint>
-#include <cstdio>
 #include <optional>
 #include <string>
 #include <utility>
 
 namespace sentinel::risk {
 
-OracleUpdateRule::OracleUpdateRule(
-    std::unordered_map<OracleFeedKey, std::vector<OracleRuleConfig>> configs_by_feed)
-    : configs_by_feed_(std::move(configs_by_feed)) {}
+OracleUpdateRule::OracleUpdateRule(ConfigMap configs_by_feed)
+    : feeds_(build_feeds_(std::move(configs_by_feed), nullptr)) {}
+
+void OracleUpdateRule::reload(ConfigMap configs_by_feed, RcuDomain& rcu) {
+    // Only the writer publishes, so the current snapshot cannot be retired
+    // while it is being read here
+    feeds_.publish(build_feeds_(std::move(configs_by_feed), &feeds_.read()), rcu);
+}
+
+std::unique_ptr<const OracleUpdateRule::Feeds>
+OracleUpdateRule::build_feeds_(ConfigMap configs_by_feed, const Feeds* previous) {
+    auto feeds = std::make_unique<Feeds>();
+    feeds->reserve(configs_by_feed.size());
+    for (auto& [key, configs] : configs_by_feed) {
+        std::shared_ptr<LastObservation> last;
+        if (previous) {
+            if (auto it = previous->find(key); it != previous->end()) {
+                last = it->second.last;
+            }
+        }
+        if (!last) {
+            last = std::make_shared<LastObservation>();
+        }
+        feeds->emplace(key, Feed{std::move(configs), std::move(last)});
+    }
+    return feeds;
+}
 
 SignalMask OracleUpdateRule::interests() const {
     return make_mask(SignalType::OracleUpdate);
@@ -24,15 +49,22 @@ std::string_view OracleUpdateRule::rule_type_name() const {
 
 namespace {
 
-inline std::string aggregator_to_hex(const std::array<uint8_t, 20>& addr) {
-    std::string out = "0x";
-    out.reserve(2 + 40);
-    for (uint8_t b : addr) {
-        char buf[3];
-        std::snprintf(buf, sizeof(buf), "%02x", b);
-        out.append(buf);
+using sentinel::events::utils::uint256;
+
+// diff * 10000 / prev, saturating at UINT64_MAX. Once prev outgrows 64 bits
+// both sides are shifted down until it fits, which keeps the divisor a
+// single limb at a relative error below 2^-63.
+uint64_t change_bps(uint256 prev, uint256 diff) {
+    const unsigned width = prev.bit_width();
+    if (width > 64) {
+        prev >>= width - 64;
+        diff >>= width - 64;
+    }
+    if (diff.mul_small(10000) != 0) {
+        return UINT64_MAX;
     }
-    return out;
+    diff /= prev.low64();
+    return diff.fits_u64() ? diff.low64() : UINT64_MAX;
 }
 
 inline std::string format_pct_from_bps(uint64_t delta_bps) {
@@ -63,83 +95,46 @@ void OracleUpdateRule::evaluate(const Signal& signal,
     OracleFeedKey key{oracle->chain_id, oracle->aggregator_address};
 
     // Only feeds that have at least one configured customer are tracked.
-    // This bounds the size of last_by_feed_ to the configured set.
-    auto cfg_it = configs_by_feed_.find(key);
-    if (cfg_it == configs_by_feed_.end()) {
+    // This bounds the number of observations kept to the configured set.
+    const Feeds& feeds = feeds_.read();
+    auto feed_it = feeds.find(key);
+    if (feed_it == feeds.end()) {
         return;
     }
+    LastObservation& state = *feed_it->second.last;
 
-    // Negative-price guard. Chainlink answers are int256; the high bit of the
-    // big-endian representation is the sign. We don't compare negative prices
-    // and we don't update state, so the next non-negative observation becomes
-    // the new baseline.
-    if (oracle->current_answer[0] & 0x80) {
-        return;
-    }
-
-    // 64-bit fit guard: bytes [0..23] must all be zero for the value to fit
-    // in uint64. Real production Chainlink answers always fit in int64.
-    for (int i = 0; i < 24; ++i) {
-        if (oracle->current_answer[i] != 0) {
-            sentinel::logger(sentinel::LogComponent::Risk).debug(
-                "OracleUpdateRule: skipping update with answer > 2^64 for "
-                "chain_id={} aggregator={}",
-                oracle->chain_id,
-                aggregator_to_hex(oracle->aggregator_address));
-            return;
-        }
-    }
+    const auto current = sentinel::events::utils::int256::from_be_bytes(oracle->current_answer);
 
-    uint64_t current_u64 = 0;
-    for (int i = 24; i < 32; ++i) {
-        current_u64 = (current_u64 << 8) | oracle->current_answer[i];
+    // Negative-price guard. Chainlink answers are int256. We don't compare
+    // negative prices and we don't update state, so the next non-negative
+    // observation becomes the new baseline.
+    if (current.is_negative()) {
+        return;
     }
 
-    auto state_it = last_by_feed_.find(key);
-    if (state_it == last_by_feed_.end()) {
+    if (!state.seen) {
         // Cold start for this feed: record and emit no alert.
-        last_by_feed_.emplace(key, LastObservation{
-            oracle->current_answer,
-            oracle->updated_at,
-        });
+        state = LastObservation{current, oracle->updated_at, true};
         return;
     }
 
-    const LastObservation& last = state_it->second;
-
-    uint64_t prev_u64 = 0;
-    for (int i = 24; i < 32; ++i) {
-        prev_u64 = (prev_u64 << 8) | last.answer[i];
-    }
+    const LastObservation& last = state;
+    const uint256 prev = last.answer.bits();
+    const uint256 cur = current.bits();
 
-    if (prev_u64 == 0) {
+    if (prev.is_zero()) {
         // Cannot compute a percentage from a zero baseline. Update state and
         // skip alerting; the next observation will compare against this one.
-        state_it->second = LastObservation{
-            oracle->current_answer,
-            oracle->updated_at,
-        };
+        state = LastObservation{current, oracle->updated_at, true};
         return;
     }
 
-    uint64_t diff = (current_u64 > prev_u64)
-                        ? (current_u64 - prev_u64)
-                        : (prev_u64 - current_u64);
-
-    // delta_bps = diff * 10000 / prev_u64. The intermediate `diff * 10000`
-    // can overflow uint64 for very large prev/diff, so widen to __int128.
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wpedantic"
-    using i128 = __int128;
-    i128 delta_bps_i = (static_cast<i128>(diff) * 10000) / prev_u64;
-    uint64_t delta_bps = (delta_bps_i > static_cast<i128>(UINT64_MAX))
-                             ? UINT64_MAX
-                             : static_cast<uint64_t>(delta_bps_i);
-#pragma GCC diagnostic pop
+    const uint64_t delta_bps = change_bps(prev, cur > prev ? cur - prev : prev - cur);
 
     std::optional<std::string> aggregator_hex;
+    std::optional<std::string> answer_dec;
 
-    for (const auto& cfg : cfg_it->second) {
+    for (const auto& cfg : feed_it->second.configs) {
         if (!cfg.enabled) {
             continue;
         }
@@ -147,10 +142,11 @@ void OracleUpdateRule::evaluate(const Signal& signal,
             continue;
         }
 
-        // Build the hex address lazily on the first emitted alert; share
-        // across multiple alerts in this bucket without re-formatting.
+        // Build the hex address and raw answer lazily on the first emitted
+        // alert; share across multiple alerts in this bucket.
         if (!aggregator_hex.has_value()) {
-            aggregator_hex = aggregator_to_hex(oracle->aggregator_address);
+            aggregator_hex = sentinel::events::utils::bytes_to_hex(oracle->aggregator_address);
+            answer_dec = current.to_decimal();
         }
 
         std::string pct = format_pct_from_bps(delta_bps);
@@ -168,7 +164,7 @@ void OracleUpdateRule::evaluate(const Signal& signal,
         alert.rule_type      = "oracle_update";
         alert.message        = std::move(msg);
         alert.timestamp_ms   = signal.meta.timestamp_ms;
-        alert.amount_decimal = std::to_string(current_u64);
+        alert.amount_decimal = *answer_dec;
         alert.token_address  = *aggregator_hex;
         alert.chain_id       = oracle->chain_id;
         out.push_back(std::move(alert));
@@ -176,10 +172,7 @@ void OracleUpdateRule::evaluate(const Signal& signal,
 
     // Always update state, even if no alert fired (or all configs disabled).
     // The next update will compare against this observation.
-    state_it->second = LastObservation{
-        oracle->current_answer,
-        oracle->updated_at,
-    };
+    state = LastObservation{current, oracle->updated_at, true};
 }
 
 } // namespace sentinel::risk
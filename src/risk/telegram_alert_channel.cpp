@@ -1,111 +1,62 @@
 #include "sentinel/risk/telegram_alert_channel.hpp"
 #include "sentinel/log.hpp"
 #include "sentinel/risk/alert_formatter.hpp"
-#include <curl/curl.h>
+#include <future>
 #include <nlohmann/json.hpp>
 
 namespace sentinel::risk {
-namespace {
-
-
-
-size_t string_write_cb(char *ptr, size_t size, size_t nmemb,
-                       void *userdata) noexcept {
-  if (!userdata) {
-    return 0;
-  }
-
-  auto *str = static_cast<std::string *>(userdata);
-  const size_t total = size * nmemb;
-
-  try {
-    str->append(ptr, total);
-    return total;
-  } catch (...) {
-    return 0;
-  }
-}
-} // namespace
 
 TelegramAlertChannel::TelegramAlertChannel(
     std::string bot_token, std::string chat_id,
     const std::unordered_map<std::uint64_t, std::string> *customer_map,
-    const std::unordered_map<TokenKey, std::string> *token_map)
+    const std::unordered_map<TokenKey, std::string> *token_map,
+    HttpDeliveryLoop *http)
     : bot_token_(std::move(bot_token)), chat_id_(std::move(chat_id)),
-      customer_map_(customer_map), token_map_(token_map) {}
+      customer_map_(customer_map), token_map_(token_map),
+      owned_http_(http ? nullptr : std::make_unique<HttpDeliveryLoop>()),
+      http_(http ? http : owned_http_.get()) {}
 
 TelegramAlertChannel::~TelegramAlertChannel() = default;
 
 void TelegramAlertChannel::send(const Alert &alert) {
-  CURL *curl = curl_easy_init();
-  auto &Lalert = sentinel::logger(sentinel::LogComponent::Alert);
-
-  if (!curl) {
-    Lalert.error(
-        "Telegram send failed: could not initialize curl handle for chat_id={}",
-        chat_id_);
-    return;
-  }
-
-  std::string url =
-      "https://api.telegram.org/bot" + bot_token_ + "/sendMessage";
+  std::promise<void> finished;
+  send_async(alert, [&finished](const DeliveryResult &) { finished.set_value(); });
+  finished.get_future().wait();
+}
 
+void TelegramAlertChannel::send_async(const Alert &alert, DeliveryCallback done) {
   std::string text = AlertFormatter::format_telegram(alert, customer_map_, token_map_);
 
   nlohmann::json payload;
   payload["chat_id"] = chat_id_;
   payload["text"] = text;
 
-  std::string json_str = payload.dump();
-
-  curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-  curl_easy_setopt(curl, CURLOPT_POST, 1L);
-  curl_easy_setopt(curl, CURLOPT_POSTFIELDS, json_str.c_str());
-  curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, json_str.size());
-
-  struct curl_slist *headers = nullptr;
-  headers = curl_slist_append(headers, "Content-Type: application/json");
-  curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-
-  /*auto discard_write_cb = [](char *ptr, size_t size, size_t nmemb,
-                             void *userdata) noexcept -> size_t {
-    (void)ptr;
-    (void)userdata;
-    return size * nmemb;
-  };*/
-  std::string response_body;
-  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, string_write_cb);
-  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_body);
-
-  // Set timeouts
-  curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 5L);
-  curl_easy_setopt(curl, CURLOPT_TIMEOUT, 10L);
-
-  CURLcode res = curl_easy_perform(curl);
-
-  if (res != CURLE_OK) {
-    Lalert.error("Telegram send failed (curl_easy_perform): {} for chat_id={}",
-                 curl_easy_strerror(res), chat_id_);
-  } else {
-    long http_code = 0;
-    CURLcode info_res =
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
-
-    if (info_res != CURLE_OK) {
-      Lalert.error("Telegram send failed: could not read HTTP response code "
-                   "for chat_id={}: {}",
-                   chat_id_, curl_easy_strerror(info_res));
-    } else if (http_code < 200 || http_code >= 300) {
+  HttpRequest req;
+  // Keyed by name, not URL, so breaker logs never carry the bot token
+  req.endpoint = "api.telegram.org";
+  req.channel = "telegram";
+  req.url = "https://api.telegram.org/bot" + bot_token_ + "/sendMessage";
+  req.body = payload.dump();
+  req.headers.push_back("Content-Type: application/json");
+
+  http_->submit(std::move(req), [chat_id = chat_id_, done = std::move(done)](HttpResponse resp) {
+    auto &Lalert = sentinel::logger(sentinel::LogComponent::Alert);
+    DeliveryResult result;
+    if (resp.status == 0) {
+      Lalert.error("Telegram send failed (curl): {} for chat_id={}", resp.error, chat_id);
+      result.ok = false;
+      result.error = resp.error;
+    } else if (!resp.ok) {
       Lalert.error("Telegram send failed: chat_id={}, HTTP {}, body={}",
-                   chat_id_, http_code, response_body);
+                   chat_id, resp.status, resp.body);
+      result.ok = false;
+      result.error = "HTTP " + std::to_string(resp.status);
     } else {
       Lalert.debug("Telegram send succeeded: chat_id={}, HTTP {}, body={}",
-                   chat_id_, http_code, response_body);
+                   chat_id, resp.status, resp.body);
     }
-  }
-
-  curl_slist_free_all(headers);
-  curl_easy_cleanup(curl);
+    done(result);
+  });
 }
 
 } // namespace sentinel::risk
@@ -0,0 +1,69 @@
+#include "sentinel/risk/timer_wheel.hpp"
+
+#include <algorithm>
+
+namespace sentinel::risk {
+
+TimerWheel::TimerWheel(std::chrono::milliseconds tick, std::size_t slots,
+                       Clock::time_point start)
+    : tick_(std::max(tick, std::chrono::milliseconds(1))), start_(start),
+      slots_(std::max<std::size_t>(slots, 1)) {}
+
+uint64_t TimerWheel::tick_of_(Clock::time_point t) const {
+  if (t <= start_) {
+    return 0;
+  }
+  return static_cast<uint64_t>((t - start_) / tick_);
+}
+
+void TimerWheel::schedule(Clock::time_point due, Callback fn) {
+  // Round up so the timer never fires before `due`
+  uint64_t tick = tick_of_(due);
+  if (start_ + tick * tick_ < due) {
+    ++tick;
+  }
+  tick = std::max(tick, current_ + 1);
+  slots_[tick % slots_.size()].push_back(Entry{tick, std::move(fn)});
+  ++size_;
+}
+
+std::vector<TimerWheel::Callback> TimerWheel::expire(Clock::time_point now) {
+  std::vector<Callback> due;
+  const uint64_t now_tick = tick_of_(now);
+  if (now_tick <= current_) {
+    return due;
+  }
+
+  // A gap of a full rotation or more visits every slot once
+  const uint64_t steps = std::min<uint64_t>(now_tick - current_, slots_.size());
+  for (uint64_t t = now_tick - steps + 1; t <= now_tick && size_ > due.size(); ++t) {
+    auto &slot = slots_[t % slots_.size()];
+    auto keep = std::stable_partition(slot.begin(), slot.end(), [now_tick](const Entry &e) {
+      return e.tick > now_tick;
+    });
+    for (auto it = keep; it != slot.end(); ++it) {
+      due.push_back(std::move(it->fn));
+    }
+    slot.erase(keep, slot.end());
+  }
+  current_ = now_tick;
+  size_ -= due.size();
+  return due;
+}
+
+std::optional<TimerWheel::Clock::time_point> TimerWheel::next_due() const {
+  if (size_ == 0) {
+    return std::nullopt;
+  }
+  for (uint64_t t = current_ + 1; t <= current_ + slots_.size(); ++t) {
+    for (const Entry &e : slots_[t % slots_.size()]) {
+      if (e.tick == t) {
+        return start_ + t * tick_;
+      }
+    }
+  }
+  // Everything is at least one rotation away
+  return start_ + (current_ + slots_.size()) * tick_;
+}
+
+} // namespace sentinel::risk
@@ -1,9 +1,10 @@
 #include "sentinel/risk/webhook_alert_channel.hpp"
 
 #include <chrono>
+#include <future>
+#include <mutex>
 #include <string>
 
-#include <curl/curl.h>
 #include <nlohmann/json.hpp>
 
 #include "sentinel/log.hpp"
@@ -13,37 +14,75 @@ namespace sentinel::risk {
 
 namespace {
 
-size_t string_write_cb(char *ptr, size_t size, size_t nmemb,
-                       void *userdata) noexcept {
-    if (!userdata)
-        return 0;
-    auto *str = static_cast<std::string *>(userdata);
-    const size_t total = size * nmemb;
-    try {
-        str->append(ptr, total);
-        return total;
-    } catch (...) {
-        return 0;
+// Completion state shared by the requests for one alert. Callbacks all run
+// on the delivery loop thread, so plain fields suffice.
+struct Fanout {
+    std::size_t remaining;
+    DeliveryResult result;
+    DeliveryCallback done;
+};
+
+void record(Fanout &fanout, const HttpResponse &resp) {
+    if (!resp.ok && fanout.result.ok) {
+        fanout.result.ok = false;
+        fanout.result.error =
+            resp.status == 0 ? resp.error : "HTTP " + std::to_string(resp.status);
+    }
+    if (--fanout.remaining == 0) {
+        fanout.done(fanout.result);
     }
 }
 
-} // namespace
+std::string now_ms_string() {
+    return std::to_string(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count());
+}
 
-WebhookAlertChannel::WebhookAlertChannel(
-    std::unordered_map<std::uint64_t, std::vector<WebhookEndpoint>>
-        customer_webhooks)
-    : customer_webhooks_(std::move(customer_webhooks)) {}
+// POSTs `body` to `url`, signed with `secret` when there is one, and hands
+// the response to `on_response` after logging it. `batch_size` > 0 marks
+// the body as a JSON array of that many alerts.
+void post_signed(HttpDeliveryLoop &http, const std::string &url,
+                 const std::string &secret, std::string body,
+                 const std::string &timestamp_ms_str, std::size_t batch_size,
+                 std::function<void(const HttpResponse &)> on_response) {
+    HttpRequest req;
+    req.url = url;
+    req.channel = "webhook";
+    req.headers.push_back("Content-Type: application/json");
+    req.headers.push_back("X-Risk-Sentinel-Timestamp: " + timestamp_ms_str);
+    if (batch_size > 0) {
+        req.headers.push_back("X-Risk-Sentinel-Batch-Size: " + std::to_string(batch_size));
+    }
 
-WebhookAlertChannel::~WebhookAlertChannel() = default;
+    if (!secret.empty()) {
+        req.headers.push_back("X-Risk-Sentinel-Signature: " +
+                              webhook_signature(secret, timestamp_ms_str, body));
+    }
+    req.body = std::move(body);
 
-void WebhookAlertChannel::send(const Alert &alert) {
-    auto it = customer_webhooks_.find(alert.customer_id);
-    if (it == customer_webhooks_.end() || it->second.empty())
-        return;
+    http.submit(std::move(req), [url, batch_size,
+                                 on_response = std::move(on_response)](HttpResponse resp) {
+        auto &Lalert = sentinel::logger(sentinel::LogComponent::Alert);
+        if (resp.status == 0) {
+            Lalert.error("Webhook send failed (curl): {} for url={}", resp.error, url);
+        } else if (!resp.ok) {
+            Lalert.error("Webhook send failed: url={}, HTTP {}, body={}",
+                         url, resp.status, resp.body);
+        } else if (batch_size > 0) {
+            Lalert.debug("Webhook batch of {} sent: url={}, HTTP {}",
+                         batch_size, url, resp.status);
+        } else {
+            Lalert.debug("Webhook send succeeded: url={}, HTTP {}", url, resp.status);
+        }
+        on_response(resp);
+    });
+}
 
-    auto &Lalert = sentinel::logger(sentinel::LogComponent::Alert);
+} // namespace
 
-    // Build the JSON payload once — sign and send THESE exact bytes.
+std::string webhook_payload(const Alert &alert) {
     nlohmann::json payload;
     payload["customer_id"] = alert.customer_id;
     payload["rule_type"]   = alert.rule_type;
@@ -55,83 +94,162 @@ void WebhookAlertChannel::send(const Alert &alert) {
         payload["token_address"] = *alert.token_address;
     if (alert.amount_decimal.has_value())
         payload["amount_decimal"] = *alert.amount_decimal;
+    return payload.dump();
+}
 
-    const std::string body = payload.dump();
+std::string webhook_signature(const std::string &secret,
+                              const std::string &timestamp_ms_str,
+                              const std::string &body) {
+    // Sign "<timestamp_ms>.<body>" so the timestamp header is
+    // authenticated and cannot be swapped on a replayed request.
+    // This matches the Stripe / GitHub webhook signing pattern.
+    return "sha256=" +
+           sentinel::security::hmac_sha256_hex(secret, timestamp_ms_str + "." + body);
+}
 
-    // Capture send timestamp once per dispatch (replay-protection window
-    // is the same for all endpoints of this alert).
-    const std::string timestamp_ms_str = std::to_string(
-        std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now().time_since_epoch())
-            .count());
+struct WebhookAlertChannel::Batches {
+    struct Pending {
+        std::string url;
+        std::string hmac_secret;
+        std::vector<std::string> items; // serialized alert objects
+        std::vector<std::shared_ptr<Fanout>> fanouts;
+        uint64_t generation = 0;        // bumped on every flush
+    };
 
-    for (const auto &endpoint : it->second) {
-        std::string signature;
-        if (!endpoint.hmac_secret.empty()) {
-            // Sign "<timestamp_ms>.<body>" so the timestamp header is
-            // authenticated and cannot be swapped on a replayed request.
-            // This matches the Stripe / GitHub webhook signing pattern.
-            const std::string signing_string = timestamp_ms_str + "." + body;
-            signature = "sha256=" +
-                        sentinel::security::hmac_sha256_hex(
-                            endpoint.hmac_secret, signing_string);
+    explicit Batches(HttpDeliveryLoop &http) : http(http) {}
+
+    void add(const WebhookEndpoint &endpoint, std::string item,
+             std::shared_ptr<Fanout> fanout, std::weak_ptr<Batches> self) {
+        std::unique_lock<std::mutex> lk(mu);
+        Pending &p = pending[&endpoint];
+        if (p.items.empty()) {
+            p.url = endpoint.url;
+            p.hmac_secret = endpoint.hmac_secret;
         }
+        p.items.push_back(std::move(item));
+        p.fanouts.push_back(std::move(fanout));
 
-        CURL *curl = curl_easy_init();
-        if (!curl) {
-            Lalert.error(
-                "Webhook send failed: could not initialize curl for url={}",
-                endpoint.url);
-            continue;
+        if (p.items.size() >= endpoint.batch_max_items) {
+            Pending full = take(p);
+            lk.unlock();
+            send(std::move(full));
+        } else if (p.items.size() == 1) {
+            // The timer only uses the endpoint's address as a key: it may
+            // fire after the channel, and its endpoints, are gone.
+            const uint64_t generation = p.generation;
+            lk.unlock();
+            http.schedule(endpoint.batch_max_delay,
+                          [self = std::move(self), key = &endpoint, generation] {
+                              if (auto batches = self.lock()) {
+                                  batches->flush(key, generation);
+                              }
+                          });
         }
+    }
 
-        std::string response_body;
-
-        curl_easy_setopt(curl, CURLOPT_URL, endpoint.url.c_str());
-        curl_easy_setopt(curl, CURLOPT_POST, 1L);
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.c_str());
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE,
-                         static_cast<long>(body.size()));
-        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 5L);
-        curl_easy_setopt(curl, CURLOPT_TIMEOUT, 10L);
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, string_write_cb);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_body);
-
-        struct curl_slist *headers = nullptr;
-        headers = curl_slist_append(headers, "Content-Type: application/json");
-
-        const std::string ts_header =
-            "X-Risk-Sentinel-Timestamp: " + timestamp_ms_str;
-        headers = curl_slist_append(headers, ts_header.c_str());
-
-        std::string sig_header;
-        if (!signature.empty()) {
-            sig_header = "X-Risk-Sentinel-Signature: " + signature;
-            headers = curl_slist_append(headers, sig_header.c_str());
+    // Sends the batch for `key` unless it was already sent since the timer
+    // was set.
+    void flush(const WebhookEndpoint *key, uint64_t generation) {
+        std::unique_lock<std::mutex> lk(mu);
+        auto it = pending.find(key);
+        if (it == pending.end() || it->second.generation != generation ||
+            it->second.items.empty()) {
+            return;
         }
+        Pending batch = take(it->second);
+        lk.unlock();
+        send(std::move(batch));
+    }
 
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    void flush_all() {
+        std::vector<Pending> batches;
+        {
+            std::lock_guard<std::mutex> lk(mu);
+            for (auto &[key, p] : pending) {
+                if (!p.items.empty()) {
+                    batches.push_back(take(p));
+                }
+            }
+        }
+        for (auto &batch : batches) {
+            send(std::move(batch));
+        }
+    }
 
-        CURLcode res = curl_easy_perform(curl);
+    static Pending take(Pending &p) {
+        Pending out;
+        out.url = p.url;
+        out.hmac_secret = p.hmac_secret;
+        out.items.swap(p.items);
+        out.fanouts.swap(p.fanouts);
+        ++p.generation;
+        return out;
+    }
 
-        if (res != CURLE_OK) {
-            Lalert.error("Webhook send failed (curl): {} for url={}",
-                         curl_easy_strerror(res), endpoint.url);
-        } else {
-            long http_code = 0;
-            curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
-            if (http_code < 200 || http_code >= 300) {
-                Lalert.error(
-                    "Webhook send failed: url={}, HTTP {}, body={}",
-                    endpoint.url, http_code, response_body);
-            } else {
-                Lalert.debug("Webhook send succeeded: url={}, HTTP {}",
-                             endpoint.url, http_code);
-            }
+    void send(Pending batch) {
+        std::string body = "[";
+        for (std::size_t i = 0; i < batch.items.size(); ++i) {
+            if (i > 0) body += ',';
+            body += batch.items[i];
         }
+        body += ']';
+
+        post_signed(http, batch.url, batch.hmac_secret, std::move(body),
+                    now_ms_string(), batch.items.size(),
+                    [fanouts = std::move(batch.fanouts)](const HttpResponse &resp) {
+                        for (const auto &fanout : fanouts) {
+                            record(*fanout, resp);
+                        }
+                    });
+    }
+
+    HttpDeliveryLoop &http;
+    std::mutex mu;
+    std::unordered_map<const WebhookEndpoint *, Pending> pending;
+};
+
+WebhookAlertChannel::WebhookAlertChannel(
+    std::unordered_map<std::uint64_t, std::vector<WebhookEndpoint>>
+        customer_webhooks,
+    HttpDeliveryLoop *http)
+    : customer_webhooks_(std::move(customer_webhooks)),
+      owned_http_(http ? nullptr : std::make_unique<HttpDeliveryLoop>()),
+      http_(http ? http : owned_http_.get()),
+      batches_(std::make_shared<Batches>(*http_)) {}
+
+WebhookAlertChannel::~WebhookAlertChannel() { batches_->flush_all(); }
+
+void WebhookAlertChannel::send(const Alert &alert) {
+    std::promise<void> finished;
+    send_async(alert, [&finished](const DeliveryResult &) { finished.set_value(); });
+    finished.get_future().wait();
+}
+
+void WebhookAlertChannel::send_async(const Alert &alert, DeliveryCallback done) {
+    auto it = customer_webhooks_.find(alert.customer_id);
+    if (it == customer_webhooks_.end() || it->second.empty()) {
+        done(DeliveryResult{});
+        return;
+    }
+
+    // Build the JSON payload once — sign and send THESE exact bytes.
+    const std::string body = webhook_payload(alert);
 
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
+    // Capture send timestamp once per dispatch (replay-protection window
+    // is the same for all endpoints of this alert).
+    const std::string timestamp_ms_str = now_ms_string();
+
+    auto fanout = std::make_shared<Fanout>(
+        Fanout{it->second.size(), DeliveryResult{}, std::move(done)});
+
+    for (const auto &endpoint : it->second) {
+        if (endpoint.batch_max_items > 1) {
+            batches_->add(endpoint, body, fanout, batches_);
+            continue;
+        }
+        post_signed(*http_, endpoint.url, endpoint.hmac_secret, body,
+                    timestamp_ms_str, 0,
+                    [fanout](const HttpResponse &resp) { record(*fanout, resp); });
     }
 }
 
@@ -2,6 +2,7 @@
 #include "sentinel/metrics/metrics.hpp"
 
 #include <curl/curl.h>
+#include <algorithm>
 #include <stdexcept>
 #include <string>
 #include <sstream>
@@ -10,6 +11,17 @@
 
 namespace {
 
+// Serialized JSON-RPC 2.0 request object
+std::string request_body(const std::string& method, const nlohmann::json& params, std::size_t id) {
+    nlohmann::json req{
+        {"jsonrpc", "2.0"},
+        {"id", id},
+        {"method", method},
+        {"params", params}
+    };
+    return req.dump();
+}
+
 // libcurl write callback
 size_t write_callback(char* ptr, size_t size, size_t nmemb, void* userdata) {
     auto* out = static_cast<std::string*>(userdata);
@@ -19,6 +31,55 @@ size_t write_callback(char* ptr, size_t size, size_t nmemb, void* userdata) {
 
 } // namespace
 
+// State shared by every pooled handle of one client: the DNS cache and TLS
+// session cache (so a freshly created handle resumes TLS instead of doing a
+// full handshake) and the constant request headers. The connection cache is
+// deliberately not shared: libcurl does not support sharing live connections
+// between concurrently running threads, so each handle keeps its own.
+struct JsonRpcClient::CurlShared {
+    CURLSH* share = nullptr;
+    struct curl_slist* headers = nullptr;
+    std::array<std::mutex, CURL_LOCK_DATA_LAST> locks;
+
+    static void lock(CURL*, curl_lock_data data, curl_lock_access, void* userptr) {
+        static_cast<CurlShared*>(userptr)->locks[data].lock();
+    }
+    static void unlock(CURL*, curl_lock_data data, void* userptr) {
+        static_cast<CurlShared*>(userptr)->locks[data].unlock();
+    }
+
+    CurlShared() {
+        headers = curl_slist_append(headers, "Content-Type: application/json");
+
+        share = curl_share_init();
+        if (share) {
+            curl_share_setopt(share, CURLSHOPT_LOCKFUNC, &CurlShared::lock);
+            curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, &CurlShared::unlock);
+            curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+            curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+            curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        }
+    }
+
+    ~CurlShared() {
+        if (share) curl_share_cleanup(share);
+        curl_slist_free_all(headers);
+    }
+};
+
+// One easy handle plus its response buffer. Both survive between calls: the
+// handle keeps its connection cache (keep-alive) and the buffer keeps its
+// capacity, so a steady stream of calls does no connection setup and no
+// response reallocation.
+struct JsonRpcClient::PooledHandle {
+    CURL* curl = nullptr;
+    std::string response;
+
+    ~PooledHandle() {
+        if (curl) curl_easy_cleanup(curl);
+    }
+};
+
 JsonRpcClient::JsonRpcClient(std::string endpoint, std::string chain_name, sentinel::metrics::Metrics* metrics)
     : endpoint_(std::move(endpoint)), chain_name_(std::move(chain_name)), metrics_(metrics) {
     if (endpoint_.empty()) {
@@ -29,7 +90,7 @@ JsonRpcClient::JsonRpcClient(std::string endpoint, std::string chain_name, senti
         last_rpc_success_gauge_ = metrics_->last_rpc_success_timestamp_seconds_chain;
 
         constexpr std::string_view kMethods[] = {
-            "eth_getLogs", "eth_blockNumber", "eth_getBlockByNumber", "eth_chainId"
+            "eth_getLogs", "eth_blockNumber", "eth_getBlockByNumber", "eth_chainId", "batch"
         };
         constexpr std::string_view kStatuses[] = {"success", "error"};
 
@@ -42,79 +103,197 @@ JsonRpcClient::JsonRpcClient(std::string endpoint, std::string chain_name, senti
             rpc_histograms_[std::string(method)] = &metrics_->rpc_call_duration_seconds.Add(
                 {{"chain", chain_name_}, {"method", std::string(method)}},
                 prometheus::Histogram::BucketBoundaries{0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0});
+
+            const prometheus::Histogram::BucketBoundaries phase_buckets{
+                0.001, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0};
+            rpc_phase_histograms_[std::string(method)] = {
+                &metrics_->rpc_call_phase_seconds.Add(
+                    {{"chain", chain_name_}, {"method", std::string(method)}, {"phase", "connect"}},
+                    phase_buckets),
+                &metrics_->rpc_call_phase_seconds.Add(
+                    {{"chain", chain_name_}, {"method", std::string(method)}, {"phase", "transfer"}},
+                    phase_buckets),
+            };
         }
     }
 
     // Global init is safe to call multiple times, but we do it once here
     curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    shared_ = std::make_unique<CurlShared>();
 }
 
-nlohmann::json JsonRpcClient::call(
-    const std::string& method,
-    const nlohmann::json& params
-) {
-    auto start_time = std::chrono::steady_clock::now();
-    auto rpc_counter = [&](const std::string& status) -> prometheus::Counter* {
-        auto it = rpc_counters_.find(method + ":" + status);
-        return it != rpc_counters_.end() ? it->second : nullptr;
-    };
+JsonRpcClient::~JsonRpcClient() {
+    // Handles reference the share object; clean them up first.
+    idle_handles_.clear();
+    shared_.reset();
+}
 
-    CURL* curl = curl_easy_init();
-    if (!curl) {
-        if (auto* c = rpc_counter("error")) c->Increment();
-        throw std::runtime_error("curl_easy_init failed");
-    }
+// Returns the leased handle to the pool on every exit path. A handle whose
+// transfer failed is still reusable: libcurl drops a broken connection and
+// reconnects on the next perform.
+class JsonRpcClient::HandleLease {
+public:
+    HandleLease(JsonRpcClient& client, const std::string& method)
+        : client_(client), handle_(client.acquire_handle_(method)) {}
+    ~HandleLease() { client_.release_handle_(std::move(handle_)); }
 
-    // --- Build JSON-RPC request ---
-    nlohmann::json req{
-        {"jsonrpc", "2.0"},
-        {"id", 1},
-        {"method", method},
-        {"params", params}
-    };
+    HandleLease(const HandleLease&) = delete;
+    HandleLease& operator=(const HandleLease&) = delete;
 
-    const std::string body = req.dump();
+    PooledHandle& operator*() { return *handle_; }
+    PooledHandle* operator->() { return handle_.get(); }
 
-    std::string response;
-    struct curl_slist* headers = nullptr;
-    headers = curl_slist_append(headers, "Content-Type: application/json");
+private:
+    JsonRpcClient& client_;
+    std::unique_ptr<PooledHandle> handle_;
+};
+
+std::unique_ptr<JsonRpcClient::PooledHandle> JsonRpcClient::acquire_handle_(const std::string& method) {
+    {
+        std::lock_guard<std::mutex> lk(pool_mutex_);
+        if (!idle_handles_.empty()) {
+            auto handle = std::move(idle_handles_.back());
+            idle_handles_.pop_back();
+            return handle;
+        }
+    }
+
+    auto handle = std::make_unique<PooledHandle>();
+    handle->curl = curl_easy_init();
+    if (!handle->curl) {
+        count_(method, "error");
+        throw std::runtime_error("curl_easy_init failed");
+    }
 
+    CURL* curl = handle->curl;
     curl_easy_setopt(curl, CURLOPT_URL, endpoint_.c_str());
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, shared_->headers);
     curl_easy_setopt(curl, CURLOPT_POST, 1L);
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.c_str());
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, body.size());
-
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &handle->response);
+    if (shared_->share) {
+        curl_easy_setopt(curl, CURLOPT_SHARE, shared_->share);
+    }
 
     // --- Important safety defaults ---
     curl_easy_setopt(curl, CURLOPT_TIMEOUT, 10L);          // seconds
     curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 5L);    // seconds
     curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);           // for multithread safety
 
+    // --- Connection reuse ---
+    // HTTP/2 over TLS when the server offers it (HTTP/1.1 keep-alive
+    // otherwise); ignored by builds without nghttp2.
+    curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_2TLS));
+    // Empty string = advertise every encoding this libcurl can decode.
+    curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "");
+    // Keep idle connections from being dropped by NATs/load balancers
+    // between polls.
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPIDLE, 30L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPINTVL, 15L);
+
+    return handle;
+}
+
+void JsonRpcClient::release_handle_(std::unique_ptr<PooledHandle> handle) {
+    std::lock_guard<std::mutex> lk(pool_mutex_);
+    if (idle_handles_.size() < kMaxIdleHandles) {
+        idle_handles_.push_back(std::move(handle));
+    }
+}
+
+void JsonRpcClient::count_(const std::string& method, const char* status) {
+    auto it = rpc_counters_.find(method + ":" + status);
+    if (it != rpc_counters_.end()) it->second->Increment();
+}
+
+void JsonRpcClient::set_first_success_callback(std::function<void()> callback) {
+    on_first_success_ = std::move(callback);
+}
+
+void JsonRpcClient::record_success_(const std::string& method,
+                                    std::chrono::steady_clock::time_point start_time) {
+    if (on_first_success_ && !succeeded_once_.load(std::memory_order_relaxed) &&
+        !succeeded_once_.exchange(true)) {
+        on_first_success_();
+    }
+    if (!metrics_) return;
+
+    if (last_rpc_success_gauge_) {
+        last_rpc_success_gauge_->Set(
+            static_cast<double>(std::chrono::duration_cast<std::chrono::seconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count())
+        );
+    }
+    count_(method, "success");
+    auto hist_it = rpc_histograms_.find(method);
+    if (hist_it != rpc_histograms_.end()) {
+        hist_it->second->Observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count());
+    }
+}
+
+void JsonRpcClient::record_phases_(const std::string& method, PooledHandle& handle) {
+    auto it = rpc_phase_histograms_.find(method);
+    if (it == rpc_phase_histograms_.end()) return;
+
+    // All *_TIME_T values are microseconds since the start of the transfer.
+    // On a reused connection connect/appconnect are 0.
+    curl_off_t connect_us = 0, appconnect_us = 0, total_us = 0;
+    curl_easy_getinfo(handle.curl, CURLINFO_CONNECT_TIME_T, &connect_us);
+    curl_easy_getinfo(handle.curl, CURLINFO_APPCONNECT_TIME_T, &appconnect_us);
+    curl_easy_getinfo(handle.curl, CURLINFO_TOTAL_TIME_T, &total_us);
+
+    const curl_off_t setup_us = std::max(connect_us, appconnect_us);
+    const curl_off_t transfer_us = std::max<curl_off_t>(total_us - setup_us, 0);
+
+    it->second[0]->Observe(static_cast<double>(setup_us) / 1e6);
+    it->second[1]->Observe(static_cast<double>(transfer_us) / 1e6);
+}
+
+void JsonRpcClient::perform_(
+    const std::string& method,
+    const std::string& body,
+    PooledHandle& handle
+) {
+    handle.response.clear();
+
+    CURL* curl = handle.curl;
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.c_str());
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(body.size()));
+
     CURLcode rc = curl_easy_perform(curl);
 
     long http_code = 0;
     curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
 
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
-
     if (rc != CURLE_OK) {
-        if (auto* c = rpc_counter("error")) c->Increment();
+        count_(method, "error");
         std::ostringstream oss;
         oss << "curl_easy_perform failed: " << curl_easy_strerror(rc);
         throw std::runtime_error(oss.str());
     }
 
+    record_phases_(method, handle);
+
     if (http_code != 200) {
-        if (auto* c = rpc_counter("error")) c->Increment();
+        count_(method, "error");
         std::ostringstream oss;
         oss << "JSON-RPC HTTP error: " << http_code
-            << ", response=" << response;
-        throw std::runtime_error(oss.str());
+            << ", response=" << handle.response;
+        throw JsonRpcHttpError(http_code, oss.str());
     }
+}
+
+nlohmann::json JsonRpcClient::call(
+    const std::string& method,
+    const nlohmann::json& params
+) {
+    auto start_time = std::chrono::steady_clock::now();
+
+    HandleLease handle(*this, method);
+    perform_(method, request_body(method, params, 1), *handle);
+    const std::string& response = handle->response;
 
     // --- Parse JSON ---
     nlohmann::json json;
@@ -129,32 +308,66 @@ nlohmann::json JsonRpcClient::call(
 
     // --- JSON-RPC error handling ---
     if (json.contains("error")) {
-        if (auto* c = rpc_counter("error")) c->Increment();
+        count_(method, "error");
         throw std::runtime_error(
             "JSON-RPC error: " + json["error"].dump()
         );
     }
 
     if (!json.contains("result")) {
-        if (auto* c = rpc_counter("error")) c->Increment();
+        count_(method, "error");
         throw std::runtime_error(
             "JSON-RPC response missing result field: " + json.dump()
         );
     }
 
-    if (metrics_) {
-        if (last_rpc_success_gauge_) {
-            last_rpc_success_gauge_->Set(
-                static_cast<double>(std::chrono::duration_cast<std::chrono::seconds>(
-                    std::chrono::system_clock::now().time_since_epoch()).count())
-            );
-        }
-        if (auto* c = rpc_counter("success")) c->Increment();
-        auto hist_it = rpc_histograms_.find(method);
-        if (hist_it != rpc_histograms_.end()) {
-            hist_it->second->Observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count());
-        }
-    }
+    record_success_(method, start_time);
 
     return json;
 }
+
+void JsonRpcClient::consume_raw_(
+    const std::string& method,
+    const std::string& body,
+    const std::function<void(std::string_view)>& consume
+) {
+    auto start_time = std::chrono::steady_clock::now();
+
+    HandleLease handle(*this, method);
+    perform_(method, body, *handle);
+
+    try {
+        consume(handle->response);
+    } catch (...) {
+        count_(method, "error");
+        throw;
+    }
+
+    record_success_(method, start_time);
+}
+
+void JsonRpcClient::call_raw(
+    const std::string& method,
+    const nlohmann::json& params,
+    const std::function<void(std::string_view)>& consume
+) {
+    consume_raw_(method, request_body(method, params, 1), consume);
+}
+
+void JsonRpcClient::call_batch_raw(
+    const std::vector<BatchCall>& calls,
+    const std::function<void(std::string_view)>& consume
+) {
+    if (calls.empty()) {
+        throw std::runtime_error("JSON-RPC batch is empty");
+    }
+
+    std::string body = "[";
+    for (std::size_t i = 0; i < calls.size(); ++i) {
+        if (i > 0) body += ',';
+        body += request_body(calls[i].method, calls[i].params, i);
+    }
+    body += ']';
+
+    consume_raw_("batch", body, consume);
+}
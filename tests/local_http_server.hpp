@@ -0,0 +1,191 @@
+#pragma once
+
+// Minimal HTTP/1.1 server on 127.0.0.1 for tests that need a real peer for
+// libcurl. Each connection gets a thread and is kept alive; `handler`
+// chooses the reply (and an optional delay before sending it).
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sentinel::test {
+
+struct ReceivedRequest {
+  std::string path;
+  std::map<std::string, std::string> headers; // names lower-cased
+  std::string body;
+  std::chrono::steady_clock::time_point received_at;
+};
+
+class LocalHttpServer {
+public:
+  struct Reply {
+    int status = 200;
+    std::string body{};
+    std::chrono::milliseconds delay{0};
+  };
+  using Handler = std::function<Reply(const ReceivedRequest &)>;
+
+  explicit LocalHttpServer(Handler handler = {}) : handler_(std::move(handler)) {
+    listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    if (::bind(listen_fd_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 ||
+        ::listen(listen_fd_, 64) != 0) {
+      ::close(listen_fd_);
+      throw std::runtime_error("LocalHttpServer: bind/listen failed");
+    }
+    socklen_t len = sizeof(addr);
+    ::getsockname(listen_fd_, reinterpret_cast<sockaddr *>(&addr), &len);
+    port_ = ntohs(addr.sin_port);
+    accept_thread_ = std::thread([this] { accept_loop_(); });
+  }
+
+  ~LocalHttpServer() { stop(); }
+
+  LocalHttpServer(const LocalHttpServer &) = delete;
+  LocalHttpServer &operator=(const LocalHttpServer &) = delete;
+
+  void stop() {
+    if (stopping_.exchange(true)) {
+      return;
+    }
+    accept_thread_.join();
+    std::vector<std::thread> threads;
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      threads.swap(conn_threads_);
+    }
+    for (auto &t : threads) t.join();
+    ::close(listen_fd_);
+  }
+
+  std::string url(const std::string &path = "/") const {
+    return "http://127.0.0.1:" + std::to_string(port_) + path;
+  }
+
+  std::vector<ReceivedRequest> requests() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return requests_;
+  }
+
+  int connections() const { return connections_.load(); }
+
+private:
+  bool wait_readable_(int fd) const {
+    pollfd p{fd, POLLIN, 0};
+    while (!stopping_.load()) {
+      if (::poll(&p, 1, 20) > 0) return true;
+    }
+    return false;
+  }
+
+  void accept_loop_() {
+    while (wait_readable_(listen_fd_)) {
+      const int fd = ::accept(listen_fd_, nullptr, nullptr);
+      if (fd < 0) continue;
+      ++connections_;
+      std::lock_guard<std::mutex> lk(mu_);
+      conn_threads_.emplace_back([this, fd] {
+        serve_(fd);
+        ::close(fd);
+      });
+    }
+  }
+
+  void serve_(int fd) {
+    std::string buf;
+    char chunk[4096];
+    while (true) {
+      // Headers
+      std::size_t header_end;
+      while ((header_end = buf.find("\r\n\r\n")) == std::string::npos) {
+        if (!wait_readable_(fd)) return;
+        const ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) return;
+        buf.append(chunk, static_cast<std::size_t>(n));
+      }
+
+      ReceivedRequest req;
+      const std::string head = buf.substr(0, header_end);
+      buf.erase(0, header_end + 4);
+      std::size_t line_end = head.find("\r\n");
+      const std::string request_line = head.substr(0, line_end);
+      const auto sp1 = request_line.find(' ');
+      req.path = request_line.substr(sp1 + 1, request_line.find(' ', sp1 + 1) - sp1 - 1);
+      while (line_end != std::string::npos) {
+        const std::size_t start = line_end + 2;
+        line_end = head.find("\r\n", start);
+        const std::string line = head.substr(start, line_end - start);
+        const auto colon = line.find(':');
+        if (colon == std::string::npos) continue;
+        std::string name = line.substr(0, colon);
+        std::transform(name.begin(), name.end(), name.begin(),
+                       [](unsigned char c) { return std::tolower(c); });
+        const auto value = line.find_first_not_of(' ', colon + 1);
+        req.headers[name] = value == std::string::npos ? "" : line.substr(value);
+      }
+
+      if (req.headers["expect"] == "100-continue") {
+        const char cont[] = "HTTP/1.1 100 Continue\r\n\r\n";
+        ::send(fd, cont, sizeof(cont) - 1, MSG_NOSIGNAL);
+      }
+
+      // Body
+      const std::size_t length = std::stoul(
+          req.headers.count("content-length") ? req.headers["content-length"] : "0");
+      while (buf.size() < length) {
+        if (!wait_readable_(fd)) return;
+        const ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) return;
+        buf.append(chunk, static_cast<std::size_t>(n));
+      }
+      req.body = buf.substr(0, length);
+      buf.erase(0, length);
+      req.received_at = std::chrono::steady_clock::now();
+
+      {
+        std::lock_guard<std::mutex> lk(mu_);
+        requests_.push_back(req);
+      }
+      const Reply reply = handler_ ? handler_(req) : Reply{};
+      std::this_thread::sleep_for(reply.delay);
+
+      const std::string response = "HTTP/1.1 " + std::to_string(reply.status) +
+                                   " X\r\nContent-Length: " +
+                                   std::to_string(reply.body.size()) + "\r\n\r\n" + reply.body;
+      if (::send(fd, response.data(), response.size(), MSG_NOSIGNAL) < 0) return;
+    }
+  }
+
+  Handler handler_;
+  int listen_fd_ = -1;
+  int port_ = 0;
+  std::atomic<bool> stopping_{false};
+  std::atomic<int> connections_{0};
+
+  mutable std::mutex mu_;
+  std::vector<ReceivedRequest> requests_;
+  std::vector<std::thread> conn_threads_;
+  std::thread accept_thread_;
+};
+
+} // namespace sentinel::test
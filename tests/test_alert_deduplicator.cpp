@@ -3,6 +3,10 @@
 #include "sentinel/risk/alert_deduplicator.hpp"
 #include "sentinel/risk/alert_dispatcher.hpp"
 
+#include <map>
+#include <string>
+#include <utility>
+
 using namespace sentinel::risk;
 
 static Alert make_alert(uint64_t customer_id,
@@ -151,3 +155,76 @@ TEST_CASE("AlertDeduplicator — tracked_keys_count decreases after cleanup") {
     dedup.cleanup_stale_entries(3'600'001);
     CHECK(dedup.tracked_keys_count() == 0);
 }
+
+TEST_CASE("AlertDeduplicator — token addresses compare as bytes, ignoring case") {
+    AlertDeduplicator dedup(make_config());
+    auto lower = make_alert(1, "large_transfer", 42161, "0xaf88d065e77c8cc2239327c5edb3a432268e5831");
+    auto mixed = make_alert(1, "large_transfer", 42161, "0xAf88d065e77C8cC2239327C5EDb3A432268e5831");
+    auto other = make_alert(1, "large_transfer", 42161, "0xaf88d065e77c8cc2239327c5edb3a432268e5832");
+    CHECK_FALSE(dedup.should_suppress(lower, 1'000));
+    CHECK(dedup.should_suppress(mixed, 2'000));
+    CHECK_FALSE(dedup.should_suppress(other, 2'000));
+}
+
+TEST_CASE("AlertDeduplicator — empty token_address shares a key with a missing one") {
+    AlertDeduplicator dedup(make_config());
+    CHECK_FALSE(dedup.should_suppress(make_alert(1, "large_transfer", 1), 1'000));
+    CHECK(dedup.should_suppress(make_alert(1, "large_transfer", 1, ""), 2'000));
+    CHECK(dedup.tracked_keys_count() == 1);
+}
+
+TEST_CASE("AlertDeduplicator — expiry matches a full scan at every cleanup") {
+    DeduplicatorConfig cfg = make_config();
+    cfg.cleanup_every_n_alerts = SIZE_MAX; // only the explicit cleanups below
+    AlertDeduplicator dedup(cfg);
+    const uint64_t max_window = 3'600'000;
+
+    // Reference model: last fired time per (customer, rule)
+    std::map<std::pair<uint64_t, int>, uint64_t> model;
+    const std::string rules[] = {"large_transfer", "governance", "approval", "other"};
+
+    uint64_t now = 1'700'000'000'000ULL;
+    uint64_t seed = 42;
+    auto next_rand = [&] {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        return seed >> 33;
+    };
+
+    for (int round = 0; round < 40; ++round) {
+        for (int i = 0; i < 500; ++i) {
+            now += next_rand() % 2'000;
+            const uint64_t customer = next_rand() % 2'000;
+            const int rule = static_cast<int>(next_rand() % 4);
+            const uint64_t window = rule == 1 ? 3'600'000 : rule == 2 ? 300'000 : 60'000;
+            auto [it, inserted] = model.try_emplace({customer, rule}, now);
+            const bool expected = !inserted && now - it->second < window;
+            if (!inserted && !expected) it->second = now;
+            REQUIRE(dedup.should_suppress(make_alert(customer, rules[rule], 42161), now) == expected);
+        }
+
+        now += next_rand() % 600'000;
+        size_t expected_removed = std::erase_if(
+            model, [&](const auto& kv) { return now - kv.second > max_window; });
+        REQUIRE(dedup.cleanup_stale_entries(now) == expected_removed);
+        REQUIRE(dedup.tracked_keys_count() == model.size());
+    }
+
+    // A long idle period expires everything at once
+    REQUIRE(dedup.cleanup_stale_entries(now + max_window + 1) == model.size());
+    CHECK(dedup.tracked_keys_count() == 0);
+}
+
+TEST_CASE("AlertDeduplicator — windows beyond the timing wheel's range") {
+    DeduplicatorConfig cfg;
+    cfg.default_window_ms = 60ULL * 24 * 3'600'000; // 60 days
+    cfg.cleanup_every_n_alerts = 10'000;
+    AlertDeduplicator dedup(cfg);
+
+    const uint64_t t0 = 1'700'000'000'000ULL;
+    auto a = make_alert(1, "large_transfer");
+    CHECK_FALSE(dedup.should_suppress(a, t0));
+    CHECK(dedup.cleanup_stale_entries(t0 + cfg.default_window_ms) == 0);
+    CHECK(dedup.should_suppress(a, t0 + cfg.default_window_ms - 1));
+    CHECK(dedup.cleanup_stale_entries(t0 + cfg.default_window_ms + 1) == 1);
+    CHECK(dedup.tracked_keys_count() == 0);
+}
@@ -0,0 +1,214 @@
+#include "sentinel/risk/alert_channel.hpp"
+#include "sentinel/risk/alert_dispatcher.hpp"
+#include "sentinel/risk/checkpoint_writer.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sentinel::risk;
+
+namespace {
+
+class CapturingChannel : public IAlertChannel {
+public:
+  explicit CapturingChannel(std::vector<std::string> &sink) : sink_(sink) {}
+  std::string name() const override { return "capture"; }
+  void send(const Alert &alert) override { sink_.push_back(alert.message); }
+
+private:
+  std::vector<std::string> &sink_; // dispatcher thread only
+};
+
+// Completes deliveries only when the test says so, like an endpoint that
+// takes a long time to answer.
+class HeldChannel : public IAlertChannel {
+public:
+  std::string name() const override { return "held"; }
+  void send(const Alert &) override {}
+  void send_async(const Alert &, DeliveryCallback done) override {
+    std::lock_guard<std::mutex> lk(mu);
+    held.push_back(std::move(done));
+  }
+
+  std::size_t held_count() {
+    std::lock_guard<std::mutex> lk(mu);
+    return held.size();
+  }
+
+  void release_all() {
+    std::vector<DeliveryCallback> callbacks;
+    {
+      std::lock_guard<std::mutex> lk(mu);
+      callbacks.swap(held);
+    }
+    for (auto &done : callbacks) done(DeliveryResult{});
+  }
+
+private:
+  std::mutex mu;
+  std::vector<DeliveryCallback> held;
+};
+
+Alert make_alert(const std::string &message) {
+  Alert a{};
+  a.rule_type = "test";
+  a.message = message;
+  return a;
+}
+
+struct NullSink : ICheckpointSink {
+  void save(uint64_t) override {}
+};
+
+template <typename Pred> bool eventually(Pred pred) {
+  for (int i = 0; i < 500; ++i) {
+    if (pred()) return true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  return pred();
+}
+
+// A zero window lets every alert through.
+DeduplicatorConfig no_dedup() {
+  DeduplicatorConfig cfg;
+  cfg.default_window_ms = 0;
+  return cfg;
+}
+
+} // namespace
+
+TEST_CASE("AlertDispatcher delivers alerts from many producer threads") {
+  std::vector<std::string> sent;
+  AlertDispatcher dispatcher("test", nullptr, no_dedup(), {},
+                             nullptr, AlertQueueConfig{.capacity = 16});
+  dispatcher.add_channel(std::make_unique<CapturingChannel>(sent));
+
+  std::jthread dispatcher_thread([&](std::stop_token st) { dispatcher.run(st); });
+
+  constexpr int kProducers = 4;
+  constexpr int kPerProducer = 500;
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&dispatcher, p] {
+      for (int i = 0; i < kPerProducer; ++i) {
+        dispatcher.dispatch(make_alert(std::to_string(p) + ":" + std::to_string(i)));
+      }
+    });
+  }
+  for (auto &t : producers) t.join();
+
+  // Alerts queued before stop() are still delivered
+  dispatcher.stop();
+  dispatcher_thread.join();
+
+  REQUIRE(sent.size() == kProducers * kPerProducer);
+  REQUIRE(std::set<std::string>(sent.begin(), sent.end()).size() == sent.size());
+}
+
+TEST_CASE("AlertDispatcher drops the newest alert when the queue is full") {
+  std::vector<std::string> sent;
+  AlertDispatcher dispatcher("test", nullptr, no_dedup(), {},
+                             nullptr,
+                             AlertQueueConfig{.capacity = 4,
+                                              .overflow = AlertOverflowPolicy::DropNewest});
+  dispatcher.add_channel(std::make_unique<CapturingChannel>(sent));
+
+  // Not running yet, so nothing drains the queue
+  for (int i = 0; i < 10; ++i) {
+    dispatcher.dispatch(make_alert(std::to_string(i)));
+  }
+
+  dispatcher.stop();
+  dispatcher.run(std::stop_token{});
+  REQUIRE(sent == std::vector<std::string>{"0", "1", "2", "3"});
+}
+
+TEST_CASE("AlertDispatcher unblocks a full-queue producer on stop") {
+  std::vector<std::string> sent;
+  AlertDispatcher dispatcher("test", nullptr, no_dedup(), {},
+                             nullptr, AlertQueueConfig{.capacity = 2});
+  dispatcher.add_channel(std::make_unique<CapturingChannel>(sent));
+
+  dispatcher.dispatch(make_alert("a"));
+  dispatcher.dispatch(make_alert("b"));
+  std::thread producer([&dispatcher] { dispatcher.dispatch(make_alert("c")); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  dispatcher.stop();
+  producer.join();
+
+  dispatcher.run(std::stop_token{});
+  REQUIRE(sent == std::vector<std::string>{"a", "b"});
+}
+
+TEST_CASE("AlertDispatcher does not wait for a slow channel") {
+  std::vector<std::string> sent;
+  auto held_owner = std::make_unique<HeldChannel>();
+  HeldChannel &held = *held_owner;
+
+  AlertDispatcher dispatcher("test", nullptr, no_dedup(), {});
+  dispatcher.add_channel(std::move(held_owner));
+  dispatcher.add_channel(std::make_unique<CapturingChannel>(sent));
+
+  std::atomic<bool> returned{false};
+  std::jthread dispatcher_thread([&](std::stop_token st) {
+    dispatcher.run(st);
+    returned = true;
+  });
+
+  for (int i = 0; i < 3; ++i) {
+    dispatcher.dispatch(make_alert(std::to_string(i)));
+  }
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (held.held_count() < 3 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  // All three reached the held channel, so none waited for the one before
+  REQUIRE(held.held_count() == 3);
+
+  // run() outlives stop() until every started delivery has reported back
+  dispatcher.stop();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  REQUIRE_FALSE(returned);
+
+  held.release_all();
+  dispatcher_thread.join();
+  REQUIRE(returned);
+  REQUIRE(sent == std::vector<std::string>{"0", "1", "2"});
+}
+
+TEST_CASE("AlertDispatcher settles a checkpoint only after earlier deliveries finish") {
+  CheckpointWriter writer(std::make_unique<NullSink>(), 0,
+                          CheckpointWriterConfig{.min_interval = std::chrono::hours(1)});
+  auto held_owner = std::make_unique<HeldChannel>();
+  HeldChannel &held = *held_owner;
+
+  AlertDispatcher dispatcher("test", nullptr, no_dedup(), {});
+  dispatcher.add_channel(std::move(held_owner));
+  dispatcher.set_checkpoint_writer(&writer);
+  std::jthread dispatcher_thread([&](std::stop_token st) { dispatcher.run(st); });
+
+  // Nothing outstanding: settles as soon as the dispatcher reaches it
+  dispatcher.checkpoint(5);
+  REQUIRE(eventually([&] { return writer.latest() == 5; }));
+
+  dispatcher.dispatch(make_alert("a"));
+  dispatcher.checkpoint(10);
+  dispatcher.checkpoint(20);
+  REQUIRE(eventually([&] { return held.held_count() == 1; }));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  REQUIRE(writer.latest() == 5);
+
+  held.release_all();
+  REQUIRE(eventually([&] { return writer.latest() == 20; }));
+
+  dispatcher.stop();
+  dispatcher_thread.join();
+}
@@ -0,0 +1,299 @@
+#include "sentinel/risk/alert_outbox.hpp"
+#include "sentinel/risk/alert_channel.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sentinel::risk;
+using namespace std::chrono_literals;
+
+namespace {
+
+// In-memory stand-in for the alert_outbox table.
+struct FakeStore : IAlertOutboxStore {
+  struct Row {
+    Alert alert;
+    std::optional<bool> delivered;
+  };
+
+  void write(const std::vector<OutboxRecord> &records,
+             const std::vector<OutboxCompletion> &completions) override {
+    std::lock_guard<std::mutex> lk(mu);
+    if (failing) {
+      ++failed_writes;
+      throw std::runtime_error("database is down");
+    }
+    ++writes;
+    for (const auto &r : records) {
+      rows.try_emplace(r.alert.outbox_id, Row{r.alert, r.delivered});
+    }
+    for (const auto &c : completions) {
+      if (auto it = rows.find(c.id); it != rows.end()) it->second.delivered = c.delivered;
+    }
+  }
+
+  std::vector<Alert> load_pending(std::chrono::hours) override {
+    std::lock_guard<std::mutex> lk(mu);
+    std::vector<Alert> out;
+    for (const auto &[id, row] : rows) {
+      if (!row.delivered) out.push_back(row.alert);
+    }
+    return out;
+  }
+
+  std::size_t row_count() {
+    std::lock_guard<std::mutex> lk(mu);
+    return rows.size();
+  }
+
+  std::optional<bool> delivered(uint64_t id) {
+    std::lock_guard<std::mutex> lk(mu);
+    return rows.at(id).delivered;
+  }
+
+  std::mutex mu;
+  std::map<uint64_t, Row> rows;
+  bool failing = false;
+  int writes = 0;
+  int failed_writes = 0;
+};
+
+// Keeps the store alive after the outbox that owns it is gone.
+struct StoreHandle : IAlertOutboxStore {
+  explicit StoreHandle(FakeStore &s) : store(s) {}
+  void write(const std::vector<OutboxRecord> &r,
+             const std::vector<OutboxCompletion> &c) override {
+    store.write(r, c);
+  }
+  std::vector<Alert> load_pending(std::chrono::hours age) override {
+    return store.load_pending(age);
+  }
+  FakeStore &store;
+};
+
+OutboxConfig fast_flush() {
+  OutboxConfig cfg;
+  cfg.flush_interval = 10ms;
+  cfg.retry_backoff = 10ms;
+  return cfg;
+}
+
+Alert make_alert(const std::string &message) {
+  Alert a{};
+  a.customer_id = 7;
+  a.rule_type = "test";
+  a.message = message;
+  return a;
+}
+
+template <typename Pred> bool eventually(Pred pred) {
+  for (int i = 0; i < 500; ++i) {
+    if (pred()) return true;
+    std::this_thread::sleep_for(2ms);
+  }
+  return pred();
+}
+
+class FlakyChannel : public IAlertChannel {
+public:
+  explicit FlakyChannel(bool ok) : ok_(ok) {}
+  std::string name() const override { return "flaky"; }
+  void send(const Alert &) override {}
+  void send_async(const Alert &alert, DeliveryCallback done) override {
+    delivered.push_back(alert.message);
+    done(DeliveryResult{ok_, ok_ ? "" : "down"});
+  }
+  std::vector<std::string> delivered; // dispatcher thread only
+
+private:
+  bool ok_;
+};
+
+} // namespace
+
+TEST_CASE("AlertOutbox assigns increasing ids and writes records in batches") {
+  FakeStore store;
+  {
+    AlertOutbox outbox(std::make_unique<StoreHandle>(store), fast_flush());
+    Alert a = make_alert("a");
+    Alert b = make_alert("b");
+    outbox.record(a);
+    outbox.record(b);
+    REQUIRE(a.outbox_id != 0);
+    REQUIRE(b.outbox_id == a.outbox_id + 1);
+
+    REQUIRE(eventually([&] { return store.row_count() == 2; }));
+    REQUIRE_FALSE(store.delivered(a.outbox_id).has_value());
+
+    outbox.complete(a.outbox_id, true);
+    outbox.complete(b.outbox_id, false);
+    REQUIRE(eventually([&] { return store.delivered(b.outbox_id).has_value(); }));
+    REQUIRE(store.delivered(a.outbox_id) == true);
+    REQUIRE(store.delivered(b.outbox_id) == false);
+  }
+}
+
+TEST_CASE("AlertOutbox folds a completion into a record not yet written") {
+  FakeStore store;
+  OutboxConfig cfg = fast_flush();
+  cfg.flush_interval = 1h; // only the destructor flushes
+  Alert a = make_alert("a");
+  {
+    AlertOutbox outbox(std::make_unique<StoreHandle>(store), cfg);
+    std::this_thread::sleep_for(5ms); // let the writer go to sleep
+    outbox.record(a);
+    outbox.complete(a.outbox_id, true);
+    REQUIRE(outbox.backlog() == 2);
+  }
+  REQUIRE(store.writes == 1);
+  REQUIRE(store.delivered(a.outbox_id) == true);
+}
+
+TEST_CASE("AlertOutbox keeps a failed batch and retries it") {
+  FakeStore store;
+  store.failing = true;
+  AlertOutbox outbox(std::make_unique<StoreHandle>(store), fast_flush());
+
+  Alert a = make_alert("a");
+  outbox.record(a);
+  REQUIRE(eventually([&] {
+    std::lock_guard<std::mutex> lk(store.mu);
+    return store.failed_writes >= 2;
+  }));
+  REQUIRE(outbox.backlog() == 1);
+
+  {
+    std::lock_guard<std::mutex> lk(store.mu);
+    store.failing = false;
+  }
+  REQUIRE(eventually([&] { return store.row_count() == 1; }));
+  REQUIRE(eventually([&] { return outbox.backlog() == 0; }));
+}
+
+TEST_CASE("AlertOutbox drops operations instead of blocking when its buffer is full") {
+  FakeStore store;
+  store.failing = true;
+  OutboxConfig cfg = fast_flush();
+  cfg.buffer_capacity = 4;
+  cfg.max_batch = 2;
+  cfg.retry_backoff = 1h;
+  AlertOutbox outbox(std::make_unique<StoreHandle>(store), cfg);
+
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < 100; ++i) {
+    Alert a = make_alert(std::to_string(i));
+    outbox.record(a);
+  }
+  REQUIRE(std::chrono::steady_clock::now() - start < 1s);
+  // Buffer plus the batch the writer holds
+  REQUIRE(outbox.backlog() <= 6);
+}
+
+TEST_CASE("AlertDispatcher records alerts in the outbox and completes them") {
+  FakeStore store;
+  AlertOutbox outbox(std::make_unique<StoreHandle>(store), fast_flush());
+
+  DeduplicatorConfig dedup;
+  dedup.default_window_ms = 0;
+  AlertDispatcher dispatcher("test", nullptr, dedup, {});
+  auto channel = std::make_unique<FlakyChannel>(true);
+  FlakyChannel *ch = channel.get();
+  dispatcher.add_channel(std::move(channel));
+  dispatcher.set_outbox(&outbox);
+
+  std::thread t([&] { dispatcher.run(); });
+  dispatcher.dispatch(make_alert("one"));
+  dispatcher.dispatch(make_alert("two"));
+  REQUIRE(eventually([&] {
+    if (store.row_count() != 2) return false;
+    return store.load_pending(1h).empty();
+  }));
+  dispatcher.stop();
+  t.join();
+  REQUIRE(ch->delivered == std::vector<std::string>{"one", "two"});
+}
+
+TEST_CASE("AlertDispatcher redelivers replayed alerts without re-recording them") {
+  FakeStore store;
+  Alert left_over = make_alert("left over");
+  left_over.outbox_id = 42;
+  store.rows[42] = FakeStore::Row{left_over, std::nullopt};
+
+  AlertOutbox outbox(std::make_unique<StoreHandle>(store), fast_flush());
+  DeduplicatorConfig dedup;
+  dedup.default_window_ms = 60'000;
+  AlertDispatcher dispatcher("test", nullptr, dedup, {});
+  auto channel = std::make_unique<FlakyChannel>(true);
+  FlakyChannel *ch = channel.get();
+  dispatcher.add_channel(std::move(channel));
+
+  std::vector<Alert> pending = outbox.load_pending();
+  REQUIRE(pending.size() == 1);
+  // Two copies: deduplication does not apply to replayed alerts
+  pending.push_back(pending.front());
+  dispatcher.replay(std::move(pending));
+  dispatcher.set_outbox(&outbox);
+
+  std::thread t([&] { dispatcher.run(); });
+  REQUIRE(eventually([&] { return store.delivered(42) == true; }));
+  dispatcher.stop();
+  t.join();
+
+  REQUIRE(ch->delivered == std::vector<std::string>{"left over", "left over"});
+  REQUIRE(store.row_count() == 1);
+}
+
+TEST_CASE("AlertDispatcher suppresses a rebuilt copy of a replayed alert") {
+  FakeStore store;
+  Alert left_over = make_alert("left over");
+  left_over.outbox_id = 42;
+  store.rows[42] = FakeStore::Row{left_over, std::nullopt};
+
+  AlertOutbox outbox(std::make_unique<StoreHandle>(store), fast_flush());
+  DeduplicatorConfig dedup;
+  dedup.default_window_ms = 60'000;
+  AlertDispatcher dispatcher("test", nullptr, dedup, {});
+  auto channel = std::make_unique<FlakyChannel>(true);
+  FlakyChannel *ch = channel.get();
+  dispatcher.add_channel(std::move(channel));
+  dispatcher.replay(outbox.load_pending());
+  dispatcher.set_outbox(&outbox);
+
+  std::thread t([&] { dispatcher.run(); });
+  REQUIRE(eventually([&] { return store.delivered(42) == true; }));
+  // The block is processed again after the restart and raises the same alert
+  dispatcher.dispatch(make_alert("left over"));
+  dispatcher.stop();
+  t.join();
+
+  REQUIRE(ch->delivered == std::vector<std::string>{"left over"});
+  REQUIRE(store.row_count() == 1);
+}
+
+TEST_CASE("AlertDispatcher leaves a failed alert open when it fails during shutdown") {
+  FakeStore store;
+  {
+    AlertOutbox outbox(std::make_unique<StoreHandle>(store), fast_flush());
+    DeduplicatorConfig dedup;
+    dedup.default_window_ms = 0;
+    AlertDispatcher dispatcher("test", nullptr, dedup, {});
+    dispatcher.add_channel(std::make_unique<FlakyChannel>(false));
+    dispatcher.set_outbox(&outbox);
+
+    dispatcher.dispatch(make_alert("failed"));
+    dispatcher.stop();
+    dispatcher.run(); // drains the queue while stopping
+  }
+  REQUIRE(store.row_count() == 1);
+  REQUIRE(store.load_pending(1h).size() == 1);
+}
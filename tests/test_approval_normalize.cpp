@@ -7,7 +7,7 @@ using namespace sentinel::risk;
 
 TEST_CASE("Approval Normalization Testing") {
 
-  SECTION("Approval topic0 produces SignalType::Approval with EvmLogEvent payload") {
+  SECTION("Approval topic0 produces SignalType::Approval with ApprovalEvent payload") {
     RawLog raw{};
     raw.address = "0xabcdefabcdefabcdefabcdefabcdefabcdefabcd";
     // ERC20 Approval topic0
@@ -27,11 +27,13 @@ TEST_CASE("Approval Normalization Testing") {
     normalize(raw, out, 42161, 1234567890);
 
     REQUIRE(out.type == SignalType::Approval);
-    const auto *evm = std::get_if<EvmLogEvent>(&out.payload);
-    REQUIRE(evm != nullptr);
-    REQUIRE(evm->chain_id == 42161);
-    REQUIRE(evm->topic_count == 3);
-    REQUIRE(evm->data_size == 32);
+    const auto *ap = std::get_if<ApprovalEvent>(&out.payload);
+    REQUIRE(ap != nullptr);
+    REQUIRE(ap->chain_id == 42161);
+    REQUIRE(ap->token_address[0] == 0xab);
+    REQUIRE(ap->owner[0] == 0xaa);
+    REQUIRE(ap->spender[19] == 0xbb);
+    REQUIRE(ap->amount[31] == 0xe8);
   }
 
   SECTION("Non-Approval topic0 does not produce SignalType::Approval") {
@@ -53,7 +55,7 @@ TEST_CASE("Approval Normalization Testing") {
     REQUIRE(out.type != SignalType::Approval);
   }
 
-  SECTION("Approval payload is EvmLogEvent, not a new struct") {
+  SECTION("Approval payload is ApprovalEvent, not another typed event") {
     RawLog raw{};
     raw.address = "0xabcdefabcdefabcdefabcdefabcdefabcdefabcd";
     raw.topics.push_back("0x8c5be1e5ebec7d5bd14f71427d1e84f3dd0314c0f7b2291e5b200ac8c7c3b925");
@@ -69,7 +71,7 @@ TEST_CASE("Approval Normalization Testing") {
     normalize(raw, out, 1, 0);
 
     REQUIRE(out.type == SignalType::Approval);
-    REQUIRE(std::get_if<EvmLogEvent>(&out.payload) != nullptr);
+    REQUIRE(std::get_if<ApprovalEvent>(&out.payload) != nullptr);
     // Governance/MintBurn/etc. structs must NOT be present
     REQUIRE(std::get_if<GovernanceEvent>(&out.payload) == nullptr);
     REQUIRE(std::get_if<MintBurnEvent>(&out.payload) == nullptr);
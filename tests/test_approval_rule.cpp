@@ -3,7 +3,6 @@
 #include "sentinel/risk/signal.hpp"
 #include <algorithm>
 #include <catch2/catch_test_macros.hpp>
-#include <cstring>
 
 using namespace sentinel::risk;
 using namespace sentinel::events::utils;
@@ -17,16 +16,13 @@ static Signal make_approval_signal(uint64_t chain_id,
     s.type = SignalType::Approval;
     s.meta.timestamp_ms = timestamp_ms;
 
-    EvmLogEvent evm{};
-    evm.chain_id = chain_id;
-    evm.removed = removed;
-    evm.topic_count = 3;
-    evm.data_size = 32;
-    evm.truncated = false;
-    parse_hex_bytes(token_hex, evm.address);
-    std::memcpy(evm.data.data(), amount.data(), 32);
+    ApprovalEvent ap{};
+    ap.chain_id = chain_id;
+    ap.removed = removed;
+    parse_hex_bytes(token_hex, ap.token_address);
+    ap.amount = amount;
 
-    s.payload = evm;
+    s.payload = ap;
     return s;
 }
 
@@ -34,13 +30,15 @@ TEST_CASE("Approval Rule Testing") {
     std::unordered_map<ApprovalContractKey, std::vector<ApprovalRuleConfig>> configs;
 
     std::string token_addr_str = "0x1234567890123456789012345678901234567890";
-    ApprovalContractKey key{1, token_addr_str};
+    std::array<uint8_t, 20> token_addr{};
+    parse_hex_bytes(token_addr_str, token_addr);
+    ApprovalContractKey key{1, token_addr};
 
     ApprovalRuleConfig cfg{};
     cfg.customer_id = 42;
     cfg.chain_id = 1;
     parse_hex_bytes(token_addr_str, cfg.token_address);
-    cfg.threshold_be = decimal_to_be_256("1000");
+    cfg.threshold = uint256::from_decimal("1000");
     cfg.alert_on_infinite = true;
     cfg.enabled = true;
     configs[key].push_back(cfg);
@@ -108,7 +106,7 @@ TEST_CASE("Approval Rule Testing") {
         // Instead use a large threshold so amount (all-0xFF) would exceed it,
         // but we want to test the alert_on_infinite=false path independently.
         // Use threshold = all-0xFF (equal, not greater), so exceeds = false.
-        no_inf_cfg.threshold_be.fill(0xFF);
+        no_inf_cfg.threshold = uint256::max();
         no_inf_cfg.alert_on_infinite = false;
         no_inf_cfg.enabled = true;
         no_inf_configs[key].push_back(no_inf_cfg);
@@ -0,0 +1,97 @@
+#include "sentinel/events/block_range_controller.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+
+using namespace sentinel::events;
+using namespace std::chrono_literals;
+
+namespace {
+
+BlockRangeControllerConfig test_config() {
+  BlockRangeControllerConfig cfg;
+  cfg.min_range = 1;
+  cfg.max_range = 10000;
+  cfg.initial_range = 1000;
+  cfg.target_response_bytes = 1000000;
+  cfg.target_logs = 5000;
+  cfg.target_latency = 2000ms;
+  return cfg;
+}
+
+} // namespace
+
+TEST_CASE("BlockRangeController grows on sparse ranges up to the cap") {
+  BlockRangeController ctl(test_config());
+  REQUIRE(ctl.range() == 1000);
+
+  ctl.on_success(1000, 0, 100, 50ms);
+  REQUIRE(ctl.range() == 2000); // at most 2x per step
+
+  for (int i = 0; i < 10; ++i) {
+    ctl.on_success(ctl.range(), 0, 100, 50ms);
+  }
+  REQUIRE(ctl.range() == 10000);
+}
+
+TEST_CASE("BlockRangeController does not grow on requests smaller than the range") {
+  BlockRangeControllerConfig cfg = test_config();
+  cfg.initial_range = 1;
+  BlockRangeController ctl(cfg);
+
+  // Polling at the head: one new block per request, no logs, fast
+  for (int i = 0; i < 20; ++i) {
+    ctl.on_success(1, 0, 100, 50ms);
+  }
+  REQUIRE(ctl.range() == 2);
+
+  // A full-range request is what earns the next step
+  ctl.on_success(2, 0, 200, 50ms);
+  REQUIRE(ctl.range() == 4);
+}
+
+TEST_CASE("BlockRangeController converges on the tightest target") {
+  BlockRangeController ctl(test_config());
+
+  // 20 logs/block -> 5000 logs is 250 blocks
+  for (int i = 0; i < 5; ++i) {
+    ctl.on_success(ctl.range(), ctl.range() * 20, 0, 100ms);
+  }
+  REQUIRE(ctl.range() == 250);
+
+  // 10 KB/block -> 1 MB is 100 blocks
+  for (int i = 0; i < 10; ++i) {
+    ctl.on_success(ctl.range(), ctl.range() * 20, ctl.range() * 10000, 100ms);
+  }
+  REQUIRE(ctl.range() == 100);
+}
+
+TEST_CASE("BlockRangeController caps on slow responses") {
+  BlockRangeController ctl(test_config());
+  ctl.on_success(1000, 10, 0, 8000ms);
+  REQUIRE(ctl.range() == 250);
+}
+
+TEST_CASE("BlockRangeController shrinks on errors") {
+  BlockRangeController ctl(test_config());
+
+  SECTION("result limit") {
+    ctl.on_error(1000, "JSON-RPC error: {\"code\":-32005,\"message\":\"query returned more than 10000 results\"}");
+    REQUIRE(ctl.range() == 250);
+  }
+
+  SECTION("provider suggested range") {
+    ctl.on_error(1000, "Log response size exceeded. this block range should work: [0x100, 0x13f]");
+    REQUIRE(ctl.range() == 64);
+  }
+
+  SECTION("other errors halve") {
+    ctl.on_error(1000, "curl_easy_perform failed: Timeout was reached");
+    REQUIRE(ctl.range() == 500);
+  }
+
+  SECTION("never below the minimum") {
+    ctl.on_error(2, "query returned more than 10000 results");
+    REQUIRE(ctl.range() == 1);
+  }
+}
@@ -3,17 +3,18 @@
 #include "sentinel/risk/rules/bridge_transfer_rule.hpp"
 #include "sentinel/risk/signal.hpp"
 #include <catch2/catch_test_macros.hpp>
-#include <cstring>
 #include <initializer_list>
 #include <set>
 
 using namespace sentinel::risk;
 using namespace sentinel::events::utils;
 
-// Build a Transfer signal (EvmLogEvent) for the bridge transfer rule.
-// token_addr_hex   : ERC-20 contract address  (evm->address)
-// to_addr_hex      : recipient               (topics[2] last 20 bytes)
+// Build a Transfer signal (TransferEvent) for the bridge transfer rule.
+// token_addr_hex   : ERC-20 contract address  (tr.token_address)
+// to_addr_hex      : recipient               (tr.to)
 // amount_dec       : transfer value in decimal
+// topic_count < 3 builds what normalize emits for a malformed Transfer log:
+// type Transfer with a plain EvmLogEvent payload.
 static Signal make_bridge_transfer_signal(
     uint64_t chain_id,
     const std::string& token_addr_hex,
@@ -27,25 +28,25 @@ static Signal make_bridge_transfer_signal(
     s.type = SignalType::Transfer;
     s.meta.timestamp_ms = timestamp_ms;
 
-    EvmLogEvent evm{};
-    evm.chain_id = chain_id;
-    evm.removed = removed;
-    evm.topic_count = topic_count;
-    evm.data_size = 32;
-    evm.truncated = false;
-
-    parse_hex_bytes(token_addr_hex, evm.address);
-
-    // topics[2]: 32 bytes, first 12 are zero padding, last 20 are the address.
-    evm.topics[2] = {};
-    std::array<uint8_t, 20> to_addr{};
-    parse_hex_bytes(to_addr_hex, to_addr);
-    std::copy(to_addr.begin(), to_addr.end(), evm.topics[2].begin() + 12);
+    if (topic_count < 3) {
+        EvmLogEvent evm{};
+        evm.chain_id = chain_id;
+        evm.removed = removed;
+        evm.topic_count = topic_count;
+        evm.data_size = 32;
+        parse_hex_bytes(token_addr_hex, evm.address);
+        s.payload = evm;
+        return s;
+    }
 
-    auto amount_be = decimal_to_be_256(amount_dec);
-    std::memcpy(evm.data.data(), amount_be.data(), 32);
+    TransferEvent tr{};
+    tr.chain_id = chain_id;
+    tr.removed = removed;
+    parse_hex_bytes(token_addr_hex, tr.token_address);
+    parse_hex_bytes(to_addr_hex, tr.to);
+    tr.amount = decimal_to_be_256(amount_dec);
 
-    s.payload = evm;
+    s.payload = tr;
     return s;
 }
 
@@ -60,7 +61,7 @@ static BridgeRuleConfig make_config(
     cfg.customer_id = customer_id;
     cfg.chain_id = chain_id;
     parse_hex_bytes(token_addr_hex, cfg.token_address);
-    cfg.threshold_be = decimal_to_be_256(threshold_dec);
+    cfg.threshold = uint256::from_decimal(threshold_dec);
     cfg.enabled = enabled;
     return cfg;
 }
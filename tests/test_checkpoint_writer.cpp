@@ -0,0 +1,112 @@
+#include "sentinel/risk/checkpoint_writer.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace sentinel::risk;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct FakeSink : ICheckpointSink {
+  void save(uint64_t last_block) override {
+    std::lock_guard<std::mutex> lk(mu);
+    if (failing) {
+      ++failures;
+      throw std::runtime_error("database is down");
+    }
+    saved.push_back(last_block);
+  }
+
+  std::vector<uint64_t> snapshot() {
+    std::lock_guard<std::mutex> lk(mu);
+    return saved;
+  }
+
+  std::mutex mu;
+  std::vector<uint64_t> saved;
+  bool failing = false;
+  int failures = 0;
+};
+
+// Keeps the sink alive after the writer that owns it is gone.
+struct SinkHandle : ICheckpointSink {
+  explicit SinkHandle(FakeSink &s) : sink(s) {}
+  void save(uint64_t last_block) override { sink.save(last_block); }
+  FakeSink &sink;
+};
+
+template <typename Pred> bool eventually(Pred pred) {
+  for (int i = 0; i < 500; ++i) {
+    if (pred()) return true;
+    std::this_thread::sleep_for(2ms);
+  }
+  return pred();
+}
+
+} // namespace
+
+TEST_CASE("CheckpointWriter saves the latest block, never going backwards") {
+  FakeSink sink;
+  {
+    CheckpointWriter writer(std::make_unique<SinkHandle>(sink), 7,
+                            CheckpointWriterConfig{.min_interval = 5ms});
+    REQUIRE(writer.persisted() == 7);
+    for (uint64_t b = 8; b <= 200; ++b) {
+      writer.advance(b);
+    }
+    writer.advance(100); // ignored
+    REQUIRE(writer.latest() == 200);
+    REQUIRE(eventually([&] { return writer.persisted() == 200; }));
+  }
+
+  const auto saved = sink.snapshot();
+  REQUIRE_FALSE(saved.empty());
+  REQUIRE(saved.back() == 200);
+  for (std::size_t i = 1; i < saved.size(); ++i) {
+    REQUIRE(saved[i] > saved[i - 1]);
+  }
+}
+
+TEST_CASE("CheckpointWriter writes at most once per interval") {
+  FakeSink sink;
+  {
+    CheckpointWriter writer(std::make_unique<SinkHandle>(sink), 0,
+                            CheckpointWriterConfig{.min_interval = 1h});
+    std::this_thread::sleep_for(5ms); // let the writer go to sleep
+    writer.advance(1);
+    writer.advance(2);
+    std::this_thread::sleep_for(20ms);
+    REQUIRE(sink.snapshot().empty());
+    writer.advance(3);
+  }
+  // The destructor writes what is left, once
+  REQUIRE(sink.snapshot() == std::vector<uint64_t>{3});
+}
+
+TEST_CASE("CheckpointWriter retries after a failed write") {
+  FakeSink sink;
+  sink.failing = true;
+  CheckpointWriter writer(std::make_unique<SinkHandle>(sink), 0,
+                          CheckpointWriterConfig{.min_interval = 1ms, .retry_backoff = 5ms});
+  writer.advance(42);
+  REQUIRE(eventually([&] {
+    std::lock_guard<std::mutex> lk(sink.mu);
+    return sink.failures >= 2;
+  }));
+  REQUIRE(writer.persisted() == 0);
+
+  {
+    std::lock_guard<std::mutex> lk(sink.mu);
+    sink.failing = false;
+  }
+  REQUIRE(eventually([&] { return writer.persisted() == 42; }));
+  REQUIRE(sink.snapshot() == std::vector<uint64_t>{42});
+}
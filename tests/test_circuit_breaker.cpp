@@ -0,0 +1,65 @@
+#include "sentinel/risk/circuit_breaker.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <string>
+
+using namespace sentinel::risk;
+using namespace std::chrono_literals;
+using State = CircuitBreaker::State;
+
+namespace {
+
+const CircuitBreaker::Clock::time_point t0{};
+
+CircuitBreaker opened_breaker() {
+  CircuitBreaker breaker({.failure_threshold = 2, .open_duration = 1000ms, .half_open_probes = 1});
+  breaker.record_failure(t0);
+  breaker.record_failure(t0);
+  return breaker;
+}
+
+} // namespace
+
+TEST_CASE("CircuitBreaker opens after consecutive failures only") {
+  CircuitBreaker breaker({.failure_threshold = 3, .open_duration = 1000ms, .half_open_probes = 1});
+  breaker.record_failure(t0);
+  breaker.record_failure(t0);
+  breaker.record_success(); // resets the streak
+  breaker.record_failure(t0);
+  breaker.record_failure(t0);
+  REQUIRE(breaker.state() == State::Closed);
+  REQUIRE(breaker.allow(t0));
+
+  breaker.record_failure(t0 + 5ms);
+  REQUIRE(breaker.state() == State::Open);
+  REQUIRE(breaker.reopens_at() == t0 + 1005ms);
+  REQUIRE_FALSE(breaker.allow(t0 + 1004ms));
+}
+
+TEST_CASE("CircuitBreaker admits limited probes when half-open") {
+  CircuitBreaker breaker = opened_breaker();
+  REQUIRE(breaker.allow(t0 + 1000ms));
+  REQUIRE(breaker.state() == State::HalfOpen);
+  REQUIRE_FALSE(breaker.allow(t0 + 1001ms));
+
+  SECTION("a successful probe closes it") {
+    breaker.record_success();
+    REQUIRE(breaker.state() == State::Closed);
+    REQUIRE(breaker.allow(t0 + 1002ms));
+  }
+  SECTION("a failed probe opens it for another period") {
+    breaker.record_failure(t0 + 1200ms);
+    REQUIRE(breaker.state() == State::Open);
+    REQUIRE_FALSE(breaker.allow(t0 + 2100ms));
+    REQUIRE(breaker.allow(t0 + 2200ms));
+  }
+}
+
+TEST_CASE("CircuitBreaker ignores late successes while open") {
+  CircuitBreaker breaker = opened_breaker();
+  breaker.record_success();
+  REQUIRE(breaker.state() == State::Open);
+  REQUIRE(std::string(to_string(breaker.state())) == "open");
+}
@@ -0,0 +1,115 @@
+#include "sentinel/db_parallel_loader.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using sentinel::ParallelLoader;
+
+namespace {
+
+struct FakeConn {
+  std::size_t index;
+};
+
+ParallelLoader<FakeConn>::Open open_all() {
+  return [](std::size_t index) { return std::make_shared<FakeConn>(FakeConn{index}); };
+}
+
+} // namespace
+
+TEST_CASE("ParallelLoader runs tasks concurrently, one connection per worker") {
+  constexpr int kTasks = 3;
+  ParallelLoader<FakeConn> loader(kTasks, open_all());
+
+  std::atomic<int> started{0};
+  std::mutex mu;
+  std::set<std::size_t> connections_used;
+  for (int i = 0; i < kTasks; ++i) {
+    loader.add("task" + std::to_string(i), [&](FakeConn &conn) {
+      {
+        std::lock_guard<std::mutex> lk(mu);
+        connections_used.insert(conn.index);
+      }
+      // Only returns once every task has started, i.e. they all ran at once
+      started.fetch_add(1);
+      const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+      while (started.load() < kTasks) {
+        if (std::chrono::steady_clock::now() > deadline) {
+          throw std::runtime_error("tasks did not overlap");
+        }
+        std::this_thread::yield();
+      }
+    });
+  }
+
+  const auto results = loader.run();
+  REQUIRE(results.size() == kTasks);
+  for (int i = 0; i < kTasks; ++i) {
+    CHECK(results[i].name == "task" + std::to_string(i));
+    CHECK(results[i].error.empty());
+  }
+  CHECK(connections_used.size() == kTasks);
+}
+
+TEST_CASE("ParallelLoader reports a failing task without affecting the others") {
+  ParallelLoader<FakeConn> loader(2, open_all());
+  std::atomic<int> ran{0};
+  loader.add("good", [&](FakeConn &) { ran.fetch_add(1); });
+  loader.add("bad", [](FakeConn &) { throw std::runtime_error("relation does not exist"); });
+  loader.add("also_good", [&](FakeConn &) { ran.fetch_add(1); });
+
+  const auto results = loader.run();
+  REQUIRE(results.size() == 3);
+  CHECK(results[0].error.empty());
+  CHECK(results[1].name == "bad");
+  CHECK(results[1].error == "relation does not exist");
+  CHECK(results[2].error.empty());
+  CHECK(ran == 2);
+}
+
+TEST_CASE("ParallelLoader: workers without a connection leave their share to the others") {
+  SECTION("one connection fails to open") {
+    ParallelLoader<FakeConn> loader(3, [](std::size_t index) -> std::shared_ptr<FakeConn> {
+      if (index == 1) {
+        throw std::runtime_error("too many connections");
+      }
+      if (index == 2) {
+        return nullptr;
+      }
+      return std::make_shared<FakeConn>(FakeConn{index});
+    });
+    std::atomic<int> ran{0};
+    for (int i = 0; i < 6; ++i) {
+      loader.add("task", [&](FakeConn &conn) {
+        CHECK(conn.index == 0);
+        ran.fetch_add(1);
+      });
+    }
+
+    for (const auto &r : loader.run()) {
+      CHECK(r.error.empty());
+    }
+    CHECK(ran == 6);
+  }
+
+  SECTION("no connection opens") {
+    ParallelLoader<FakeConn> loader(2, [](std::size_t) -> std::shared_ptr<FakeConn> {
+      throw std::runtime_error("connection refused");
+    });
+    loader.add("a", [](FakeConn &) { FAIL("must not run"); });
+    loader.add("b", [](FakeConn &) { FAIL("must not run"); });
+
+    for (const auto &r : loader.run()) {
+      CHECK(r.error == "no database connection: connection refused");
+      CHECK(r.elapsed.count() == 0.0);
+    }
+  }
+}
@@ -13,13 +13,13 @@ TEST_CASE("Governance Rule Testing") {
   parse_hex_bytes("0x1111111111111111111111111111111111111111", token_addr);
 
   // Setup config for contract 0x111...111 on chain 1
-  GovernanceContractKey key{1, "0x1111111111111111111111111111111111111111"};
+  GovernanceContractKey key{1, token_addr};
   
   // Customer 1: listens to all actions (no filter)
   config_map[key].push_back({
       .customer_id = 1,
       .chain_id = 1,
-      .contract_address = "0x1111111111111111111111111111111111111111",
+      .contract_address = token_addr,
       .enabled = true,
       .action_filter = std::nullopt
   });
@@ -28,7 +28,7 @@ TEST_CASE("Governance Rule Testing") {
   config_map[key].push_back({
       .customer_id = 2,
       .chain_id = 1,
-      .contract_address = "0x1111111111111111111111111111111111111111",
+      .contract_address = token_addr,
       .enabled = true,
       .action_filter = GovernanceAction::Paused
   });
@@ -0,0 +1,101 @@
+#include "sentinel/events/utils/hex.hpp"
+#include "sentinel/events/utils/hex_codec.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace sentinel::events::utils;
+
+namespace {
+
+std::string reference_hex(const std::vector<uint8_t> &bytes, bool upper) {
+  const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+  std::string out;
+  for (uint8_t b : bytes) {
+    out.push_back(digits[b >> 4]);
+    out.push_back(digits[b & 0x0f]);
+  }
+  return out;
+}
+
+} // namespace
+
+TEST_CASE("Hex kernels round-trip every length up to 300 bytes") {
+  REQUIRE(!available_hex_kernels().empty());
+  REQUIRE(std::string(available_hex_kernels().back().name) == "scalar");
+
+  std::mt19937 rng(7);
+  for (const auto &k : available_hex_kernels()) {
+    INFO("kernel " << k.name);
+    for (std::size_t n = 0; n <= 300; ++n) {
+      std::vector<uint8_t> bytes(n);
+      for (auto &b : bytes) b = static_cast<uint8_t>(rng());
+
+      std::string encoded(2 * n, '?');
+      k.encode(bytes.data(), n, encoded.data());
+      REQUIRE(encoded == reference_hex(bytes, false));
+
+      const std::string upper = reference_hex(bytes, true);
+      std::vector<uint8_t> decoded(n, 0xee);
+      REQUIRE(k.decode(upper.data(), n, decoded.data()));
+      REQUIRE(decoded == bytes);
+      REQUIRE(k.validate(upper.data(), upper.size()));
+    }
+  }
+}
+
+TEST_CASE("Hex kernels reject a bad digit at any position") {
+  // Neighbours of every valid range, and bytes with the high bit set
+  const char bad[] = {'/', ':', '@', 'G', '`', 'g', ' ', '\0', '\x10', '\x80', '\xc6'};
+
+  for (const auto &k : available_hex_kernels()) {
+    INFO("kernel " << k.name);
+    for (std::size_t n : {1u, 15u, 16u, 20u, 31u, 32u, 33u, 64u, 256u}) {
+      const std::string good(2 * n, 'a');
+      std::vector<uint8_t> out(n);
+      REQUIRE(k.decode(good.data(), n, out.data()));
+
+      for (std::size_t pos = 0; pos < good.size(); ++pos) {
+        for (char c : bad) {
+          std::string s = good;
+          s[pos] = c;
+          INFO("n=" << n << " pos=" << pos << " char=" << int(c));
+          REQUIRE_FALSE(k.decode(s.data(), n, out.data()));
+          REQUIRE_FALSE(k.validate(s.data(), s.size()));
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("bytes_to_hex formats 0x-prefixed lower case") {
+  const std::array<uint8_t, 4> b{0xde, 0xad, 0x00, 0x0f};
+  REQUIRE(bytes_to_hex(b) == "0xdead000f");
+  REQUIRE(bytes_to_hex(nullptr, 0) == "0x");
+
+  std::array<uint8_t, 20> addr{};
+  parse_hex_bytes("0xFd086bC7CD5C481DCC9C85ebE478A1C0b69FCbb9", addr);
+  REQUIRE(bytes_to_hex(addr) == "0xfd086bc7cd5c481dcc9c85ebe478a1c0b69fcbb9");
+}
+
+TEST_CASE("parse_hex_data decodes the prefix and validates the rest") {
+  std::array<uint8_t, 4> out{};
+
+  REQUIRE(parse_hex_data("0x0102", out) == 2);
+  REQUIRE(out[0] == 0x01);
+  REQUIRE(out[1] == 0x02);
+
+  REQUIRE(parse_hex_data("0xaabbccddeeff", out) == 6);
+  REQUIRE(out == std::array<uint8_t, 4>{0xaa, 0xbb, 0xcc, 0xdd});
+
+  // A bad digit past the decoded prefix is still an error
+  REQUIRE_THROWS(parse_hex_data("0xaabbccddeezz", out));
+  REQUIRE_THROWS(parse_hex_data("0xabc", out));
+  REQUIRE_THROWS(parse_hex_data("abcd", out));
+  REQUIRE(parse_hex_data("0x", out) == 0);
+}
@@ -0,0 +1,300 @@
+#include "sentinel/risk/http_delivery.hpp"
+
+#include "local_http_server.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sentinel::risk;
+using sentinel::test::LocalHttpServer;
+
+namespace {
+
+HttpRequest post(const std::string &url, std::string body = "{}") {
+  HttpRequest req;
+  req.url = url;
+  req.body = std::move(body);
+  req.headers.push_back("Content-Type: application/json");
+  return req;
+}
+
+// Failures complete right away instead of being retried
+HttpDeliveryConfig no_retry() {
+  HttpDeliveryConfig cfg;
+  cfg.retry.max_attempts = 1;
+  return cfg;
+}
+
+HttpResponse post_and_wait(HttpDeliveryLoop &loop, HttpRequest req) {
+  std::promise<HttpResponse> result;
+  loop.submit(std::move(req), [&result](HttpResponse resp) { result.set_value(std::move(resp)); });
+  return result.get_future().get();
+}
+
+// A port nothing listens on: bound, then released.
+std::string closed_url() {
+  std::string url;
+  {
+    LocalHttpServer server;
+    url = server.url("/");
+  }
+  return url;
+}
+
+} // namespace
+
+TEST_CASE("HttpDeliveryLoop posts the body and headers") {
+  LocalHttpServer server([](const auto &) {
+    return LocalHttpServer::Reply{.status = 202, .body = "accepted"};
+  });
+  HttpDeliveryLoop loop;
+
+  HttpRequest req = post(server.url("/hook"), R"({"a":1})");
+  req.headers.push_back("X-Test: yes");
+  const HttpResponse resp = post_and_wait(loop, std::move(req));
+
+  REQUIRE(resp.ok);
+  REQUIRE(resp.status == 202);
+  REQUIRE(resp.body == "accepted");
+
+  const auto received = server.requests();
+  REQUIRE(received.size() == 1);
+  REQUIRE(received[0].path == "/hook");
+  REQUIRE(received[0].body == R"({"a":1})");
+  REQUIRE(received[0].headers.at("content-type") == "application/json");
+  REQUIRE(received[0].headers.at("x-test") == "yes");
+}
+
+TEST_CASE("HttpDeliveryLoop reports HTTP and transport failures") {
+  LocalHttpServer server([](const auto &) { return LocalHttpServer::Reply{.status = 503}; });
+  HttpDeliveryLoop loop(no_retry());
+
+  const HttpResponse http_error = post_and_wait(loop, post(server.url()));
+  REQUIRE_FALSE(http_error.ok);
+  REQUIRE(http_error.status == 503);
+
+  const HttpResponse refused = post_and_wait(loop, post(closed_url()));
+  REQUIRE_FALSE(refused.ok);
+  REQUIRE(refused.status == 0);
+  REQUIRE_FALSE(refused.error.empty());
+}
+
+TEST_CASE("HttpDeliveryLoop reuses the connection to a host") {
+  LocalHttpServer server;
+  HttpDeliveryLoop loop;
+
+  for (int i = 0; i < 5; ++i) {
+    REQUIRE(post_and_wait(loop, post(server.url("/n/" + std::to_string(i)))).ok);
+  }
+  REQUIRE(server.requests().size() == 5);
+  REQUIRE(server.connections() == 1);
+}
+
+TEST_CASE("HttpDeliveryLoop caps concurrency per endpoint without blocking others") {
+  using namespace std::chrono_literals;
+  std::atomic<int> slow_active{0};
+  std::atomic<int> slow_peak{0};
+  LocalHttpServer server([&](const sentinel::test::ReceivedRequest &req) {
+    if (req.path == "/slow") {
+      const int now = ++slow_active;
+      int seen = slow_peak.load();
+      while (now > seen && !slow_peak.compare_exchange_weak(seen, now)) {
+      }
+      std::this_thread::sleep_for(150ms);
+      --slow_active;
+    }
+    return LocalHttpServer::Reply{};
+  });
+  HttpDeliveryLoop loop(HttpDeliveryConfig{.max_per_endpoint = 2});
+
+  std::mutex mu;
+  std::vector<std::string> finished;
+  auto record = [&](std::string what) {
+    return [&mu, &finished, what](HttpResponse resp) {
+      std::lock_guard<std::mutex> lk(mu);
+      finished.push_back(resp.ok ? what : "failed");
+    };
+  };
+
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < 6; ++i) {
+    loop.submit(post(server.url("/slow")), record("slow"));
+  }
+  loop.submit(post(server.url("/fast")), record("fast"));
+  REQUIRE(loop.pending() == 7);
+
+  while (loop.pending() > 0) {
+    std::this_thread::sleep_for(5ms);
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  // The fast endpoint is not queued behind the slow one
+  REQUIRE(finished.size() == 7);
+  REQUIRE(finished.front() == "fast");
+  REQUIRE(std::count(finished.begin(), finished.end(), "slow") == 6);
+  // Six slow requests, two at a time: three rounds of 150 ms
+  REQUIRE(slow_peak == 2);
+  REQUIRE(elapsed >= 400ms);
+}
+
+TEST_CASE("HttpDeliveryLoop runs every callback before it is destroyed") {
+  LocalHttpServer server([](const auto &) {
+    return LocalHttpServer::Reply{.delay = std::chrono::milliseconds(20)};
+  });
+  std::atomic<int> done{0};
+  std::atomic<int> ok{0};
+  {
+    HttpDeliveryLoop loop(HttpDeliveryConfig{.max_per_endpoint = 1});
+    for (int i = 0; i < 5; ++i) {
+      loop.submit(post(server.url()), [&](HttpResponse resp) {
+        ++done;
+        if (resp.ok) ++ok;
+      });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  // The in-flight request completes; the queued ones are failed
+  REQUIRE(done == 5);
+  REQUIRE(ok >= 1);
+  REQUIRE(ok < 5);
+}
+
+TEST_CASE("HttpDeliveryLoop runs scheduled callbacks in deadline order") {
+  using namespace std::chrono_literals;
+  HttpDeliveryLoop loop;
+
+  std::mutex mu;
+  std::vector<int> order;
+  std::promise<void> finished;
+  const auto start = std::chrono::steady_clock::now();
+  loop.schedule(60ms, [&] {
+    std::lock_guard<std::mutex> lk(mu);
+    order.push_back(2);
+    finished.set_value();
+  });
+  loop.schedule(20ms, [&] {
+    std::lock_guard<std::mutex> lk(mu);
+    order.push_back(1);
+  });
+  finished.get_future().wait();
+
+  REQUIRE(std::chrono::steady_clock::now() - start >= 60ms);
+  std::lock_guard<std::mutex> lk(mu);
+  REQUIRE(order == std::vector<int>{1, 2});
+}
+
+TEST_CASE("HttpDeliveryLoop retries failed requests with backoff") {
+  using namespace std::chrono_literals;
+  std::atomic<int> calls{0};
+  LocalHttpServer server([&](const auto &) {
+    return LocalHttpServer::Reply{.status = ++calls < 3 ? 503 : 200};
+  });
+  HttpDeliveryConfig cfg;
+  cfg.retry.initial_backoff = 40ms;
+  HttpDeliveryLoop loop(cfg);
+
+  const auto start = std::chrono::steady_clock::now();
+  const HttpResponse resp = post_and_wait(loop, post(server.url()));
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  REQUIRE(resp.ok);
+  const auto received = server.requests();
+  REQUIRE(received.size() == 3);
+  REQUIRE(received[0].body == received[2].body);
+  // Backoffs of 40 ms and 80 ms, each at least half waited out
+  REQUIRE(received[1].received_at - received[0].received_at >= 20ms);
+  REQUIRE(received[2].received_at - received[1].received_at >= 40ms);
+  REQUIRE(elapsed >= 60ms);
+}
+
+TEST_CASE("HttpDeliveryLoop does not retry client errors") {
+  LocalHttpServer server([](const auto &) { return LocalHttpServer::Reply{.status = 400}; });
+  HttpDeliveryLoop loop;
+
+  const HttpResponse resp = post_and_wait(loop, post(server.url()));
+  REQUIRE(resp.status == 400);
+  REQUIRE(server.requests().size() == 1);
+}
+
+TEST_CASE("HttpDeliveryLoop fails fast while an endpoint's breaker is open") {
+  using namespace std::chrono_literals;
+  std::atomic<bool> healthy{false};
+  LocalHttpServer server([&](const auto &) {
+    return LocalHttpServer::Reply{.status = healthy ? 200 : 500};
+  });
+  HttpDeliveryConfig cfg = no_retry();
+  cfg.breaker.failure_threshold = 2;
+  cfg.breaker.open_duration = 100ms;
+  HttpDeliveryLoop loop(cfg);
+
+  REQUIRE(post_and_wait(loop, post(server.url())).status == 500);
+  REQUIRE(post_and_wait(loop, post(server.url())).status == 500);
+
+  // Open: nothing reaches the server
+  const HttpResponse rejected = post_and_wait(loop, post(server.url()));
+  REQUIRE_FALSE(rejected.ok);
+  REQUIRE(rejected.error == "circuit open");
+  REQUIRE(server.requests().size() == 2);
+
+  // Other endpoints are unaffected
+  REQUIRE(post_and_wait(loop, post(server.url("/other"))).status == 500);
+
+  // After open_duration one probe goes through and closes it again
+  healthy = true;
+  std::this_thread::sleep_for(120ms);
+  REQUIRE(post_and_wait(loop, post(server.url())).ok);
+  REQUIRE(post_and_wait(loop, post(server.url())).ok);
+  REQUIRE(server.requests().size() == 5);
+}
+
+TEST_CASE("HttpDeliveryLoop retries a rejected request once the breaker admits probes") {
+  using namespace std::chrono_literals;
+  std::atomic<bool> healthy{false};
+  LocalHttpServer server([&](const auto &) {
+    return LocalHttpServer::Reply{.status = healthy ? 200 : 503};
+  });
+  HttpDeliveryConfig cfg;
+  cfg.retry.max_attempts = 2;
+  cfg.retry.initial_backoff = 1ms;
+  cfg.breaker.failure_threshold = 1;
+  cfg.breaker.open_duration = 100ms;
+  HttpDeliveryLoop loop(cfg);
+
+  std::promise<HttpResponse> result;
+  const auto start = std::chrono::steady_clock::now();
+  loop.submit(post(server.url()), [&](HttpResponse resp) { result.set_value(std::move(resp)); });
+  std::this_thread::sleep_for(30ms);
+  healthy = true;
+
+  // The retry waits for the breaker rather than its 1 ms backoff
+  REQUIRE(result.get_future().get().ok);
+  REQUIRE(std::chrono::steady_clock::now() - start >= 100ms);
+  REQUIRE(server.requests().size() == 2);
+}
+
+TEST_CASE("HttpDeliveryLoop completes waiting retries when they are abandoned") {
+  using namespace std::chrono_literals;
+  LocalHttpServer server([](const auto &) { return LocalHttpServer::Reply{.status = 503}; });
+  HttpDeliveryConfig cfg;
+  cfg.retry.initial_backoff = std::chrono::minutes(1);
+  HttpDeliveryLoop loop(cfg);
+
+  std::promise<HttpResponse> result;
+  loop.submit(post(server.url()), [&](HttpResponse resp) { result.set_value(std::move(resp)); });
+  while (server.requests().empty()) {
+    std::this_thread::sleep_for(5ms);
+  }
+  loop.abandon_retries();
+
+  const HttpResponse resp = result.get_future().get();
+  REQUIRE(resp.status == 503);
+  REQUIRE(server.requests().size() == 1);
+}
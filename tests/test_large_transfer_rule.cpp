@@ -15,7 +15,7 @@ TEST_CASE("Large Transfer Rule Testing") {
       .customer_id = 1,
       .chain_id = 42161,
       .token_address = token_addr,
-      .threshold_be = decimal_to_be_256("1000") // small threshold
+      .threshold = uint256::from_decimal("1000") // small threshold
   });
 
   LargeTransferRule rule(configs);
@@ -36,19 +36,15 @@ TEST_CASE("Large Transfer Rule Testing") {
     s.type = SignalType::Transfer;
     s.meta.timestamp_ms = 12345;
 
-    EvmLogEvent evm;
-    evm.chain_id = 42161;
-    evm.address = token_addr;
-    evm.removed = false;
-    evm.topic_count = 3;
-    evm.data_size = 32;
-    evm.truncated = false;
+    TransferEvent tr{};
+    tr.chain_id = 42161;
+    tr.token_address = token_addr;
+    tr.removed = false;
 
     // 2000 > 1000
-    auto data_be = decimal_to_be_256("2000");
-    std::memcpy(evm.data.data(), data_be.data(), 32);
+    tr.amount = decimal_to_be_256("2000");
 
-    s.payload = evm;
+    s.payload = tr;
 
     StateStore store;
     std::vector<Alert> alerts;
@@ -60,3 +56,103 @@ TEST_CASE("Large Transfer Rule Testing") {
     REQUIRE(alerts[0].timestamp_ms == 12345);
   }
 }
+
+TEST_CASE("Large Transfer Rule index returns every exceeded threshold") {
+  std::array<uint8_t, 20> token_a{};
+  std::array<uint8_t, 20> token_b{};
+  parse_hex_bytes("0xFd086bC7CD5C481DCC9C85ebE478A1C0b69FCbb9", token_a);
+  parse_hex_bytes("0xaf88d065e77c8cC2239327C5EDb3A432268e5831", token_b);
+
+  std::vector<LargeTransferRuleConfig> configs{
+      {.customer_id = 1, .chain_id = 42161, .token_address = token_a,
+       .threshold = uint256::from_decimal("5000")},
+      {.customer_id = 2, .chain_id = 42161, .token_address = token_a,
+       .threshold = uint256::from_decimal("1000")},
+      {.customer_id = 3, .chain_id = 42161, .token_address = token_a,
+       .threshold = uint256::from_decimal("300000000000000000000000")},
+      {.customer_id = 4, .chain_id = 42161, .token_address = token_a,
+       .threshold = uint256::from_decimal("1000")},
+      {.customer_id = 5, .chain_id = 42161, .token_address = token_b,
+       .threshold = uint256::from_decimal("1")},
+      {.customer_id = 6, .chain_id = 1, .token_address = token_a,
+       .threshold = uint256::from_decimal("1")},
+  };
+
+  LargeTransferRule rule(configs);
+  REQUIRE(rule.bucket_count() == 3);
+
+  auto evaluate = [&](const char *amount) {
+    Signal s{};
+    s.type = SignalType::Transfer;
+    TransferEvent tr{};
+    tr.chain_id = 42161;
+    tr.token_address = token_a;
+    tr.amount = decimal_to_be_256(amount);
+    s.payload = tr;
+
+    StateStore store;
+    std::vector<Alert> alerts;
+    rule.evaluate(s, store, alerts);
+
+    std::vector<uint64_t> customers;
+    for (const auto &a : alerts) {
+      REQUIRE(a.amount_decimal == amount);
+      REQUIRE(a.token_address == "0xfd086bc7cd5c481dcc9c85ebe478a1c0b69fcbb9");
+      REQUIRE(a.chain_id == 42161);
+      customers.push_back(a.customer_id);
+    }
+    return customers;
+  };
+
+  // Strictly greater: equal to a threshold does not fire
+  REQUIRE(evaluate("1000").empty());
+  // Equal thresholds keep config order
+  REQUIRE(evaluate("1001") == std::vector<uint64_t>{2, 4});
+  REQUIRE(evaluate("5001") == std::vector<uint64_t>{2, 4, 1});
+  REQUIRE(evaluate("300000000000000000000001") == std::vector<uint64_t>{2, 4, 1, 3});
+  REQUIRE(evaluate("999").empty());
+}
+
+TEST_CASE("Large Transfer Rule reload replaces the thresholds") {
+  std::array<uint8_t, 20> token{};
+  parse_hex_bytes("0xFd086bC7CD5C481DCC9C85ebE478A1C0b69FCbb9", token);
+
+  LargeTransferRule rule({{.customer_id = 1, .chain_id = 42161, .token_address = token,
+                           .threshold = uint256::from_decimal("1000")}});
+  RcuDomain rcu;
+
+  auto customers = [&](const char *amount) {
+    Signal s{};
+    s.type = SignalType::Transfer;
+    TransferEvent tr{};
+    tr.chain_id = 42161;
+    tr.token_address = token;
+    tr.amount = decimal_to_be_256(amount);
+    s.payload = tr;
+
+    StateStore store;
+    std::vector<Alert> alerts;
+    rule.evaluate(s, store, alerts);
+    std::vector<uint64_t> out;
+    for (const auto &a : alerts) {
+      out.push_back(a.customer_id);
+    }
+    return out;
+  };
+
+  REQUIRE(customers("1500") == std::vector<uint64_t>{1});
+
+  rule.reload({{.customer_id = 1, .chain_id = 42161, .token_address = token,
+                .threshold = uint256::from_decimal("2000")},
+               {.customer_id = 2, .chain_id = 42161, .token_address = token,
+                .threshold = uint256::from_decimal("100")}},
+              rcu);
+
+  REQUIRE(rule.config_generation() == 1);
+  REQUIRE(customers("1500") == std::vector<uint64_t>{2});
+  REQUIRE(customers("2500") == std::vector<uint64_t>{2, 1});
+
+  rule.reload({}, rcu);
+  REQUIRE(rule.bucket_count() == 0);
+  REQUIRE(customers("2500").empty());
+}
@@ -0,0 +1,103 @@
+#include "sentinel/events/normalize.hpp"
+#include "sentinel/events/utils/hex.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <string>
+
+using namespace sentinel::events;
+using namespace sentinel::risk;
+
+namespace {
+
+const std::string kAddr = "0x000000000000000000000000aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa";
+const std::string kAmount = "0x00000000000000000000000000000000000000000000000000000000000003e8";
+
+constexpr auto kTransfer = utils::parse_topic_literal(
+    "0xddf252ad1be2c89b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef");
+constexpr auto kApproval = utils::parse_topic_literal(
+    "0x8c5be1e5ebec7d5bd14f71427d1e84f3dd0314c0f7b2291e5b200ac8c7c3b925");
+
+std::string to_hex(const std::array<uint8_t, 32> &bytes) {
+  static constexpr char kDigits[] = "0123456789abcdef";
+  std::string out = "0x";
+  for (uint8_t b : bytes) {
+    out += kDigits[b >> 4];
+    out += kDigits[b & 0x0f];
+  }
+  return out;
+}
+
+// Classifies a log with the given topic0 and enough topics/data for every
+// typed payload.
+SignalType classify(const std::array<uint8_t, 32> &topic0) {
+  RawLog raw{};
+  raw.address = "0x1111111111111111111111111111111111111111";
+  raw.topics = {to_hex(topic0), kAddr, kAddr};
+  raw.data = kAmount;
+  raw.blockNumber = "0x1";
+  raw.transactionIndex = "0x0";
+  raw.logIndex = "0x0";
+  raw.transactionHash = "0x" + std::string(64, '0');
+
+  Signal out;
+  normalize(raw, out, 42161, 0);
+  return out.type;
+}
+
+} // namespace
+
+TEST_CASE("topic0 whitelist covers exactly the requested signal types") {
+  const SignalMask rules = make_mask(SignalType::Transfer) |
+                           make_mask(SignalType::MintBurn) |
+                           make_mask(SignalType::Governance) |
+                           make_mask(SignalType::Approval) |
+                           make_mask(SignalType::OracleUpdate);
+
+  const auto topics = topic0_whitelist(rules);
+
+  // Transfer is shared by Transfer and MintBurn; 6 governance topics
+  REQUIRE(topics.size() == 9);
+  REQUIRE(std::count(topics.begin(), topics.end(), kTransfer) == 1);
+
+  for (const auto &t : topics) {
+    REQUIRE((rules & make_mask(classify(t))) != 0);
+  }
+}
+
+TEST_CASE("topic0 whitelist narrows to a single type") {
+  const auto topics = topic0_whitelist(make_mask(SignalType::Approval));
+  REQUIRE(topics.size() == 1);
+  REQUIRE(topics[0] == kApproval);
+}
+
+TEST_CASE("topic0 whitelist is empty when no topic filter can serve the rules") {
+  SECTION("a rule wants Unknown logs") {
+    REQUIRE(topic0_whitelist(make_mask(SignalType::Unknown) |
+                             make_mask(SignalType::Transfer))
+                .empty());
+  }
+
+  SECTION("no rule types") {
+    REQUIRE(topic0_whitelist(0).empty());
+  }
+
+  SECTION("types normalize never produces") {
+    REQUIRE(topic0_whitelist(make_mask(SignalType::PriceTick)).empty());
+  }
+}
+
+TEST_CASE("normalize records the log index in the signal meta") {
+  RawLog raw{};
+  raw.address = "0x1111111111111111111111111111111111111111";
+  raw.topics = {to_hex(kTransfer), kAddr, kAddr};
+  raw.data = kAmount;
+  raw.blockNumber = "0x10";
+  raw.transactionIndex = "0x3";
+  raw.logIndex = "0x2a";
+  raw.transactionHash = "0x" + std::string(64, '0');
+
+  Signal out;
+  normalize(raw, out, 42161, 0);
+  REQUIRE(out.meta.log_index == 42);
+}
@@ -0,0 +1,213 @@
+#include "sentinel/events/log_stream_decoder.hpp"
+#include "sentinel/events/normalize.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+using namespace sentinel::events;
+using namespace sentinel::risk;
+
+namespace {
+
+RawLog make_log(std::string topic0, std::string topic1, std::string topic2,
+                std::string data) {
+  RawLog raw{};
+  raw.address = "0x1111111111111111111111111111111111111111";
+  raw.topics = {std::move(topic0), std::move(topic1), std::move(topic2)};
+  raw.data = std::move(data);
+  raw.blockNumber = "0x1a2b3c";
+  raw.transactionIndex = "0x7";
+  raw.logIndex = "0x2a";
+  raw.transactionHash = "0xabcdefabcdefabcdefabcdefabcdefabcdefabcdefabcdefabcdefabcdefabcd";
+  return raw;
+}
+
+const std::string kTransfer = "0xddf252ad1be2c89b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef";
+const std::string kOwnership = "0x8be0079c531659141344cd1fd0a4f28419497f9722a3daafe3b4186f6b6457e0";
+const std::string kZero = "0x0000000000000000000000000000000000000000000000000000000000000000";
+const std::string kAddrA = "0x000000000000000000000000aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa";
+const std::string kAmount = "0x00000000000000000000000000000000000000000000000000000000000003e8";
+
+std::string response_for(const std::vector<RawLog> &logs, int id = 1) {
+  nlohmann::json res{{"jsonrpc", "2.0"}, {"id", id}, {"result", logs}};
+  return res.dump();
+}
+
+void require_same(const Signal &a, const Signal &b) {
+  REQUIRE(a.type == b.type);
+  REQUIRE(a.meta.block_number == b.meta.block_number);
+  REQUIRE(a.meta.log_index == b.meta.log_index);
+  REQUIRE(a.meta.tx_hash == b.meta.tx_hash);
+  REQUIRE(a.meta.source_id == b.meta.source_id);
+  REQUIRE(a.payload.index() == b.payload.index());
+
+  if (const auto *ea = std::get_if<EvmLogEvent>(&a.payload)) {
+    const auto &eb = std::get<EvmLogEvent>(b.payload);
+    REQUIRE(ea->chain_id == eb.chain_id);
+    REQUIRE(ea->tx_index == eb.tx_index);
+    REQUIRE(ea->log_index == eb.log_index);
+    REQUIRE(ea->removed == eb.removed);
+    REQUIRE(ea->address == eb.address);
+    REQUIRE(ea->topic_count == eb.topic_count);
+    REQUIRE(ea->data_size == eb.data_size);
+    REQUIRE(ea->truncated == eb.truncated);
+    REQUIRE(ea->body != nullptr);
+    REQUIRE(eb.body != nullptr);
+    REQUIRE(ea->body->topics == eb.body->topics);
+    REQUIRE(ea->body->data == eb.body->data);
+  } else if (const auto *ta = std::get_if<TransferEvent>(&a.payload)) {
+    const auto &tb = std::get<TransferEvent>(b.payload);
+    REQUIRE(ta->chain_id == tb.chain_id);
+    REQUIRE(ta->token_address == tb.token_address);
+    REQUIRE(ta->from == tb.from);
+    REQUIRE(ta->to == tb.to);
+    REQUIRE(ta->amount == tb.amount);
+    REQUIRE(ta->removed == tb.removed);
+  } else if (const auto *ma = std::get_if<MintBurnEvent>(&a.payload)) {
+    const auto &mb = std::get<MintBurnEvent>(b.payload);
+    REQUIRE(ma->direction == mb.direction);
+    REQUIRE(ma->token_address == mb.token_address);
+    REQUIRE(ma->amount == mb.amount);
+    REQUIRE(ma->from == mb.from);
+    REQUIRE(ma->to == mb.to);
+  } else if (const auto *ga = std::get_if<GovernanceEvent>(&a.payload)) {
+    const auto &gb = std::get<GovernanceEvent>(b.payload);
+    REQUIRE(ga->action == gb.action);
+    REQUIRE(ga->contract_address == gb.contract_address);
+  }
+}
+
+} // namespace
+
+TEST_CASE("Streaming eth_getLogs decoder matches RawLog + normalize") {
+  std::vector<RawLog> logs{
+      make_log(kTransfer, kAddrA, kAddrA, kAmount),   // plain transfer
+      make_log(kTransfer, kZero, kAddrA, kAmount),    // mint
+      make_log(kOwnership, kAddrA, kAddrA, "0x"),     // governance
+  };
+  logs[2].removed = true;
+
+  // >256 bytes of data is truncated, >4 topics are capped
+  RawLog big = make_log(kTransfer, kAddrA, kAddrA, "0x" + std::string(600, 'e'));
+  big.topics.push_back(kAddrA);
+  big.topics.push_back(kAddrA);
+  logs.push_back(big);
+
+  const std::string body = response_for(logs);
+
+  std::vector<Signal> decoded;
+  REQUIRE(decode_get_logs_response(body, 42161, decoded) == logs.size());
+  REQUIRE(decoded.size() == logs.size());
+
+  for (std::size_t i = 0; i < logs.size(); ++i) {
+    Signal expected;
+    normalize(logs[i], expected, 42161, 0);
+    require_same(decoded[i], expected);
+  }
+
+  REQUIRE(decoded[0].type == SignalType::Transfer);
+  REQUIRE(decoded[1].type == SignalType::MintBurn);
+  REQUIRE(decoded[2].type == SignalType::Governance);
+  REQUIRE(std::holds_alternative<TransferEvent>(decoded[0].payload));
+  // Oversized data is not a plain ERC-20 transfer: generic payload
+  const auto &evm = std::get<EvmLogEvent>(decoded[3].payload);
+  REQUIRE(evm.truncated);
+  REQUIRE(evm.topic_count == 4);
+}
+
+TEST_CASE("Streaming eth_getLogs decoder tolerates layout and extra fields") {
+  const std::string body = R"({ "id" : 7, "jsonrpc":"2.0",
+    "result" : [ {
+      "blockHash": "0x00", "blockTimestamp": "0x6650f0a0",
+      "nested": {"a": [1, 2, {"b": "x\"}]"}], "c": null},
+      "address" : "0x1111111111111111111111111111111111111111",
+      "topics" : [ ")" + kTransfer + R"(" ],
+      "data" : "0x",
+      "blockNumber" : "0x10", "transactionHash" : ")" + kZero + R"(",
+      "transactionIndex" : "0x0", "logIndex" : "0x1", "removed" : false
+    } ] }
+  )";
+
+  std::vector<Signal> decoded;
+  REQUIRE(decode_get_logs_response(body, 1, decoded) == 1);
+  REQUIRE(decoded[0].meta.block_number == 16);
+  REQUIRE(std::get<EvmLogEvent>(decoded[0].payload).log_index == 1);
+}
+
+TEST_CASE("Streaming eth_getLogs decoder rejects bad responses") {
+  std::vector<Signal> decoded(2);
+
+  SECTION("JSON-RPC error object") {
+    const std::string body =
+        R"({"jsonrpc":"2.0","id":1,"error":{"code":-32005,"message":"query returned more than 10000 results"}})";
+    REQUIRE_THROWS(decode_get_logs_response(body, 1, decoded));
+  }
+
+  SECTION("missing result") {
+    REQUIRE_THROWS(decode_get_logs_response(R"({"jsonrpc":"2.0","id":1})", 1, decoded));
+  }
+
+  SECTION("log missing a required field") {
+    RawLog raw = make_log(kTransfer, kAddrA, kAddrA, kAmount);
+    nlohmann::json log = raw;
+    log.erase("logIndex");
+    nlohmann::json res{{"jsonrpc", "2.0"}, {"id", 1}, {"result", {log}}};
+    REQUIRE_THROWS(decode_get_logs_response(res.dump(), 1, decoded));
+  }
+
+  SECTION("truncated body") {
+    const std::string body =
+        response_for({make_log(kTransfer, kAddrA, kAddrA, kAmount)});
+    REQUIRE_THROWS(decode_get_logs_response(body.substr(0, body.size() / 2), 1, decoded));
+  }
+
+  // Partial results are rolled back
+  REQUIRE(decoded.size() == 2);
+}
+
+TEST_CASE("JSON-RPC batch responses are split by id") {
+  const std::string logs_body =
+      response_for({make_log(kTransfer, kAddrA, kAddrA, kAmount)}, 0);
+  // Servers may reorder batch elements
+  const std::string body = R"([ {"jsonrpc":"2.0","id":2,"result":"0x1f"},
+    {"jsonrpc":"2.0","id":1,"error":{"code":-32000,"message":"header not found"}}, )" +
+                           logs_body + " ]";
+
+  std::vector<std::string_view> parts(3);
+  split_batch_response(body, parts);
+
+  std::vector<Signal> decoded;
+  REQUIRE(decode_get_logs_response(parts[0], 1, decoded) == 1);
+  REQUIRE(parts[1].find("header not found") != std::string_view::npos);
+  REQUIRE(nlohmann::json::parse(parts[2])["result"] == "0x1f");
+
+  SECTION("missing elements stay empty") {
+    std::vector<std::string_view> more(4);
+    split_batch_response(body, more);
+    REQUIRE(more[3].empty());
+  }
+
+  SECTION("unknown id is rejected") {
+    std::vector<std::string_view> fewer(2);
+    REQUIRE_THROWS(split_batch_response(body, fewer));
+  }
+}
+
+TEST_CASE("Non-array batch response is reported as a rejected batch") {
+  std::vector<std::string_view> parts(3);
+  REQUIRE_THROWS_AS(
+      split_batch_response(R"({"jsonrpc":"2.0","id":null,"error":{"code":-32600,"message":"batch not supported"}})", parts),
+      BatchRejectedError);
+}
+
+TEST_CASE("Batch error elements without an id are reported as a rejected batch") {
+  std::vector<std::string_view> parts(2);
+  REQUIRE_THROWS_AS(
+      split_batch_response(R"([{"jsonrpc":"2.0","id":null,"error":{"code":-32005,"message":"batch limit exceeded"}}])", parts),
+      BatchRejectedError);
+  REQUIRE_THROWS_AS(
+      split_batch_response(R"([{"jsonrpc":"2.0","id":0,"result":"0x1"},{"jsonrpc":"2.0","error":{"code":-32600,"message":"too many requests in batch"}}])", parts),
+      BatchRejectedError);
+}
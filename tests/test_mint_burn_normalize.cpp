@@ -95,7 +95,7 @@ TEST_CASE("MintBurn Normalization Testing") {
 
     // Evaluates purely to transfer since full 32-bytes wasn't 0
     REQUIRE(out.type == SignalType::Transfer); 
-    const auto* payload = std::get_if<EvmLogEvent>(&out.payload);
+    const auto* payload = std::get_if<TransferEvent>(&out.payload);
     REQUIRE(payload != nullptr);
   }
 }
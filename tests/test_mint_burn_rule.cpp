@@ -11,14 +11,16 @@ TEST_CASE("MintBurn Rule Testing") {
   std::unordered_map<MintBurnContractKey, std::vector<MintBurnRuleConfig>> configs;
   
   std::string token_addr_str = "0x1234567890123456789012345678901234567890";
-  MintBurnContractKey key{1, token_addr_str};
+  std::array<uint8_t, 20> token_addr{};
+  parse_hex_bytes(token_addr_str, token_addr);
+  MintBurnContractKey key{1, token_addr};
 
   MintBurnRuleConfig cfg;
   cfg.customer_id = 99;
   cfg.chain_id = 1;
-  cfg.contract_address = token_addr_str;
-  cfg.mint_threshold_be = decimal_to_be_256("1000");   // alert if mint >= 1000
-  cfg.burn_threshold_be = decimal_to_be_256("2000");   // alert if burn >= 2000
+  cfg.contract_address = token_addr;
+  cfg.mint_threshold = uint256::from_decimal("1000");   // alert if mint >= 1000
+  cfg.burn_threshold = uint256::from_decimal("2000");   // alert if burn >= 2000
   cfg.enabled = true;
   configs[key].push_back(cfg);
 
@@ -0,0 +1,306 @@
+#include "mock_node.hpp"
+
+#include "local_http_server.hpp"
+#include "sentinel/chains/arbitrum/ArbitrumAdapter.hpp"
+#include "sentinel/events/EventSource.hpp"
+#include "sentinel/events/block_range_controller.hpp"
+#include "sentinel/events/utils/hex.hpp"
+#include "sentinel/rpc/JsonRpcClient.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+
+using namespace sentinel::mock;
+using nlohmann::json;
+using sentinel::risk::Signal;
+using sentinel::risk::SignalType;
+
+namespace {
+
+ChainConfig manual_chain() {
+  ChainConfig chain;
+  chain.start_block = 200;
+  chain.block_time = std::chrono::milliseconds(0);
+  chain.logs_per_block = 5;
+  chain.seed = 7;
+  return chain;
+}
+
+LogQuery blocks(uint64_t from, uint64_t to) {
+  LogQuery query;
+  query.from_block = from;
+  query.to_block = to;
+  return query;
+}
+
+json parse_logs(MockChain &chain, const LogQuery &query) {
+  std::string out;
+  REQUIRE(chain.logs_json(query, 1'000'000, out));
+  return json::parse(out);
+}
+
+json rpc(MockNode &node, const json &request) { return json::parse(node.handle_rpc(request.dump())); }
+
+json get_logs(uint64_t from, uint64_t to, int id = 1) {
+  return {{"jsonrpc", "2.0"},
+          {"id", id},
+          {"method", "eth_getLogs"},
+          {"params", json::array({{{"fromBlock", sentinel::events::utils::to_hex_quantity(from)},
+                                   {"toBlock", sentinel::events::utils::to_hex_quantity(to)}}})}};
+}
+
+// Serves `node` over plain HTTP for JsonRpcClient (no cpp-httplib needed)
+sentinel::test::LocalHttpServer serve(MockNode &node) {
+  return sentinel::test::LocalHttpServer(
+      [&node](const sentinel::test::ReceivedRequest &req) {
+        int status = 200;
+        std::string body = node.handle_rpc(req.body, &status);
+        return sentinel::test::LocalHttpServer::Reply{status, std::move(body)};
+      });
+}
+
+} // namespace
+
+TEST_CASE("MockChain: blocks are reproducible and filterable") {
+  MockChain a(manual_chain());
+  MockChain b(manual_chain());
+  CHECK(a.head() == 200);
+
+  const LogQuery all = blocks(150, 160);
+  const json logs = parse_logs(a, all);
+  CHECK(logs.size() == 55);
+  CHECK(logs == parse_logs(b, all));
+  CHECK(a.block_hash(155) == b.block_hash(155));
+  CHECK(a.block_timestamp(156) == a.block_timestamp(155) + 1);
+
+  LogQuery one_token = all;
+  one_token.addresses = {a.token_address(0)};
+  for (const auto &log : parse_logs(a, one_token)) {
+    REQUIRE(log["address"] == a.token_address(0));
+  }
+
+  LogQuery transfers = all;
+  transfers.topic0s = {logs[0]["topics"][0].get<std::string>()};
+  for (const auto &log : parse_logs(a, transfers)) {
+    REQUIRE(log["topics"][0] == transfers.topic0s[0]);
+  }
+
+  std::string out = "prefix";
+  CHECK_FALSE(a.logs_json(all, 54, out));
+  CHECK(out == "prefix");
+}
+
+TEST_CASE("MockChain: a reorg rewrites the blocks after its fork point") {
+  MockChain chain(manual_chain());
+  const std::string kept = chain.block_hash(197);
+  const std::string replaced = chain.block_hash(198);
+  const json before = parse_logs(chain, blocks(198, 200));
+
+  CHECK(chain.reorg(3) == 198);
+  CHECK(chain.reorgs() == 1);
+  CHECK(chain.block_hash(197) == kept);
+  CHECK(chain.block_hash(198) != replaced);
+  CHECK(parse_logs(chain, blocks(198, 200)) != before);
+
+  // Blocks mined on top of the new fork stay on it
+  chain.mine(2);
+  CHECK(chain.head() == 202);
+
+  ChainConfig automatic = manual_chain();
+  automatic.reorg_every = 5;
+  automatic.reorg_depth = 2;
+  MockChain auto_chain(automatic);
+  auto_chain.mine(12);
+  CHECK(auto_chain.reorgs() == 2);
+}
+
+TEST_CASE("MockNode: answers JSON-RPC calls and batches") {
+  MockNodeConfig cfg;
+  cfg.chain = manual_chain();
+  MockNode node(cfg);
+
+  CHECK(rpc(node, {{"jsonrpc", "2.0"}, {"id", 1}, {"method", "eth_chainId"}})["result"] ==
+        "0xa4b1");
+  CHECK(rpc(node, {{"jsonrpc", "2.0"}, {"id", 2}, {"method", "eth_blockNumber"}})["result"] ==
+        "0xc8");
+  CHECK(rpc(node, {{"jsonrpc", "2.0"}, {"id", 3}, {"method", "eth_foo"}})["error"]["code"] ==
+        -32601);
+
+  const json batch = rpc(node, json::array({get_logs(10, 11, 0),
+                                            {{"jsonrpc", "2.0"},
+                                             {"id", 1},
+                                             {"method", "eth_getBlockByNumber"},
+                                             {"params", json::array({"0xb", false})}}}));
+  REQUIRE(batch.is_array());
+  REQUIRE(batch.size() == 2);
+  CHECK(batch[0]["id"] == 0);
+  CHECK(batch[0]["result"].size() == 10);
+  CHECK(batch[1]["result"]["hash"] == node.chain().block_hash(11));
+
+  // Past the head is clamped, as nodes do
+  CHECK(rpc(node, get_logs(199, 500))["result"].size() == 10);
+}
+
+TEST_CASE("MockNode: provider limits read as errors the range controller recognises") {
+  MockNodeConfig cfg;
+  cfg.chain = manual_chain();
+  cfg.faults.max_results = 20;
+  cfg.faults.max_block_range = 100;
+  cfg.faults.batch = false;
+  MockNode node(cfg);
+
+  const json too_many = rpc(node, get_logs(10, 20));
+  REQUIRE(too_many.contains("error"));
+  CHECK(sentinel::events::BlockRangeController::is_result_limit_error(
+      too_many["error"]["message"].get<std::string>()));
+
+  const json too_wide = rpc(node, get_logs(1, 150));
+  REQUIRE(too_wide.contains("error"));
+  CHECK(sentinel::events::BlockRangeController::is_result_limit_error(
+      too_wide["error"]["message"].get<std::string>()));
+
+  CHECK(rpc(node, get_logs(10, 13))["result"].size() == 20);
+
+  const json rejected = rpc(node, json::array({get_logs(10, 11)}));
+  CHECK(rejected.is_object());
+  CHECK(rejected.contains("error"));
+
+  const json stats = node.stats();
+  CHECK(stats["faults"]["too_many_results"] == 1);
+  CHECK(stats["faults"]["range_too_large"] == 1);
+  CHECK(stats["calls"]["eth_getLogs"] == 3);
+}
+
+TEST_CASE("MockNode: ArbitrumAdapter reads it through JsonRpcClient") {
+  MockNodeConfig cfg;
+  cfg.chain = manual_chain();
+  MockNode node(cfg);
+  auto server = serve(node);
+
+  JsonRpcClient client(server.url(), "mock");
+  ArbitrumAdapter adapter(client);
+  CHECK(adapter.chainId() == 42161);
+  CHECK(adapter.latestBlock() == 200);
+  CHECK(adapter.blockTimestamp(150) == node.chain().block_timestamp(150));
+
+  std::vector<Signal> out;
+  const auto fetch = adapter.fetchRange(100, 119, 42161, out);
+  CHECK(out.size() == 100);
+  CHECK(fetch.chain_head == 200);
+}
+
+TEST_CASE("MockNode: ArbitrumAdapter falls back to single calls when batches get HTTP 400") {
+  MockNodeConfig cfg;
+  cfg.chain = manual_chain();
+  cfg.faults.batch = false;
+  cfg.faults.batch_rejection_status = 400;
+  MockNode node(cfg);
+  auto server = serve(node);
+
+  JsonRpcClient client(server.url(), "mock");
+  ArbitrumAdapter adapter(client);
+
+  std::vector<Signal> out;
+  const auto first = adapter.fetchRange(100, 119, 42161, out);
+  CHECK(out.size() == 100);
+  CHECK(first.to_block_timestamp == node.chain().block_timestamp(119));
+
+  // Batching stays off: the next range goes straight to single calls
+  const uint64_t get_logs_before = node.stats()["calls"]["eth_getLogs"].get<uint64_t>();
+  out.clear();
+  adapter.fetchRange(120, 129, 42161, out);
+  CHECK(out.size() == 50);
+  CHECK(node.stats()["calls"]["eth_getLogs"].get<uint64_t>() == get_logs_before + 1);
+}
+
+TEST_CASE("MockNode: ArbitrumAdapter keeps batching after an HTTP error that is not a refusal") {
+  MockNodeConfig cfg;
+  cfg.chain = manual_chain();
+  cfg.faults.batch = false;
+  cfg.faults.batch_rejection_status = 403;
+  MockNode node(cfg);
+  auto server = serve(node);
+
+  JsonRpcClient client(server.url(), "mock");
+  ArbitrumAdapter adapter(client);
+
+  // An auth failure would fail single calls too: it is reported, and the
+  // next range is tried as a batch again
+  std::vector<Signal> out;
+  CHECK_THROWS_AS(adapter.fetchRange(100, 119, 42161, out), JsonRpcHttpError);
+  CHECK_THROWS_AS(adapter.fetchRange(100, 119, 42161, out), JsonRpcHttpError);
+  CHECK(out.empty());
+  CHECK_FALSE(node.stats()["calls"].contains("eth_getLogs"));
+}
+
+TEST_CASE("MockNode: EventSource delivers every log once despite injected failures") {
+  MockNodeConfig cfg;
+  cfg.chain = manual_chain();
+  cfg.faults.rpc_error_rate = 0.2;
+  cfg.faults.too_many_results_rate = 0.1;
+  cfg.seed = 3;
+  MockNode node(cfg);
+  auto server = serve(node);
+
+  JsonRpcClient client(server.url(), "mock");
+  ArbitrumAdapter adapter(client);
+  sentinel::risk::RingBuffer<Signal> ring(4096);
+
+  sentinel::events::EventSourceConfig source_cfg;
+  source_cfg.start_block = 101;
+  source_cfg.max_block_range = 16;
+  source_cfg.initial_block_range = 16;
+  source_cfg.idle_sleep = std::chrono::milliseconds(2);
+  source_cfg.error_backoff = std::chrono::milliseconds(1);
+  source_cfg.backfill_parallelism = 2;
+
+  // The chain id lookup at construction is not retried
+  std::unique_ptr<sentinel::events::EventSource> source;
+  for (int attempt = 0; !source; ++attempt) {
+    try {
+      source = std::make_unique<sentinel::events::EventSource>(adapter, ring, source_cfg, "mock");
+    } catch (const std::exception &) {
+      REQUIRE(attempt < 20);
+    }
+  }
+  std::jthread runner([&](std::stop_token st) { source->run(st); });
+
+  std::set<std::pair<uint64_t, uint32_t>> seen;
+  std::size_t duplicates = 0;
+  bool mined = false;
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+  while (seen.size() < 550 && std::chrono::steady_clock::now() < deadline) {
+    Signal *s = ring.front();
+    if (!s) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      continue;
+    }
+    if (s->type != SignalType::Control &&
+        !seen.emplace(s->meta.block_number, s->meta.log_index).second) {
+      ++duplicates;
+    }
+    ring.pop();
+    // Backfill done: grow the chain so the live path runs too
+    if (!mined && seen.size() == 500) {
+      node.chain().mine(10);
+      mined = true;
+    }
+  }
+  source->stop();
+  runner.request_stop();
+  runner.join();
+
+  CHECK(seen.size() == 550); // blocks 101..210, 5 logs each
+  CHECK(duplicates == 0);
+  CHECK(seen.begin()->first == 101);
+  CHECK(seen.rbegin()->first == 210);
+  const json stats = node.stats();
+  CHECK(stats["faults"]["rpc_errors"].get<uint64_t>() > 0);
+}
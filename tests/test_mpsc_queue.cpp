@@ -0,0 +1,97 @@
+#include "sentinel/risk/mpsc_queue.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sentinel::risk;
+
+TEST_CASE("MpscQueue rounds capacity up to a power of two") {
+  REQUIRE(MpscQueue<int>(0).capacity() == 2);
+  REQUIRE(MpscQueue<int>(5).capacity() == 8);
+  REQUIRE(MpscQueue<int>(64).capacity() == 64);
+}
+
+TEST_CASE("MpscQueue rejects pushes when full and keeps the value") {
+  MpscQueue<std::string> q(4);
+  for (int i = 0; i < 4; ++i) {
+    REQUIRE(q.try_push(std::to_string(i)));
+  }
+  std::string extra = "extra";
+  REQUIRE_FALSE(q.try_push(std::move(extra)));
+  REQUIRE(extra == "extra");
+  REQUIRE(q.size() == 4);
+
+  std::vector<std::string> out;
+  REQUIRE(q.pop_batch(out, 3) == 3);
+  REQUIRE(out == std::vector<std::string>{"0", "1", "2"});
+
+  // The freed slots are reusable after wrapping around
+  REQUIRE(q.try_push(std::move(extra)));
+  out.clear();
+  REQUIRE(q.pop_batch(out, 10) == 2);
+  REQUIRE(out == std::vector<std::string>{"3", "extra"});
+  REQUIRE(q.empty());
+}
+
+TEST_CASE("MpscQueue delivers every item once, in order per producer") {
+  constexpr int kProducers = 4;
+  constexpr uint32_t kPerProducer = 50000;
+  MpscQueue<uint64_t> q(256);
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&q, p] {
+      for (uint32_t i = 0; i < kPerProducer; ++i) {
+        uint64_t v = (static_cast<uint64_t>(p) << 32) | i;
+        while (!q.try_push(std::move(v))) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  std::vector<uint32_t> next(kProducers, 0);
+  std::vector<uint64_t> batch;
+  uint64_t received = 0;
+  while (received < kProducers * uint64_t{kPerProducer}) {
+    batch.clear();
+    if (q.pop_batch(batch, 32) == 0) {
+      q.wait_for(std::chrono::milliseconds(10), [] { return false; });
+      continue;
+    }
+    for (uint64_t v : batch) {
+      const auto p = static_cast<std::size_t>(v >> 32);
+      REQUIRE(static_cast<uint32_t>(v) == next[p]);
+      ++next[p];
+    }
+    received += batch.size();
+  }
+
+  for (auto &t : producers) t.join();
+  REQUIRE(q.empty());
+  for (uint32_t n : next) REQUIRE(n == kPerProducer);
+}
+
+TEST_CASE("MpscQueue wait_for wakes on push and times out when idle") {
+  MpscQueue<int> q(8);
+
+  auto start = std::chrono::steady_clock::now();
+  q.wait_for(std::chrono::milliseconds(20), [] { return false; });
+  REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(15));
+
+  std::thread producer([&q] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    q.try_push(7);
+  });
+  start = std::chrono::steady_clock::now();
+  while (q.empty()) {
+    q.wait_for(std::chrono::seconds(5), [] { return false; });
+  }
+  REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::seconds(2));
+  producer.join();
+}
@@ -329,3 +329,55 @@ TEST_CASE("OracleUpdateRule — feed with no configured customer records no stat
     rule.evaluate(make_oracle_signal(kChain, kAggregator, 200, 2, 0, 4000), store, alerts);
     REQUIRE(alerts.size() == 1);
 }
+
+TEST_CASE("OracleUpdateRule — answers wider than 64 bits are compared, not skipped") {
+    auto configs = make_configs_map({make_config(1, kChain, kAggregator, "WEIRD/USD", 500, 18)});
+    OracleUpdateRule rule(std::move(configs));
+
+    StateStore store;
+    std::vector<Alert> alerts;
+
+    // 2^70 -> 2^70 * 1.5: +50.00%
+    const uint256 base = uint256(1) << 70;
+    rule.evaluate(make_oracle_signal_with_answer(kChain, kAggregator, base.to_be_bytes(), 1, 0, 1000),
+                  store, alerts);
+    REQUIRE(alerts.empty());
+
+    const uint256 next = base + (base >> 1);
+    rule.evaluate(make_oracle_signal_with_answer(kChain, kAggregator, next.to_be_bytes(), 2, 0, 2000),
+                  store, alerts);
+    REQUIRE(alerts.size() == 1);
+    REQUIRE(*alerts[0].amount_decimal == "1770887431076116955136");
+    REQUIRE(alerts[0].message.ends_with(": 50.00% change"));
+}
+
+TEST_CASE("OracleUpdateRule — reload keeps the baseline of feeds that stay configured") {
+    OracleUpdateRule rule(make_configs_map({make_config(1, kChain, kAggregator, "ETH/USD", 500)}));
+    RcuDomain rcu;
+
+    StateStore store;
+    std::vector<Alert> alerts;
+    rule.evaluate(make_oracle_signal(kChain, kAggregator, 1000, 1, 0, 1000), store, alerts);
+    REQUIRE(alerts.empty());
+
+    // Lower threshold for the existing feed, plus a new feed
+    rule.reload(make_configs_map({make_config(1, kChain, kAggregator, "ETH/USD", 100),
+                                  make_config(2, kChain, kOtherAggregator, "BTC/USD", 100)}),
+                rcu);
+    REQUIRE(rule.config_generation() == 1);
+
+    // +2%: compared with the observation from before the reload
+    rule.evaluate(make_oracle_signal(kChain, kAggregator, 1020, 2, 0, 2000), store, alerts);
+    REQUIRE(alerts.size() == 1);
+    REQUIRE(alerts[0].customer_id == 1);
+
+    // The new feed starts cold
+    alerts.clear();
+    rule.evaluate(make_oracle_signal(kChain, kOtherAggregator, 500, 1, 0, 3000), store, alerts);
+    REQUIRE(alerts.empty());
+
+    // A feed dropped by a reload is no longer evaluated
+    rule.reload(make_configs_map({make_config(2, kChain, kOtherAggregator, "BTC/USD", 100)}), rcu);
+    rule.evaluate(make_oracle_signal(kChain, kAggregator, 5000, 3, 0, 4000), store, alerts);
+    REQUIRE(alerts.empty());
+}
@@ -41,7 +41,7 @@ TEST_CASE("Regression: Existing Full Flow is preserved") {
         .customer_id = 99,
         .chain_id = 1,
         .token_address = token_addr,
-        .threshold_be = utils::decimal_to_be_256("1000")
+        .threshold = utils::uint256::from_decimal("1000")
     });
 
     LargeTransferRule rule(configs);
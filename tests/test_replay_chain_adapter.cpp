@@ -0,0 +1,194 @@
+#include "sentinel/events/log_stream_decoder.hpp"
+#include "sentinel/replay/replay_chain_adapter.hpp"
+#include "sentinel/replay/replay_runner.hpp"
+#include "sentinel/replay/rules_file.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+using namespace sentinel::replay;
+using sentinel::events::RawLog;
+using sentinel::risk::Signal;
+
+namespace {
+
+constexpr uint64_t kChainId = 42161;
+const std::string kToken = "0x1111111111111111111111111111111111111111";
+const std::string kTransfer = "0xddf252ad1be2c89b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef";
+const std::string kAddrA = "0x000000000000000000000000aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa";
+const std::string kAddrB = "0x000000000000000000000000bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb";
+
+std::string hex(uint64_t v) {
+  char buf[24];
+  std::snprintf(buf, sizeof(buf), "0x%llx", static_cast<unsigned long long>(v));
+  return buf;
+}
+
+// A Transfer of block * 1000 in each block
+RawLog transfer_in(uint64_t block) {
+  char amount[67];
+  std::snprintf(amount, sizeof(amount), "0x%064llx",
+                static_cast<unsigned long long>(block * 1000));
+  char tx[67];
+  std::snprintf(tx, sizeof(tx), "0x%064llx", static_cast<unsigned long long>(block));
+
+  RawLog raw{};
+  raw.address = kToken;
+  raw.topics = {kTransfer, kAddrA, kAddrB};
+  raw.data = amount;
+  raw.blockNumber = hex(block);
+  raw.transactionIndex = "0x0";
+  raw.logIndex = "0x0";
+  raw.transactionHash = tx;
+  return raw;
+}
+
+std::string response_for(uint64_t from, uint64_t to, int parity = -1) {
+  std::vector<RawLog> logs;
+  for (uint64_t b = from; b <= to; ++b) {
+    if (parity < 0 || static_cast<int>(b % 2) == parity) {
+      logs.push_back(transfer_in(b));
+    }
+  }
+  nlohmann::json res{{"jsonrpc", "2.0"}, {"id", 1}, {"result", logs}};
+  return res.dump();
+}
+
+CorpusRecord logs_record(uint64_t offset_us, uint64_t from, uint64_t to, uint32_t part,
+                         std::string body) {
+  return CorpusRecord{RecordKind::Logs, offset_us, from, to, part, std::move(body)};
+}
+
+// Blocks 1..30: two plain ranges, one split into two address chunks (the
+// way the adapter records a multi-chunk fetch) and a refetch overlapping
+// the first two.
+std::vector<CorpusRecord> corpus() {
+  std::vector<CorpusRecord> records;
+  records.push_back({RecordKind::ChainId, 0, kChainId, 0, 0, {}});
+  records.push_back({RecordKind::Head, 0, 30, 0, 0, {}});
+  records.push_back({RecordKind::BlockTimestamp, 10, 1, 1'700'000'000, 0, {}});
+  records.push_back(logs_record(1'000, 1, 10, 0, response_for(1, 10)));
+  records.push_back({RecordKind::BlockTimestamp, 1'000, 11, 1'700'000'100, 0, {}});
+  records.push_back(logs_record(2'000, 11, 20, 0, response_for(11, 20)));
+  records.push_back(logs_record(3'000, 21, 30, 0, response_for(21, 30, 1)));
+  records.push_back(logs_record(3'000, 21, 30, 1, response_for(21, 30, 0)));
+  records.push_back(logs_record(4'000, 5, 12, 0, response_for(5, 12)));
+  return records;
+}
+
+std::vector<uint64_t> blocks_of(const std::vector<Signal> &signals) {
+  std::vector<uint64_t> blocks;
+  for (const auto &s : signals) {
+    blocks.push_back(s.meta.block_number);
+  }
+  return blocks;
+}
+
+std::vector<uint64_t> block_range(uint64_t from, uint64_t to) {
+  std::vector<uint64_t> blocks;
+  for (uint64_t b = from; b <= to; ++b) {
+    blocks.push_back(b);
+  }
+  return blocks;
+}
+
+} // namespace
+
+TEST_CASE("ReplayChainAdapter: indexes the recorded ranges") {
+  ReplayChainAdapter adapter(corpus());
+  CHECK(adapter.chainId() == kChainId);
+  CHECK(adapter.first_block() == 1);
+  CHECK(adapter.last_block() == 30);
+  CHECK(adapter.latestBlock() == 30);
+  CHECK(adapter.ranges() == 3);
+  CHECK(adapter.overlapping_ranges() == 1);
+
+  CHECK(adapter.blockTimestamp(1) == 1'700'000'000);
+  CHECK(adapter.blockTimestamp(10) == 1'700'000'000);
+  CHECK(adapter.blockTimestamp(11) == 1'700'000'100);
+  CHECK(adapter.blockTimestamp(30) == 1'700'000'100);
+}
+
+TEST_CASE("ReplayChainAdapter: serves any range as a node would") {
+  ReplayChainAdapter adapter(corpus());
+  std::vector<Signal> out;
+
+  SECTION("a recorded range decodes like the raw response") {
+    adapter.getSignals(11, 20, kChainId, out);
+    std::vector<Signal> direct;
+    sentinel::events::decode_get_logs_response(response_for(11, 20), kChainId, direct);
+    REQUIRE(out.size() == direct.size());
+    for (std::size_t i = 0; i < out.size(); ++i) {
+      REQUIRE(out[i].meta.block_number == direct[i].meta.block_number);
+      REQUIRE(out[i].meta.tx_hash == direct[i].meta.tx_hash);
+    }
+  }
+
+  SECTION("part of a range") {
+    adapter.getSignals(4, 6, kChainId, out);
+    CHECK(blocks_of(out) == block_range(4, 6));
+  }
+
+  SECTION("across ranges, with address chunks merged in block order") {
+    adapter.getSignals(8, 25, kChainId, out);
+    CHECK(blocks_of(out) == block_range(8, 25));
+    CHECK(adapter.signals_served() == 18);
+  }
+
+  SECTION("blocks past the capture have no logs") {
+    adapter.getSignals(31, 40, kChainId, out);
+    CHECK(out.empty());
+  }
+
+  SECTION("getLogs agrees with getSignals") {
+    const auto logs = adapter.getLogs(9, 22);
+    REQUIRE(logs.size() == 14);
+    CHECK(logs.front().blockNumber == hex(9));
+  }
+}
+
+TEST_CASE("ReplayChainAdapter: rejects a corpus it cannot serve") {
+  std::vector<CorpusRecord> no_chain{logs_record(0, 1, 2, 0, response_for(1, 2))};
+  REQUIRE_THROWS(ReplayChainAdapter(no_chain));
+
+  std::vector<CorpusRecord> no_logs{{RecordKind::ChainId, 0, kChainId, 0, 0, {}}};
+  REQUIRE_THROWS(ReplayChainAdapter(no_logs));
+}
+
+TEST_CASE("run_replay: the whole corpus reaches the dispatcher") {
+  ReplayChainAdapter adapter(corpus());
+  auto rules = rules_from_json(nlohmann::json::parse(R"({
+    "large_transfer": [{"customer_id": 7, "chain_id": 42161,
+                        "token_address": "0x1111111111111111111111111111111111111111",
+                        "threshold": "15500"}]
+  })"));
+
+  ReplayOptions options;
+  options.max_block_range = 7;
+  options.timeout = std::chrono::seconds(30);
+  const auto report = run_replay(adapter, std::move(rules), options);
+
+  REQUIRE(report.completed);
+  CHECK(report.first_block == 1);
+  CHECK(report.last_block == 30);
+  CHECK(report.signals == 30);
+  CHECK(report.alerts_generated == 15); // blocks 16..30
+  // One customer, rule and token, so the dedup window suppresses repeats
+  CHECK(report.alerts_delivered >= 1);
+  CHECK(report.alerts_delivered <= report.alerts_generated);
+  CHECK(report.signals_per_second() > 0);
+
+  bool saw_rule_stage = false;
+  for (const auto &stage : report.stages) {
+    if (stage.stage == "rule:large_transfer") {
+      saw_rule_stage = true;
+      CHECK(stage.count == 30);
+    }
+  }
+  CHECK(saw_rule_stage);
+}
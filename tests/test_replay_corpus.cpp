@@ -0,0 +1,121 @@
+#include "sentinel/replay/corpus.hpp"
+#include "sentinel/replay/latency_histogram.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <zlib.h>
+
+using namespace sentinel::replay;
+
+namespace {
+
+std::string temp_path(const char *name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+} // namespace
+
+TEST_CASE("Corpus: records read back in the order they were written") {
+  const std::string path = temp_path("sentinel_test_corpus.bin");
+  const std::string big(200'000, 'x');
+  {
+    CorpusWriter writer(path);
+    writer.chain_id(42161);
+    writer.head(120);
+    writer.block_timestamp(110, 1'700'000'000);
+    writer.logs(100, 110, std::vector<std::string_view>{R"({"result":[]})", big});
+    REQUIRE(writer.records() == 5);
+  }
+
+  CorpusReader reader(path);
+  CorpusRecord r;
+  REQUIRE(reader.next(r));
+  CHECK(r.kind == RecordKind::ChainId);
+  CHECK(r.a == 42161);
+  REQUIRE(reader.next(r));
+  CHECK(r.kind == RecordKind::Head);
+  CHECK(r.a == 120);
+  REQUIRE(reader.next(r));
+  CHECK(r.kind == RecordKind::BlockTimestamp);
+  CHECK(r.a == 110);
+  CHECK(r.b == 1'700'000'000);
+  REQUIRE(reader.next(r));
+  CHECK(r.kind == RecordKind::Logs);
+  CHECK(r.a == 100);
+  CHECK(r.b == 110);
+  CHECK(r.part == 0);
+  CHECK(r.body == R"({"result":[]})");
+  REQUIRE(reader.next(r));
+  CHECK(r.part == 1);
+  CHECK(r.body == big);
+  CHECK_FALSE(reader.next(r));
+  CHECK_FALSE(reader.truncated());
+
+  std::remove(path.c_str());
+}
+
+TEST_CASE("Corpus: a capture cut off mid-record keeps its complete records") {
+  const std::string path = temp_path("sentinel_test_corpus_cut.bin");
+  {
+    // What a killed capture leaves: a record header without its body
+    gzFile f = gzopen(path.c_str(), "wb");
+    REQUIRE(f != nullptr);
+    gzwrite(f, "SNTLRPC1", 8);
+    const unsigned char head[33] = {2, 0, 0, 0, 0, 0, 0, 0, 0, 7};
+    gzwrite(f, head, sizeof(head));
+    unsigned char logs[33] = {4};
+    logs[29] = 100; // body length, never written
+    gzwrite(f, logs, sizeof(logs));
+    gzclose(f);
+  }
+
+  const auto records = read_corpus(path);
+  REQUIRE(records.size() == 1);
+  CHECK(records[0].kind == RecordKind::Head);
+  CHECK(records[0].a == 7);
+
+  std::remove(path.c_str());
+}
+
+TEST_CASE("Corpus: other files are rejected") {
+  const std::string path = temp_path("sentinel_test_not_corpus.bin");
+  {
+    std::ofstream(path) << "hello";
+  }
+  REQUIRE_THROWS(CorpusReader(path));
+  REQUIRE_THROWS(CorpusReader(temp_path("sentinel_test_missing_corpus.bin")));
+  std::remove(path.c_str());
+}
+
+TEST_CASE("LatencyHistogram: percentiles are within a bucket of the true value") {
+  LatencyHistogram h;
+  CHECK(h.percentile(50) == 0);
+
+  for (uint64_t v = 1; v <= 1000; ++v) {
+    h.record(v * 1000); // 1us .. 1ms
+  }
+  CHECK(h.count() == 1000);
+  CHECK(h.max() == 1'000'000);
+
+  auto near = [](uint64_t got, uint64_t want) {
+    return got >= want && got <= want + want / 8;
+  };
+  CHECK(near(h.percentile(50), 500'000));
+  CHECK(near(h.percentile(99), 990'000));
+  CHECK(h.percentile(100) == 1'000'000);
+
+  // Small values are exact; buckets cover every value without gaps
+  CHECK(LatencyHistogram::bucket_of(17) == 17);
+  for (std::size_t b = 0; b + 1 < LatencyHistogram::kBuckets; ++b) {
+    REQUIRE(LatencyHistogram::bucket_of(LatencyHistogram::bucket_upper(b)) == b);
+    REQUIRE(LatencyHistogram::bucket_of(LatencyHistogram::bucket_upper(b) + 1) == b + 1);
+  }
+  CHECK(LatencyHistogram::bucket_of(UINT64_MAX) == LatencyHistogram::kBuckets - 1);
+}
@@ -0,0 +1,302 @@
+#include "sentinel/risk/risk_engine.hpp"
+#include "sentinel/risk/checkpoint_writer.hpp"
+#include "sentinel/risk/rcu.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace sentinel::risk;
+
+namespace {
+
+constexpr uint64_t kChain = 42161;
+
+std::array<uint8_t, 20> token(uint8_t n) {
+  std::array<uint8_t, 20> addr{};
+  addr[0] = 0xaa;
+  addr[19] = n;
+  return addr;
+}
+
+Signal make_transfer(uint8_t token_id, uint64_t seq) {
+  Signal s{};
+  s.type = SignalType::Transfer;
+  s.meta.block_number = seq;
+  TransferEvent ev{};
+  ev.chain_id = kChain;
+  ev.token_address = token(token_id);
+  s.payload = ev;
+  return s;
+}
+
+Signal make_stop() {
+  Signal s{};
+  s.type = SignalType::Control;
+  s.payload = ControlSignal{ControlSignal::Command::Stop};
+  return s;
+}
+
+Signal make_sync(uint64_t block) {
+  Signal s{};
+  s.type = SignalType::Control;
+  s.payload = ControlSignal{.command = ControlSignal::Command::Sync, .block = block};
+  return s;
+}
+
+struct NullSink : ICheckpointSink {
+  void save(uint64_t) override {}
+};
+
+// Records which thread saw which signal, in evaluation order.
+class RecordingRule : public IRiskRule {
+public:
+  struct Seen {
+    uint8_t token_id;
+    uint64_t seq;
+    std::thread::id thread;
+  };
+
+  SignalMask interests() const override { return make_mask(SignalType::Transfer); }
+  std::string_view rule_type_name() const override { return "recording"; }
+
+  void evaluate(const Signal &signal, StateStore &, std::vector<Alert> &) override {
+    const auto &tr = std::get<TransferEvent>(signal.payload);
+    std::lock_guard<std::mutex> lk(mu);
+    seen.push_back({tr.token_address[19], signal.meta.block_number,
+                    std::this_thread::get_id()});
+  }
+
+  std::mutex mu;
+  std::vector<Seen> seen;
+};
+
+// Reads a snapshot published from another thread on every signal.
+class SnapshotRule : public IRiskRule {
+public:
+  struct Config {
+    explicit Config(uint64_t v) : version(v) {}
+    ~Config() { canary = 0; }
+    uint64_t version;
+    uint64_t canary = 0xC0FFEE;
+  };
+
+  SignalMask interests() const override { return make_mask(SignalType::Transfer); }
+  std::string_view rule_type_name() const override { return "snapshot"; }
+
+  void evaluate(const Signal &, StateStore &, std::vector<Alert> &) override {
+    const Config &c = config.read();
+    if (c.canary != 0xC0FFEE) {
+      freed_read = true;
+    }
+    if (c.version == latest) {
+      saw_latest.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  RcuCell<Config> config{std::make_unique<const Config>(0)};
+  std::atomic<bool> freed_read{false};
+  uint64_t latest = 0; // set before the engine starts
+  std::atomic<uint64_t> saw_latest{0};
+};
+
+void run_engine(unsigned workers, RecordingRule &rule, uint64_t signals,
+                uint8_t tokens) {
+  RingBuffer<Signal> ring(1024);
+  AlertDispatcher dispatcher("test", nullptr, DeduplicatorConfig{}, {});
+  RiskEngine engine(ring, dispatcher, "test", nullptr, nullptr,
+                    RiskEngineConfig{.workers = workers, .shard_queue_capacity = 64});
+  engine.register_rule(&rule);
+  REQUIRE(engine.worker_count() == std::max(workers, 1u));
+
+  std::jthread engine_thread([&](std::stop_token st) { engine.run(st); });
+
+  for (uint64_t seq = 0; seq < signals; ++seq) {
+    Signal s = make_transfer(static_cast<uint8_t>(seq % tokens), seq);
+    while (!ring.try_push(std::move(s))) {
+      std::this_thread::yield();
+    }
+  }
+  while (!ring.try_push(make_stop())) {
+    std::this_thread::yield();
+  }
+
+  engine_thread.join();
+  REQUIRE(engine.is_finished());
+}
+
+} // namespace
+
+TEST_CASE("partition_key follows the contract a signal is about") {
+  const Signal a = make_transfer(1, 0);
+  const Signal b = make_transfer(1, 99);
+  const Signal c = make_transfer(2, 0);
+  REQUIRE(partition_key(a) == partition_key(b));
+  REQUIRE(partition_key(a) != partition_key(c));
+
+  Signal other_chain = make_transfer(1, 0);
+  std::get<TransferEvent>(other_chain.payload).chain_id = 1;
+  REQUIRE(partition_key(other_chain) != partition_key(a));
+
+  // Oracle updates key on the aggregator, like the rule's per-feed state
+  Signal oracle{};
+  oracle.type = SignalType::OracleUpdate;
+  OracleUpdateEvent ev{};
+  ev.chain_id = kChain;
+  ev.aggregator_address = token(1);
+  oracle.payload = ev;
+  REQUIRE(partition_key(oracle) == partition_key(a));
+
+  REQUIRE(partition_key(make_stop()) == 0);
+}
+
+TEST_CASE("Sharded RiskEngine evaluates each signal once, in order per contract") {
+  constexpr uint64_t kSignals = 20000;
+  constexpr uint8_t kTokens = 37;
+
+  RecordingRule rule;
+  run_engine(4, rule, kSignals, kTokens);
+
+  // The poison pill drains everything pushed before it
+  REQUIRE(rule.seen.size() == kSignals);
+
+  std::map<uint8_t, uint64_t> last_seq;
+  std::map<uint8_t, std::thread::id> owner;
+  std::set<std::thread::id> threads;
+  std::set<uint64_t> seqs;
+
+  for (const auto &s : rule.seen) {
+    seqs.insert(s.seq);
+    threads.insert(s.thread);
+
+    auto [it, first] = owner.emplace(s.token_id, s.thread);
+    REQUIRE(it->second == s.thread); // one worker per contract
+
+    auto last = last_seq.find(s.token_id);
+    if (last != last_seq.end()) {
+      REQUIRE(s.seq > last->second); // ring order kept per contract
+    }
+    last_seq[s.token_id] = s.seq;
+  }
+
+  REQUIRE(seqs.size() == kSignals);
+  REQUIRE(threads.size() > 1);
+  REQUIRE(threads.count(std::this_thread::get_id()) == 0);
+}
+
+TEST_CASE("Single-worker RiskEngine keeps global order") {
+  RecordingRule rule;
+  run_engine(1, rule, 5000, 7);
+
+  REQUIRE(rule.seen.size() == 5000);
+  for (std::size_t i = 0; i < rule.seen.size(); ++i) {
+    REQUIRE(rule.seen[i].seq == i);
+  }
+}
+
+TEST_CASE("Sharded RiskEngine stops without the poison pill") {
+  RingBuffer<Signal> ring(16);
+  AlertDispatcher dispatcher("test", nullptr, DeduplicatorConfig{}, {});
+  RiskEngine engine(ring, dispatcher, "test", nullptr, nullptr,
+                    RiskEngineConfig{.workers = 3});
+
+  std::jthread engine_thread([&](std::stop_token st) { engine.run(st); });
+  engine.stop();
+  engine_thread.join();
+  REQUIRE(engine.is_finished());
+}
+
+TEST_CASE("RiskEngine passes checkpoint barriers on once every worker reached them") {
+  for (const unsigned workers : {1u, 4u}) {
+    CAPTURE(workers);
+    RecordingRule rule;
+    CheckpointWriter writer(std::make_unique<NullSink>(), 0,
+                            CheckpointWriterConfig{.min_interval = std::chrono::hours(1)});
+    RingBuffer<Signal> ring(1024);
+    AlertDispatcher dispatcher("test", nullptr, DeduplicatorConfig{}, {});
+    dispatcher.set_checkpoint_writer(&writer);
+    RiskEngine engine(ring, dispatcher, "test", nullptr, nullptr,
+                      RiskEngineConfig{.workers = workers, .shard_queue_capacity = 64});
+    engine.register_rule(&rule);
+
+    std::jthread dispatcher_thread([&](std::stop_token st) { dispatcher.run(st); });
+    std::jthread engine_thread([&](std::stop_token st) { engine.run(st); });
+
+    auto push = [&](Signal s) {
+      while (!ring.try_push(std::move(s))) {
+        std::this_thread::yield();
+      }
+    };
+    for (uint64_t block = 1; block <= 50; ++block) {
+      for (uint8_t t = 0; t < 8; ++t) {
+        push(make_transfer(t, block));
+      }
+      push(make_sync(block));
+    }
+    push(make_stop());
+    engine_thread.join();
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (writer.latest() < 50 && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(writer.latest() == 50);
+    REQUIRE(rule.seen.size() == 50 * 8);
+
+    dispatcher.stop();
+    dispatcher_thread.join();
+  }
+}
+
+TEST_CASE("RiskEngine picks up rule configs published while it runs") {
+  for (const unsigned workers : {1u, 4u}) {
+    CAPTURE(workers);
+    RcuDomain rcu;
+    SnapshotRule rule;
+    rule.latest = 2000;
+    RingBuffer<Signal> ring(1024);
+    AlertDispatcher dispatcher("test", nullptr, DeduplicatorConfig{}, {});
+    RiskEngine engine(ring, dispatcher, "test", nullptr, nullptr,
+                      RiskEngineConfig{.workers = workers, .shard_queue_capacity = 64, .rcu = &rcu});
+    engine.register_rule(&rule);
+
+    std::jthread engine_thread([&](std::stop_token st) { engine.run(st); });
+    std::jthread publisher([&](std::stop_token st) {
+      for (uint64_t v = 1; v <= 2000 && !st.stop_requested(); ++v) {
+        rule.config.publish(std::make_unique<const SnapshotRule::Config>(v), rcu);
+      }
+    });
+
+    for (uint64_t seq = 0; seq < 20'000; ++seq) {
+      Signal s = make_transfer(static_cast<uint8_t>(seq % 16), seq);
+      while (!ring.try_push(std::move(s))) {
+        std::this_thread::yield();
+      }
+    }
+    publisher.join();
+    // Signals after the last publish see it
+    for (uint64_t seq = 0; seq < 64; ++seq) {
+      while (!ring.try_push(make_transfer(static_cast<uint8_t>(seq % 16), seq))) {
+        std::this_thread::yield();
+      }
+    }
+    while (!ring.try_push(make_stop())) {
+      std::this_thread::yield();
+    }
+    engine_thread.join();
+
+    REQUIRE_FALSE(rule.freed_read);
+    REQUIRE(rule.saw_latest >= 64);
+    // The engine's readers are gone, so nothing is held back
+    rcu.collect();
+    REQUIRE(rcu.pending() == 0);
+  }
+}
@@ -0,0 +1,80 @@
+#include "sentinel/risk/timer_wheel.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <vector>
+
+using namespace sentinel::risk;
+using namespace std::chrono_literals;
+
+namespace {
+
+const TimerWheel::Clock::time_point t0{};
+
+void run(std::vector<TimerWheel::Callback> due) {
+  for (auto &fn : due) fn();
+}
+
+} // namespace
+
+TEST_CASE("TimerWheel fires timers once their tick has passed, never early") {
+  TimerWheel wheel(10ms, 8, t0);
+  std::vector<int> fired;
+  wheel.schedule(t0 + 25ms, [&] { fired.push_back(25); });
+  wheel.schedule(t0 + 10ms, [&] { fired.push_back(10); });
+  REQUIRE(wheel.size() == 2);
+
+  run(wheel.expire(t0 + 9ms));
+  REQUIRE(fired.empty());
+  run(wheel.expire(t0 + 10ms));
+  REQUIRE(fired == std::vector<int>{10});
+  // 25 ms rounds up to the 30 ms tick
+  run(wheel.expire(t0 + 29ms));
+  REQUIRE(fired.size() == 1);
+  run(wheel.expire(t0 + 30ms));
+  REQUIRE(fired == std::vector<int>{10, 25});
+  REQUIRE(wheel.empty());
+}
+
+TEST_CASE("TimerWheel keeps timers beyond one rotation for their round") {
+  TimerWheel wheel(10ms, 4, t0);
+  int fired = 0;
+  // Same slot as 20 ms, three rotations later
+  wheel.schedule(t0 + 140ms, [&] { ++fired; });
+  wheel.schedule(t0 + 20ms, [&] { ++fired; });
+
+  run(wheel.expire(t0 + 60ms));
+  REQUIRE(fired == 1);
+  REQUIRE(wheel.next_due() == t0 + 100ms); // early estimate: one rotation out
+  run(wheel.expire(t0 + 139ms));
+  REQUIRE(fired == 1);
+  REQUIRE(wheel.next_due() == t0 + 140ms);
+  run(wheel.expire(t0 + 140ms));
+  REQUIRE(fired == 2);
+  REQUIRE_FALSE(wheel.next_due().has_value());
+}
+
+TEST_CASE("TimerWheel catches up after a long gap") {
+  TimerWheel wheel(10ms, 4, t0);
+  int fired = 0;
+  for (int ms = 10; ms <= 200; ms += 10) {
+    wheel.schedule(t0 + std::chrono::milliseconds(ms), [&] { ++fired; });
+  }
+  run(wheel.expire(t0 + 1s));
+  REQUIRE(fired == 20);
+  REQUIRE(wheel.empty());
+}
+
+TEST_CASE("TimerWheel schedules overdue timers for the next tick") {
+  TimerWheel wheel(10ms, 8, t0);
+  run(wheel.expire(t0 + 50ms));
+
+  int fired = 0;
+  wheel.schedule(t0 + 5ms, [&] { ++fired; });
+  REQUIRE(wheel.next_due() == t0 + 60ms);
+  run(wheel.expire(t0 + 55ms));
+  REQUIRE(fired == 0);
+  run(wheel.expire(t0 + 60ms));
+  REQUIRE(fired == 1);
+}
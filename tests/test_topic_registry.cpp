@@ -0,0 +1,105 @@
+#include "sentinel/events/normalize.hpp"
+#include "sentinel/events/topic_registry.hpp"
+#include "sentinel/events/utils/hex.hpp"
+#include "sentinel/events/utils/keccak.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <string>
+#include <utility>
+#include <variant>
+
+using namespace sentinel::events;
+using namespace sentinel::events::utils;
+using sentinel::risk::GovernanceAction;
+using sentinel::risk::SignalType;
+
+// Published topic0 values. The hex literals the registry replaced had the
+// wrong tail for V3 Swap, Mint and Burn.
+static_assert(keccak256("Transfer(address,address,uint256)") ==
+              parse_topic_literal("0xddf252ad1be2c89b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef"));
+static_assert(keccak256("Swap(address,uint256,uint256,uint256,uint256,address)") ==
+              parse_topic_literal("0xd78ad95fa46c994b6551d0da85fc275fe613ce37657fb8d5e3d130840159d822"));
+static_assert(keccak256("Swap(address,address,int256,int256,uint160,uint128,int24)") ==
+              parse_topic_literal("0xc42079f94a6350d7e6235f29174924f928cc2ac818eb64fed8004e115fbcca67"));
+static_assert(keccak256("Mint(address,uint256,uint256)") ==
+              parse_topic_literal("0x4c209b5fc8ad50758f13e2e1088ba56a560dff690a1c6fef26394f4c03821c4f"));
+static_assert(keccak256("Burn(address,uint256,uint256,address)") ==
+              parse_topic_literal("0xdccd412f0b1252819cb1fd330b93224ca42612892bb3f4f789976e6d81936496"));
+static_assert(keccak256("OwnershipTransferred(address,address)") ==
+              parse_topic_literal("0x8be0079c531659141344cd1fd0a4f28419497f9722a3daafe3b4186f6b6457e0"));
+static_assert(keccak256("Paused(address)") ==
+              parse_topic_literal("0x62e78cea01bee320cd4e420270b5ea74000d11b0c9f74754ebdbfc544b05a258"));
+static_assert(keccak256("Unpaused(address)") ==
+              parse_topic_literal("0x5db9ee0a495bf2e6ff9c91a7834c1ba4fdd244a5e8aa4e537bd38aeae4b073aa"));
+static_assert(keccak256("RoleGranted(bytes32,address,address)") ==
+              parse_topic_literal("0x2f8788117e7eff1d82e926ec794901d17c78024a50270940304540a733656f0d"));
+static_assert(keccak256("RoleRevoked(bytes32,address,address)") ==
+              parse_topic_literal("0xf6391f5c32d9c69d2a47ea670b442974b53935d1edc7fd64eb21e047a839171b"));
+static_assert(keccak256("Upgraded(address)") ==
+              parse_topic_literal("0xbc7cd75a20ee27fd9adebab32041f755214dbc6bffa90cc0225b39da2e5c2d3b"));
+static_assert(keccak256("Approval(address,address,uint256)") ==
+              parse_topic_literal("0x8c5be1e5ebec7d5bd14f71427d1e84f3dd0314c0f7b2291e5b200ac8c7c3b925"));
+static_assert(keccak256("AnswerUpdated(int256,uint256,uint256)") ==
+              parse_topic_literal("0x0559884fd3a460db3073b7fc896cc77986f16e378210ded43186175bf646fc5f"));
+
+static_assert(find_topic(keccak256("Paused(address)"))->action == GovernanceAction::Paused);
+static_assert(find_topic(keccak256("Deposit(address,uint256)")) == nullptr);
+
+TEST_CASE("keccak256 matches reference vectors") {
+  REQUIRE(keccak256("") ==
+          parse_topic_literal("0xc5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470"));
+
+  // Same permutation with SHA3-256 padding, checked across the 136-byte
+  // block boundary
+  REQUIRE(utils::detail::keccak_256_sponge("abc", 0x06) ==
+          parse_topic_literal("0x3a985da74fe225b2045c172d6bd390bd855f086e3e9d525b46bfe24511431532"));
+  REQUIRE(utils::detail::keccak_256_sponge(std::string(135, 'a'), 0x06) ==
+          parse_topic_literal("0x8094bb53c44cfb1e67b7c30447f9a1c33696d2463ecc1d9c92538913392843c9"));
+  REQUIRE(utils::detail::keccak_256_sponge(std::string(136, 'a'), 0x06) ==
+          parse_topic_literal("0x3fc5559f14db8e453a0a3091edbd2bc25e11528d81c66fa570a4efdcc2695ee1"));
+  REQUIRE(utils::detail::keccak_256_sponge(std::string(300, 'a'), 0x06) ==
+          parse_topic_literal("0x8a5720b2ca0cae7b89ad399c5daab22c29f5c72bcf30ab81e807d9bda95b4580"));
+}
+
+TEST_CASE("find_topic resolves every registry entry and nothing else") {
+  for (const auto &entry : kTopicRegistry) {
+    INFO(std::string(entry.signature));
+    REQUIRE(find_topic(entry.topic0) == &entry);
+
+    // Same hash prefix, different tail
+    auto near = entry.topic0;
+    near[31] ^= 1;
+    REQUIRE(find_topic(near) == nullptr);
+  }
+
+  std::mt19937_64 rng(11);
+  for (int i = 0; i < 10000; ++i) {
+    std::array<uint8_t, 32> t{};
+    for (auto &b : t) b = static_cast<uint8_t>(rng());
+    REQUIRE(find_topic(t) == nullptr);
+  }
+}
+
+TEST_CASE("classify_log takes the governance action from the registry") {
+  const std::pair<const char *, GovernanceAction> cases[] = {
+      {"OwnershipTransferred(address,address)", GovernanceAction::OwnershipTransferred},
+      {"Paused(address)", GovernanceAction::Paused},
+      {"Unpaused(address)", GovernanceAction::Unpaused},
+      {"RoleGranted(bytes32,address,address)", GovernanceAction::RoleGranted},
+      {"RoleRevoked(bytes32,address,address)", GovernanceAction::RoleRevoked},
+      {"Upgraded(address)", GovernanceAction::Upgraded},
+  };
+
+  for (const auto &[signature, action] : cases) {
+    DecodedLog log{};
+    log.topic_count = 1;
+    log.topics[0] = keccak256(signature);
+
+    sentinel::risk::Signal out{};
+    classify_log(log, out);
+    REQUIRE(out.type == SignalType::Governance);
+    REQUIRE(std::get<sentinel::risk::GovernanceEvent>(out.payload).action == action);
+  }
+}
@@ -0,0 +1,112 @@
+#include "sentinel/events/utils/hex.hpp"
+#include "sentinel/events/utils/uint256.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <string>
+
+using namespace sentinel::events::utils;
+
+namespace {
+
+constexpr const char *kMax =
+    "115792089237316195423570985008687907853269984665640564039457584007913129639935";
+
+// The byte-at-a-time long division uint256 replaced, as an oracle.
+std::string reference_decimal(std::array<uint8_t, 32> buffer) {
+  std::string result;
+  bool is_zero = false;
+  while (!is_zero) {
+    uint32_t remainder = 0;
+    is_zero = true;
+    for (int i = 0; i < 32; ++i) {
+      uint32_t num = (remainder << 8) | buffer[i];
+      buffer[i] = static_cast<uint8_t>(num / 10);
+      remainder = num % 10;
+      if (buffer[i] != 0) {
+        is_zero = false;
+      }
+    }
+    result.insert(result.begin(), static_cast<char>('0' + remainder));
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("uint256 constexpr arithmetic and ordering") {
+  constexpr uint256 a = uint256(1) << 200;
+  static_assert(a.bit_width() == 201);
+  static_assert((a >> 200) == uint256(1));
+  static_assert(a - uint256(1) < a);
+  static_assert(a + a == uint256(1) << 201);
+  static_assert(uint256::max() + uint256(1) == uint256{});
+  static_assert(uint256{} - uint256(1) == uint256::max());
+  static_assert((uint256(7) * 6).low64() == 42);
+  static_assert(uint256(0, 0, 1, 0) / 2 == uint256(1ULL << 63));
+  static_assert(uint256(0, 0, 1, 5) % 10 == 1);  // 2^64 + 5 = ...21
+  static_assert(uint256::from_be_bytes(uint256(1, 2, 3, 4).to_be_bytes()) ==
+                uint256(1, 2, 3, 4));
+  static_assert(int256(-1).bits() == uint256::max());
+  static_assert(int256(-5) < int256(3));
+  static_assert(int256(-5) < int256(-4));
+  static_assert(int256(-5).magnitude() == uint256(5));
+
+  uint256 c = uint256::max();
+  REQUIRE(c.mul_small(2) == 1);
+  REQUIRE(c == uint256::max() - uint256(1));
+
+  uint256 d(1, 0, 0, 0);
+  REQUIRE(d.div_small(3) == 1);  // 2^192 = 3q + 1
+  REQUIRE(d * 3 + uint256(1) == uint256(1, 0, 0, 0));
+}
+
+TEST_CASE("uint256 decimal formatting matches long division") {
+  REQUIRE(uint256{}.to_decimal() == "0");
+  REQUIRE(uint256(10'000'000'000'000'000'000ULL).to_decimal() == "10000000000000000000");
+  REQUIRE(uint256::max().to_decimal() == kMax);
+  // Chunk boundaries: 10^19 and 10^38 need zero-padded low chunks
+  REQUIRE((uint256(10'000'000'000'000'000'000ULL) * 10'000'000'000'000'000'000ULL)
+              .to_decimal() == "1" + std::string(38, '0'));
+
+  std::mt19937_64 rng(3);
+  for (int i = 0; i < 2000; ++i) {
+    std::array<uint8_t, 32> be{};
+    // Vary the magnitude so every chunk count is covered
+    const std::size_t skip = static_cast<std::size_t>(rng() % 33);
+    for (std::size_t j = skip; j < 32; ++j) {
+      be[j] = static_cast<uint8_t>(rng());
+    }
+    const std::string expected = reference_decimal(be);
+    REQUIRE(uint256::from_be_bytes(be).to_decimal() == expected);
+    REQUIRE(uint256::from_decimal(expected) == uint256::from_be_bytes(be));
+  }
+}
+
+TEST_CASE("uint256 formats with token decimals") {
+  REQUIRE(uint256(1'500'000).to_decimal(6) == "1.5");
+  REQUIRE(uint256(1'000'000).to_decimal(6) == "1");
+  REQUIRE(uint256(1).to_decimal(6) == "0.000001");
+  REQUIRE(uint256(0).to_decimal(18) == "0");
+  REQUIRE(uint256(224680000000ULL).to_decimal(8) == "2246.8");
+  REQUIRE(uint256(42).to_decimal(0) == "42");
+  REQUIRE(uint256::from_decimal("123456789012345678901234567890").to_decimal(18) ==
+          "123456789012.34567890123456789");
+  REQUIRE(int256(-150).to_decimal(2) == "-1.5");
+  REQUIRE(int256(-150).to_decimal() == "-150");
+}
+
+TEST_CASE("uint256 decimal parsing rejects bad input") {
+  REQUIRE(uint256::from_decimal(kMax) == uint256::max());
+  REQUIRE(uint256::from_decimal("0000000000000000000000001") == uint256(1));
+  REQUIRE_THROWS(uint256::from_decimal(
+      "115792089237316195423570985008687907853269984665640564039457584007913129639936"));
+  REQUIRE_THROWS(uint256::from_decimal(std::string(kMax) + "0"));
+  REQUIRE_THROWS(uint256::from_decimal("12a"));
+  REQUIRE_THROWS(uint256::from_decimal("-1"));
+  REQUIRE_THROWS(uint256::from_decimal(""));
+
+  // The byte-array helpers are thin wrappers now
+  REQUIRE(uint256_be_to_decimal(decimal_to_be_256("1000").data()) == "1000");
+}
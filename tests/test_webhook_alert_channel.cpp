@@ -1,6 +1,8 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <chrono>
 #include <cstdint>
+#include <future>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -10,6 +12,9 @@
 
 #include "sentinel/risk/alert_dispatcher.hpp"      // Alert, CustomerId
 #include "sentinel/risk/webhook_alert_channel.hpp" // WebhookAlertChannel, WebhookEndpoint
+#include "sentinel/security/crypto.hpp"
+
+#include "local_http_server.hpp"
 
 using namespace sentinel::risk;
 
@@ -143,3 +148,151 @@ TEST_CASE("WebhookAlertChannel: optional fields omitted when unset",
     REQUIRE_FALSE(payload.contains("token_address"));
     REQUIRE_FALSE(payload.contains("amount_decimal"));
 }
+
+// ---------------------------------------------------------------------------
+// Delivery against a local HTTP server
+// ---------------------------------------------------------------------------
+
+TEST_CASE("WebhookAlertChannel: send_async signs and posts to every endpoint",
+          "[webhook]") {
+    sentinel::test::LocalHttpServer server([](const auto &req) {
+        sentinel::test::LocalHttpServer::Reply reply;
+        if (req.path == "/down")
+            reply.status = 500;
+        return reply;
+    });
+    HttpDeliveryConfig http_cfg;
+    http_cfg.retry.max_attempts = 1;
+    HttpDeliveryLoop http(http_cfg);
+
+    std::unordered_map<std::uint64_t, std::vector<WebhookEndpoint>> map;
+    map[42] = {
+        WebhookEndpoint{server.url("/signed"), "secret-a"},
+        WebhookEndpoint{server.url("/down"), ""},
+    };
+    WebhookAlertChannel channel(std::move(map), &http);
+
+    std::promise<DeliveryResult> result;
+    channel.send_async(make_alert(42), [&result](const DeliveryResult &r) {
+        result.set_value(r);
+    });
+    const DeliveryResult r = result.get_future().get();
+
+    // One endpoint answered 500, so the delivery as a whole failed
+    REQUIRE_FALSE(r.ok);
+    REQUIRE(r.error == "HTTP 500");
+
+    auto received = server.requests();
+    REQUIRE(received.size() == 2);
+    if (received[0].path != "/signed")
+        std::swap(received[0], received[1]);
+
+    const auto &signed_req = received[0];
+    const std::string ts = signed_req.headers.at("x-risk-sentinel-timestamp");
+    REQUIRE(signed_req.headers.at("x-risk-sentinel-signature") ==
+            "sha256=" + sentinel::security::hmac_sha256_hex(
+                            "secret-a", ts + "." + signed_req.body));
+    REQUIRE(nlohmann::json::parse(signed_req.body)["customer_id"] == 42);
+
+    // Same bytes to both endpoints; the unsigned one carries no signature
+    REQUIRE(received[1].body == signed_req.body);
+    REQUIRE(received[1].headers.count("x-risk-sentinel-signature") == 0);
+}
+
+TEST_CASE("WebhookAlertChannel: a full batch goes out as one signed array",
+          "[webhook]") {
+    sentinel::test::LocalHttpServer server;
+    HttpDeliveryLoop http;
+
+    WebhookEndpoint endpoint{server.url("/batch"), "secret-b"};
+    endpoint.batch_max_items = 3;
+    endpoint.batch_max_delay = std::chrono::seconds(30);
+    std::unordered_map<std::uint64_t, std::vector<WebhookEndpoint>> map;
+    map[42] = {endpoint};
+    WebhookAlertChannel channel(std::move(map), &http);
+
+    std::vector<std::promise<DeliveryResult>> results(3);
+    for (int i = 0; i < 3; ++i) {
+        Alert a = make_alert(42);
+        a.message = "alert " + std::to_string(i);
+        channel.send_async(a, [&results, i](const DeliveryResult &r) {
+            results[i].set_value(r);
+        });
+    }
+    for (auto &result : results) {
+        REQUIRE(result.get_future().get().ok);
+    }
+
+    const auto received = server.requests();
+    REQUIRE(received.size() == 1);
+    const auto &req = received[0];
+    REQUIRE(req.headers.at("x-risk-sentinel-batch-size") == "3");
+    const std::string ts = req.headers.at("x-risk-sentinel-timestamp");
+    REQUIRE(req.headers.at("x-risk-sentinel-signature") ==
+            "sha256=" + sentinel::security::hmac_sha256_hex(
+                            "secret-b", ts + "." + req.body));
+
+    const auto body = nlohmann::json::parse(req.body);
+    REQUIRE(body.is_array());
+    REQUIRE(body.size() == 3);
+    REQUIRE(body[0]["message"] == "alert 0");
+    REQUIRE(body[2]["message"] == "alert 2");
+}
+
+TEST_CASE("WebhookAlertChannel: a partial batch is sent after the delay",
+          "[webhook]") {
+    using namespace std::chrono_literals;
+    sentinel::test::LocalHttpServer server;
+    HttpDeliveryLoop http;
+
+    WebhookEndpoint batched{server.url("/batch"), ""};
+    batched.batch_max_items = 100;
+    batched.batch_max_delay = 50ms;
+    std::unordered_map<std::uint64_t, std::vector<WebhookEndpoint>> map;
+    map[42] = {batched, WebhookEndpoint{server.url("/direct"), ""}};
+    WebhookAlertChannel channel(std::move(map), &http);
+
+    const auto start = std::chrono::steady_clock::now();
+    std::promise<DeliveryResult> result;
+    channel.send_async(make_alert(42), [&result](const DeliveryResult &r) {
+        result.set_value(r);
+    });
+    REQUIRE(result.get_future().get().ok);
+
+    auto received = server.requests();
+    REQUIRE(received.size() == 2);
+    if (received[0].path != "/direct")
+        std::swap(received[0], received[1]);
+
+    // The unbatched endpoint is not held back by the batched one
+    REQUIRE(received[0].headers.count("x-risk-sentinel-batch-size") == 0);
+    REQUIRE(received[0].received_at - start < 50ms);
+    REQUIRE(received[1].received_at - start >= 50ms);
+    REQUIRE(received[1].headers.at("x-risk-sentinel-batch-size") == "1");
+    REQUIRE(nlohmann::json::parse(received[1].body).size() == 1);
+}
+
+TEST_CASE("WebhookAlertChannel: pending batches are sent on destruction",
+          "[webhook]") {
+    sentinel::test::LocalHttpServer server;
+    std::promise<DeliveryResult> result;
+    {
+        HttpDeliveryLoop http;
+        WebhookEndpoint endpoint{server.url("/batch"), ""};
+        endpoint.batch_max_items = 10;
+        endpoint.batch_max_delay = std::chrono::minutes(1);
+        std::unordered_map<std::uint64_t, std::vector<WebhookEndpoint>> map;
+        map[42] = {endpoint};
+        WebhookAlertChannel channel(std::move(map), &http);
+
+        channel.send_async(make_alert(42), [&result](const DeliveryResult &r) {
+            result.set_value(r);
+        });
+        channel.send_async(make_alert(42), [](const DeliveryResult &) {});
+    }
+    REQUIRE(result.get_future().get().ok);
+
+    const auto received = server.requests();
+    REQUIRE(received.size() == 1);
+    REQUIRE(nlohmann::json::parse(received[0].body).size() == 2);
+}